@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+
+#
+# Copyright (c) 2021 Project CHIP Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+set -e
+
+# Builds chip-perf against the sockets and the LwIP network configurations
+# and runs the same workloads on both. Extra arguments are passed to chip-perf.
+
+CHIP_ROOT="$(dirname "$0")/../.."
+
+source "$CHIP_ROOT/scripts/activate.sh"
+
+gn --root="$CHIP_ROOT" gen "$CHIP_ROOT/out/perf-sockets" --args='is_debug=false'
+gn --root="$CHIP_ROOT" gen "$CHIP_ROOT/out/perf-lwip" --args='is_debug=false chip_system_config_use_lwip=true chip_system_config_use_sockets=false chip_device_platform="none" lwip_platform="standalone"'
+
+for config in sockets lwip; do
+    ninja -C "$CHIP_ROOT/out/perf-$config" src/messaging/tests/perf:chip-perf
+done
+
+for config in sockets lwip; do
+    "$CHIP_ROOT/out/perf-$config/chip-perf" "$@"
+done
@@ -0,0 +1,173 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements an iterator that expands the wildcard attribute paths of a read request
+ *      into concrete attribute paths.
+ *
+ */
+
+#include <app/AttributePathExpandIterator.h>
+#include <app/InteractionModelEngine.h>
+
+namespace chip {
+namespace app {
+void AttributePathExpandIterator::Reset(ClusterInfo * apClusterInfoList)
+{
+    mpClusterInfo   = apClusterInfoList;
+    mEndpointIndex  = 0;
+    mClusterIndex   = 0;
+    mAttributeIndex = 0;
+    Settle();
+}
+
+bool AttributePathExpandIterator::Get(AttributePathParams & aPath) const
+{
+    if (mpClusterInfo == nullptr)
+    {
+        return false;
+    }
+
+    aPath = mOutputPath;
+    return true;
+}
+
+bool AttributePathExpandIterator::Next()
+{
+    if (mpClusterInfo == nullptr)
+    {
+        return false;
+    }
+
+    mAttributeIndex++;
+    return Settle();
+}
+
+bool AttributePathExpandIterator::Settle()
+{
+    // Resume from the current indexes; each loop restarts the loops nested in it when it moves on.
+    for (; mpClusterInfo != nullptr; mpClusterInfo = mpClusterInfo->mpNext)
+    {
+        const AttributePathParams & path = mpClusterInfo->mAttributePathParams;
+        EndpointId endpointId;
+
+        for (; GetEndpointAt(path, mEndpointIndex, endpointId); mEndpointIndex++, mClusterIndex = 0, mAttributeIndex = 0)
+        {
+            ClusterId clusterId;
+
+            for (; GetClusterAt(path, endpointId, mClusterIndex, clusterId); mClusterIndex++, mAttributeIndex = 0)
+            {
+                AttributeId attributeId;
+
+                for (; GetAttributeAt(path, endpointId, clusterId, mAttributeIndex, attributeId); mAttributeIndex++)
+                {
+                    // Attribute paths address fields with 8-bit ids; attributes beyond that range cannot be reported yet.
+                    if (attributeId > UINT8_MAX)
+                    {
+                        continue;
+                    }
+
+                    mOutputPath             = path;
+                    mOutputPath.mEndpointId = endpointId;
+                    mOutputPath.mClusterId  = clusterId;
+                    mOutputPath.mFieldId    = static_cast<FieldId>(attributeId);
+                    mOutputPath.mFlags.Clear(AttributePathFlags::kEndpointIdWildcard).Clear(AttributePathFlags::kClusterIdWildcard);
+                    if (path.mFlags.Has(AttributePathFlags::kFieldIdWildcard))
+                    {
+                        mOutputPath.mFlags.Clear(AttributePathFlags::kFieldIdWildcard).Set(AttributePathFlags::kFieldIdValid);
+                    }
+                    return true;
+                }
+            }
+        }
+
+        mEndpointIndex  = 0;
+        mClusterIndex   = 0;
+        mAttributeIndex = 0;
+    }
+
+    return false;
+}
+
+bool AttributePathExpandIterator::GetEndpointAt(const AttributePathParams & aPath, uint16_t aIndex, EndpointId & aEndpointId) const
+{
+    if (aPath.mFlags.Has(AttributePathFlags::kEndpointIdWildcard))
+    {
+        return GetEndpointIdAtIndex(aIndex, aEndpointId);
+    }
+
+    aEndpointId = aPath.mEndpointId;
+    return aIndex == 0;
+}
+
+bool AttributePathExpandIterator::GetClusterAt(const AttributePathParams & aPath, EndpointId aEndpointId, uint16_t aIndex,
+                                               ClusterId & aClusterId) const
+{
+    if (aPath.mFlags.Has(AttributePathFlags::kClusterIdWildcard))
+    {
+        return GetClusterIdAtIndex(aEndpointId, aIndex, aClusterId);
+    }
+
+    VerifyOrReturnError(aIndex == 0, false);
+    aClusterId = aPath.mClusterId;
+    if (!aPath.mFlags.Has(AttributePathFlags::kEndpointIdWildcard))
+    {
+        return true;
+    }
+
+    // Only the endpoints that have the requested cluster are selected.
+    ClusterId clusterId;
+    for (uint16_t index = 0; GetClusterIdAtIndex(aEndpointId, index, clusterId); index++)
+    {
+        if (clusterId == aClusterId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AttributePathExpandIterator::GetAttributeAt(const AttributePathParams & aPath, EndpointId aEndpointId, ClusterId aClusterId,
+                                                 uint16_t aIndex, AttributeId & aAttributeId) const
+{
+    if (aPath.mFlags.Has(AttributePathFlags::kFieldIdWildcard))
+    {
+        return GetAttributeIdAtIndex(aEndpointId, aClusterId, aIndex, aAttributeId);
+    }
+
+    VerifyOrReturnError(aIndex == 0, false);
+    aAttributeId = aPath.mFieldId;
+    if (!aPath.mFlags.HasAny(AttributePathFlags::kEndpointIdWildcard, AttributePathFlags::kClusterIdWildcard))
+    {
+        return true;
+    }
+
+    // Only the clusters that have the requested attribute are selected.
+    AttributeId attributeId;
+    for (uint16_t index = 0; GetAttributeIdAtIndex(aEndpointId, aClusterId, index, attributeId); index++)
+    {
+        if (attributeId == aAttributeId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace app
+} // namespace chip
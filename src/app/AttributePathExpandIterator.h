@@ -0,0 +1,90 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an iterator that expands the wildcard attribute paths of a read request
+ *      into concrete attribute paths.
+ *
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ClusterInfo.h>
+#include <app/util/basic-types.h>
+
+namespace chip {
+namespace app {
+/**
+ *  @class AttributePathExpandIterator
+ *
+ *  @brief Walks a ClusterInfo list and yields, one at a time, every concrete attribute path it selects.
+ *
+ *  Wildcard endpoint, cluster and field ids are resolved lazily against the data model metadata
+ *  (GetEndpointIdAtIndex, GetClusterIdAtIndex and GetAttributeIdAtIndex), so the iterator only keeps the
+ *  indexes of its current position and no ClusterInfo is needed per expanded path. A concrete id under a
+ *  wildcard parent is only yielded where the data model has it; a path without wildcard is yielded as-is.
+ *
+ *  The position survives between calls, which lets a report that does not fit in one message be continued
+ *  from the first path that was not sent.
+ */
+class AttributePathExpandIterator
+{
+public:
+    AttributePathExpandIterator() {}
+
+    /**
+     *  Restart the iteration at the first concrete path selected by @p apClusterInfoList.
+     */
+    void Reset(ClusterInfo * apClusterInfoList);
+
+    /**
+     *  Get the concrete path at the current position.
+     *
+     *  @retval true if @p aPath has been filled, false if the iteration is done.
+     */
+    bool Get(AttributePathParams & aPath) const;
+
+    /**
+     *  Move to the next concrete path.
+     *
+     *  @retval true if there is a path at the new position, false if the iteration is done.
+     */
+    bool Next();
+
+    /**
+     *  The ClusterInfo that selected the path at the current position, nullptr if the iteration is done.
+     */
+    ClusterInfo * GetClusterInfo() const { return mpClusterInfo; }
+
+private:
+    bool Settle();
+    bool GetEndpointAt(const AttributePathParams & aPath, uint16_t aIndex, EndpointId & aEndpointId) const;
+    bool GetClusterAt(const AttributePathParams & aPath, EndpointId aEndpointId, uint16_t aIndex, ClusterId & aClusterId) const;
+    bool GetAttributeAt(const AttributePathParams & aPath, EndpointId aEndpointId, ClusterId aClusterId, uint16_t aIndex,
+                        AttributeId & aAttributeId) const;
+
+    ClusterInfo * mpClusterInfo = nullptr;
+    uint16_t mEndpointIndex     = 0;
+    uint16_t mClusterIndex      = 0;
+    uint16_t mAttributeIndex    = 0;
+    AttributePathParams mOutputPath;
+};
+} // namespace app
+} // namespace chip
@@ -25,8 +25,11 @@ namespace chip {
 namespace app {
 enum class AttributePathFlags : uint8_t
 {
-    kFieldIdValid   = 0x01,
-    kListIndexValid = 0x02,
+    kFieldIdValid       = 0x01,
+    kListIndexValid     = 0x02,
+    kEndpointIdWildcard = 0x04,
+    kClusterIdWildcard  = 0x08,
+    kFieldIdWildcard    = 0x10,
 };
 
 struct AttributePathParams
@@ -57,6 +60,15 @@ struct AttributePathParams
         }
         return true;
     }
+    /**
+     * Whether this path, wildcards included, selects the attribute at @p aPath.
+     */
+    bool Contains(const AttributePathParams & aPath) const
+    {
+        return (mFlags.Has(AttributePathFlags::kEndpointIdWildcard) || mEndpointId == aPath.mEndpointId) &&
+            (mFlags.Has(AttributePathFlags::kClusterIdWildcard) || mClusterId == aPath.mClusterId) &&
+            (mFlags.Has(AttributePathFlags::kFieldIdWildcard) || mFieldId == aPath.mFieldId);
+    }
     chip::NodeId mNodeId         = 0;
     chip::EndpointId mEndpointId = 0;
     chip::ClusterId mClusterId   = 0;
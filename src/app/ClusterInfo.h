@@ -19,6 +19,7 @@
 #pragma once
 
 #include <app/AttributePathParams.h>
+#include <app/EventPathParams.h>
 #include <app/util/basic-types.h>
 
 namespace chip {
@@ -34,6 +35,7 @@ struct ClusterInfo
     void ClearDirty() { mDirty = false; }
     bool IsSamePath(const ClusterInfo & other) const { return other.mAttributePathParams.IsSamePath(mAttributePathParams); }
     AttributePathParams mAttributePathParams;
+    EventPathParams mEventPathParams;
     bool mDirty          = false;
     ClusterInfo * mpNext = nullptr;
 };
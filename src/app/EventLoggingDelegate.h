@@ -0,0 +1,52 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the delegate a cluster implements to write the data of the events it logs.
+ *
+ */
+
+#pragma once
+
+#include <core/CHIPCore.h>
+#include <core/CHIPTLV.h>
+
+namespace chip {
+namespace app {
+/**
+ * @brief
+ *   This class defines the API a cluster uses to write the data of an event when it is logged through EventManagement.
+ */
+class EventLoggingDelegate
+{
+public:
+    virtual ~EventLoggingDelegate() = default;
+
+    /**
+     * Write the data of the event.
+     * @param[in]  aWriter  TLV writer positioned within the data structure of the event, where the fields of the event are
+     *                      written with context tags. The writer is backed by the event buffer. WriteEvent is called
+     *                      again after older events are evicted if the event did not fit, so it must not have side effects.
+     * @retval # CHIP_NO_ERROR on success.
+     * @retval # others to drop the event; errors of the writer are returned as is.
+     */
+    virtual CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) = 0;
+};
+} // namespace app
+} // namespace chip
@@ -0,0 +1,59 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the types used to log events in a CHIP Interaction Model server
+ *
+ */
+
+#pragma once
+
+#include <app/EventPathParams.h>
+#include <app/util/basic-types.h>
+
+namespace chip {
+namespace app {
+/**
+ * The priority of an event. Events of each priority are kept in their own buffer, so that a burst of low priority events
+ * cannot evict the critical ones.
+ */
+enum class PriorityLevel : uint8_t
+{
+    First    = 0,
+    Debug    = First,
+    Info     = 1,
+    Critical = 2,
+    Last     = Critical,
+    Invalid  = Last + 1,
+};
+
+static constexpr size_t kNumPriorityLevel = static_cast<size_t>(PriorityLevel::Last) + 1;
+
+/**
+ * The metadata of an event, given by the cluster that logs it.
+ */
+struct EventOptions
+{
+    EventOptions() {}
+    EventOptions(const EventPathParams & aPath, PriorityLevel aPriority) : mPath(aPath), mPriority(aPriority) {}
+    EventPathParams mPath;
+    PriorityLevel mPriority = PriorityLevel::Invalid;
+};
+} // namespace app
+} // namespace chip
@@ -0,0 +1,257 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the event store of a CHIP Interaction Model server
+ *
+ */
+
+#include <app/EventManagement.h>
+#include <app/MessageDef/EventDataElement.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#include <cinttypes>
+
+namespace chip {
+namespace app {
+namespace {
+EventManagement sEventManagement;
+
+bool IsInterestedEventPath(ClusterInfo * apClusterInfoList, const EventPathParams & aPath)
+{
+    for (ClusterInfo * clusterInfo = apClusterInfoList; clusterInfo != nullptr; clusterInfo = clusterInfo->mpNext)
+    {
+        if (clusterInfo->mEventPathParams.Contains(aPath))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+EventManagement & EventManagement::GetInstance()
+{
+    return sEventManagement;
+}
+
+CHIP_ERROR EventManagement::Init(CircularEventBuffer * apBuffers, size_t aNumBuffers)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Shutdown();
+    VerifyOrExit(apBuffers != nullptr || aNumBuffers == 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (size_t index = 0; index < aNumBuffers; index++)
+    {
+        size_t priority = static_cast<size_t>(apBuffers[index].GetPriority());
+        VerifyOrExit(priority < kNumPriorityLevel && mpBuffers[priority] == nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+        mpBuffers[priority] = &apBuffers[index];
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogFunctError(err);
+        Shutdown();
+    }
+    return err;
+}
+
+void EventManagement::Shutdown()
+{
+    for (auto & buffer : mpBuffers)
+    {
+        buffer = nullptr;
+    }
+}
+
+CircularEventBuffer * EventManagement::GetBuffer(PriorityLevel aPriority)
+{
+    size_t priority = static_cast<size_t>(aPriority);
+    return priority < kNumPriorityLevel ? mpBuffers[priority] : nullptr;
+}
+
+CHIP_ERROR EventManagement::RefuseEviction(TLV::CHIPCircularTLVBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader)
+{
+    return CHIP_ERROR_NO_MEMORY;
+}
+
+CHIP_ERROR EventManagement::WriteEvent(CircularEventBuffer & aBuffer, EventLoggingDelegate * apDelegate,
+                                       const EventOptions & aEventOptions)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLV::TLVWriter writer;
+    TLV::TLVType dataContainerType;
+    EventDataElement::Builder eventDataElementBuilder;
+    const EventPathParams & path = aEventOptions.mPath;
+    // The buffer only moves its tail until the event is complete, so restoring its state drops a partly written event.
+    CircularEventBuffer checkpoint = aBuffer;
+
+    // The writer asks the buffer to evict older events when it runs out of space. That is refused, so that they are only
+    // evicted once it is known that the new event fits. The callback of the application is put back afterwards.
+    aBuffer.mProcessEvictedElement = RefuseEviction;
+
+    err = writer.Init(aBuffer, aBuffer.GetQueueSize());
+    SuccessOrExit(err);
+
+    err = eventDataElementBuilder.Init(&writer);
+    SuccessOrExit(err);
+
+    {
+        EventPath::Builder & eventPathBuilder = eventDataElementBuilder.CreateEventPathBuilder();
+        eventPathBuilder.NodeId(path.mNodeId)
+            .EndpointId(path.mEndpointId)
+            .ClusterId(path.mClusterId)
+            .EventId(path.mEventId)
+            .EndOfEventPath();
+        SuccessOrExit(err = eventPathBuilder.GetError());
+    }
+
+    eventDataElementBuilder.PriorityLevel(static_cast<uint8_t>(aEventOptions.mPriority));
+    eventDataElementBuilder.Number(mNextEventNumber);
+    eventDataElementBuilder.SystemTimestamp(System::Platform::Layer::GetClock_MonotonicMS());
+    SuccessOrExit(err = eventDataElementBuilder.GetError());
+
+    err = writer.StartContainer(TLV::ContextTag(EventDataElement::kCsTag_Data), TLV::kTLVType_Structure, dataContainerType);
+    SuccessOrExit(err);
+    err = apDelegate->WriteEvent(writer);
+    SuccessOrExit(err);
+    err = writer.EndContainer(dataContainerType);
+    SuccessOrExit(err);
+
+    eventDataElementBuilder.EndOfEventDataElement();
+    SuccessOrExit(err = eventDataElementBuilder.GetError());
+
+    err = writer.Finalize();
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        aBuffer = checkpoint;
+    }
+    aBuffer.mProcessEvictedElement = checkpoint.mProcessEvictedElement;
+    return err;
+}
+
+CHIP_ERROR EventManagement::LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions,
+                                     EventNumber & aEventNumber)
+{
+    CHIP_ERROR err               = CHIP_NO_ERROR;
+    CircularEventBuffer * buffer = GetBuffer(aEventOptions.mPriority);
+
+    VerifyOrExit(apDelegate != nullptr && buffer != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The size of an event is only known once it is written, so room is made one evicted event at a time. The writer is
+    // bounded by the size of the buffer, so an event that can never fit fails with CHIP_ERROR_BUFFER_TOO_SMALL, before any
+    // event is evicted for it.
+    while ((err = WriteEvent(*buffer, apDelegate, aEventOptions)) == CHIP_ERROR_NO_MEMORY)
+    {
+        VerifyOrExit(!buffer->IsEmpty(), err = CHIP_ERROR_BUFFER_TOO_SMALL);
+        err = buffer->EvictHead();
+        SuccessOrExit(err);
+        ChipLogDetail(EventLogging, "Evicted the oldest event of priority %u", static_cast<unsigned>(aEventOptions.mPriority));
+    }
+    SuccessOrExit(err);
+
+    aEventNumber             = mNextEventNumber++;
+    buffer->mLastEventNumber = aEventNumber;
+    ChipLogDetail(EventLogging, "Logged event 0x%" PRIx64 " of cluster %08x, priority %u", aEventNumber,
+                  aEventOptions.mPath.mClusterId, static_cast<unsigned>(aEventOptions.mPriority));
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+bool EventManagement::HasEventsSince(PriorityLevel aPriority, EventNumber aEventNumber)
+{
+    CircularEventBuffer * buffer = GetBuffer(aPriority);
+    return buffer != nullptr && !buffer->IsEmpty() && buffer->mLastEventNumber >= aEventNumber;
+}
+
+CHIP_ERROR EventManagement::FetchEventsSince(TLV::TLVWriter & aWriter, ClusterInfo * apClusterInfoList, PriorityLevel aPriority,
+                                             EventNumber & aEventNumber, size_t & aEventCount, uint32_t aReservedSize)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLV::CircularTLVReader reader;
+
+    // Readers usually have all the events of a buffer, which is then not scanned.
+    VerifyOrReturnError(HasEventsSince(aPriority, aEventNumber), CHIP_NO_ERROR);
+
+    reader.Init(*GetBuffer(aPriority));
+    while (CHIP_NO_ERROR == (err = reader.Next()))
+    {
+        EventDataElement::Parser event;
+        EventPath::Parser eventPathParser;
+        EventPathParams eventPath;
+        EventNumber eventNumber = 0;
+
+        err = event.Init(reader);
+        SuccessOrExit(err);
+        err = event.GetNumber(&eventNumber);
+        SuccessOrExit(err);
+        if (eventNumber < aEventNumber)
+        {
+            continue;
+        }
+
+        err = event.GetEventPath(&eventPathParser);
+        SuccessOrExit(err);
+        err = eventPathParser.GetEndpointId(&eventPath.mEndpointId);
+        SuccessOrExit(err);
+        err = eventPathParser.GetClusterId(&eventPath.mClusterId);
+        SuccessOrExit(err);
+        err = eventPathParser.GetEventId(&eventPath.mEventId);
+        SuccessOrExit(err);
+
+        if (IsInterestedEventPath(apClusterInfoList, eventPath))
+        {
+            TLV::TLVWriter checkpoint = aWriter;
+
+            // Events are stored in the format of the event list, so they are copied without being decoded.
+            err = aWriter.CopyElement(TLV::AnonymousTag, reader);
+            if (err == CHIP_NO_ERROR && aWriter.GetRemainingFreeLength() < aReservedSize)
+            {
+                err = CHIP_ERROR_BUFFER_TOO_SMALL;
+            }
+            if (err != CHIP_NO_ERROR)
+            {
+                // This event goes first in the next report.
+                aWriter = checkpoint;
+                ExitNow();
+            }
+            aEventCount++;
+        }
+        aEventNumber = eventNumber + 1;
+    }
+
+    // if we have exhausted this buffer
+    if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    return err;
+}
+} // namespace app
+} // namespace chip
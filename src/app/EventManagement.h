@@ -0,0 +1,149 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the event store of a CHIP Interaction Model server: the events logged by the clusters are
+ *      kept in circular buffers, one per priority, until they are evicted by newer events of the same priority, and
+ *      the reporting engine fetches them from there for each reader.
+ *
+ */
+
+#pragma once
+
+#include <app/ClusterInfo.h>
+#include <app/EventLoggingDelegate.h>
+#include <app/EventLoggingTypes.h>
+#include <app/util/basic-types.h>
+#include <core/CHIPCircularTLVBuffer.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPTLV.h>
+
+namespace chip {
+namespace app {
+/**
+ * @brief
+ *   A circular buffer holding the events of one priority, in the EventDataElement format of the report data messages, so
+ *   that they are copied to reports as they are.
+ */
+class CircularEventBuffer : public TLV::CHIPCircularTLVBuffer
+{
+public:
+    /**
+     * @param[in]  apBuffer        The storage of the events, owned by the application.
+     * @param[in]  aBufferLength   The size of apBuffer, which bounds the size of a single event.
+     * @param[in]  aPriority       The priority of the events kept in this buffer.
+     */
+    CircularEventBuffer(uint8_t * apBuffer, uint32_t aBufferLength, PriorityLevel aPriority) :
+        CHIPCircularTLVBuffer(apBuffer, aBufferLength), mPriority(aPriority)
+    {}
+
+    PriorityLevel GetPriority() const { return mPriority; }
+    bool IsEmpty() const { return DataLength() == 0; }
+
+private:
+    friend class EventManagement;
+
+    PriorityLevel mPriority = PriorityLevel::Invalid;
+    // The number of the newest event of the buffer, valid if the buffer is not empty.
+    EventNumber mLastEventNumber = 0;
+};
+
+/**
+ * @brief
+ *   The event store. Events are numbered in the order they are logged, across all priorities, so that a reader knows
+ *   the order of the events it receives, and the number of the next event a reader expects is the position of that
+ *   reader in the buffer of a priority.
+ */
+class EventManagement
+{
+public:
+    static EventManagement & GetInstance();
+
+    /**
+     *  Initialize the event store with the buffers of the application, at most one per priority. Events of a priority
+     *  without a buffer cannot be logged.
+     *
+     *  @param[in]    apBuffers     The event buffers; they must outlive the event store.
+     *  @param[in]    aNumBuffers   The number of buffers in apBuffers.
+     *
+     *  @retval #CHIP_ERROR_INVALID_ARGUMENT If two buffers have the same priority, or a buffer has an invalid priority.
+     *  @retval #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR Init(CircularEventBuffer * apBuffers, size_t aNumBuffers);
+
+    /**
+     *  Forget the buffers of the application, whose events are no longer reported. Event numbers are not reused.
+     */
+    void Shutdown();
+
+    /**
+     *  Log an event. The oldest events of the same priority are evicted until the new event fits in the buffer, each one
+     *  passed first to the mProcessEvictedElement callback of the buffer, if the application installed one. Readers
+     *  receive the event with the next report they are sent.
+     *
+     *  @param[in]    apDelegate      The delegate writing the data of the event.
+     *  @param[in]    aEventOptions   The path and the priority of the event.
+     *  @param[out]   aEventNumber    The number of the event, on success.
+     *
+     *  @retval #CHIP_ERROR_INVALID_ARGUMENT If there is no buffer for the priority of the event.
+     *  @retval #CHIP_ERROR_BUFFER_TOO_SMALL If the event does not fit in an empty buffer.
+     *  @retval #Others If the delegate fails to write the event, or the eviction callback refuses to evict an event; the
+     *                  event is then dropped.
+     *  @retval #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
+
+    /**
+     *  Copy the events of a priority selected by a list of event paths into a report, starting at a given event number,
+     *  until the report is full.
+     *
+     *  @param[in]     aWriter            The writer of the event list of the report.
+     *  @param[in]     apClusterInfoList  The event paths of the reader.
+     *  @param[in]     aPriority          The priority of the events to copy.
+     *  @param[in,out] aEventNumber       The number of the first event to consider. On return, the number of the first
+     *                                    event left to copy.
+     *  @param[in,out] aEventCount        Incremented for each event copied.
+     *  @param[in]     aReservedSize      Space of the report to leave free after the last event.
+     *
+     *  @retval #CHIP_ERROR_BUFFER_TOO_SMALL or #CHIP_ERROR_NO_MEMORY If the report is full, and events are left to copy.
+     *  @retval #CHIP_NO_ERROR If all the events have been copied.
+     */
+    CHIP_ERROR FetchEventsSince(TLV::TLVWriter & aWriter, ClusterInfo * apClusterInfoList, PriorityLevel aPriority,
+                                EventNumber & aEventNumber, size_t & aEventCount, uint32_t aReservedSize);
+
+    /**
+     *  Whether some events of a priority are numbered @p aEventNumber or higher, regardless of their path.
+     */
+    bool HasEventsSince(PriorityLevel aPriority, EventNumber aEventNumber);
+
+    /**
+     *  The number the next logged event will get.
+     */
+    EventNumber GetNextEventNumber() const { return mNextEventNumber; }
+
+private:
+    CircularEventBuffer * GetBuffer(PriorityLevel aPriority);
+    CHIP_ERROR WriteEvent(CircularEventBuffer & aBuffer, EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions);
+    static CHIP_ERROR RefuseEviction(TLV::CHIPCircularTLVBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader);
+
+    CircularEventBuffer * mpBuffers[kNumPriorityLevel] = { nullptr };
+    EventNumber mNextEventNumber                       = 0;
+};
+} // namespace app
+} // namespace chip
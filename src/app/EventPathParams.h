@@ -19,24 +19,41 @@
 #pragma once
 
 #include <app/util/basic-types.h>
+#include <support/BitFlags.h>
 
 namespace chip {
 namespace app {
+enum class EventPathFlags : uint8_t
+{
+    kEndpointIdWildcard = 0x01,
+    kEventIdWildcard    = 0x02,
+};
+
 struct EventPathParams
 {
     EventPathParams(NodeId aNodeId, EndpointId aEndpointId, ClusterId aClusterId, EventId aEventId, bool aIsUrgent) :
         mNodeId(aNodeId), mEndpointId(aEndpointId), mClusterId(aClusterId), mEventId(aEventId), mIsUrgent(aIsUrgent)
     {}
+    EventPathParams() {}
     bool IsSamePath(const EventPathParams & other) const
     {
         return other.mNodeId == mNodeId && other.mEndpointId == mEndpointId && other.mClusterId == mClusterId &&
-            other.mEventId == mEventId;
+            other.mEventId == mEventId && other.mFlags == mFlags;
+    }
+    /**
+     * Whether this path, wildcards included, selects the event at @p aPath.
+     */
+    bool Contains(const EventPathParams & aPath) const
+    {
+        return (mFlags.Has(EventPathFlags::kEndpointIdWildcard) || mEndpointId == aPath.mEndpointId) &&
+            mClusterId == aPath.mClusterId && (mFlags.Has(EventPathFlags::kEventIdWildcard) || mEventId == aPath.mEventId);
     }
     NodeId mNodeId         = 0;
     EndpointId mEndpointId = 0;
     ClusterId mClusterId   = 0;
     EventId mEventId       = 0;
     bool mIsUrgent         = false;
+    BitFlags<EventPathFlags> mFlags;
 };
 } // namespace app
 } // namespace chip
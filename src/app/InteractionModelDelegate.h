@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <app/AttributePathParams.h>
 #include <core/CHIPCore.h>
 #include <core/CHIPTLV.h>
 #include <messaging/ExchangeContext.h>
@@ -33,6 +34,7 @@ namespace chip {
 namespace app {
 class ReadClient;
 class CommandSender;
+class WriteClient;
 
 /**
  * @brief
@@ -59,6 +61,25 @@ public:
         return CHIP_ERROR_NOT_IMPLEMENTED;
     }
 
+    /**
+     * Notification that a Report Data message carries data for an attribute. It is called for each attribute data element as
+     * each message of a report is received, so a report that is chunked over several messages is consumed incrementally, and
+     * always before ReportProcessed.
+     * @param[in]  apReadClient         A current readClient which can identify the read to the consumer, particularly during
+     *                                  multiple read interactions
+     * @param[in]  aAttributePathParams The concrete path of the attribute.
+     * @param[in]  aReader              TLV reader positioned on the data of the attribute, within the received message. The
+     *                                  data is not copied: the reader is only valid during the call, and the callee must copy
+     *                                  what it needs to keep.
+     * @retval # CHIP_ERROR_NOT_IMPLEMENTED if not implemented, the data is then handed to WriteSingleClusterData.
+     * @retval # others to stop processing the report, which is then reported through ReportError.
+     */
+    virtual CHIP_ERROR AttributeDataReceived(const ReadClient * apReadClient, const AttributePathParams & aAttributePathParams,
+                                             TLV::TLVReader & aReader)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
     /**
      * Notification that the last message for a Report Data action for the given ReadClient has been received and processed.
      * @param[in]  apReadClient   A current readClient which can identify the read to the consumer, particularly during
@@ -133,6 +154,47 @@ public:
         return CHIP_ERROR_NOT_IMPLEMENTED;
     }
 
+    /**
+     * Notification that a Write Client has received a Write Response containing a status code for one of the written attributes.
+     * @param[in]  apWriteClient   A current write client which can identify the write client to the consumer, particularly
+     * during multiple write interactions
+     * @param[in]  aGeneralCode   Status code defined by the standard
+     * @param[in]  aProtocolId    Protocol Id
+     * @param[in]  aProtocolCode  Detailed error information, protocol-specific.
+     * @param[in]  aAttributePathParams  The attribute path the status applies to
+     * @param[in]  aAttributeIndex  Current processing attribute status index, starting at 1, which can identify the attribute if
+     * there exists multiple writes of the same attribute
+     * @retval # CHIP_ERROR_NOT_IMPLEMENTED if not implemented
+     */
+    virtual CHIP_ERROR WriteResponseStatus(const WriteClient * apWriteClient,
+                                           const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                           const uint32_t aProtocolId, const uint16_t aProtocolCode,
+                                           AttributePathParams & aAttributePathParams, uint16_t aAttributeIndex)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Notification that a Write Response has already been processed.
+     * @param[in]  apWriteClient  A current write client which can identify the write client to the consumer, particularly
+     * during multiple write interactions
+     * @retval # CHIP_ERROR_NOT_IMPLEMENTED if not implemented
+     */
+    virtual CHIP_ERROR WriteResponseProcessed(const WriteClient * apWriteClient) { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
+    /**
+     * Notification that a Write Client encountered an asynchronous failure.
+     * @param[in]  apWriteClient  A current write client which can identify the write client to the consumer, particularly
+     * during multiple write interactions
+     * @param[in]  aError         A error that could be CHIP_ERROR_TIMEOUT when write client fails to receive, or other error when
+     *                            fail to process write response.
+     * @retval # CHIP_ERROR_NOT_IMPLEMENTED if not implemented
+     */
+    virtual CHIP_ERROR WriteResponseError(const WriteClient * apWriteClient, CHIP_ERROR aError)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
     virtual ~InteractionModelDelegate() = default;
 };
 
@@ -86,6 +86,16 @@ void InteractionModelEngine::Shutdown()
         readHandler.Shutdown();
     }
 
+    for (auto & writeClient : mWriteClients)
+    {
+        writeClient.Shutdown();
+    }
+
+    for (auto & writeHandler : mWriteHandlers)
+    {
+        writeHandler.Shutdown();
+    }
+
     for (uint32_t index = 0; index < IM_SERVER_MAX_NUM_PATH_GROUPS; index++)
     {
         mClusterInfoPool[index].mpNext = nullptr;
@@ -139,6 +149,27 @@ CHIP_ERROR InteractionModelEngine::NewReadClient(ReadClient ** const apReadClien
     return err;
 }
 
+CHIP_ERROR InteractionModelEngine::NewWriteClient(WriteClient ** const apWriteClient)
+{
+    CHIP_ERROR err = CHIP_ERROR_NO_MEMORY;
+    *apWriteClient = nullptr;
+
+    for (auto & writeClient : mWriteClients)
+    {
+        if (writeClient.IsFree())
+        {
+            err = writeClient.Init(mpExchangeMgr, mpDelegate);
+            if (CHIP_NO_ERROR == err)
+            {
+                *apWriteClient = &writeClient;
+            }
+            return err;
+        }
+    }
+
+    return err;
+}
+
 void InteractionModelEngine::OnUnknownMsgType(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
                                               const PayloadHeader & aPayloadHeader, System::PacketBufferHandle aPayload)
 {
@@ -202,8 +233,37 @@ void InteractionModelEngine::OnReadRequest(Messaging::ExchangeContext * apExchan
         {
             err = readHandler.Init(mpDelegate);
             SuccessOrExit(err);
-            err = readHandler.OnReadRequest(apExchangeContext, std::move(aPayload));
+            // The read handler owns the exchange from here on, and closes it itself on failure.
+            err               = readHandler.OnReadRequest(apExchangeContext, std::move(aPayload));
+            apExchangeContext = nullptr;
+            SuccessOrExit(err);
+            break;
+        }
+    }
+
+exit:
+    ChipLogFunctError(err);
+
+    if (nullptr != apExchangeContext)
+    {
+        apExchangeContext->Abort();
+    }
+}
+
+void InteractionModelEngine::OnWriteRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                            const PayloadHeader & aPayloadHeader, System::PacketBufferHandle aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    ChipLogDetail(DataManagement, "Receive Write request");
+
+    for (auto & writeHandler : mWriteHandlers)
+    {
+        if (writeHandler.IsFree())
+        {
+            err = writeHandler.Init(mpDelegate);
             SuccessOrExit(err);
+            err = writeHandler.OnWriteRequest(apExchangeContext, std::move(aPayload));
             apExchangeContext = nullptr;
             break;
         }
@@ -230,6 +290,10 @@ void InteractionModelEngine::OnMessageReceived(Messaging::ExchangeContext * apEx
     {
         OnReadRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
     }
+    else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::WriteRequest))
+    {
+        OnWriteRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
+    }
     else
     {
         OnUnknownMsgType(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
@@ -274,7 +338,23 @@ CHIP_ERROR __attribute__((weak)) WriteSingleClusterData(AttributePathParams & aA
                   aAttributePathParams.mEndpointId, aAttributePathParams.mFieldId, aAttributePathParams.mListIndex);
     ChipLogError(DataManagement,
                  "Default WriteSingleClusterData is called, this should be replaced by actual dispatched for cluster");
-    return CHIP_NO_ERROR;
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+}
+
+bool __attribute__((weak)) GetEndpointIdAtIndex(uint16_t aIndex, EndpointId & aEndpointId)
+{
+    return false;
+}
+
+bool __attribute__((weak)) GetClusterIdAtIndex(EndpointId aEndpointId, uint16_t aIndex, ClusterId & aClusterId)
+{
+    return false;
+}
+
+bool __attribute__((weak))
+GetAttributeIdAtIndex(EndpointId aEndpointId, ClusterId aClusterId, uint16_t aIndex, AttributeId & aAttributeId)
+{
+    return false;
 }
 
 uint16_t InteractionModelEngine::GetReadClientArrayIndex(const ReadClient * const apReadClient) const
@@ -282,6 +362,21 @@ uint16_t InteractionModelEngine::GetReadClientArrayIndex(const ReadClient * cons
     return static_cast<uint16_t>(apReadClient - mReadClients);
 }
 
+uint16_t InteractionModelEngine::GetNumReadClientsAwaitingResponse(NodeId aNodeId, Transport::AdminId aAdminId) const
+{
+    uint16_t numReadClients = 0;
+
+    for (auto & readClient : mReadClients)
+    {
+        if (readClient.IsAwaitingResponseFrom(aNodeId, aAdminId))
+        {
+            numReadClients++;
+        }
+    }
+
+    return numReadClients;
+}
+
 void InteractionModelEngine::ReleaseClusterInfoList(ClusterInfo *& aClusterInfo)
 {
     ClusterInfo * lastClusterInfo = aClusterInfo;
@@ -315,5 +410,19 @@ CHIP_ERROR InteractionModelEngine::PushFront(ClusterInfo *& aClusterInfo, Attrib
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR InteractionModelEngine::PushFront(ClusterInfo *& aClusterInfo, EventPathParams & aEventPathParams)
+{
+    ClusterInfo * last = aClusterInfo;
+    if (mpNextAvailableClusterInfo == nullptr)
+    {
+        return CHIP_ERROR_NO_MEMORY;
+    }
+    aClusterInfo                   = mpNextAvailableClusterInfo;
+    mpNextAvailableClusterInfo     = mpNextAvailableClusterInfo->mpNext;
+    aClusterInfo->mpNext           = last;
+    aClusterInfo->mEventPathParams = aEventPathParams;
+    return CHIP_NO_ERROR;
+}
+
 } // namespace app
 } // namespace chip
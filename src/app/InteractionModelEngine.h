@@ -44,13 +44,17 @@
 #include <app/InteractionModelDelegate.h>
 #include <app/ReadClient.h>
 #include <app/ReadHandler.h>
+#include <app/WriteClient.h>
+#include <app/WriteHandler.h>
 #include <app/reporting/Engine.h>
 #include <app/util/basic-types.h>
 
 #define CHIP_MAX_NUM_COMMAND_HANDLER 1
 #define CHIP_MAX_NUM_COMMAND_SENDER 1
-#define CHIP_MAX_NUM_READ_CLIENT 1
+#define CHIP_MAX_NUM_READ_CLIENT CHIP_CONFIG_IM_MAX_NUM_READ_CLIENT
 #define CHIP_MAX_NUM_READ_HANDLER 1
+#define CHIP_MAX_NUM_WRITE_CLIENT 1
+#define CHIP_MAX_NUM_WRITE_HANDLER 1
 #define CHIP_MAX_REPORTS_IN_FLIGHT 1
 #define IM_SERVER_MAX_NUM_PATH_GROUPS 8
 
@@ -119,6 +123,17 @@ public:
      */
     CHIP_ERROR NewReadClient(ReadClient ** const apReadClient);
 
+    /**
+     *  Retrieve a WriteClient that the SDK consumer can use to write many attributes in a single request.  If the call
+     *  succeeds, the consumer is responsible for calling Shutdown() on the WriteClient once it's done using it.
+     *
+     *  @param[out]    apWriteClient    A pointer to the WriteClient object.
+     *
+     *  @retval #CHIP_ERROR_NO_MEMORY If there is no WriteClient available
+     *  @retval #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR NewWriteClient(WriteClient ** const apWriteClient);
+
     /**
      *  Get read client index in mReadClients
      *
@@ -128,10 +143,21 @@ public:
      */
     uint16_t GetReadClientArrayIndex(const ReadClient * const apReadClient) const;
 
+    /**
+     *  Get the number of read clients of the pool with a read request outstanding with a peer.
+     *
+     *  @param[in]    aNodeId     Node Id of the peer.
+     *  @param[in]    aAdminId    Admin ID used with the peer.
+     *
+     *  @retval  the number of read clients awaiting a report from the peer
+     */
+    uint16_t GetNumReadClientsAwaitingResponse(NodeId aNodeId, Transport::AdminId aAdminId) const;
+
     reporting::Engine & GetReportingEngine() { return mReportingEngine; }
 
     void ReleaseClusterInfoList(ClusterInfo *& aClusterInfo);
     CHIP_ERROR PushFront(ClusterInfo *& aClusterInfo, AttributePathParams & aAttributePathParams);
+    CHIP_ERROR PushFront(ClusterInfo *& aClusterInfo, EventPathParams & aEventPathParams);
 
 private:
     friend class reporting::Engine;
@@ -150,12 +176,21 @@ private:
     void OnReadRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
                        const PayloadHeader & aPayloadHeader, System::PacketBufferHandle aPayload);
 
+    /**
+     * Called when Interaction Model receives a Write Request message.  Errors processing
+     * the Write Request are handled entirely within this function.
+     */
+    void OnWriteRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                        const PayloadHeader & aPayloadHeader, System::PacketBufferHandle aPayload);
+
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
     InteractionModelDelegate * mpDelegate      = nullptr;
     CommandHandler mCommandHandlerObjs[CHIP_MAX_NUM_COMMAND_HANDLER];
     CommandSender mCommandSenderObjs[CHIP_MAX_NUM_COMMAND_SENDER];
     ReadClient mReadClients[CHIP_MAX_NUM_READ_CLIENT];
     ReadHandler mReadHandlers[CHIP_MAX_NUM_READ_HANDLER];
+    WriteClient mWriteClients[CHIP_MAX_NUM_WRITE_CLIENT];
+    WriteHandler mWriteHandlers[CHIP_MAX_NUM_WRITE_HANDLER];
     reporting::Engine mReportingEngine;
     ClusterInfo mClusterInfoPool[IM_SERVER_MAX_NUM_PATH_GROUPS];
     ClusterInfo * mpNextAvailableClusterInfo = nullptr;
@@ -165,5 +200,13 @@ void DispatchSingleClusterCommand(chip::ClusterId aClusterId, chip::CommandId aC
                                   chip::TLV::TLVReader & aReader, Command * apCommandObj);
 CHIP_ERROR ReadSingleClusterData(AttributePathParams & aAttributePathParams, TLV::TLVWriter & aWriter);
 CHIP_ERROR WriteSingleClusterData(AttributePathParams & aAttributePathParams, TLV::TLVReader & aReader);
+
+/**
+ * Data model metadata used to expand wildcard attribute paths.  Entries are numbered from 0 and each function returns
+ * false once aIndex is past the last one.  The default implementations describe an empty data model.
+ */
+bool GetEndpointIdAtIndex(uint16_t aIndex, EndpointId & aEndpointId);
+bool GetClusterIdAtIndex(EndpointId aEndpointId, uint16_t aIndex, ClusterId & aClusterId);
+bool GetAttributeIdAtIndex(EndpointId aEndpointId, ClusterId aClusterId, uint16_t aIndex, AttributeId & aAttributeId);
 } // namespace app
 } // namespace chip
@@ -66,6 +66,11 @@ public:
      */
     AttributeDataElement::Builder & CreateAttributeDataElementBuilder();
 
+    /**
+     *  @return A reference to AttributeDataElement::Builder
+     */
+    AttributeDataElement::Builder & GetAttributeDataElementBuilder() { return mAttributeDataElementBuilder; };
+
     /**
      *  @brief Mark the end of this AttributeDataList
      *
@@ -151,16 +151,15 @@ CHIP_ERROR AttributePath::Parser::CheckSchemaValidity() const
     // if we have exhausted this container
     if (CHIP_END_OF_TLV == err)
     {
-        // check for required fields:
-        const uint16_t RequiredFields = (1 << kCsTag_EndpointId) | (1 << kCsTag_ClusterId);
-
-        if ((TagPresenceMask & RequiredFields) == RequiredFields)
+        // EndpointId and ClusterId can be left out to select all of them, but a list index only makes sense within
+        // a given cluster.
+        if ((TagPresenceMask & (1 << kCsTag_ListIndex)) && !(TagPresenceMask & (1 << kCsTag_ClusterId)))
         {
-            err = CHIP_NO_ERROR;
+            err = CHIP_ERROR_IM_MALFORMED_ATTRIBUTE_PATH;
         }
         else
         {
-            err = CHIP_ERROR_IM_MALFORMED_ATTRIBUTE_PATH;
+            err = CHIP_NO_ERROR;
         }
     }
     SuccessOrExit(err);
@@ -46,6 +46,11 @@ public:
      */
     AttributeStatusElement::Builder & CreateAttributeStatusBuilder();
 
+    /**
+     *  @return A reference to AttributeStatusElement::Builder
+     */
+    AttributeStatusElement::Builder & GetAttributeStatusBuilder() { return mAttributeStatusBuilder; };
+
     /**
      *  @brief Mark the end of this AttributeStatusList
      *
@@ -138,8 +138,8 @@ CHIP_ERROR EventPath::Parser::CheckSchemaValidity() const
     // if we have exhausted this container
     if (CHIP_END_OF_TLV == err)
     {
-        // check for required fields:
-        const uint16_t RequiredFields = (1 << kCsTag_EndpointId) | (1 << kCsTag_ClusterId);
+        // EndpointId and EventId can be left out to select all of them, but events are always selected within a cluster.
+        const uint16_t RequiredFields = (1 << kCsTag_ClusterId);
 
         if ((TagPresenceMask & RequiredFields) == RequiredFields)
         {
@@ -219,6 +219,11 @@ exit:
     return mAttributeDataListBuilder;
 }
 
+AttributeDataList::Builder & WriteRequest::Builder::GetAttributeDataListBuilder()
+{
+    return mAttributeDataListBuilder;
+}
+
 AttributeDataVersionList::Builder & WriteRequest::Builder::CreateAttributeDataVersionListBuilder()
 {
     // skip if error has already been set
@@ -135,6 +135,13 @@ public:
      */
     AttributeDataList::Builder & CreateAttributeDataListBuilder();
 
+    /**
+     *  @brief Get reference to AttributeDataList::Builder
+     *
+     *  @return A reference to AttributeDataList::Builder
+     */
+    AttributeDataList::Builder & GetAttributeDataListBuilder();
+
     /**
      *  @brief Initialize a AttributeDataVersionList::Builder for writing into the TLV stream
      *
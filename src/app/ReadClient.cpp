@@ -88,6 +88,9 @@ CHIP_ERROR ReadClient::SendReadRequest(NodeId aNodeId, Transport::AdminId aAdmin
     VerifyOrExit(ClientState::Initialized == mState, err = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(mpDelegate != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(mpExchangeCtx == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(InteractionModelEngine::GetInstance()->GetNumReadClientsAwaitingResponse(aNodeId, aAdminId) <
+                     CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION,
+                 err = CHIP_ERROR_RATE_LIMIT_EXCEEDED);
 
     {
         System::PacketBufferTLVWriter writer;
@@ -103,7 +106,28 @@ CHIP_ERROR ReadClient::SendReadRequest(NodeId aNodeId, Transport::AdminId aAdmin
 
         if (aEventPathParamsListSize != 0 && apEventPathParamsList != nullptr)
         {
-            // TODO: fill to construct event paths
+            EventPathList::Builder eventPathListBuilder = request.CreateEventPathListBuilder();
+            SuccessOrExit(err = eventPathListBuilder.GetError());
+            for (size_t index = 0; index < aEventPathParamsListSize; index++)
+            {
+                const EventPathParams & path        = apEventPathParamsList[index];
+                EventPath::Builder eventPathBuilder = eventPathListBuilder.CreateEventPathBuilder();
+                eventPathBuilder.NodeId(path.mNodeId);
+                // Wildcard ids are left out of the path, and matched by the responder.
+                if (!path.mFlags.Has(EventPathFlags::kEndpointIdWildcard))
+                {
+                    eventPathBuilder.EndpointId(path.mEndpointId);
+                }
+                eventPathBuilder.ClusterId(path.mClusterId);
+                if (!path.mFlags.Has(EventPathFlags::kEventIdWildcard))
+                {
+                    eventPathBuilder.EventId(path.mEventId);
+                }
+                eventPathBuilder.EndOfEventPath();
+                SuccessOrExit(err = eventPathBuilder.GetError());
+            }
+            eventPathListBuilder.EndOfEventPathList();
+            SuccessOrExit(err = eventPathListBuilder.GetError());
         }
 
         if (aAttributePathParamsListSize != 0 && apAttributePathParamsList != nullptr)
@@ -112,25 +136,36 @@ CHIP_ERROR ReadClient::SendReadRequest(NodeId aNodeId, Transport::AdminId aAdmin
             SuccessOrExit(attributePathListBuilder.GetError());
             for (size_t index = 0; index < aAttributePathParamsListSize; index++)
             {
+                const AttributePathParams & path            = apAttributePathParamsList[index];
                 AttributePath::Builder attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
-                attributePathBuilder.NodeId(apAttributePathParamsList[index].mNodeId)
-                    .EndpointId(apAttributePathParamsList[index].mEndpointId)
-                    .ClusterId(apAttributePathParamsList[index].mClusterId);
-                if (apAttributePathParamsList[index].mFlags == AttributePathFlags::kFieldIdValid)
+                attributePathBuilder.NodeId(path.mNodeId);
+                // Wildcard ids are left out of the path, and expanded by the responder.
+                if (!path.mFlags.Has(AttributePathFlags::kEndpointIdWildcard))
                 {
-                    attributePathBuilder.FieldId(apAttributePathParamsList[index].mFieldId);
+                    attributePathBuilder.EndpointId(path.mEndpointId);
                 }
-                else if (apAttributePathParamsList[index].mFlags == AttributePathFlags::kListIndexValid)
+                if (!path.mFlags.Has(AttributePathFlags::kClusterIdWildcard))
                 {
-                    attributePathBuilder.ListIndex(apAttributePathParamsList[index].mListIndex);
+                    attributePathBuilder.ClusterId(path.mClusterId);
                 }
-                else
+                if (path.mFlags.Has(AttributePathFlags::kFieldIdValid))
+                {
+                    attributePathBuilder.FieldId(path.mFieldId);
+                }
+                else if (path.mFlags.Has(AttributePathFlags::kListIndexValid))
+                {
+                    attributePathBuilder.ListIndex(path.mListIndex);
+                }
+                else if (!path.mFlags.Has(AttributePathFlags::kFieldIdWildcard))
                 {
                     err = CHIP_ERROR_INVALID_ARGUMENT;
                     ExitNow();
                 }
-                SuccessOrExit(attributePathBuilder.GetError());
+                attributePathBuilder.EndOfAttributePath();
+                SuccessOrExit(err = attributePathBuilder.GetError());
             }
+            attributePathListBuilder.EndOfAttributePathList();
+            SuccessOrExit(err = attributePathListBuilder.GetError());
         }
         request.EndOfReadRequest();
         SuccessOrExit(request.GetError());
@@ -146,6 +181,8 @@ CHIP_ERROR ReadClient::SendReadRequest(NodeId aNodeId, Transport::AdminId aAdmin
     err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::ReadRequest, std::move(msgBuf),
                                      Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
     SuccessOrExit(err);
+    mPeerNodeId = aNodeId;
+    mAdminId    = aAdminId;
     MoveToState(ClientState::AwaitingResponse);
 
 exit:
@@ -161,6 +198,15 @@ void ReadClient::OnMessageReceived(Messaging::ExchangeContext * apExchangeContex
                  err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
     VerifyOrExit(apExchangeContext == mpExchangeCtx, err = CHIP_ERROR_INCORRECT_STATE);
     err = ProcessReportData(std::move(aPayload));
+    SuccessOrExit(err);
+
+    if (mMoreChunkedMessages)
+    {
+        // The rest of a chunked report comes on the same exchange; a lost chunk ends the read with a timeout.
+        err = mpExchangeCtx->ExpectResponse();
+        SuccessOrExit(err);
+        return;
+    }
 
 exit:
     ChipLogFunctError(err);
@@ -201,7 +247,6 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle aPayload)
     bool isEventListPresent         = false;
     bool isAttributeDataListPresent = false;
     bool suppressResponse           = false;
-    bool moreChunkedMessages        = false;
     EventList::Parser eventList;
     AttributeDataList::Parser attributeDataList;
     System::PacketBufferTLVReader reader;
@@ -224,7 +269,8 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle aPayload)
     }
     SuccessOrExit(err);
 
-    err = report.GetMoreChunkedMessages(&moreChunkedMessages);
+    mMoreChunkedMessages = false;
+    err                  = report.GetMoreChunkedMessages(&mMoreChunkedMessages);
     if (CHIP_END_OF_TLV == err)
     {
         err = CHIP_NO_ERROR;
@@ -254,7 +300,8 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle aPayload)
         err = CHIP_NO_ERROR;
     }
     SuccessOrExit(err);
-    if (isAttributeDataListPresent && nullptr != mpDelegate && !moreChunkedMessages)
+    // Each chunk of a report carries complete attribute data elements, so they are processed as they come.
+    if (isAttributeDataListPresent && nullptr != mpDelegate)
     {
         chip::TLV::TLVReader attributeDataListReader;
         attributeDataList.GetReader(&attributeDataListReader);
@@ -325,7 +372,20 @@ CHIP_ERROR ReadClient::ProcessAttributeDataList(TLV::TLVReader & aAttributeDataL
 
         err = element.GetData(&dataReader);
         SuccessOrExit(err);
-        err = WriteSingleClusterData(attributePathParams, dataReader);
+
+        // The delegate reads the data in place; the data model is only the fallback for delegates that do not consume it.
+        err = mpDelegate->AttributeDataReceived(this, attributePathParams, dataReader);
+        if (CHIP_ERROR_NOT_IMPLEMENTED == err)
+        {
+            err = element.GetData(&dataReader);
+            SuccessOrExit(err);
+            err = WriteSingleClusterData(attributePathParams, dataReader);
+            // Without a data model to store it in, the attribute data is dropped.
+            if (CHIP_ERROR_NOT_IMPLEMENTED == err)
+            {
+                err = CHIP_NO_ERROR;
+            }
+        }
         SuccessOrExit(err);
     }
 
@@ -64,7 +64,8 @@ public:
      *  Send a Read Request.  There can be one Read Request outstanding on a given ReadClient.
      *  If SendReadRequest returns success, no more Read Requests can be sent on this ReadClient
      *  until the corresponding InteractionModelDelegate::ReportProcessed or InteractionModelDelegate::ReportError
-     *  call happens with guarantee.
+     *  call happens with guarantee.  Read Requests to the same peer can be outstanding on several ReadClients at once,
+     *  each on its own exchange, up to CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION.
      *
      *  @param[in]    aNodeId    Node Id
      *  @param[in]    aAdminId   Admin ID
@@ -72,6 +73,7 @@ public:
      *  @param[in]    aEventPathParamsListSize    Number of event paths in apEventPathParamsList
      *  @param[in]    apAttributePathParamsList       a list of attribute paths the read client is interested in
      *  @param[in]    aAttributePathParamsListSize    Number of attribute paths in apAttributePathParamsList
+     *  @retval #CHIP_ERROR_RATE_LIMIT_EXCEEDED if too many Read Requests are outstanding with this peer
      *  @retval #others fail to send read request
      *  @retval #CHIP_NO_ERROR On success.
      */
@@ -117,6 +119,15 @@ private:
      */
     bool IsFree() const { return mState == ClientState::Uninitialized; };
 
+    /**
+     *  Check if current read client is waiting for a report from the given peer
+     *
+     */
+    bool IsAwaitingResponseFrom(NodeId aNodeId, Transport::AdminId aAdminId) const
+    {
+        return mState == ClientState::AwaitingResponse && mPeerNodeId == aNodeId && mAdminId == aAdminId;
+    }
+
     CHIP_ERROR ProcessAttributeDataList(TLV::TLVReader & aAttributeDataListReader);
 
     void MoveToState(const ClientState aTargetState);
@@ -128,6 +139,9 @@ private:
     Messaging::ExchangeContext * mpExchangeCtx = nullptr;
     InteractionModelDelegate * mpDelegate      = nullptr;
     ClientState mState                         = ClientState::Uninitialized;
+    bool mMoreChunkedMessages                  = false;
+    NodeId mPeerNodeId                         = kUndefinedNodeId;
+    Transport::AdminId mAdminId                = Transport::kUndefinedAdminId;
 };
 
 }; // namespace app
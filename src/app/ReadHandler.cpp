@@ -35,11 +35,12 @@ CHIP_ERROR ReadHandler::Init(InteractionModelDelegate * apDelegate)
     // Error if already initialized.
     VerifyOrExit(apDelegate != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(mpExchangeCtx == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-    mpExchangeCtx     = nullptr;
-    mpDelegate        = apDelegate;
-    mSuppressResponse = true;
-    mGetToAllEvents   = true;
-    mpClusterInfoList = nullptr;
+    mpExchangeCtx          = nullptr;
+    mpDelegate             = apDelegate;
+    mSuppressResponse      = true;
+    mGetToAllEvents        = true;
+    mpClusterInfoList      = nullptr;
+    mpEventClusterInfoList = nullptr;
     MoveToState(HandlerState::Initialized);
 
 exit:
@@ -50,6 +51,8 @@ exit:
 void ReadHandler::Shutdown()
 {
     InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpClusterInfoList);
+    InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpEventClusterInfoList);
+    mAttributePathExpandIterator.Reset(nullptr);
     ClearExistingExchangeContext();
     MoveToState(HandlerState::Uninitialized);
     mpDelegate = nullptr;
@@ -95,7 +98,6 @@ CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle aPayload)
                                      Messaging::SendFlags(Messaging::SendMessageFlags::kNone));
 exit:
     ChipLogFunctError(err);
-    Shutdown();
     return err;
 }
 
@@ -107,7 +109,7 @@ CHIP_ERROR ReadHandler::ProcessReadRequest(System::PacketBufferHandle aPayload)
     ReadRequest::Parser readRequestParser;
     EventPathList::Parser eventPathListParser;
     AttributePathList::Parser attributePathListParser;
-    TLV::TLVReader eventPathListReader;
+    EventNumber eventNumber = 0;
 
     reader.Init(std::move(aPayload));
 
@@ -130,7 +132,8 @@ CHIP_ERROR ReadHandler::ProcessReadRequest(System::PacketBufferHandle aPayload)
     else
     {
         SuccessOrExit(err);
-        ProcessAttributePathList(attributePathListParser);
+        err = ProcessAttributePathList(attributePathListParser);
+        SuccessOrExit(err);
     }
 
     err = readRequestParser.GetEventPathList(&eventPathListParser);
@@ -141,26 +144,27 @@ CHIP_ERROR ReadHandler::ProcessReadRequest(System::PacketBufferHandle aPayload)
     else
     {
         SuccessOrExit(err);
-        eventPathListParser.GetReader(&eventPathListReader);
-
-        while (CHIP_NO_ERROR == (err = eventPathListReader.Next()))
-        {
-            VerifyOrExit(TLV::AnonymousTag == eventPathListReader.GetTag(), err = CHIP_ERROR_INVALID_TLV_TAG);
-
-            EventPath::Parser eventPath;
-
-            err = eventPath.Init(eventPathListReader);
-            SuccessOrExit(err);
-            // TODO: Pass event path to report engine to generate report with interested events
-        }
+        err = ProcessEventPathList(eventPathListParser);
+        SuccessOrExit(err);
     }
 
-    // if we have exhausted this container
-    if (CHIP_END_OF_TLV == err)
+    err = readRequestParser.GetEventNumber(&eventNumber);
+    if (CHIP_NO_ERROR == err)
+    {
+        // The reader already has the events up to the event number it gives, of all priorities.
+        eventNumber++;
+    }
+    else if (CHIP_END_OF_TLV == err)
     {
         err = CHIP_NO_ERROR;
     }
+    SuccessOrExit(err);
+    for (auto & nextEventNumber : mNextEventNumbers)
+    {
+        nextEventNumber = eventNumber;
+    }
 
+    mAttributePathExpandIterator.Reset(mpClusterInfoList);
     MoveToState(HandlerState::Reportable);
 
     err = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
@@ -186,11 +190,31 @@ CHIP_ERROR ReadHandler::ProcessAttributePathList(AttributePathList::Parser & aAt
         SuccessOrExit(err);
         err = path.GetNodeId(&(attributePathParams.mNodeId));
         SuccessOrExit(err);
+        // A missing endpoint, cluster or field id selects all of them; the paths are expanded while reporting.
         err = path.GetEndpointId(&(attributePathParams.mEndpointId));
+        if (CHIP_END_OF_TLV == err)
+        {
+            attributePathParams.mFlags.Set(AttributePathFlags::kEndpointIdWildcard);
+            err = CHIP_NO_ERROR;
+        }
         SuccessOrExit(err);
         err = path.GetClusterId(&(attributePathParams.mClusterId));
+        if (CHIP_END_OF_TLV == err)
+        {
+            attributePathParams.mFlags.Set(AttributePathFlags::kClusterIdWildcard);
+            err = CHIP_NO_ERROR;
+        }
         SuccessOrExit(err);
         err = path.GetFieldId(&(attributePathParams.mFieldId));
+        if (CHIP_NO_ERROR == err)
+        {
+            attributePathParams.mFlags.Set(AttributePathFlags::kFieldIdValid);
+        }
+        else if (CHIP_END_OF_TLV == err)
+        {
+            attributePathParams.mFlags.Set(AttributePathFlags::kFieldIdWildcard);
+            err = CHIP_NO_ERROR;
+        }
         SuccessOrExit(err);
         err = InteractionModelEngine::GetInstance()->PushFront(mpClusterInfoList, attributePathParams);
         SuccessOrExit(err);
@@ -207,6 +231,53 @@ exit:
     return err;
 }
 
+CHIP_ERROR ReadHandler::ProcessEventPathList(EventPathList::Parser & aEventPathListParser)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLV::TLVReader reader;
+    aEventPathListParser.GetReader(&reader);
+
+    while (CHIP_NO_ERROR == (err = reader.Next()))
+    {
+        VerifyOrExit(TLV::AnonymousTag == reader.GetTag(), err = CHIP_ERROR_INVALID_TLV_TAG);
+        VerifyOrExit(TLV::kTLVType_List == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+        EventPathParams eventPathParams;
+        EventPath::Parser path;
+        err = path.Init(reader);
+        SuccessOrExit(err);
+        err = path.GetNodeId(&(eventPathParams.mNodeId));
+        SuccessOrExit(err);
+        // A missing endpoint or event id selects all of them; the cluster is required.
+        err = path.GetEndpointId(&(eventPathParams.mEndpointId));
+        if (CHIP_END_OF_TLV == err)
+        {
+            eventPathParams.mFlags.Set(EventPathFlags::kEndpointIdWildcard);
+            err = CHIP_NO_ERROR;
+        }
+        SuccessOrExit(err);
+        err = path.GetClusterId(&(eventPathParams.mClusterId));
+        SuccessOrExit(err);
+        err = path.GetEventId(&(eventPathParams.mEventId));
+        if (CHIP_END_OF_TLV == err)
+        {
+            eventPathParams.mFlags.Set(EventPathFlags::kEventIdWildcard);
+            err = CHIP_NO_ERROR;
+        }
+        SuccessOrExit(err);
+        err = InteractionModelEngine::GetInstance()->PushFront(mpEventClusterInfoList, eventPathParams);
+        SuccessOrExit(err);
+    }
+    // if we have exhausted this container
+    if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
 const char * ReadHandler::GetStateStr() const
 {
 #if CHIP_DETAIL_LOGGING
@@ -24,7 +24,9 @@
 
 #pragma once
 
+#include <app/AttributePathExpandIterator.h>
 #include <app/ClusterInfo.h>
+#include <app/EventLoggingTypes.h>
 #include <app/InteractionModelDelegate.h>
 #include <core/CHIPCore.h>
 #include <core/CHIPTLVDebug.hpp>
@@ -85,7 +87,8 @@ public:
     CHIP_ERROR OnReadRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle aPayload);
 
     /**
-     *  Send ReportData to initiator
+     *  Send ReportData to initiator. The exchange is kept open, so that a report split in several chunks can be sent
+     *  as several ReportData messages; the reporting engine shuts the handler down once the last chunk is out.
      *
      *  @param[in]    aPayload             A payload that has read request data
      *
@@ -102,6 +105,19 @@ public:
 
     ClusterInfo * GetCluterInfolist() { return mpClusterInfoList; };
 
+    /**
+     *  The position of the reporting engine in the concrete attribute paths selected by this read, kept between the
+     *  chunks of a report.
+     */
+    AttributePathExpandIterator & GetAttributePathExpandIterator() { return mAttributePathExpandIterator; }
+
+    ClusterInfo * GetEventClusterInfolist() { return mpEventClusterInfoList; };
+
+    /**
+     *  The number of the next event of a priority to report to this reader, advanced as events are reported.
+     */
+    EventNumber & GetNextEventNumber(PriorityLevel aPriority) { return mNextEventNumbers[static_cast<size_t>(aPriority)]; }
+
 private:
     enum class HandlerState
     {
@@ -112,6 +128,7 @@ private:
 
     CHIP_ERROR ProcessReadRequest(System::PacketBufferHandle aPayload);
     CHIP_ERROR ProcessAttributePathList(AttributePathList::Parser & aAttributePathListParser);
+    CHIP_ERROR ProcessEventPathList(EventPathList::Parser & aEventPathListParser);
     void MoveToState(const HandlerState aTargetState);
 
     const char * GetStateStr() const;
@@ -129,6 +146,9 @@ private:
     // Current Handler state
     HandlerState mState;
     ClusterInfo * mpClusterInfoList = nullptr;
+    AttributePathExpandIterator mAttributePathExpandIterator;
+    ClusterInfo * mpEventClusterInfoList = nullptr;
+    EventNumber mNextEventNumbers[kNumPriorityLevel];
 };
 } // namespace app
 } // namespace chip
@@ -0,0 +1,388 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the initiator side of a CHIP Write Interaction.
+ *
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/WriteClient.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR WriteClient::Init(Messaging::ExchangeManager * apExchangeMgr, InteractionModelDelegate * apDelegate)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    // Error if already initialized.
+    VerifyOrExit(apExchangeMgr != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mpExchangeMgr == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mpExchangeCtx == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    err = Reset();
+    SuccessOrExit(err);
+
+    mpExchangeMgr = apExchangeMgr;
+    mpDelegate    = apDelegate;
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteClient::Reset()
+{
+    CHIP_ERROR err                    = CHIP_NO_ERROR;
+    System::PacketBufferHandle packet = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+    VerifyOrExit(!packet.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+
+    mMessageWriter.Init(std::move(packet));
+
+    err = mWriteRequestBuilder.Init(&mMessageWriter);
+    SuccessOrExit(err);
+
+    err = mWriteRequestBuilder.CreateAttributeDataListBuilder().GetError();
+    SuccessOrExit(err);
+
+    mAttributeCount       = 0;
+    mAttributeStatusIndex = 0;
+    MoveToState(State::Initialized);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+void WriteClient::Shutdown()
+{
+    VerifyOrReturn(mState != State::Uninitialized);
+    mMessageWriter.Reset();
+    ClearExistingExchangeContext();
+    mpExchangeMgr         = nullptr;
+    mpDelegate            = nullptr;
+    mAttributeCount       = 0;
+    mAttributeStatusIndex = 0;
+    MoveToState(State::Uninitialized);
+}
+
+CHIP_ERROR WriteClient::PrepareAttribute(const AttributePathParams & aAttributePathParams)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    VerifyOrExit(mState == State::Initialized || mState == State::AddAttribute, err = CHIP_ERROR_INCORRECT_STATE);
+    {
+        AttributeDataElement::Builder attributeDataElement =
+            mWriteRequestBuilder.GetAttributeDataListBuilder().CreateAttributeDataElementBuilder();
+        err = attributeDataElement.GetError();
+        SuccessOrExit(err);
+
+        err = ConstructAttributePath(aAttributePathParams, attributeDataElement);
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+TLV::TLVWriter * WriteClient::GetAttributeDataElementTLVWriter()
+{
+    return mWriteRequestBuilder.GetAttributeDataListBuilder().GetAttributeDataElementBuilder().GetWriter();
+}
+
+CHIP_ERROR WriteClient::FinishAttribute()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    AttributeDataElement::Builder attributeDataElement =
+        mWriteRequestBuilder.GetAttributeDataListBuilder().GetAttributeDataElementBuilder();
+
+    // TODO: Add DataVersion support
+    attributeDataElement.DataVersion(0);
+    attributeDataElement.EndOfAttributeDataElement();
+    err = attributeDataElement.GetError();
+    SuccessOrExit(err);
+
+    mAttributeCount++;
+    MoveToState(State::AddAttribute);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteClient::ConstructAttributePath(const AttributePathParams & aAttributePathParams,
+                                               AttributeDataElement::Builder aAttributeDataElement)
+{
+    AttributePath::Builder attributePath = aAttributeDataElement.CreateAttributePathBuilder();
+    attributePath.NodeId(aAttributePathParams.mNodeId)
+        .EndpointId(aAttributePathParams.mEndpointId)
+        .ClusterId(aAttributePathParams.mClusterId);
+    if (aAttributePathParams.mFlags.Has(AttributePathFlags::kFieldIdValid))
+    {
+        attributePath.FieldId(aAttributePathParams.mFieldId);
+    }
+
+    if (aAttributePathParams.mFlags.Has(AttributePathFlags::kListIndexValid))
+    {
+        attributePath.ListIndex(aAttributePathParams.mListIndex);
+    }
+
+    attributePath.EndOfAttributePath();
+
+    return attributePath.GetError();
+}
+
+CHIP_ERROR WriteClient::FinalizeMessage(System::PacketBufferHandle & aPacket)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    AttributeDataList::Builder attributeDataListBuilder;
+    VerifyOrExit(mState == State::AddAttribute, err = CHIP_ERROR_INCORRECT_STATE);
+    attributeDataListBuilder = mWriteRequestBuilder.GetAttributeDataListBuilder().EndOfAttributeDataList();
+    err                      = attributeDataListBuilder.GetError();
+    SuccessOrExit(err);
+
+    mWriteRequestBuilder.EndOfWriteRequest();
+    err = mWriteRequestBuilder.GetError();
+    SuccessOrExit(err);
+
+    err = mMessageWriter.Finalize(&aPacket);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+const char * WriteClient::GetStateStr() const
+{
+#if CHIP_DETAIL_LOGGING
+    switch (mState)
+    {
+    case State::Uninitialized:
+        return "Uninitialized";
+
+    case State::Initialized:
+        return "Initialized";
+
+    case State::AddAttribute:
+        return "AddAttribute";
+
+    case State::AwaitingResponse:
+        return "AwaitingResponse";
+    }
+#endif // CHIP_DETAIL_LOGGING
+    return "N/A";
+}
+
+void WriteClient::MoveToState(const State aTargetState)
+{
+    mState = aTargetState;
+    ChipLogDetail(DataManagement, "WriteClient moving to [%10.10s]", GetStateStr());
+}
+
+CHIP_ERROR WriteClient::ClearExistingExchangeContext()
+{
+    if (mpExchangeCtx != nullptr)
+    {
+        mpExchangeCtx->Abort();
+        mpExchangeCtx = nullptr;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteClient::SendWriteRequest(NodeId aNodeId, Transport::AdminId aAdminId)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferHandle packet;
+
+    VerifyOrExit(mState == State::AddAttribute, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mpExchangeCtx == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    err = FinalizeMessage(packet);
+    SuccessOrExit(err);
+
+    ChipLogDetail(DataManagement, "Sending write request with %u attributes", mAttributeCount);
+
+    // TODO: Hard code keyID to 0 to unblock IM end-to-end test. Complete solution is tracked in issue:4451
+    mpExchangeCtx = mpExchangeMgr->NewContext({ aNodeId, 0, aAdminId }, this);
+    VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_NO_MEMORY);
+    mpExchangeCtx->SetResponseTimeout(kImMessageTimeoutMsec);
+
+    err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::WriteRequest, std::move(packet),
+                                     Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+    SuccessOrExit(err);
+    MoveToState(State::AwaitingResponse);
+
+exit:
+    if (err != CHIP_NO_ERROR && mState == State::AddAttribute)
+    {
+        // The request can't be rebuilt once finalized, so drop it and get ready for the next one.
+        ClearExistingExchangeContext();
+        Reset();
+    }
+    ChipLogFunctError(err);
+
+    return err;
+}
+
+void WriteClient::OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                    const PayloadHeader & aPayloadHeader, System::PacketBufferHandle aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    VerifyOrExit(aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::WriteResponse),
+                 err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
+    VerifyOrExit(apExchangeContext == mpExchangeCtx, err = CHIP_ERROR_INCORRECT_STATE);
+    err = ProcessWriteResponseMessage(std::move(aPayload));
+
+exit:
+    ChipLogFunctError(err);
+
+    ClearExistingExchangeContext();
+    Reset();
+    if (mpDelegate != nullptr)
+    {
+        if (err != CHIP_NO_ERROR)
+        {
+            mpDelegate->WriteResponseError(this, err);
+        }
+        else
+        {
+            mpDelegate->WriteResponseProcessed(this);
+        }
+    }
+}
+
+void WriteClient::OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext)
+{
+    ChipLogProgress(DataManagement, "Time out! failed to receive write response from Exchange: %d",
+                    apExchangeContext->GetExchangeId());
+    ClearExistingExchangeContext();
+    Reset();
+    if (mpDelegate != nullptr)
+    {
+        mpDelegate->WriteResponseError(this, CHIP_ERROR_TIMEOUT);
+    }
+}
+
+CHIP_ERROR WriteClient::ProcessWriteResponseMessage(System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+    TLV::TLVReader attributeStatusListReader;
+    WriteResponse::Parser writeResponse;
+    AttributeStatusList::Parser attributeStatusListParser;
+
+    reader.Init(std::move(aPayload));
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = writeResponse.Init(reader);
+    SuccessOrExit(err);
+
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = writeResponse.CheckSchemaValidity();
+    SuccessOrExit(err);
+#endif
+    err = writeResponse.GetAttributeStatusList(&attributeStatusListParser);
+    SuccessOrExit(err);
+
+    attributeStatusListParser.GetReader(&attributeStatusListReader);
+
+    while (CHIP_NO_ERROR == (err = attributeStatusListReader.Next()))
+    {
+        VerifyOrExit(TLV::AnonymousTag == attributeStatusListReader.GetTag(), err = CHIP_ERROR_INVALID_TLV_TAG);
+
+        AttributeStatusElement::Parser element;
+
+        err = element.Init(attributeStatusListReader);
+        SuccessOrExit(err);
+
+        err = ProcessAttributeStatusElement(element);
+        SuccessOrExit(err);
+    }
+
+    // if we have exhausted this container
+    if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteClient::ProcessAttributeStatusElement(AttributeStatusElement::Parser & aAttributeStatusElement)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    AttributePath::Parser attributePath;
+    AttributePathParams attributePathParams;
+    StatusElement::Parser statusElementParser;
+    Protocols::SecureChannel::GeneralStatusCode generalCode = Protocols::SecureChannel::GeneralStatusCode::kSuccess;
+    uint32_t protocolId                                     = 0;
+    uint16_t protocolCode                                   = 0;
+
+    mAttributeStatusIndex++;
+    err = aAttributeStatusElement.GetAttributePath(&attributePath);
+    SuccessOrExit(err);
+    err = attributePath.GetNodeId(&(attributePathParams.mNodeId));
+    SuccessOrExit(err);
+    err = attributePath.GetEndpointId(&(attributePathParams.mEndpointId));
+    SuccessOrExit(err);
+    err = attributePath.GetClusterId(&(attributePathParams.mClusterId));
+    SuccessOrExit(err);
+    err = attributePath.GetFieldId(&(attributePathParams.mFieldId));
+    if (CHIP_NO_ERROR == err)
+    {
+        attributePathParams.mFlags.Set(AttributePathFlags::kFieldIdValid);
+    }
+    else if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    SuccessOrExit(err);
+    err = attributePath.GetListIndex(&(attributePathParams.mListIndex));
+    if (CHIP_NO_ERROR == err)
+    {
+        attributePathParams.mFlags.Set(AttributePathFlags::kListIndexValid);
+    }
+    else if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    SuccessOrExit(err);
+
+    err = aAttributeStatusElement.GetStatusElement(&statusElementParser);
+    SuccessOrExit(err);
+    err = statusElementParser.DecodeStatusElement(&generalCode, &protocolId, &protocolCode);
+    SuccessOrExit(err);
+
+    if (mpDelegate != nullptr)
+    {
+        mpDelegate->WriteResponseStatus(this, generalCode, protocolId, protocolCode, attributePathParams, mAttributeStatusIndex);
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines write client for a CHIP Interaction Data model
+ *
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/InteractionModelDelegate.h>
+#include <app/MessageDef/AttributeDataList.h>
+#include <app/MessageDef/AttributeStatusElement.h>
+#include <app/MessageDef/WriteRequest.h>
+#include <app/MessageDef/WriteResponse.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPTLVDebug.hpp>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/Flags.h>
+#include <protocols/Protocols.h>
+#include <support/CodeUtils.h>
+#include <support/DLLUtil.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+
+namespace chip {
+namespace app {
+/**
+ *  @class WriteClient
+ *
+ *  @brief The write client represents the initiator side of a Write Interaction, and is responsible
+ *  for generating one Write Request for a set of attributes, and handling the Write Response.
+ *
+ *  Any number of attributes, on any number of clusters, can be added to a single request with
+ *  PrepareAttribute / GetAttributeDataElementTLVWriter / FinishAttribute, as long as they fit in one message.
+ *  The responder applies them all and answers with a single Write Response listing one status per attribute.
+ *
+ */
+class WriteClient : public Messaging::ExchangeDelegate
+{
+public:
+    /**
+     *  Shut down the Client. This terminates this instance of the object and releases
+     *  all held resources.  The object must not be used after Shutdown() is called.
+     *
+     *  SDK consumer can choose when to shut down the WriteClient.
+     *  The WriteClient will never shut itself down, unless the overall InteractionModelEngine is shut down.
+     */
+    void Shutdown();
+
+    /**
+     *  Start a new AttributeDataElement for the attribute at @p aAttributePathParams. The caller is expected to put the
+     *  attribute value, tagged with TLV::ContextTag(AttributeDataElement::kCsTag_Data), into the writer returned by
+     *  GetAttributeDataElementTLVWriter, then call FinishAttribute.
+     *
+     *  @retval #CHIP_ERROR_INCORRECT_STATE if a request is in flight or the previous attribute was not finished.
+     *  @retval #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR PrepareAttribute(const AttributePathParams & aAttributePathParams);
+    TLV::TLVWriter * GetAttributeDataElementTLVWriter();
+    CHIP_ERROR FinishAttribute();
+
+    /**
+     *  Send the Write Request holding all the attributes added since the last request.  There can be one Write Request
+     *  outstanding on a given WriteClient.  If SendWriteRequest returns success, no more Write Requests can be sent on
+     *  this WriteClient until the corresponding InteractionModelDelegate::WriteResponseProcessed or
+     *  InteractionModelDelegate::WriteResponseError call happens with guarantee.
+     *
+     *  @param[in]    aNodeId    Node Id
+     *  @param[in]    aAdminId   Admin ID
+     *  @retval #others fail to send write request
+     *  @retval #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR SendWriteRequest(NodeId aNodeId, Transport::AdminId aAdminId);
+
+    /**
+     *  Number of attributes added to the request being built.
+     */
+    uint16_t GetAttributeCount() const { return mAttributeCount; }
+
+private:
+    friend class TestWriteInteraction;
+    friend class InteractionModelEngine;
+
+    enum class State
+    {
+        Uninitialized = 0, //< The client has not been initialized
+        Initialized,       //< The client has been initialized and is ready for a PrepareAttribute
+        AddAttribute,      //< The client has added at least one attribute to the request
+        AwaitingResponse,  //< The client has sent out the write request message
+    };
+
+    /**
+     *  Initialize the client object. Within the lifetime
+     *  of this instance, this method is invoked once after object
+     *  construction until a call to Shutdown is made to terminate the
+     *  instance.
+     *
+     *  @param[in]    apExchangeMgr    A pointer to the ExchangeManager object.
+     *  @param[in]    apDelegate       InteractionModelDelegate set by application.
+     *
+     *  @retval #CHIP_ERROR_INCORRECT_STATE incorrect state if it is already initialized
+     *  @retval #CHIP_NO_ERROR On success.
+     *
+     */
+    CHIP_ERROR Init(Messaging::ExchangeManager * apExchangeMgr, InteractionModelDelegate * apDelegate);
+
+    virtual ~WriteClient() = default;
+
+    void OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                           const PayloadHeader & aPayloadHeader, System::PacketBufferHandle aPayload) override;
+    void OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext) override;
+
+    /**
+     *  Check if current write client is being used
+     *
+     */
+    bool IsFree() const { return mState == State::Uninitialized; };
+
+    CHIP_ERROR Reset();
+    CHIP_ERROR FinalizeMessage(System::PacketBufferHandle & aPacket);
+    CHIP_ERROR ProcessWriteResponseMessage(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR ProcessAttributeStatusElement(AttributeStatusElement::Parser & aAttributeStatusElement);
+    CHIP_ERROR ConstructAttributePath(const AttributePathParams & aAttributePathParams,
+                                      AttributeDataElement::Builder aAttributeDataElement);
+    void MoveToState(const State aTargetState);
+    CHIP_ERROR ClearExistingExchangeContext();
+    const char * GetStateStr() const;
+
+    Messaging::ExchangeManager * mpExchangeMgr = nullptr;
+    Messaging::ExchangeContext * mpExchangeCtx = nullptr;
+    InteractionModelDelegate * mpDelegate      = nullptr;
+    State mState                               = State::Uninitialized;
+    System::PacketBufferTLVWriter mMessageWriter;
+    WriteRequest::Builder mWriteRequestBuilder;
+    uint16_t mAttributeCount       = 0;
+    uint16_t mAttributeStatusIndex = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,363 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines write handler for a CHIP Interaction Data model
+ *
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/WriteHandler.h>
+#include <app/reporting/Engine.h>
+
+using GeneralStatusCode = chip::Protocols::SecureChannel::GeneralStatusCode;
+
+namespace chip {
+namespace app {
+CHIP_ERROR WriteHandler::Init(InteractionModelDelegate * apDelegate)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferHandle packet;
+    // Error if already initialized.
+    VerifyOrExit(IsFree(), err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mpExchangeCtx == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    packet = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+    VerifyOrExit(!packet.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+
+    mMessageWriter.Init(std::move(packet));
+    err = mWriteResponseBuilder.Init(&mMessageWriter);
+    SuccessOrExit(err);
+
+    err = mWriteResponseBuilder.CreateAttributeStatusListBuilder().GetError();
+    SuccessOrExit(err);
+
+    mpDelegate            = apDelegate;
+    mNumAttributesWritten = 0;
+    MoveToState(State::Initialized);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+void WriteHandler::Shutdown()
+{
+    VerifyOrReturn(mState != State::Uninitialized);
+    mMessageWriter.Reset();
+    ClearExistingExchangeContext();
+    mpDelegate            = nullptr;
+    mNumAttributesWritten = 0;
+    ClearState();
+}
+
+CHIP_ERROR WriteHandler::ClearExistingExchangeContext()
+{
+    if (mpExchangeCtx != nullptr)
+    {
+        mpExchangeCtx->Abort();
+        mpExchangeCtx = nullptr;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteHandler::OnWriteRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    mpExchangeCtx = apExchangeContext;
+
+    err = ProcessWriteRequest(std::move(aPayload));
+    SuccessOrExit(err);
+
+    err = SendWriteResponse();
+
+exit:
+    ChipLogFunctError(err);
+    Shutdown();
+    return err;
+}
+
+CHIP_ERROR WriteHandler::FinalizeMessage(System::PacketBufferHandle & aPacket)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    AttributeStatusList::Builder attributeStatusList;
+    VerifyOrExit(mState == State::Initialized || mState == State::AddAttributeStatusCode, err = CHIP_ERROR_INCORRECT_STATE);
+    attributeStatusList = mWriteResponseBuilder.GetAttributeStatusListBuilder().EndOfAttributeStatusList();
+    err                 = attributeStatusList.GetError();
+    SuccessOrExit(err);
+
+    mWriteResponseBuilder.EndOfWriteResponse();
+    err = mWriteResponseBuilder.GetError();
+    SuccessOrExit(err);
+
+    err = mMessageWriter.Finalize(&aPacket);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::SendWriteResponse()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferHandle packet;
+
+    err = FinalizeMessage(packet);
+    SuccessOrExit(err);
+
+    VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::WriteResponse, std::move(packet),
+                                     Messaging::SendFlags(Messaging::SendMessageFlags::kNone));
+    SuccessOrExit(err);
+
+    MoveToState(State::Sending);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::ProcessWriteRequest(System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+
+    WriteRequest::Parser writeRequestParser;
+    AttributeDataList::Parser attributeDataListParser;
+    TLV::TLVReader attributeDataListReader;
+
+    reader.Init(std::move(aPayload));
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = writeRequestParser.Init(reader);
+    SuccessOrExit(err);
+
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = writeRequestParser.CheckSchemaValidity();
+    SuccessOrExit(err);
+#endif
+
+    err = writeRequestParser.GetAttributeDataList(&attributeDataListParser);
+    SuccessOrExit(err);
+
+    attributeDataListParser.GetReader(&attributeDataListReader);
+    err = ProcessAttributeDataList(attributeDataListReader);
+    SuccessOrExit(err);
+
+exit:
+    // Every changed attribute has been marked dirty; a single run of the reporting engine reports all of them, including
+    // those applied before the request turned out to be malformed.
+    if (mNumAttributesWritten > 0)
+    {
+        CHIP_ERROR reportErr = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+        ChipLogFunctError(reportErr);
+    }
+
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::ProcessAttributeDataList(TLV::TLVReader & aAttributeDataListReader)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    while (CHIP_NO_ERROR == (err = aAttributeDataListReader.Next()))
+    {
+        VerifyOrExit(TLV::AnonymousTag == aAttributeDataListReader.GetTag(), err = CHIP_ERROR_INVALID_TLV_TAG);
+
+        AttributeDataElement::Parser element;
+
+        err = element.Init(aAttributeDataListReader);
+        SuccessOrExit(err);
+
+        err = ProcessAttributeDataElement(element);
+        SuccessOrExit(err);
+    }
+
+    // if we have exhausted this container
+    if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::ProcessAttributeDataElement(AttributeDataElement::Parser & aAttributeDataElement)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    AttributePath::Parser attributePath;
+    AttributePathParams attributePathParams;
+    TLV::TLVReader dataReader;
+    uint32_t remainingLength;
+
+    err = aAttributeDataElement.GetAttributePath(&attributePath);
+    SuccessOrExit(err);
+    err = attributePath.GetNodeId(&(attributePathParams.mNodeId));
+    SuccessOrExit(err);
+    err = attributePath.GetEndpointId(&(attributePathParams.mEndpointId));
+    SuccessOrExit(err);
+    err = attributePath.GetClusterId(&(attributePathParams.mClusterId));
+    SuccessOrExit(err);
+    err = attributePath.GetFieldId(&(attributePathParams.mFieldId));
+    if (CHIP_NO_ERROR == err)
+    {
+        attributePathParams.mFlags.Set(AttributePathFlags::kFieldIdValid);
+    }
+    else if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    SuccessOrExit(err);
+    err = attributePath.GetListIndex(&(attributePathParams.mListIndex));
+    if (CHIP_NO_ERROR == err)
+    {
+        attributePathParams.mFlags.Set(AttributePathFlags::kListIndexValid);
+    }
+    else if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    SuccessOrExit(err);
+
+    err = aAttributeDataElement.GetData(&dataReader);
+    SuccessOrExit(err);
+
+    // An attribute is only applied while the response has room for its status and for the status rejecting the next one.
+    // Once it fills up, the remaining attributes are rejected, each with a status for as long as there is room.
+    remainingLength = mWriteResponseBuilder.GetAttributeStatusListBuilder().GetWriter()->GetRemainingFreeLength();
+    if (remainingLength < 2 * kMaxAttributeStatusSize + kReservedSizeForEndOfResponse)
+    {
+        if (remainingLength >= kMaxAttributeStatusSize + kReservedSizeForEndOfResponse)
+        {
+            err = AddAttributeStatusCode(attributePathParams, GeneralStatusCode::kResourceExhausted, Protocols::SecureChannel::Id,
+                                         Protocols::SecureChannel::kProtocolCodeGeneralFailure);
+        }
+        ExitNow();
+    }
+
+    // A failed write is reported in the status of that attribute; the rest of the request is still applied.
+    err = WriteSingleClusterData(attributePathParams, dataReader);
+    if (err == CHIP_NO_ERROR)
+    {
+        mNumAttributesWritten++;
+        InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(attributePathParams);
+        err = AddAttributeStatusCode(attributePathParams, GeneralStatusCode::kSuccess, Protocols::SecureChannel::Id,
+                                     Protocols::SecureChannel::kProtocolCodeSuccess);
+    }
+    else
+    {
+        // Attributes that no data model handles are unsupported rather than failed.
+        GeneralStatusCode generalCode =
+            (err == CHIP_ERROR_NOT_IMPLEMENTED) ? GeneralStatusCode::kUnsupported : GeneralStatusCode::kFailure;
+        err = AddAttributeStatusCode(attributePathParams, generalCode, Protocols::SecureChannel::Id,
+                                     Protocols::SecureChannel::kProtocolCodeGeneralFailure);
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::AddAttributeStatusCode(const AttributePathParams & aAttributePathParams,
+                                                const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                                const Protocols::Id aProtocolId, const uint16_t aProtocolCode)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    AttributePath::Builder attributePath;
+    StatusElement::Builder statusElementBuilder;
+    AttributeStatusElement::Builder attributeStatusElement =
+        mWriteResponseBuilder.GetAttributeStatusListBuilder().CreateAttributeStatusBuilder();
+    err = attributeStatusElement.GetError();
+    SuccessOrExit(err);
+
+    attributePath = attributeStatusElement.CreateAttributePathBuilder();
+    attributePath.NodeId(aAttributePathParams.mNodeId)
+        .EndpointId(aAttributePathParams.mEndpointId)
+        .ClusterId(aAttributePathParams.mClusterId);
+    if (aAttributePathParams.mFlags.Has(AttributePathFlags::kFieldIdValid))
+    {
+        attributePath.FieldId(aAttributePathParams.mFieldId);
+    }
+    if (aAttributePathParams.mFlags.Has(AttributePathFlags::kListIndexValid))
+    {
+        attributePath.ListIndex(aAttributePathParams.mListIndex);
+    }
+    attributePath.EndOfAttributePath();
+    err = attributePath.GetError();
+    SuccessOrExit(err);
+
+    statusElementBuilder = attributeStatusElement.CreateStatusElementBuilder();
+    statusElementBuilder.EncodeStatusElement(aGeneralCode, aProtocolId.ToFullyQualifiedSpecForm(), aProtocolCode)
+        .EndOfStatusElement();
+    err = statusElementBuilder.GetError();
+    SuccessOrExit(err);
+
+    attributeStatusElement.EndOfAttributeStatusElement();
+    err = attributeStatusElement.GetError();
+    SuccessOrExit(err);
+
+    MoveToState(State::AddAttributeStatusCode);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+const char * WriteHandler::GetStateStr() const
+{
+#if CHIP_DETAIL_LOGGING
+    switch (mState)
+    {
+    case State::Uninitialized:
+        return "Uninitialized";
+
+    case State::Initialized:
+        return "Initialized";
+
+    case State::AddAttributeStatusCode:
+        return "AddAttributeStatusCode";
+
+    case State::Sending:
+        return "Sending";
+    }
+#endif // CHIP_DETAIL_LOGGING
+    return "N/A";
+}
+
+void WriteHandler::MoveToState(const State aTargetState)
+{
+    mState = aTargetState;
+    ChipLogDetail(DataManagement, "IM WH moving to [%s]", GetStateStr());
+}
+
+void WriteHandler::ClearState()
+{
+    MoveToState(State::Uninitialized);
+}
+
+} // namespace app
+} // namespace chip
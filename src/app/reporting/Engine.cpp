@@ -23,6 +23,7 @@
  *
  */
 
+#include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/Engine.h>
 
@@ -37,36 +38,35 @@ CHIP_ERROR Engine::Init()
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR
-Engine::RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElementBuilder, ClusterInfo & aClusterInfo)
+CHIP_ERROR Engine::RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElementBuilder,
+                                       AttributePathParams & aAttributePathParams)
 {
     CHIP_ERROR err                              = CHIP_NO_ERROR;
     TLV::TLVType type                           = TLV::kTLVType_NotSpecified;
     AttributePath::Builder attributePathBuilder = aAttributeDataElementBuilder.CreateAttributePathBuilder();
-    attributePathBuilder.NodeId(aClusterInfo.mAttributePathParams.mNodeId)
-        .EndpointId(aClusterInfo.mAttributePathParams.mEndpointId)
-        .ClusterId(aClusterInfo.mAttributePathParams.mClusterId)
-        .FieldId(aClusterInfo.mAttributePathParams.mFieldId)
+    attributePathBuilder.NodeId(aAttributePathParams.mNodeId)
+        .EndpointId(aAttributePathParams.mEndpointId)
+        .ClusterId(aAttributePathParams.mClusterId)
+        .FieldId(aAttributePathParams.mFieldId)
         .EndOfAttributePath();
     err = attributePathBuilder.GetError();
     SuccessOrExit(err);
 
-    aAttributeDataElementBuilder.GetWriter()->StartContainer(TLV::ContextTag(AttributeDataElement::kCsTag_Data),
-                                                             TLV::kTLVType_Structure, type);
-    err = ReadSingleClusterData(aClusterInfo.mAttributePathParams, *(aAttributeDataElementBuilder.GetWriter()));
+    err = aAttributeDataElementBuilder.GetWriter()->StartContainer(TLV::ContextTag(AttributeDataElement::kCsTag_Data),
+                                                                   TLV::kTLVType_Structure, type);
+    SuccessOrExit(err);
+    err = ReadSingleClusterData(aAttributePathParams, *(aAttributeDataElementBuilder.GetWriter()));
+    SuccessOrExit(err);
+    err = aAttributeDataElementBuilder.GetWriter()->EndContainer(type);
     SuccessOrExit(err);
-    aAttributeDataElementBuilder.GetWriter()->EndContainer(type);
     aAttributeDataElementBuilder.DataVersion(0).MoreClusterData(false).EndOfAttributeDataElement();
     err = aAttributeDataElementBuilder.GetError();
     // TODO: Add DataVersion support
 
 exit:
-    aClusterInfo.ClearDirty();
-
-    if (err != CHIP_NO_ERROR)
+    if (err != CHIP_NO_ERROR && err != CHIP_ERROR_BUFFER_TOO_SMALL && err != CHIP_ERROR_NO_MEMORY)
     {
-        ChipLogError(DataManagement, "Error retrieving data from clusterId: %08x, err = %d",
-                     aClusterInfo.mAttributePathParams.mClusterId, err);
+        ChipLogError(DataManagement, "Error retrieving data from clusterId: %08x, err = %d", aAttributePathParams.mClusterId, err);
     }
 
     return err;
@@ -75,24 +75,122 @@ exit:
 CHIP_ERROR Engine::BuildSingleReportDataAttributeDataList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler)
 {
     CHIP_ERROR err                               = CHIP_NO_ERROR;
-    ClusterInfo * clusterInfo                    = apReadHandler->GetCluterInfolist();
+    AttributePathExpandIterator & pathIterator   = apReadHandler->GetAttributePathExpandIterator();
+    uint16_t numAttributeDataElements            = 0;
     AttributeDataList::Builder attributeDataList = reportDataBuilder.CreateAttributeDataListBuilder();
-    SuccessOrExit(reportDataBuilder.GetError());
-    // TODO: Need to handle multiple chunk of message
-    while (clusterInfo != nullptr)
+    AttributePathParams attributePathParams;
+    SuccessOrExit(err = reportDataBuilder.GetError());
+
+    mMoreChunkedMessages = false;
+
+    // The iterator resumes where the previous chunk of this report stopped.
+    for (; pathIterator.Get(attributePathParams); pathIterator.Next())
+    {
+        TLV::TLVWriter checkpoint;
+
+        if (!pathIterator.GetClusterInfo()->IsDirty())
+        {
+            continue;
+        }
+
+        ChipLogDetail(DataManagement, "<RE:Run> Cluster %u, Field %u is dirty", attributePathParams.mClusterId,
+                      attributePathParams.mFieldId);
+
+        attributeDataList.Checkpoint(checkpoint);
+        AttributeDataElement::Builder attributeDataElementBuilder = attributeDataList.CreateAttributeDataElementBuilder();
+        err = RetrieveClusterData(attributeDataElementBuilder, attributePathParams);
+        if (err == CHIP_NO_ERROR && attributeDataList.GetWriter()->GetRemainingFreeLength() < kReservedSizeForMoreChunksFlag)
+        {
+            err = CHIP_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY)
+        {
+            // This element goes first in the next chunk, unless it cannot fit in a message on its own.
+            VerifyOrExit(numAttributeDataElements > 0,
+                         ChipLogError(DataManagement, "<RE:Run> Attribute data is too large for a report, aborting"));
+            attributeDataList.Rollback(checkpoint);
+            mMoreChunkedMessages = true;
+            err                  = CHIP_NO_ERROR;
+            break;
+        }
+        VerifyOrExit(err == CHIP_NO_ERROR, ChipLogError(DataManagement, "<RE:Run> Error retrieving data from cluster, aborting"));
+        numAttributeDataElements++;
+    }
+
+    attributeDataList.EndOfAttributeDataList();
+    err = attributeDataList.GetError();
+    SuccessOrExit(err);
+
+    if (!mMoreChunkedMessages)
+    {
+        // Every selected path has been reported.
+        ClusterInfo * clusterInfo = apReadHandler->GetCluterInfolist();
+        while (clusterInfo != nullptr)
+        {
+            clusterInfo->ClearDirty();
+            clusterInfo = clusterInfo->mpNext;
+        }
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR Engine::BuildSingleReportDataEventList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler)
+{
+    CHIP_ERROR err                    = CHIP_NO_ERROR;
+    size_t numEventDataElements       = 0;
+    bool hasEvents                    = false;
+    EventManagement & eventManagement = EventManagement::GetInstance();
+    TLV::TLVWriter checkpoint;
+    SuccessOrExit(err = reportDataBuilder.GetError());
+
+    mMoreChunkedMessages = false;
+    VerifyOrExit(apReadHandler->GetEventClusterInfolist() != nullptr, );
+
+    for (size_t index = 0; index < kNumPriorityLevel && !hasEvents; index++)
+    {
+        PriorityLevel priority = static_cast<PriorityLevel>(index);
+        hasEvents              = eventManagement.HasEventsSince(priority, apReadHandler->GetNextEventNumber(priority));
+    }
+    VerifyOrExit(hasEvents, );
+
+    reportDataBuilder.Checkpoint(checkpoint);
     {
-        if (clusterInfo->IsDirty())
+        EventList::Builder & eventList = reportDataBuilder.CreateEventDataListBuilder();
+        SuccessOrExit(err = reportDataBuilder.GetError());
+
+        for (size_t index = kNumPriorityLevel; index > 0; index--)
+        {
+            PriorityLevel priority = static_cast<PriorityLevel>(index - 1);
+
+            err = eventManagement.FetchEventsSince(*(eventList.GetWriter()), apReadHandler->GetEventClusterInfolist(), priority,
+                                                   apReadHandler->GetNextEventNumber(priority), numEventDataElements,
+                                                   kReservedSizeForMoreChunksFlag);
+            if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY)
+            {
+                // The events are the first data of a report, so the next chunk has room for this one, unless it cannot fit
+                // in a message on its own.
+                VerifyOrExit(numEventDataElements > 0,
+                             ChipLogError(DataManagement, "<RE:Run> Event data is too large for a report, aborting"));
+                mMoreChunkedMessages = true;
+                err                  = CHIP_NO_ERROR;
+                break;
+            }
+            SuccessOrExit(err);
+        }
+
+        if (numEventDataElements == 0)
         {
-            AttributeDataElement::Builder attributeDataElementBuilder = attributeDataList.CreateAttributeDataElementBuilder();
-            ChipLogDetail(DataManagement, "<RE:Run> Cluster %u, Field %u is dirty", clusterInfo->mAttributePathParams.mClusterId,
-                          clusterInfo->mAttributePathParams.mFieldId);
-            // Retrieve data for this cluster instance and clear its dirty flag.
-            err = RetrieveClusterData(attributeDataElementBuilder, *clusterInfo);
-            VerifyOrExit(err == CHIP_NO_ERROR,
-                         ChipLogError(DataManagement, "<RE:Run> Error retrieving data from cluster, aborting"));
+            // None of the new events is on the paths of the reader.
+            reportDataBuilder.Rollback(checkpoint);
+            ExitNow();
         }
 
-        clusterInfo = clusterInfo->mpNext;
+        eventList.EndOfEventList();
+        err = eventList.GetError();
     }
 
 exit:
@@ -115,14 +213,17 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     err = reportDataBuilder.Init(&reportDataWriter);
     SuccessOrExit(err);
 
-    err = BuildSingleReportDataAttributeDataList(reportDataBuilder, apReadHandler);
+    err = BuildSingleReportDataEventList(reportDataBuilder, apReadHandler);
     SuccessOrExit(err);
-    // TODO: Fill in the EventList.
-    // err = BuildSingleReportDataEventList(reportDataBuilder, apReadHandler);
-    // SuccessOrExit(err);
+
+    // Attributes wait for the events that did not fit in this report.
+    if (!mMoreChunkedMessages)
+    {
+        err = BuildSingleReportDataAttributeDataList(reportDataBuilder, apReadHandler);
+        SuccessOrExit(err);
+    }
 
     // TODO: Add mechanism to set mSuppressResponse to handle status reports for multiple reports
-    // TODO: Add more chunk message support, currently mMoreChunkedMessages is always false.
     if (mMoreChunkedMessages)
     {
         reportDataBuilder.MoreChunkedMessages(mMoreChunkedMessages);
@@ -158,9 +259,12 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
     ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %u with readHandler %u, RE has %s", mNumReportsInFlight,
                   mCurReadHandlerIdx, mMoreChunkedMessages ? "more messages" : "no more messages");
 
-    if (!mMoreChunkedMessages)
+    // Status reports are not supported yet, so a chunk is confirmed as soon as it is sent and the next one goes out on
+    // the next run.
+    OnReportConfirm();
+    if (mMoreChunkedMessages)
     {
-        OnReportConfirm();
+        err = ScheduleRun();
     }
 
 exit:
@@ -211,6 +315,25 @@ void Engine::Run()
     }
 }
 
+void Engine::SetDirty(const AttributePathParams & aAttributePathParams)
+{
+    for (auto & readHandler : InteractionModelEngine::GetInstance()->mReadHandlers)
+    {
+        if (readHandler.IsFree())
+        {
+            continue;
+        }
+
+        for (ClusterInfo * clusterInfo = readHandler.GetCluterInfolist(); clusterInfo != nullptr; clusterInfo = clusterInfo->mpNext)
+        {
+            if (clusterInfo->mAttributePathParams.Contains(aAttributePathParams))
+            {
+                clusterInfo->SetDirty();
+            }
+        }
+    }
+}
+
 CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
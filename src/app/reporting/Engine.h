@@ -70,6 +70,12 @@ public:
      */
     CHIP_ERROR ScheduleRun();
 
+    /**
+     * Mark the attribute at @p aAttributePathParams as changed for every read handler interested in it. Nothing is sent
+     * until the next Run, so changes to many attributes can be coalesced into a single report.
+     */
+    void SetDirty(const AttributePathParams & aAttributePathParams);
+
 private:
     friend class TestReportingEngine;
     /**
@@ -78,9 +84,23 @@ private:
      */
     CHIP_ERROR BuildAndSendSingleReportData(ReadHandler * apReadHandler);
 
+    /**
+     * Fill the attribute data list with as many of the paths selected by the read handler as fit in one message, starting
+     * from the position of its path iterator. mMoreChunkedMessages is set if some paths are left for another report.
+     *
+     */
     CHIP_ERROR BuildSingleReportDataAttributeDataList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler);
 
-    CHIP_ERROR RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElementBuilder, ClusterInfo & aClusterInfo);
+    /**
+     * Fill the event list with the events selected by the read handler that it has not received yet, most important
+     * priority first, and advance its event numbers. mMoreChunkedMessages is set if some events are left for another
+     * report. The event list is left out of the report if there is no event to send.
+     *
+     */
+    CHIP_ERROR BuildSingleReportDataEventList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler);
+
+    CHIP_ERROR RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElementBuilder,
+                                   AttributePathParams & aAttributePathParams);
     /**
      * Send Report via ReadHandler
      *
@@ -100,6 +120,12 @@ private:
      */
     static void Run(System::Layer * aSystemLayer, void * apAppState, System::Error);
 
+    /**
+     * Space kept free in a report for the MoreChunkedMessages flag written after the attribute data and event lists.
+     *
+     */
+    static constexpr uint32_t kReservedSizeForMoreChunksFlag = 2;
+
     /**
      * Boolean to show if more chunk message on the way
      *
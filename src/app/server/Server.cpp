@@ -103,12 +103,12 @@ class ServerStorageDelegate : public PersistentStorageDelegate
 
 ServerStorageDelegate gServerStorage;
 
-CHIP_ERROR PersistAdminPairingToKVS(AdminPairingInfo * admin, AdminId nextAvailableId)
+CHIP_ERROR PersistAdminPairingToKVS(AdminPairingTable & adminPairings, AdminPairingInfo * admin, AdminId nextAvailableId)
 {
     ReturnErrorCodeIf(admin == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     ChipLogProgress(AppServer, "Persisting admin ID %d, next available %d", admin->GetAdminId(), nextAvailableId);
 
-    ReturnErrorOnFailure(admin->StoreIntoKVS(gServerStorage));
+    ReturnErrorOnFailure(adminPairings.StoreIntoKVS(gServerStorage, admin->GetAdminId()));
     ReturnErrorOnFailure(PersistedStorage::KeyValueStoreMgr().Put(kAdminTableCountKey, &nextAvailableId, sizeof(nextAvailableId)));
 
     ChipLogProgress(AppServer, "Persisting admin ID successfully");
@@ -122,12 +122,23 @@ CHIP_ERROR RestoreAllAdminPairingsFromKVS(AdminPairingTable & adminPairings, Adm
                         CHIP_NO_ERROR);
     ChipLogProgress(AppServer, "Next available admin ID is %d", nextAvailableId);
 
+    // Restore the admins from the table index. Their records are fetched when they are first used.
+    if (adminPairings.LoadIndexFromKVS(gServerStorage) == CHIP_NO_ERROR)
+    {
+        ChipLogProgress(AppServer, "Restored %u admin pairings from index", static_cast<unsigned>(adminPairings.GetCount()));
+        return CHIP_NO_ERROR;
+    }
+
+    // Otherwise the admins were stored without an index: probe every admin ID, then store the index for the next restore.
+    adminPairings.Reset();
+
     // TODO: The admin ID space allocation should be re-evaluated. With the current approach, the space could be
     //       exhausted while IDs are still available (e.g. if the admin IDs are allocated and freed over a period of time).
     //       Also, the current approach can make ID lookup slower as more IDs are allocated and freed.
     for (AdminId id = 0; id < nextAvailableId; id++)
     {
         AdminPairingInfo * admin = adminPairings.AssignAdminId(id);
+        VerifyOrReturnError(admin != nullptr, CHIP_ERROR_NO_MEMORY);
         // Recreate the binding if one exists in persistent storage. Else skip to the next ID
         if (admin->FetchFromKVS(gServerStorage) != CHIP_NO_ERROR)
         {
@@ -140,12 +151,13 @@ CHIP_ERROR RestoreAllAdminPairingsFromKVS(AdminPairingTable & adminPairings, Adm
         }
     }
 
-    return CHIP_NO_ERROR;
+    return adminPairings.StoreIndexIntoKVS(gServerStorage);
 }
 
 void EraseAllAdminPairingsUpTo(AdminId nextAvailableId)
 {
     PersistedStorage::KeyValueStoreMgr().Delete(kAdminTableCountKey);
+    AdminPairingTable::DeleteIndexFromKVS(gServerStorage);
 
     for (AdminId id = 0; id < nextAvailableId; id++)
     {
@@ -270,7 +282,7 @@ public:
         AdminPairingInfo * admin = gAdminPairings.FindAdmin(mAdmin);
         if (admin != nullptr)
         {
-            ReturnErrorOnFailure(PersistAdminPairingToKVS(admin, gNextAvailableAdminId));
+            ReturnErrorOnFailure(PersistAdminPairingToKVS(gAdminPairings, admin, gNextAvailableAdminId));
         }
 
         return CHIP_NO_ERROR;
@@ -592,9 +604,8 @@ CHIP_ERROR AddTestPairing()
     PASESession * testSession    = nullptr;
     PASESessionSerializable serializedTestSession;
 
-    for (const AdminPairingInfo & admin : gAdminPairings)
-        if (admin.IsInitialized() && admin.GetNodeId() == chip::kTestDeviceNodeId)
-            ExitNow();
+    if (gAdminPairings.FindAdminForNode(chip::kTestDeviceNodeId) != nullptr)
+        ExitNow();
 
     adminInfo = gAdminPairings.AssignAdminId(gNextAvailableAdminId);
     VerifyOrExit(adminInfo != nullptr, err = CHIP_ERROR_NO_MEMORY);
@@ -0,0 +1,222 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for AttributePathExpandIterator
+ *
+ */
+
+#include <app/AttributePathExpandIterator.h>
+#include <app/InteractionModelEngine.h>
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+
+namespace chip {
+namespace app {
+namespace {
+// Endpoint 1 has clusters 6 and 8, endpoint 2 has cluster 6 only.
+const EndpointId sEndpoints[]        = { 1, 2 };
+const ClusterId sEndpoint1Clusters[] = { 6, 8 };
+const ClusterId sEndpoint2Clusters[] = { 6 };
+// 0x4000 is out of the range of a field id, and is never yielded.
+const AttributeId sCluster6Attributes[] = { 0, 1, 0x4000 };
+const AttributeId sCluster8Attributes[] = { 0 };
+} // namespace
+
+bool GetEndpointIdAtIndex(uint16_t aIndex, EndpointId & aEndpointId)
+{
+    VerifyOrReturnError(aIndex < ArraySize(sEndpoints), false);
+    aEndpointId = sEndpoints[aIndex];
+    return true;
+}
+
+bool GetClusterIdAtIndex(EndpointId aEndpointId, uint16_t aIndex, ClusterId & aClusterId)
+{
+    if (aEndpointId == 1 && aIndex < ArraySize(sEndpoint1Clusters))
+    {
+        aClusterId = sEndpoint1Clusters[aIndex];
+        return true;
+    }
+    if (aEndpointId == 2 && aIndex < ArraySize(sEndpoint2Clusters))
+    {
+        aClusterId = sEndpoint2Clusters[aIndex];
+        return true;
+    }
+    return false;
+}
+
+bool GetAttributeIdAtIndex(EndpointId aEndpointId, ClusterId aClusterId, uint16_t aIndex, AttributeId & aAttributeId)
+{
+    if (aClusterId == 6 && aIndex < ArraySize(sCluster6Attributes))
+    {
+        aAttributeId = sCluster6Attributes[aIndex];
+        return true;
+    }
+    if (aClusterId == 8 && aEndpointId == 1 && aIndex < ArraySize(sCluster8Attributes))
+    {
+        aAttributeId = sCluster8Attributes[aIndex];
+        return true;
+    }
+    return false;
+}
+
+namespace TestAttributePathExpandIterator {
+struct ExpectedPath
+{
+    EndpointId mEndpointId;
+    ClusterId mClusterId;
+    FieldId mFieldId;
+};
+
+void CheckPaths(nlTestSuite * apSuite, ClusterInfo * apClusterInfoList, const ExpectedPath * apExpected, size_t aExpectedCount)
+{
+    AttributePathExpandIterator iterator;
+    AttributePathParams path;
+    size_t index = 0;
+
+    for (iterator.Reset(apClusterInfoList); iterator.Get(path); iterator.Next())
+    {
+        NL_TEST_ASSERT(apSuite, index < aExpectedCount);
+        if (index >= aExpectedCount)
+        {
+            break;
+        }
+        NL_TEST_ASSERT(apSuite, path.mEndpointId == apExpected[index].mEndpointId);
+        NL_TEST_ASSERT(apSuite, path.mClusterId == apExpected[index].mClusterId);
+        NL_TEST_ASSERT(apSuite, path.mFieldId == apExpected[index].mFieldId);
+        NL_TEST_ASSERT(apSuite, path.mFlags == AttributePathFlags::kFieldIdValid);
+        index++;
+    }
+    NL_TEST_ASSERT(apSuite, index == aExpectedCount);
+    NL_TEST_ASSERT(apSuite, !iterator.Next());
+    NL_TEST_ASSERT(apSuite, iterator.GetClusterInfo() == nullptr);
+}
+
+void TestWildcardEndpoint(nlTestSuite * apSuite, void * apContext)
+{
+    // */6/*
+    ClusterInfo clusterInfo;
+    clusterInfo.mAttributePathParams.mClusterId = 6;
+    clusterInfo.mAttributePathParams.mFlags.Set(AttributePathFlags::kEndpointIdWildcard).Set(AttributePathFlags::kFieldIdWildcard);
+
+    const ExpectedPath expected[] = { { 1, 6, 0 }, { 1, 6, 1 }, { 2, 6, 0 }, { 2, 6, 1 } };
+    CheckPaths(apSuite, &clusterInfo, expected, ArraySize(expected));
+}
+
+void TestWildcardCluster(nlTestSuite * apSuite, void * apContext)
+{
+    // 1/*/*
+    ClusterInfo clusterInfo;
+    clusterInfo.mAttributePathParams.mEndpointId = 1;
+    clusterInfo.mAttributePathParams.mFlags.Set(AttributePathFlags::kClusterIdWildcard).Set(AttributePathFlags::kFieldIdWildcard);
+
+    const ExpectedPath expected[] = { { 1, 6, 0 }, { 1, 6, 1 }, { 1, 8, 0 } };
+    CheckPaths(apSuite, &clusterInfo, expected, ArraySize(expected));
+}
+
+void TestConcreteUnderWildcard(nlTestSuite * apSuite, void * apContext)
+{
+    // */8/0 only exists on endpoint 1.
+    ClusterInfo clusterInfo;
+    clusterInfo.mAttributePathParams.mClusterId = 8;
+    clusterInfo.mAttributePathParams.mFieldId   = 0;
+    clusterInfo.mAttributePathParams.mFlags.Set(AttributePathFlags::kEndpointIdWildcard).Set(AttributePathFlags::kFieldIdValid);
+
+    const ExpectedPath expected[] = { { 1, 8, 0 } };
+    CheckPaths(apSuite, &clusterInfo, expected, ArraySize(expected));
+}
+
+void TestMultiplePaths(nlTestSuite * apSuite, void * apContext)
+{
+    // A concrete path is yielded as-is, even if the data model does not know it.
+    ClusterInfo clusterInfo1;
+    ClusterInfo clusterInfo2;
+    ClusterInfo clusterInfo3;
+    clusterInfo1.mAttributePathParams = AttributePathParams(0, 3, 6, 5, 0, AttributePathFlags::kFieldIdValid);
+
+    clusterInfo2.mAttributePathParams.mEndpointId = 2;
+    clusterInfo2.mAttributePathParams.mFlags.Set(AttributePathFlags::kClusterIdWildcard).Set(AttributePathFlags::kFieldIdWildcard);
+    // Endpoint 2 has no cluster 8, so this path selects nothing.
+    clusterInfo3.mAttributePathParams.mEndpointId = 2;
+    clusterInfo3.mAttributePathParams.mClusterId  = 8;
+    clusterInfo3.mAttributePathParams.mFlags.Set(AttributePathFlags::kFieldIdWildcard);
+    clusterInfo1.mpNext = &clusterInfo2;
+    clusterInfo2.mpNext = &clusterInfo3;
+
+    const ExpectedPath expected[] = { { 3, 6, 5 }, { 2, 6, 0 }, { 2, 6, 1 } };
+    CheckPaths(apSuite, &clusterInfo1, expected, ArraySize(expected));
+}
+
+void TestResume(nlTestSuite * apSuite, void * apContext)
+{
+    ClusterInfo clusterInfo;
+    AttributePathExpandIterator iterator;
+    AttributePathParams path1;
+    AttributePathParams path2;
+    clusterInfo.mAttributePathParams.mFlags.Set(AttributePathFlags::kEndpointIdWildcard)
+        .Set(AttributePathFlags::kClusterIdWildcard)
+        .Set(AttributePathFlags::kFieldIdWildcard);
+
+    // Getting the current path does not move the iterator.
+    iterator.Reset(&clusterInfo);
+    NL_TEST_ASSERT(apSuite, iterator.Next());
+    NL_TEST_ASSERT(apSuite, iterator.Get(path1));
+    NL_TEST_ASSERT(apSuite, iterator.Get(path2));
+    NL_TEST_ASSERT(apSuite, path1.IsSamePath(path2));
+    NL_TEST_ASSERT(apSuite, path1.mEndpointId == 1 && path1.mClusterId == 6 && path1.mFieldId == 1);
+    NL_TEST_ASSERT(apSuite, iterator.GetClusterInfo() == &clusterInfo);
+
+    // Endpoint 1: 6/0, 6/1, 8/0; endpoint 2: 6/0, 6/1.
+    size_t count = 2;
+    while (iterator.Next())
+    {
+        count++;
+    }
+    NL_TEST_ASSERT(apSuite, count == 5);
+    NL_TEST_ASSERT(apSuite, !iterator.Get(path1));
+
+    iterator.Reset(nullptr);
+    NL_TEST_ASSERT(apSuite, !iterator.Get(path1));
+}
+} // namespace TestAttributePathExpandIterator
+} // namespace app
+} // namespace chip
+
+namespace {
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestWildcardEndpoint", chip::app::TestAttributePathExpandIterator::TestWildcardEndpoint),
+    NL_TEST_DEF("TestWildcardCluster", chip::app::TestAttributePathExpandIterator::TestWildcardCluster),
+    NL_TEST_DEF("TestConcreteUnderWildcard", chip::app::TestAttributePathExpandIterator::TestConcreteUnderWildcard),
+    NL_TEST_DEF("TestMultiplePaths", chip::app::TestAttributePathExpandIterator::TestMultiplePaths),
+    NL_TEST_DEF("TestResume", chip::app::TestAttributePathExpandIterator::TestResume),
+    NL_TEST_SENTINEL()
+};
+}
+
+int TestAttributePathExpandIterator()
+{
+    nlTestSuite theSuite = { "AttributePathExpandIterator", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributePathExpandIterator)
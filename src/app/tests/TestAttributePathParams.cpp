@@ -77,6 +77,18 @@ void TestDifferentPathFlag(nlTestSuite * apSuite, void * apContext)
     AttributePathParams attributePathParams2(1, 2, 3, 4, 5, AttributePathFlags::kListIndexValid);
     NL_TEST_ASSERT(apSuite, !attributePathParams1.IsSamePath(attributePathParams2));
 }
+
+void TestWildcardContains(nlTestSuite * apSuite, void * apContext)
+{
+    AttributePathParams concretePath(1, 2, 3, 4, 5, AttributePathFlags::kFieldIdValid);
+    AttributePathParams clusterPath(1, 0, 3, 0, 0, AttributePathFlags::kEndpointIdWildcard);
+    clusterPath.mFlags.Set(AttributePathFlags::kFieldIdWildcard);
+    AttributePathParams otherClusterPath(1, 0, 6, 0, 0, AttributePathFlags::kEndpointIdWildcard);
+    otherClusterPath.mFlags.Set(AttributePathFlags::kFieldIdWildcard);
+    NL_TEST_ASSERT(apSuite, concretePath.Contains(concretePath));
+    NL_TEST_ASSERT(apSuite, clusterPath.Contains(concretePath));
+    NL_TEST_ASSERT(apSuite, !otherClusterPath.Contains(concretePath));
+}
 } // namespace TestAttributePathParams
 } // namespace app
 } // namespace chip
@@ -89,6 +101,7 @@ const nlTest sTests[] = { NL_TEST_DEF("TestSamePath", chip::app::TestAttributePa
                           NL_TEST_DEF("TestDifferentFieldId", chip::app::TestAttributePathParams::TestDifferentFieldId),
                           NL_TEST_DEF("TestDifferentListIndex", chip::app::TestAttributePathParams::TestDifferentListIndex),
                           NL_TEST_DEF("TestDifferentPathFlag", chip::app::TestAttributePathParams::TestDifferentPathFlag),
+                          NL_TEST_DEF("TestWildcardContains", chip::app::TestAttributePathParams::TestWildcardContains),
                           NL_TEST_SENTINEL() };
 }
 
@@ -0,0 +1,181 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the response timeouts of CHIPDeviceCallbacksMgr
+ *
+ */
+
+#include <app/util/CHIPDeviceCallbacksMgr.h>
+#include <app/util/af-enums.h>
+#include <nlunit-test.h>
+#include <support/UnitTestRegistration.h>
+
+namespace chip {
+namespace app {
+namespace TestDeviceCallbacksMgr {
+
+constexpr NodeId kTestNodeId        = 0x1122334455667788;
+constexpr uint32_t kShortTimeoutMs  = 10;
+constexpr uint32_t kLongTimeoutMs   = 60000;
+constexpr uint32_t kExpiryAdvanceMs = 1000;
+
+struct CallCounts
+{
+    int success        = 0;
+    int failure        = 0;
+    uint8_t lastStatus = 0;
+};
+
+void OnSuccess(void * context)
+{
+    static_cast<CallCounts *>(context)->success++;
+}
+
+void OnFailure(void * context, uint8_t status)
+{
+    CallCounts * counts = static_cast<CallCounts *>(context);
+    counts->failure++;
+    counts->lastStatus = status;
+}
+
+typedef void (*SuccessFn)(void * context);
+
+// Deadlines of callbacks registered with kShortTimeoutMs have passed at this time, unlike those registered with
+// kLongTimeoutMs.
+System::Timer::Epoch AfterShortTimeout()
+{
+    return System::Timer::GetCurrentEpoch() + kExpiryAdvanceMs;
+}
+
+void TestExpiredResponseFails(nlTestSuite * apSuite, void * apContext)
+{
+    CHIPDeviceCallbacksMgr & mgr = CHIPDeviceCallbacksMgr::GetInstance();
+    CallCounts counts;
+    Callback::Callback<SuccessFn> onSuccess(OnSuccess, &counts);
+    Callback::Callback<CHIPDeviceCallbacksMgr::ResponseFailureFn> onFailure(OnFailure, &counts);
+    Callback::Cancelable * successCallback;
+    Callback::Cancelable * failureCallback;
+
+    NL_TEST_ASSERT(apSuite,
+                   mgr.AddResponseCallback(kTestNodeId, 1, onSuccess.Cancel(), onFailure.Cancel(), kShortTimeoutMs) ==
+                       CHIP_NO_ERROR);
+
+    mgr.ExpireResponseCallbacks(AfterShortTimeout());
+    NL_TEST_ASSERT(apSuite, counts.failure == 1);
+    NL_TEST_ASSERT(apSuite, counts.lastStatus == EMBER_ZCL_STATUS_TIMEOUT);
+    NL_TEST_ASSERT(apSuite, counts.success == 0);
+
+    // Both registrations are gone, so a late response finds nothing and a later pass does not fail it again.
+    NL_TEST_ASSERT(apSuite, !onSuccess.IsRegistered());
+    NL_TEST_ASSERT(apSuite, !onFailure.IsRegistered());
+    NL_TEST_ASSERT(apSuite,
+                   mgr.GetResponseCallback(kTestNodeId, 1, &successCallback, &failureCallback) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    mgr.ExpireResponseCallbacks(AfterShortTimeout());
+    NL_TEST_ASSERT(apSuite, counts.failure == 1);
+}
+
+void TestAnsweredResponseDoesNotExpire(nlTestSuite * apSuite, void * apContext)
+{
+    CHIPDeviceCallbacksMgr & mgr = CHIPDeviceCallbacksMgr::GetInstance();
+    CallCounts counts;
+    Callback::Callback<SuccessFn> onSuccess(OnSuccess, &counts);
+    Callback::Callback<CHIPDeviceCallbacksMgr::ResponseFailureFn> onFailure(OnFailure, &counts);
+    Callback::Cancelable * successCallback = nullptr;
+    Callback::Cancelable * failureCallback = nullptr;
+
+    NL_TEST_ASSERT(apSuite,
+                   mgr.AddResponseCallback(kTestNodeId, 2, onSuccess.Cancel(), onFailure.Cancel(), kShortTimeoutMs) ==
+                       CHIP_NO_ERROR);
+
+    // The response arrives before the deadline.
+    NL_TEST_ASSERT(apSuite, mgr.GetResponseCallback(kTestNodeId, 2, &successCallback, &failureCallback) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, successCallback == onSuccess.Cancel());
+    NL_TEST_ASSERT(apSuite, failureCallback == onFailure.Cancel());
+
+    mgr.ExpireResponseCallbacks(AfterShortTimeout());
+    NL_TEST_ASSERT(apSuite, counts.failure == 0);
+}
+
+void TestReregisteredResponse(nlTestSuite * apSuite, void * apContext)
+{
+    CHIPDeviceCallbacksMgr & mgr = CHIPDeviceCallbacksMgr::GetInstance();
+    CallCounts staleCounts;
+    CallCounts counts;
+    Callback::Callback<SuccessFn> onStaleSuccess(OnSuccess, &staleCounts);
+    Callback::Callback<CHIPDeviceCallbacksMgr::ResponseFailureFn> onStaleFailure(OnFailure, &staleCounts);
+    Callback::Callback<SuccessFn> onSuccess(OnSuccess, &counts);
+    Callback::Callback<CHIPDeviceCallbacksMgr::ResponseFailureFn> onFailure(OnFailure, &counts);
+    Callback::Cancelable * successCallback = nullptr;
+    Callback::Cancelable * failureCallback = nullptr;
+
+    NL_TEST_ASSERT(apSuite,
+                   mgr.AddResponseCallback(kTestNodeId, 3, onStaleSuccess.Cancel(), onStaleFailure.Cancel(), kShortTimeoutMs) ==
+                       CHIP_NO_ERROR);
+
+    // Registering the same node and sequence number again replaces the callbacks and their deadline.
+    NL_TEST_ASSERT(apSuite,
+                   mgr.AddResponseCallback(kTestNodeId, 3, onSuccess.Cancel(), onFailure.Cancel(), kLongTimeoutMs) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !onStaleSuccess.IsRegistered());
+    NL_TEST_ASSERT(apSuite, !onStaleFailure.IsRegistered());
+
+    // The deadline left in the queue by the first registration must not expire the second one.
+    mgr.ExpireResponseCallbacks(AfterShortTimeout());
+    NL_TEST_ASSERT(apSuite, staleCounts.failure == 0);
+    NL_TEST_ASSERT(apSuite, counts.failure == 0);
+    NL_TEST_ASSERT(apSuite, onSuccess.IsRegistered());
+    NL_TEST_ASSERT(apSuite, onFailure.IsRegistered());
+
+    NL_TEST_ASSERT(apSuite, mgr.GetResponseCallback(kTestNodeId, 3, &successCallback, &failureCallback) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, successCallback == onSuccess.Cancel());
+    NL_TEST_ASSERT(apSuite, failureCallback == onFailure.Cancel());
+
+    // Drop the deadline of the second registration so that it does not outlive this test.
+    mgr.ExpireResponseCallbacks(System::Timer::GetCurrentEpoch() + kLongTimeoutMs + kExpiryAdvanceMs);
+    NL_TEST_ASSERT(apSuite, counts.failure == 0);
+}
+
+} // namespace TestDeviceCallbacksMgr
+} // namespace app
+} // namespace chip
+
+namespace {
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestExpiredResponseFails", chip::app::TestDeviceCallbacksMgr::TestExpiredResponseFails),
+    NL_TEST_DEF("TestAnsweredResponseDoesNotExpire", chip::app::TestDeviceCallbacksMgr::TestAnsweredResponseDoesNotExpire),
+    NL_TEST_DEF("TestReregisteredResponse", chip::app::TestDeviceCallbacksMgr::TestReregisteredResponse),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+} // namespace
+
+int TestDeviceCallbacksMgr()
+{
+    nlTestSuite theSuite = { "DeviceCallbacksMgr", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDeviceCallbacksMgr)
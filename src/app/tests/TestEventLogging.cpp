@@ -0,0 +1,374 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the event store of the CHIP Interaction Model
+ *
+ */
+
+#include <app/EventManagement.h>
+#include <app/MessageDef/EventDataElement.h>
+#include <core/CHIPTLV.h>
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+
+namespace chip {
+namespace app {
+namespace {
+constexpr NodeId kTestNodeId         = 1;
+constexpr EndpointId kTestEndpointId = 1;
+constexpr ClusterId kTestClusterId1  = 6;
+constexpr ClusterId kTestClusterId2  = 8;
+constexpr EventId kTestEventId1      = 1;
+constexpr EventId kTestEventId2      = 2;
+constexpr uint8_t kTestValueTag      = 1;
+constexpr uint32_t kTestBufferSize   = 256;
+constexpr uint32_t kTestSmallBuffer  = 100;
+constexpr size_t kTestLargePayload   = 300;
+constexpr size_t kTestMaxNumExpected = 16;
+constexpr size_t kTestNumChunkEvents = 4;
+constexpr uint32_t kTestChunkSize    = 100;
+
+class TestEventGenerator : public EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        if (mPayloadSize > 0)
+        {
+            uint8_t payload[kTestLargePayload] = { 0 };
+            return aWriter.PutBytes(TLV::ContextTag(kTestValueTag), payload, static_cast<uint32_t>(mPayloadSize));
+        }
+        return aWriter.Put(TLV::ContextTag(kTestValueTag), mValue);
+    }
+
+    uint32_t mValue     = 0;
+    size_t mPayloadSize = 0;
+};
+
+CHIP_ERROR LogTestEvent(ClusterId aClusterId, EventId aEventId, PriorityLevel aPriority, uint32_t aValue,
+                        EventNumber & aEventNumber)
+{
+    TestEventGenerator generator;
+    EventOptions options(EventPathParams(kTestNodeId, kTestEndpointId, aClusterId, aEventId, false), aPriority);
+    generator.mValue = aValue;
+    return EventManagement::GetInstance().LogEvent(&generator, options, aEventNumber);
+}
+
+// Fetch the events of a priority into a buffer of aBufferSize bytes, and check their numbers and values. The value of an
+// event is its number, relative to aBaseEventNumber.
+CHIP_ERROR CheckFetch(nlTestSuite * apSuite, ClusterInfo * apClusterInfoList, PriorityLevel aPriority, EventNumber & aEventNumber,
+                      EventNumber aBaseEventNumber, const EventNumber * apExpected, size_t aExpectedCount,
+                      size_t aBufferSize = kTestBufferSize)
+{
+    uint8_t buffer[kTestBufferSize];
+    TLV::TLVWriter writer;
+    TLV::TLVReader reader;
+    size_t eventCount = 0;
+    size_t index      = 0;
+
+    writer.Init(buffer, static_cast<uint32_t>(aBufferSize));
+    CHIP_ERROR fetchErr = EventManagement::GetInstance().FetchEventsSince(writer, apClusterInfoList, aPriority, aEventNumber,
+                                                                          eventCount, 0);
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventCount == aExpectedCount);
+
+    reader.Init(buffer, writer.GetLengthWritten());
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        EventDataElement::Parser event;
+        TLV::TLVReader dataReader;
+        TLV::TLVType dataContainerType;
+        EventNumber eventNumber = 0;
+        uint8_t priority        = 0;
+        uint32_t value          = 0;
+
+        NL_TEST_ASSERT(apSuite, index < aExpectedCount);
+        NL_TEST_ASSERT(apSuite, event.Init(reader) == CHIP_NO_ERROR);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+        NL_TEST_ASSERT(apSuite, event.CheckSchemaValidity() == CHIP_NO_ERROR);
+#endif
+        NL_TEST_ASSERT(apSuite, event.GetNumber(&eventNumber) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, event.GetPriorityLevel(&priority) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, priority == static_cast<uint8_t>(aPriority));
+        NL_TEST_ASSERT(apSuite, event.GetData(&dataReader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, dataReader.EnterContainer(dataContainerType) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, dataReader.Next() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, dataReader.Get(value) == CHIP_NO_ERROR);
+        if (index < aExpectedCount)
+        {
+            NL_TEST_ASSERT(apSuite, eventNumber == aBaseEventNumber + apExpected[index]);
+            NL_TEST_ASSERT(apSuite, value == apExpected[index]);
+        }
+        index++;
+    }
+    NL_TEST_ASSERT(apSuite, index == aExpectedCount);
+    return fetchErr;
+}
+
+CHIP_ERROR CountEviction(TLV::CHIPCircularTLVBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader)
+{
+    (*static_cast<size_t *>(apAppData))++;
+    return CHIP_NO_ERROR;
+}
+} // namespace
+
+namespace TestEventLogging {
+void TestInit(nlTestSuite * apSuite, void * apContext)
+{
+    uint8_t storage1[kTestBufferSize];
+    uint8_t storage2[kTestBufferSize];
+    CircularEventBuffer buffers[] = { CircularEventBuffer(storage1, sizeof(storage1), PriorityLevel::Info),
+                                      CircularEventBuffer(storage2, sizeof(storage2), PriorityLevel::Info) };
+    EventNumber eventNumber       = 0;
+
+    NL_TEST_ASSERT(apSuite, EventManagement::GetInstance().Init(buffers, ArraySize(buffers)) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite, EventManagement::GetInstance().Init(buffers, 1) == CHIP_NO_ERROR);
+
+    // There is no buffer for the critical events.
+    NL_TEST_ASSERT(apSuite,
+                   LogTestEvent(kTestClusterId1, kTestEventId1, PriorityLevel::Critical, 0, eventNumber) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite, !EventManagement::GetInstance().HasEventsSince(PriorityLevel::Critical, 0));
+    NL_TEST_ASSERT(apSuite, !EventManagement::GetInstance().HasEventsSince(PriorityLevel::Info, 0));
+
+    EventManagement::GetInstance().Shutdown();
+}
+
+void TestLogAndFetch(nlTestSuite * apSuite, void * apContext)
+{
+    uint8_t debugStorage[kTestBufferSize];
+    uint8_t infoStorage[kTestBufferSize];
+    uint8_t criticalStorage[kTestBufferSize];
+    CircularEventBuffer buffers[] = { CircularEventBuffer(debugStorage, sizeof(debugStorage), PriorityLevel::Debug),
+                                      CircularEventBuffer(infoStorage, sizeof(infoStorage), PriorityLevel::Info),
+                                      CircularEventBuffer(criticalStorage, sizeof(criticalStorage), PriorityLevel::Critical) };
+    EventManagement & eventManagement = EventManagement::GetInstance();
+    EventNumber base                  = eventManagement.GetNextEventNumber();
+    EventNumber eventNumber           = 0;
+    EventNumber cursor                = base;
+    ClusterInfo clusterInfo;
+
+    NL_TEST_ASSERT(apSuite, eventManagement.Init(buffers, ArraySize(buffers)) == CHIP_NO_ERROR);
+
+    // Event numbers are shared by all the priorities.
+    NL_TEST_ASSERT(apSuite, LogTestEvent(kTestClusterId1, kTestEventId1, PriorityLevel::Info, 0, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventNumber == base);
+    NL_TEST_ASSERT(apSuite,
+                   LogTestEvent(kTestClusterId1, kTestEventId2, PriorityLevel::Critical, 1, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, LogTestEvent(kTestClusterId2, kTestEventId1, PriorityLevel::Info, 2, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, LogTestEvent(kTestClusterId1, kTestEventId1, PriorityLevel::Debug, 3, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, LogTestEvent(kTestClusterId1, kTestEventId2, PriorityLevel::Info, 4, eventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventNumber == base + 4);
+
+    // */6/* selects the events of cluster 6 only.
+    clusterInfo.mEventPathParams.mClusterId = kTestClusterId1;
+    clusterInfo.mEventPathParams.mFlags.Set(EventPathFlags::kEndpointIdWildcard).Set(EventPathFlags::kEventIdWildcard);
+    {
+        const EventNumber expected[] = { 0, 4 };
+        NL_TEST_ASSERT(apSuite,
+                       CheckFetch(apSuite, &clusterInfo, PriorityLevel::Info, cursor, base, expected, ArraySize(expected)) ==
+                           CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, cursor == base + 5);
+    }
+    {
+        const EventNumber expected[] = { 1 };
+        EventNumber criticalCursor   = base;
+        NL_TEST_ASSERT(apSuite,
+                       CheckFetch(apSuite, &clusterInfo, PriorityLevel::Critical, criticalCursor, base, expected,
+                                  ArraySize(expected)) == CHIP_NO_ERROR);
+    }
+
+    // The events are not fetched again.
+    NL_TEST_ASSERT(apSuite, !eventManagement.HasEventsSince(PriorityLevel::Info, cursor));
+    NL_TEST_ASSERT(apSuite, CheckFetch(apSuite, &clusterInfo, PriorityLevel::Info, cursor, base, nullptr, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cursor == base + 5);
+
+    // 1/6/2 selects a single event id, and events are fetched from any number.
+    clusterInfo.mEventPathParams.mEndpointId = kTestEndpointId;
+    clusterInfo.mEventPathParams.mEventId    = kTestEventId2;
+    clusterInfo.mEventPathParams.mFlags.ClearAll();
+    cursor = base + 2;
+    {
+        const EventNumber expected[] = { 4 };
+        NL_TEST_ASSERT(apSuite,
+                       CheckFetch(apSuite, &clusterInfo, PriorityLevel::Info, cursor, base, expected, ArraySize(expected)) ==
+                           CHIP_NO_ERROR);
+    }
+
+    eventManagement.Shutdown();
+}
+
+void TestEviction(nlTestSuite * apSuite, void * apContext)
+{
+    uint8_t infoStorage[kTestSmallBuffer];
+    uint8_t criticalStorage[kTestSmallBuffer];
+    CircularEventBuffer buffers[] = { CircularEventBuffer(infoStorage, sizeof(infoStorage), PriorityLevel::Info),
+                                      CircularEventBuffer(criticalStorage, sizeof(criticalStorage), PriorityLevel::Critical) };
+    EventManagement & eventManagement = EventManagement::GetInstance();
+    EventNumber base                  = eventManagement.GetNextEventNumber();
+    EventNumber eventNumber           = 0;
+    EventNumber cursor                = base;
+    size_t numRemaining               = 0;
+    size_t numEvicted                 = 0;
+    ClusterInfo clusterInfo;
+    EventNumber expected[kTestMaxNumExpected];
+
+    NL_TEST_ASSERT(apSuite, eventManagement.Init(buffers, ArraySize(buffers)) == CHIP_NO_ERROR);
+    buffers[0].mProcessEvictedElement = CountEviction;
+    buffers[0].mAppData               = &numEvicted;
+    clusterInfo.mEventPathParams.mClusterId = kTestClusterId1;
+    clusterInfo.mEventPathParams.mFlags.Set(EventPathFlags::kEndpointIdWildcard).Set(EventPathFlags::kEventIdWildcard);
+
+    // A burst of info events evicts the oldest ones, but not the critical event.
+    NL_TEST_ASSERT(apSuite,
+                   LogTestEvent(kTestClusterId1, kTestEventId1, PriorityLevel::Critical, 0, eventNumber) == CHIP_NO_ERROR);
+    for (uint32_t value = 1; value < kTestMaxNumExpected; value++)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       LogTestEvent(kTestClusterId1, kTestEventId1, PriorityLevel::Info, value, eventNumber) == CHIP_NO_ERROR);
+    }
+
+    // The newest events are kept, in order.
+    {
+        uint8_t buffer[kTestBufferSize];
+        TLV::TLVWriter writer;
+        size_t eventCount = 0;
+        writer.Init(buffer, sizeof(buffer));
+        NL_TEST_ASSERT(apSuite,
+                       eventManagement.FetchEventsSince(writer, &clusterInfo, PriorityLevel::Info, cursor, eventCount, 0) ==
+                           CHIP_NO_ERROR);
+        numRemaining = eventCount;
+    }
+    NL_TEST_ASSERT(apSuite, numRemaining > 0 && numRemaining < kTestMaxNumExpected - 1);
+    // The callback of the application sees every evicted event, and stays installed.
+    NL_TEST_ASSERT(apSuite, numEvicted == kTestMaxNumExpected - 1 - numRemaining);
+    NL_TEST_ASSERT(apSuite, buffers[0].mProcessEvictedElement == CountEviction);
+    for (size_t index = 0; index < numRemaining; index++)
+    {
+        expected[index] = kTestMaxNumExpected - numRemaining + index;
+    }
+    cursor = base;
+    NL_TEST_ASSERT(apSuite,
+                   CheckFetch(apSuite, &clusterInfo, PriorityLevel::Info, cursor, base, expected, numRemaining) == CHIP_NO_ERROR);
+
+    cursor      = base;
+    expected[0] = 0;
+    NL_TEST_ASSERT(apSuite, CheckFetch(apSuite, &clusterInfo, PriorityLevel::Critical, cursor, base, expected, 1) == CHIP_NO_ERROR);
+
+    eventManagement.Shutdown();
+}
+
+void TestEventTooLarge(nlTestSuite * apSuite, void * apContext)
+{
+    uint8_t infoStorage[kTestSmallBuffer];
+    CircularEventBuffer buffer(infoStorage, sizeof(infoStorage), PriorityLevel::Info);
+    EventManagement & eventManagement = EventManagement::GetInstance();
+    EventNumber base                  = eventManagement.GetNextEventNumber();
+    EventNumber eventNumber           = 0;
+    EventNumber cursor                = base;
+    TestEventGenerator generator;
+    EventOptions options(EventPathParams(kTestNodeId, kTestEndpointId, kTestClusterId1, kTestEventId1, false), PriorityLevel::Info);
+    ClusterInfo clusterInfo;
+    const EventNumber expected[] = { 0 };
+
+    NL_TEST_ASSERT(apSuite, eventManagement.Init(&buffer, 1) == CHIP_NO_ERROR);
+    clusterInfo.mEventPathParams.mClusterId = kTestClusterId1;
+    clusterInfo.mEventPathParams.mFlags.Set(EventPathFlags::kEndpointIdWildcard).Set(EventPathFlags::kEventIdWildcard);
+
+    NL_TEST_ASSERT(apSuite, LogTestEvent(kTestClusterId1, kTestEventId1, PriorityLevel::Info, 0, eventNumber) == CHIP_NO_ERROR);
+
+    // An event larger than the buffer is dropped, without evicting the events of the buffer or using an event number.
+    generator.mPayloadSize = kTestLargePayload;
+    NL_TEST_ASSERT(apSuite, eventManagement.LogEvent(&generator, options, eventNumber) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(apSuite, eventManagement.GetNextEventNumber() == base + 1);
+    NL_TEST_ASSERT(apSuite,
+                   CheckFetch(apSuite, &clusterInfo, PriorityLevel::Info, cursor, base, expected, ArraySize(expected)) ==
+                       CHIP_NO_ERROR);
+
+    eventManagement.Shutdown();
+}
+
+void TestFetchChunks(nlTestSuite * apSuite, void * apContext)
+{
+    uint8_t infoStorage[kTestBufferSize];
+    CircularEventBuffer buffer(infoStorage, sizeof(infoStorage), PriorityLevel::Info);
+    EventManagement & eventManagement = EventManagement::GetInstance();
+    EventNumber base                  = eventManagement.GetNextEventNumber();
+    EventNumber eventNumber           = 0;
+    EventNumber cursor                = base;
+    EventNumber numFetched            = 0;
+    size_t numChunks                  = 0;
+    CHIP_ERROR err                    = CHIP_NO_ERROR;
+    ClusterInfo clusterInfo;
+
+    NL_TEST_ASSERT(apSuite, eventManagement.Init(&buffer, 1) == CHIP_NO_ERROR);
+    clusterInfo.mEventPathParams.mClusterId = kTestClusterId1;
+    clusterInfo.mEventPathParams.mFlags.Set(EventPathFlags::kEndpointIdWildcard).Set(EventPathFlags::kEventIdWildcard);
+    for (uint32_t value = 0; value < kTestNumChunkEvents; value++)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       LogTestEvent(kTestClusterId1, kTestEventId1, PriorityLevel::Info, value, eventNumber) == CHIP_NO_ERROR);
+    }
+
+    // Each fetch resumes at the first event that did not fit in the previous one.
+    do
+    {
+        uint8_t chunk[kTestBufferSize];
+        TLV::TLVWriter writer;
+        size_t eventCount = 0;
+        writer.Init(chunk, kTestChunkSize);
+        err = eventManagement.FetchEventsSince(writer, &clusterInfo, PriorityLevel::Info, cursor, eventCount, 0);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR || err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY);
+        NL_TEST_ASSERT(apSuite, eventCount > 0);
+        numFetched += eventCount;
+        NL_TEST_ASSERT(apSuite, cursor == base + numFetched);
+        numChunks++;
+    } while (err != CHIP_NO_ERROR && numChunks < kTestNumChunkEvents);
+
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, numChunks > 1);
+    NL_TEST_ASSERT(apSuite, numFetched == kTestNumChunkEvents);
+
+    eventManagement.Shutdown();
+}
+} // namespace TestEventLogging
+} // namespace app
+} // namespace chip
+
+namespace {
+const nlTest sTests[] = { NL_TEST_DEF("TestInit", chip::app::TestEventLogging::TestInit),
+                          NL_TEST_DEF("TestLogAndFetch", chip::app::TestEventLogging::TestLogAndFetch),
+                          NL_TEST_DEF("TestEviction", chip::app::TestEventLogging::TestEviction),
+                          NL_TEST_DEF("TestEventTooLarge", chip::app::TestEventLogging::TestEventTooLarge),
+                          NL_TEST_DEF("TestFetchChunks", chip::app::TestEventLogging::TestFetchChunks),
+                          NL_TEST_SENTINEL() };
+}
+
+int TestEventLogging()
+{
+    nlTestSuite theSuite = { "EventLogging", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestEventLogging)
@@ -63,6 +63,20 @@ void TestDifferentEventId(nlTestSuite * apSuite, void * apContext)
     EventPathParams eventPathParams2(1, 2, 3, 6, false);
     NL_TEST_ASSERT(apSuite, !eventPathParams1.IsSamePath(eventPathParams2));
 }
+void TestContains(nlTestSuite * apSuite, void * apContext)
+{
+    EventPathParams eventPathParams1(1, 2, 3, 4, false);
+    EventPathParams eventPathParams2(1, 2, 3, 4, false);
+    EventPathParams eventPathParams3(1, 5, 3, 6, false);
+    NL_TEST_ASSERT(apSuite, eventPathParams1.Contains(eventPathParams2));
+    NL_TEST_ASSERT(apSuite, !eventPathParams1.Contains(eventPathParams3));
+
+    // Wildcards select any endpoint and event of the cluster, but not other clusters.
+    eventPathParams1.mFlags.Set(EventPathFlags::kEndpointIdWildcard).Set(EventPathFlags::kEventIdWildcard);
+    NL_TEST_ASSERT(apSuite, eventPathParams1.Contains(eventPathParams3));
+    eventPathParams3.mClusterId = 7;
+    NL_TEST_ASSERT(apSuite, !eventPathParams1.Contains(eventPathParams3));
+}
 } // namespace TestEventPathParams
 } // namespace app
 } // namespace chip
@@ -73,6 +87,7 @@ const nlTest sTests[] = { NL_TEST_DEF("TestSamePath", chip::app::TestEventPathPa
                           NL_TEST_DEF("TestDifferentEndpointId", chip::app::TestEventPathParams::TestDifferentEndpointId),
                           NL_TEST_DEF("TestDifferentClusterId", chip::app::TestEventPathParams::TestDifferentClusterId),
                           NL_TEST_DEF("TestDifferentEventId", chip::app::TestEventPathParams::TestDifferentEventId),
+                          NL_TEST_DEF("TestContains", chip::app::TestEventPathParams::TestContains),
                           NL_TEST_SENTINEL() };
 }
 
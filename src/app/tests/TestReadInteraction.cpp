@@ -48,15 +48,46 @@ Messaging::ExchangeManager gExchangeManager;
 TransportMgr<Transport::UDP> gTransportManager;
 const Transport::AdminId gAdminId = 0;
 
+constexpr ClusterId kTestClusterId   = 6;
+constexpr EndpointId kTestEndpointId = 1;
+
 namespace app {
+class TestReadDelegate : public InteractionModelDelegate
+{
+public:
+    CHIP_ERROR AttributeDataReceived(const ReadClient * apReadClient, const AttributePathParams & aAttributePathParams,
+                                     TLV::TLVReader & aReader) override
+    {
+        TLV::TLVType containerType;
+        uint8_t value;
+
+        // The reader is positioned on the data of the attribute.
+        ReturnErrorOnFailure(aReader.EnterContainer(containerType));
+        ReturnErrorOnFailure(aReader.Next());
+        ReturnErrorOnFailure(aReader.Get(value));
+        VerifyOrReturnError(aAttributePathParams.mClusterId == kTestClusterId, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(aAttributePathParams.mEndpointId == kTestEndpointId, CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(value == aAttributePathParams.mFieldId, CHIP_ERROR_INVALID_ARGUMENT);
+
+        mNumAttributes++;
+        return aReader.ExitContainer(containerType);
+    }
+
+    uint16_t mNumAttributes = 0;
+};
+
 class TestReadInteraction
 {
 public:
     static void TestReadClient(nlTestSuite * apSuite, void * apContext);
+    static void TestReadClientAttributeData(nlTestSuite * apSuite, void * apContext);
+    static void TestReadClientPerSessionLimit(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandler(nlTestSuite * apSuite, void * apContext);
 
 private:
     static void GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload);
+    static void GenerateAttributeReportData(nlTestSuite * apSuite, System::PacketBufferHandle & aPayload, FieldId aFirstFieldId,
+                                            uint8_t aNumFields, bool aMoreChunkedMessages);
 };
 
 void TestReadInteraction::GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload)
@@ -83,6 +114,59 @@ void TestReadInteraction::GenerateReportData(nlTestSuite * apSuite, void * apCon
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 }
 
+void TestReadInteraction::GenerateAttributeReportData(nlTestSuite * apSuite, System::PacketBufferHandle & aPayload,
+                                                      FieldId aFirstFieldId, uint8_t aNumFields, bool aMoreChunkedMessages)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    writer.Init(std::move(aPayload));
+
+    ReportData::Builder reportDataBuilder;
+
+    err = reportDataBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    AttributeDataList::Builder attributeDataListBuilder = reportDataBuilder.CreateAttributeDataListBuilder();
+    NL_TEST_ASSERT(apSuite, attributeDataListBuilder.GetError() == CHIP_NO_ERROR);
+
+    for (uint8_t i = 0; i < aNumFields; i++)
+    {
+        FieldId fieldId                                           = static_cast<FieldId>(aFirstFieldId + i);
+        TLV::TLVType containerType                                = TLV::kTLVType_NotSpecified;
+        AttributeDataElement::Builder attributeDataElementBuilder = attributeDataListBuilder.CreateAttributeDataElementBuilder();
+        AttributePath::Builder attributePathBuilder               = attributeDataElementBuilder.CreateAttributePathBuilder();
+        attributePathBuilder.NodeId(kTestDeviceNodeId)
+            .EndpointId(kTestEndpointId)
+            .ClusterId(kTestClusterId)
+            .FieldId(fieldId)
+            .EndOfAttributePath();
+        NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+
+        TLV::TLVWriter * pWriter = attributeDataElementBuilder.GetWriter();
+        err = pWriter->StartContainer(TLV::ContextTag(AttributeDataElement::kCsTag_Data), TLV::kTLVType_Structure, containerType);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = pWriter->Put(TLV::ContextTag(fieldId), fieldId);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = pWriter->EndContainer(containerType);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        attributeDataElementBuilder.DataVersion(0).MoreClusterData(false).EndOfAttributeDataElement();
+        NL_TEST_ASSERT(apSuite, attributeDataElementBuilder.GetError() == CHIP_NO_ERROR);
+    }
+
+    attributeDataListBuilder.EndOfAttributeDataList();
+    NL_TEST_ASSERT(apSuite, attributeDataListBuilder.GetError() == CHIP_NO_ERROR);
+
+    reportDataBuilder.MoreChunkedMessages(aMoreChunkedMessages);
+    NL_TEST_ASSERT(apSuite, reportDataBuilder.GetError() == CHIP_NO_ERROR);
+
+    reportDataBuilder.EndOfReportData();
+    NL_TEST_ASSERT(apSuite, reportDataBuilder.GetError() == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&aPayload);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
 void TestReadInteraction::TestReadClient(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -105,6 +189,73 @@ void TestReadInteraction::TestReadClient(nlTestSuite * apSuite, void * apContext
     readClient.Shutdown();
 }
 
+void TestReadInteraction::TestReadClientAttributeData(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    app::ReadClient readClient;
+    TestReadDelegate delegate;
+    System::PacketBufferHandle buf;
+
+    err = readClient.Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // Each chunk of a report is handed to the delegate as it comes.
+    buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateAttributeReportData(apSuite, buf, 0, 3, true);
+    err = readClient.ProcessReportData(std::move(buf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, readClient.mMoreChunkedMessages);
+    NL_TEST_ASSERT(apSuite, delegate.mNumAttributes == 3);
+
+    buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateAttributeReportData(apSuite, buf, 3, 2, false);
+    err = readClient.ProcessReportData(std::move(buf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !readClient.mMoreChunkedMessages);
+    NL_TEST_ASSERT(apSuite, delegate.mNumAttributes == 5);
+
+    readClient.Shutdown();
+}
+
+void TestReadInteraction::TestReadClientPerSessionLimit(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TestReadDelegate delegate;
+    ReadClient * readClients[CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION + 1];
+
+    err = InteractionModelEngine::GetInstance()->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    for (auto & readClient : readClients)
+    {
+        err = InteractionModelEngine::GetInstance()->NewReadClient(&readClient);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+
+    // Reads outstanding with the peer, each on its own read client.
+    for (uint16_t i = 0; i < CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION; i++)
+    {
+        readClients[i]->mPeerNodeId = kTestDeviceNodeId;
+        readClients[i]->mAdminId    = gAdminId;
+        readClients[i]->MoveToState(ReadClient::ClientState::AwaitingResponse);
+    }
+    NL_TEST_ASSERT(apSuite,
+                   InteractionModelEngine::GetInstance()->GetNumReadClientsAwaitingResponse(kTestDeviceNodeId, gAdminId) ==
+                       CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION);
+    NL_TEST_ASSERT(apSuite,
+                   InteractionModelEngine::GetInstance()->GetNumReadClientsAwaitingResponse(kTestDeviceNodeId + 1, gAdminId) == 0);
+
+    err = readClients[CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION]->SendReadRequest(kTestDeviceNodeId, gAdminId, nullptr, 0,
+                                                                                    nullptr, 0);
+    NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_RATE_LIMIT_EXCEEDED);
+
+    InteractionModelEngine::GetInstance()->Shutdown();
+    for (auto & readClient : readClients)
+    {
+        NL_TEST_ASSERT(apSuite, readClient->IsFree());
+    }
+}
+
 void TestReadInteraction::TestReadHandler(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -170,6 +321,8 @@ void InitializeChip(nlTestSuite * apSuite)
 const nlTest sTests[] =
 {
     NL_TEST_DEF("CheckReadClient", chip::app::TestReadInteraction::TestReadClient),
+    NL_TEST_DEF("CheckReadClientAttributeData", chip::app::TestReadInteraction::TestReadClientAttributeData),
+    NL_TEST_DEF("CheckReadClientPerSessionLimit", chip::app::TestReadInteraction::TestReadClientPerSessionLimit),
     NL_TEST_DEF("CheckReadHandler", chip::app::TestReadInteraction::TestReadHandler),
     NL_TEST_SENTINEL()
 };
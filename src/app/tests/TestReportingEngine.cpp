@@ -22,6 +22,7 @@
  *
  */
 
+#include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/Engine.h>
 #include <core/CHIPCore.h>
@@ -47,13 +48,19 @@ static System::Layer gSystemLayer;
 static SecureSessionMgr gSessionManager;
 static Messaging::ExchangeManager gExchangeManager;
 static TransportMgr<Transport::UDP> gTransportManager;
-static const Transport::AdminId gAdminId = 0;
-constexpr ClusterId kTestClusterId       = 6;
-constexpr EndpointId kTestEndpointId     = 1;
-constexpr chip::FieldId kTestFieldId1    = 1;
-constexpr chip::FieldId kTestFieldId2    = 2;
-constexpr uint8_t kTestFieldValue1       = 1;
-constexpr uint8_t kTestFieldValue2       = 2;
+static const Transport::AdminId gAdminId  = 0;
+constexpr ClusterId kTestClusterId        = 6;
+constexpr EndpointId kTestEndpointId      = 1;
+constexpr chip::FieldId kTestFieldId1     = 1;
+constexpr chip::FieldId kTestFieldId2     = 2;
+constexpr chip::FieldId kTestLargeFieldId = 3;
+constexpr uint8_t kTestFieldValue1        = 1;
+constexpr uint8_t kTestFieldValue2        = 2;
+constexpr size_t kTestLargeFieldSize      = 200;
+constexpr size_t kTestNumLargeFields      = 6;
+constexpr ClusterId kTestOtherClusterId   = 8;
+constexpr EventId kTestEventId            = 1;
+constexpr uint32_t kTestEventBufferSize   = 2048;
 
 namespace app {
 CHIP_ERROR ReadSingleClusterData(AttributePathParams & aAttributePathParams, TLV::TLVWriter & aWriter)
@@ -72,6 +79,12 @@ CHIP_ERROR ReadSingleClusterData(AttributePathParams & aAttributePathParams, TLV
         err = aWriter.Put(TLV::ContextTag(kTestFieldId2), kTestFieldValue2);
         SuccessOrExit(err);
     }
+    if (aAttributePathParams.mFieldId == kTestLargeFieldId)
+    {
+        uint8_t value[kTestLargeFieldSize] = { 0 };
+        err                                = aWriter.PutBytes(TLV::ContextTag(kTestLargeFieldId), value, sizeof(value));
+        SuccessOrExit(err);
+    }
 
 exit:
     ChipLogFunctError(err);
@@ -83,6 +96,17 @@ class TestReportingEngine
 {
 public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
+    static void TestChunkedReportData(nlTestSuite * apSuite, void * apContext);
+    static void TestEventReportData(nlTestSuite * apSuite, void * apContext);
+};
+
+class TestEventGenerator : public EventLoggingDelegate
+{
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        uint8_t value[kTestLargeFieldSize] = { 0 };
+        return aWriter.PutBytes(TLV::ContextTag(kTestLargeFieldId), value, sizeof(value));
+    }
 };
 
 class TestExchangeDelegate : public Messaging::ExchangeDelegate
@@ -134,6 +158,223 @@ void TestReportingEngine::TestBuildAndSendSingleReportData(nlTestSuite * apSuite
     err = reportingEngine.BuildAndSendSingleReportData(&readHandler);
     NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_NOT_CONNECTED);
 }
+
+void TestReportingEngine::TestChunkedReportData(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    app::ReadHandler readHandler;
+    Engine reportingEngine;
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequest::Builder readRequestBuilder;
+    AttributePathList::Builder attributePathListBuilder;
+    size_t numChunks                = 0;
+    size_t numAttributeDataElements = 0;
+    TestExchangeDelegate delegate;
+
+    err = InteractionModelEngine::GetInstance()->Init(&gExchangeManager, nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    Messaging::ExchangeContext * exchangeCtx = gExchangeManager.NewContext({ 0, 0, 0 }, nullptr);
+    exchangeCtx->SetDelegate(&delegate);
+
+    // Together, the large fields do not fit in a single report.
+    writer.Init(std::move(readRequestbuf));
+    err = readRequestBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    attributePathListBuilder = readRequestBuilder.CreateAttributePathListBuilder();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    for (size_t i = 0; i < kTestNumLargeFields; i++)
+    {
+        AttributePath::Builder attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
+        attributePathBuilder.NodeId(1)
+            .EndpointId(kTestEndpointId)
+            .ClusterId(kTestClusterId)
+            .FieldId(kTestLargeFieldId)
+            .EndOfAttributePath();
+        NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+    }
+    attributePathListBuilder.EndOfAttributePathList();
+    readRequestBuilder.EndOfReadRequest();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    err = writer.Finalize(&readRequestbuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = readHandler.OnReadRequest(exchangeCtx, std::move(readRequestbuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    reportingEngine.Init();
+
+    do
+    {
+        System::PacketBufferTLVWriter reportDataWriter;
+        System::PacketBufferTLVReader reader;
+        System::PacketBufferHandle reportDataBuf = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+        ReportData::Builder reportDataBuilder;
+        ReportData::Parser reportDataParser;
+        AttributeDataList::Parser attributeDataListParser;
+        TLV::TLVReader attributeDataListReader;
+
+        reportDataWriter.Init(std::move(reportDataBuf));
+        err = reportDataBuilder.Init(&reportDataWriter);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = reportingEngine.BuildSingleReportDataAttributeDataList(reportDataBuilder, &readHandler);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        if (reportingEngine.mMoreChunkedMessages)
+        {
+            reportDataBuilder.MoreChunkedMessages(true);
+        }
+        reportDataBuilder.EndOfReportData();
+        NL_TEST_ASSERT(apSuite, reportDataBuilder.GetError() == CHIP_NO_ERROR);
+        err = reportDataWriter.Finalize(&reportDataBuf);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        numChunks++;
+
+        reader.Init(std::move(reportDataBuf));
+        err = reader.Next();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = reportDataParser.Init(reader);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+        err = reportDataParser.CheckSchemaValidity();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#endif
+        err = reportDataParser.GetAttributeDataList(&attributeDataListParser);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        attributeDataListParser.GetReader(&attributeDataListReader);
+        while (attributeDataListReader.Next() == CHIP_NO_ERROR)
+        {
+            numAttributeDataElements++;
+        }
+    } while (reportingEngine.mMoreChunkedMessages && numChunks < kTestNumLargeFields);
+
+    NL_TEST_ASSERT(apSuite, numChunks > 1);
+    NL_TEST_ASSERT(apSuite, numAttributeDataElements == kTestNumLargeFields);
+    NL_TEST_ASSERT(apSuite, !readHandler.GetCluterInfolist()->IsDirty());
+
+    readHandler.Shutdown();
+    InteractionModelEngine::GetInstance()->Shutdown();
+}
+
+void TestReportingEngine::TestEventReportData(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    app::ReadHandler readHandler;
+    Engine reportingEngine;
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequest::Builder readRequestBuilder;
+    EventPathList::Builder eventPathListBuilder;
+    EventPath::Builder eventPathBuilder;
+    uint8_t eventStorage[kTestEventBufferSize];
+    CircularEventBuffer eventBuffer(eventStorage, sizeof(eventStorage), PriorityLevel::Info);
+    TestEventGenerator generator;
+    EventNumber eventNumber     = 0;
+    size_t numChunks            = 0;
+    size_t numEventDataElements = 0;
+    TestExchangeDelegate delegate;
+
+    err = InteractionModelEngine::GetInstance()->Init(&gExchangeManager, nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    Messaging::ExchangeContext * exchangeCtx = gExchangeManager.NewContext({ 0, 0, 0 }, nullptr);
+    exchangeCtx->SetDelegate(&delegate);
+
+    // Together, the large events do not fit in a single report. The event of the other cluster is not selected.
+    err = EventManagement::GetInstance().Init(&eventBuffer, 1);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    for (size_t i = 0; i < kTestNumLargeFields; i++)
+    {
+        EventOptions options(EventPathParams(1, kTestEndpointId, kTestClusterId, kTestEventId, false), PriorityLevel::Info);
+        err = EventManagement::GetInstance().LogEvent(&generator, options, eventNumber);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    {
+        EventOptions options(EventPathParams(1, kTestEndpointId, kTestOtherClusterId, kTestEventId, false), PriorityLevel::Info);
+        err = EventManagement::GetInstance().LogEvent(&generator, options, eventNumber);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+
+    // Any endpoint and event of the test cluster.
+    writer.Init(std::move(readRequestbuf));
+    err = readRequestBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    eventPathListBuilder = readRequestBuilder.CreateEventPathListBuilder();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    eventPathBuilder = eventPathListBuilder.CreateEventPathBuilder();
+    NL_TEST_ASSERT(apSuite, eventPathListBuilder.GetError() == CHIP_NO_ERROR);
+    eventPathBuilder = eventPathBuilder.NodeId(1).ClusterId(kTestClusterId).EndOfEventPath();
+    NL_TEST_ASSERT(apSuite, eventPathBuilder.GetError() == CHIP_NO_ERROR);
+    eventPathListBuilder.EndOfEventPathList();
+    readRequestBuilder.EndOfReadRequest();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    err = writer.Finalize(&readRequestbuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = readHandler.OnReadRequest(exchangeCtx, std::move(readRequestbuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    reportingEngine.Init();
+
+    // The last report has no events left to send, and no event list.
+    for (bool hasEventList = true; hasEventList && numChunks <= kTestNumLargeFields; numChunks++)
+    {
+        System::PacketBufferTLVWriter reportDataWriter;
+        System::PacketBufferTLVReader reader;
+        System::PacketBufferHandle reportDataBuf = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+        ReportData::Builder reportDataBuilder;
+        ReportData::Parser reportDataParser;
+        EventList::Parser eventListParser;
+        TLV::TLVReader eventListReader;
+
+        reportDataWriter.Init(std::move(reportDataBuf));
+        err = reportDataBuilder.Init(&reportDataWriter);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = reportingEngine.BuildSingleReportDataEventList(reportDataBuilder, &readHandler);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        if (reportingEngine.mMoreChunkedMessages)
+        {
+            reportDataBuilder.MoreChunkedMessages(true);
+        }
+        reportDataBuilder.EndOfReportData();
+        NL_TEST_ASSERT(apSuite, reportDataBuilder.GetError() == CHIP_NO_ERROR);
+        err = reportDataWriter.Finalize(&reportDataBuf);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        reader.Init(std::move(reportDataBuf));
+        err = reader.Next();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = reportDataParser.Init(reader);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+        err = reportDataParser.CheckSchemaValidity();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#endif
+        err          = reportDataParser.GetEventDataList(&eventListParser);
+        hasEventList = (err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, hasEventList || (err == CHIP_END_OF_TLV && !reportingEngine.mMoreChunkedMessages));
+        if (!hasEventList)
+        {
+            continue;
+        }
+        eventListParser.GetReader(&eventListReader);
+        while (eventListReader.Next() == CHIP_NO_ERROR)
+        {
+            EventDataElement::Parser event;
+            EventPath::Parser eventPath;
+            ClusterId clusterId = 0;
+            NL_TEST_ASSERT(apSuite, event.Init(eventListReader) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, event.GetEventPath(&eventPath) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, eventPath.GetClusterId(&clusterId) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, clusterId == kTestClusterId);
+            numEventDataElements++;
+        }
+    }
+
+    NL_TEST_ASSERT(apSuite, numChunks > 2);
+    NL_TEST_ASSERT(apSuite, numEventDataElements == kTestNumLargeFields);
+    NL_TEST_ASSERT(apSuite, readHandler.GetNextEventNumber(PriorityLevel::Info) == eventNumber + 1);
+
+    readHandler.Shutdown();
+    EventManagement::GetInstance().Shutdown();
+    InteractionModelEngine::GetInstance()->Shutdown();
+}
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -164,6 +405,8 @@ void InitializeChip(nlTestSuite * apSuite)
 const nlTest sTests[] =
         {
                 NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
+                NL_TEST_DEF("CheckChunkedReportData", chip::app::reporting::TestReportingEngine::TestChunkedReportData),
+                NL_TEST_DEF("CheckEventReportData", chip::app::reporting::TestReportingEngine::TestEventReportData),
                 NL_TEST_SENTINEL()
         };
 // clang-format on
@@ -0,0 +1,334 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for CHIP Interaction Model Write Interaction
+ *
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPTLV.h>
+#include <core/CHIPTLVDebug.hpp>
+#include <core/CHIPTLVUtilities.hpp>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/Flags.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <protocols/secure_channel/PASESession.h>
+#include <support/ErrorStr.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/raw/UDP.h>
+
+#include <nlunit-test.h>
+
+namespace chip {
+System::Layer gSystemLayer;
+SecureSessionMgr gSessionManager;
+Messaging::ExchangeManager gExchangeManager;
+TransportMgr<Transport::UDP> gTransportManager;
+const Transport::AdminId gAdminId = 0;
+
+constexpr ClusterId kTestClusterId1    = 6;
+constexpr ClusterId kTestClusterId2    = 8;
+constexpr EndpointId kTestEndpointId   = 1;
+constexpr FieldId kTestFailingFieldId  = 0x55;
+constexpr uint16_t kTestAttributeCount = 10;
+
+namespace app {
+uint16_t gNumWrites = 0;
+
+CHIP_ERROR WriteSingleClusterData(AttributePathParams & aAttributePathParams, TLV::TLVReader & aReader)
+{
+    uint8_t value;
+
+    VerifyOrReturnError(aAttributePathParams.mFieldId != kTestFailingFieldId, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(aReader.Get(value));
+    VerifyOrReturnError(value == aAttributePathParams.mFieldId, CHIP_ERROR_INVALID_ARGUMENT);
+
+    gNumWrites++;
+    return CHIP_NO_ERROR;
+}
+
+class TestWriteDelegate : public InteractionModelDelegate
+{
+public:
+    CHIP_ERROR WriteResponseStatus(const WriteClient * apWriteClient,
+                                   const Protocols::SecureChannel::GeneralStatusCode aGeneralCode, const uint32_t aProtocolId,
+                                   const uint16_t aProtocolCode, AttributePathParams & aAttributePathParams,
+                                   uint16_t aAttributeIndex) override
+    {
+        if (aGeneralCode == Protocols::SecureChannel::GeneralStatusCode::kSuccess)
+        {
+            mNumSuccess++;
+        }
+        else
+        {
+            mNumFailure++;
+            mFailedFieldId = aAttributePathParams.mFieldId;
+        }
+        mLastAttributeIndex = aAttributeIndex;
+        return CHIP_NO_ERROR;
+    }
+
+    uint16_t mNumSuccess         = 0;
+    uint16_t mNumFailure         = 0;
+    uint16_t mLastAttributeIndex = 0;
+    FieldId mFailedFieldId       = 0;
+};
+
+class TestWriteInteraction
+{
+public:
+    static void TestWriteClient(nlTestSuite * apSuite, void * apContext);
+    static void TestWriteHandler(nlTestSuite * apSuite, void * apContext);
+    static void TestWriteHandlerResponseFull(nlTestSuite * apSuite, void * apContext);
+
+private:
+    static void AddAttributes(nlTestSuite * apSuite, WriteClient & aWriteClient);
+};
+
+void TestWriteInteraction::AddAttributes(nlTestSuite * apSuite, WriteClient & aWriteClient)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // Attributes of two clusters, and one that the data model refuses.
+    for (uint16_t i = 0; i < kTestAttributeCount; i++)
+    {
+        AttributePathParams attributePathParams;
+        attributePathParams.mNodeId     = kTestDeviceNodeId;
+        attributePathParams.mEndpointId = kTestEndpointId;
+        attributePathParams.mClusterId  = (i % 2) ? kTestClusterId2 : kTestClusterId1;
+        attributePathParams.mFieldId    = (i == kTestAttributeCount - 1) ? kTestFailingFieldId : static_cast<FieldId>(i);
+        attributePathParams.mFlags.Set(AttributePathFlags::kFieldIdValid);
+
+        err = aWriteClient.PrepareAttribute(attributePathParams);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        TLV::TLVWriter * writer = aWriteClient.GetAttributeDataElementTLVWriter();
+        err = writer->Put(TLV::ContextTag(AttributeDataElement::kCsTag_Data), static_cast<uint8_t>(attributePathParams.mFieldId));
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        err = aWriteClient.FinishAttribute();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, aWriteClient.GetAttributeCount() == kTestAttributeCount);
+}
+
+void TestWriteInteraction::TestWriteClient(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    app::WriteClient writeClient;
+
+    err = writeClient.Init(&gExchangeManager, nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // Nothing to send yet.
+    err = writeClient.SendWriteRequest(kTestDeviceNodeId, gAdminId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_INCORRECT_STATE);
+
+    AddAttributes(apSuite, writeClient);
+
+    writeClient.Shutdown();
+    NL_TEST_ASSERT(apSuite, writeClient.IsFree());
+}
+
+void TestWriteInteraction::TestWriteHandler(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    app::WriteClient writeClient;
+    app::WriteHandler writeHandler;
+    TestWriteDelegate delegate;
+    System::PacketBufferHandle writeRequestBuf;
+    System::PacketBufferHandle writeResponseBuf;
+
+    err = InteractionModelEngine::GetInstance()->Init(&gExchangeManager, nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = writeClient.Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    AddAttributes(apSuite, writeClient);
+    err = writeClient.FinalizeMessage(writeRequestBuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // All the attributes are applied from one request, and answered in one response.
+    gNumWrites = 0;
+    err        = writeHandler.Init(nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = writeHandler.ProcessWriteRequest(std::move(writeRequestBuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, gNumWrites == kTestAttributeCount - 1);
+    NL_TEST_ASSERT(apSuite, writeHandler.mNumAttributesWritten == kTestAttributeCount - 1);
+    err = writeHandler.FinalizeMessage(writeResponseBuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    writeHandler.Shutdown();
+
+    err = writeClient.ProcessWriteResponseMessage(std::move(writeResponseBuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, delegate.mNumSuccess == kTestAttributeCount - 1);
+    NL_TEST_ASSERT(apSuite, delegate.mNumFailure == 1);
+    NL_TEST_ASSERT(apSuite, delegate.mFailedFieldId == kTestFailingFieldId);
+    NL_TEST_ASSERT(apSuite, delegate.mLastAttributeIndex == kTestAttributeCount);
+
+    writeClient.Shutdown();
+    InteractionModelEngine::GetInstance()->Shutdown();
+}
+
+void TestWriteInteraction::TestWriteHandlerResponseFull(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    app::WriteClient writeClient;
+    app::WriteHandler writeHandler;
+    TestWriteDelegate delegate;
+    System::PacketBufferHandle writeRequestBuf;
+    System::PacketBufferHandle writeResponseBuf;
+    AttributePathParams attributePathParams;
+    uint32_t remainingLength;
+    uint16_t attributeCount = 0;
+
+    err = InteractionModelEngine::GetInstance()->Init(&gExchangeManager, nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // The largest status fits in the space the handler sets aside for one.
+    attributePathParams.mNodeId     = UINT64_MAX;
+    attributePathParams.mEndpointId = UINT8_MAX;
+    attributePathParams.mClusterId  = UINT16_MAX;
+    attributePathParams.mFieldId    = UINT8_MAX;
+    attributePathParams.mListIndex  = UINT16_MAX;
+    attributePathParams.mFlags.Set(AttributePathFlags::kFieldIdValid).Set(AttributePathFlags::kListIndexValid);
+    err = writeHandler.Init(nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    remainingLength = writeHandler.mMessageWriter.GetRemainingFreeLength();
+    err = writeHandler.AddAttributeStatusCode(attributePathParams, Protocols::SecureChannel::GeneralStatusCode::kResourceExhausted,
+                                              Protocols::SecureChannel::Id, Protocols::SecureChannel::kProtocolCodeGeneralFailure);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite,
+                   remainingLength - writeHandler.mMessageWriter.GetRemainingFreeLength() <= WriteHandler::kMaxAttributeStatusSize);
+    writeHandler.Shutdown();
+
+    // Fill a request with attributes, whose statuses do not all fit in the response.
+    err = writeClient.Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    while (writeClient.mMessageWriter.GetRemainingFreeLength() > WriteHandler::kMaxAttributeStatusSize)
+    {
+        attributePathParams            = AttributePathParams();
+        attributePathParams.mNodeId    = kTestDeviceNodeId;
+        attributePathParams.mClusterId = kTestClusterId1;
+        attributePathParams.mFieldId   = static_cast<FieldId>(attributeCount % kTestFailingFieldId);
+        attributePathParams.mFlags.Set(AttributePathFlags::kFieldIdValid);
+
+        err = writeClient.PrepareAttribute(attributePathParams);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = writeClient.GetAttributeDataElementTLVWriter()->Put(TLV::ContextTag(AttributeDataElement::kCsTag_Data),
+                                                                  static_cast<uint8_t>(attributePathParams.mFieldId));
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = writeClient.FinishAttribute();
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        attributeCount++;
+    }
+    err = writeClient.FinalizeMessage(writeRequestBuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // Only the attributes whose statuses fit are applied, and the first one left out is rejected in the response.
+    gNumWrites = 0;
+    err        = writeHandler.Init(nullptr);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = writeHandler.ProcessWriteRequest(std::move(writeRequestBuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, gNumWrites > 0 && gNumWrites < attributeCount);
+    NL_TEST_ASSERT(apSuite, writeHandler.mNumAttributesWritten == gNumWrites);
+    err = writeHandler.FinalizeMessage(writeResponseBuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    writeHandler.Shutdown();
+
+    err = writeClient.ProcessWriteResponseMessage(std::move(writeResponseBuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, delegate.mNumSuccess == gNumWrites);
+    NL_TEST_ASSERT(apSuite, delegate.mNumFailure >= 1);
+    NL_TEST_ASSERT(apSuite, delegate.mNumSuccess + delegate.mNumFailure <= attributeCount);
+
+    writeClient.Shutdown();
+    InteractionModelEngine::GetInstance()->Shutdown();
+}
+
+} // namespace app
+} // namespace chip
+
+namespace {
+
+void InitializeChip(nlTestSuite * apSuite)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::Optional<chip::Transport::PeerAddress> peer(chip::Transport::Type::kUndefined);
+    chip::Transport::AdminPairingTable admins;
+    chip::Transport::AdminPairingInfo * adminInfo = admins.AssignAdminId(chip::gAdminId, chip::kTestDeviceNodeId);
+
+    NL_TEST_ASSERT(apSuite, adminInfo != nullptr);
+
+    err = chip::Platform::MemoryInit();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    chip::gSystemLayer.Init(nullptr);
+
+    err = chip::gSessionManager.Init(chip::kTestDeviceNodeId, &chip::gSystemLayer, &chip::gTransportManager, &admins);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = chip::gExchangeManager.Init(&chip::gSessionManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("CheckWriteClient", chip::app::TestWriteInteraction::TestWriteClient),
+    NL_TEST_DEF("CheckWriteHandler", chip::app::TestWriteInteraction::TestWriteHandler),
+    NL_TEST_DEF("CheckWriteHandlerResponseFull", chip::app::TestWriteInteraction::TestWriteHandlerResponseFull),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestWriteInteraction()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "TestWriteInteraction",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    InitializeChip(&theSuite);
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestWriteInteraction)
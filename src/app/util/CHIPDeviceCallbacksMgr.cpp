@@ -26,60 +26,83 @@
 
 #include "CHIPDeviceCallbacksMgr.h"
 
+#include <app/util/af-enums.h>
 #include <core/CHIPCore.h>
 #include <inttypes.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
 
 namespace {
-struct ResponseCallbackInfo
+// Finalizer of MurmurHash3, spreads every bit of a key into the bucket index.
+uint32_t MixHash(uint64_t value)
 {
-    chip::NodeId nodeId;
-    uint8_t sequenceNumber;
-
-    bool operator==(ResponseCallbackInfo const & other) { return nodeId == other.nodeId && sequenceNumber == other.sequenceNumber; }
-};
-
-struct ReportCallbackInfo
-{
-    chip::NodeId nodeId;
-    chip::EndpointId endpointId;
-    chip::ClusterId clusterId;
-    chip::AttributeId attributeId;
-
-    bool operator==(ReportCallbackInfo const & other)
-    {
-        return nodeId == other.nodeId && endpointId == other.endpointId && clusterId == other.clusterId &&
-            attributeId == other.attributeId;
-    }
-};
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return static_cast<uint32_t>(value);
+}
 } // namespace
 
 namespace chip {
 namespace app {
 
+uint32_t CHIPDeviceCallbacksMgr::ResponseCallbackInfo::Hash() const
+{
+    return MixHash(nodeId ^ (static_cast<uint64_t>(sequenceNumber) << 56));
+}
+
+uint32_t CHIPDeviceCallbacksMgr::ReportCallbackInfo::Hash() const
+{
+    return MixHash(nodeId ^ (static_cast<uint64_t>(endpointId) << 48) ^ (static_cast<uint64_t>(clusterId) << 32) ^
+                   (static_cast<uint64_t>(attributeId) << 16));
+}
+
 CHIP_ERROR CHIPDeviceCallbacksMgr::AddResponseCallback(NodeId nodeId, uint8_t sequenceNumber,
                                                        Callback::Cancelable * onSuccessCallback,
-                                                       Callback::Cancelable * onFailureCallback)
+                                                       Callback::Cancelable * onFailureCallback, uint32_t timeoutMs)
 {
     VerifyOrReturnError(onSuccessCallback != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(onFailureCallback != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    ResponseCallbackInfo info = { nodeId, sequenceNumber };
-    memcpy(&onSuccessCallback->mInfoPtr, &info, sizeof(info));
-    memcpy(&onFailureCallback->mInfoPtr, &info, sizeof(info));
+    ResponseCallbackInfo info = { nodeId, sequenceNumber, 0 };
+
+    if (timeoutMs != 0)
+    {
+        const System::Timer::Epoch deadline = System::Timer::GetCurrentEpoch() + timeoutMs;
+        uint64_t earliestDeadline;
+        const bool isEarliest = !mResponseDeadlines.GetEarliestDeadline(earliestDeadline) || deadline < earliestDeadline;
+
+        // 0 marks registrations without a deadline.
+        mNextTimeoutId = (mNextTimeoutId == UINT32_MAX) ? 1 : mNextTimeoutId + 1;
+        info.timeoutId = mNextTimeoutId;
+        ReturnErrorOnFailure(mResponseDeadlines.Push(deadline, info));
+
+        if (isEarliest)
+        {
+            ScheduleExpiryTimer();
+        }
+    }
 
     // If some callbacks have already been registered for the same ResponseCallbackInfo, it usually means that the response
     // has not been received for a previous command with the same sequenceNumber. Cancel the previously registered callbacks.
     CancelCallback(info, mResponsesSuccess);
     CancelCallback(info, mResponsesFailure);
 
-    mResponsesSuccess.Enqueue(onSuccessCallback);
-    mResponsesFailure.Enqueue(onFailureCallback);
+    // A deadline pushed above for callbacks that cannot be registered is skipped when it expires.
+    VerifyOrReturnError(mResponsesSuccess.Register(onSuccessCallback, info), CHIP_ERROR_NO_MEMORY);
+    if (!mResponsesFailure.Register(onFailureCallback, info))
+    {
+        onSuccessCallback->Cancel();
+        return CHIP_ERROR_NO_MEMORY;
+    }
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR CHIPDeviceCallbacksMgr::CancelResponseCallback(NodeId nodeId, uint8_t sequenceNumber)
 {
-    ResponseCallbackInfo info = { nodeId, sequenceNumber };
+    ResponseCallbackInfo info = { nodeId, sequenceNumber, 0 };
     CancelCallback(info, mResponsesSuccess);
     CancelCallback(info, mResponsesFailure);
     return CHIP_NO_ERROR;
@@ -89,7 +112,7 @@ CHIP_ERROR CHIPDeviceCallbacksMgr::GetResponseCallback(NodeId nodeId, uint8_t se
                                                        Callback::Cancelable ** onSuccessCallback,
                                                        Callback::Cancelable ** onFailureCallback)
 {
-    ResponseCallbackInfo info = { nodeId, sequenceNumber };
+    ResponseCallbackInfo info = { nodeId, sequenceNumber, 0 };
 
     ReturnErrorOnFailure(GetCallback(info, mResponsesSuccess, onSuccessCallback));
     (*onSuccessCallback)->Cancel();
@@ -106,12 +129,11 @@ CHIP_ERROR CHIPDeviceCallbacksMgr::AddReportCallback(NodeId nodeId, EndpointId e
     VerifyOrReturnError(onReportCallback != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
     ReportCallbackInfo info = { nodeId, endpointId, clusterId, attributeId };
-    memmove(&onReportCallback->mInfoPtr, &info, sizeof(info));
 
     // If a callback has already been registered for the same ReportCallbackInfo, let's cancel it.
     CancelCallback(info, mReports);
 
-    mReports.Enqueue(onReportCallback);
+    VerifyOrReturnError(mReports.Register(onReportCallback, info), CHIP_ERROR_NO_MEMORY);
     return CHIP_NO_ERROR;
 }
 
@@ -125,5 +147,76 @@ CHIP_ERROR CHIPDeviceCallbacksMgr::GetReportCallback(NodeId nodeId, EndpointId e
     return CHIP_NO_ERROR;
 }
 
+void CHIPDeviceCallbacksMgr::ExpireResponseCallbacks(System::Timer::Epoch now)
+{
+    ResponseCallbackInfo info;
+    while (mResponseDeadlines.PopExpired(now, info))
+    {
+        // Entries of responses that arrived, were cancelled or were registered again are left in the queue; skip them.
+        Callback::Cancelable * onFailureCallback = mResponsesFailure.Find(info);
+        if (onFailureCallback == nullptr || ResponseRegistry::GetKey(onFailureCallback).timeoutId != info.timeoutId)
+        {
+            continue;
+        }
+
+        ChipLogDetail(Zcl, "No response from node 0x%" PRIx64 " to message %u", info.nodeId, info.sequenceNumber);
+
+        CancelCallback(info, mResponsesSuccess);
+        onFailureCallback->Cancel();
+
+        Callback::Callback<ResponseFailureFn> * cb = Callback::Callback<ResponseFailureFn>::FromCancelable(onFailureCallback);
+        cb->mCall(cb->mContext, EMBER_ZCL_STATUS_TIMEOUT);
+    }
+
+    ScheduleExpiryTimer();
+}
+
+void CHIPDeviceCallbacksMgr::SetSystemLayer(System::Layer * systemLayer)
+{
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(ExpiryTimerCallback, this);
+    }
+
+    mSystemLayer = systemLayer;
+    ScheduleExpiryTimer();
+}
+
+void CHIPDeviceCallbacksMgr::ReleaseSystemLayer(System::Layer * systemLayer)
+{
+    if (mSystemLayer == systemLayer)
+    {
+        SetSystemLayer(nullptr);
+    }
+}
+
+void CHIPDeviceCallbacksMgr::ScheduleExpiryTimer()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+
+    uint64_t deadline;
+    if (!mResponseDeadlines.GetEarliestDeadline(deadline))
+    {
+        mSystemLayer->CancelTimer(ExpiryTimerCallback, this);
+        return;
+    }
+
+    const System::Timer::Epoch now = System::Timer::GetCurrentEpoch();
+    const uint64_t delay           = (deadline > now) ? deadline - now : 0;
+
+    CHIP_ERROR err =
+        mSystemLayer->StartTimer(static_cast<uint32_t>(delay < UINT32_MAX ? delay : UINT32_MAX), ExpiryTimerCallback, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Zcl, "Failed to start the response expiry timer: %s", ErrorStr(err));
+    }
+}
+
+void CHIPDeviceCallbacksMgr::ExpiryTimerCallback(System::Layer * layer, void * param, System::Error error)
+{
+    CHIPDeviceCallbacksMgr * mgr = reinterpret_cast<CHIPDeviceCallbacksMgr *>(param);
+    mgr->ExpireResponseCallbacks(System::Timer::GetCurrentEpoch());
+}
+
 } // namespace app
 } // namespace chip
@@ -28,8 +28,13 @@
 
 #include <app/util/basic-types.h>
 #include <core/CHIPCallback.h>
+#include <core/CHIPConfig.h>
 #include <core/CHIPError.h>
+#include <support/CodeUtils.h>
 #include <support/DLLUtil.h>
+#include <support/DeadlineQueue.h>
+#include <system/SystemLayer.h>
+#include <system/SystemTimer.h>
 
 namespace chip {
 namespace app {
@@ -47,55 +52,124 @@ public:
         return instance;
     }
 
+    /**
+     * Signature of the failure callbacks of responses. Failure callbacks of responses that do not arrive in time are
+     * called with EMBER_ZCL_STATUS_TIMEOUT.
+     */
+    typedef void (*ResponseFailureFn)(void * context, uint8_t status);
+
+    /**
+     * Register the callbacks for the response to the message @p sequenceNumber sent to @p nodeId.
+     *
+     * If the response has not arrived @p timeoutMs milliseconds from now, the callbacks are cancelled and
+     * @p onFailureCallback, a Callback<ResponseFailureFn>, is called with EMBER_ZCL_STATUS_TIMEOUT. A timeout of 0
+     * disables this.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if CHIP_CONFIG_DEVICE_MAX_PENDING_CALLBACKS responses are already awaited; the callbacks
+     *                              are then not registered.
+     */
     CHIP_ERROR AddResponseCallback(NodeId nodeId, uint8_t sequenceNumber, Callback::Cancelable * onSuccessCallback,
-                                   Callback::Cancelable * onFailureCallback);
+                                   Callback::Cancelable * onFailureCallback,
+                                   uint32_t timeoutMs = CHIP_CONFIG_DEVICE_CALLBACK_RESPONSE_TIMEOUT);
     CHIP_ERROR CancelResponseCallback(NodeId nodeId, uint8_t sequenceNumber);
     CHIP_ERROR GetResponseCallback(NodeId nodeId, uint8_t sequenceNumber, Callback::Cancelable ** onSuccessCallback,
                                    Callback::Cancelable ** onFailureCallback);
 
+    /**
+     * Register the callback for the reports of an attribute, in place of any previous one.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if CHIP_CONFIG_DEVICE_MAX_REPORT_CALLBACKS report callbacks are already registered.
+     */
     CHIP_ERROR AddReportCallback(NodeId nodeId, EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
                                  Callback::Cancelable * onReportCallback);
     CHIP_ERROR GetReportCallback(NodeId nodeId, EndpointId endpointId, ClusterId clusterId, AttributeId attributeId,
                                  Callback::Cancelable ** onReportCallback);
 
+    /**
+     * Fail the response callbacks whose deadline is not after @p now, in milliseconds of System::Timer::GetCurrentEpoch().
+     * The cost is proportional to the number of responses registered with a deadline up to @p now.
+     */
+    void ExpireResponseCallbacks(System::Timer::Epoch now);
+
+    /**
+     * Run ExpireResponseCallbacks() from a timer of @p systemLayer, whenever a deadline passes. Pass nullptr to stop.
+     */
+    void SetSystemLayer(System::Layer * systemLayer);
+
+    /**
+     * Stop using @p systemLayer, unless another one has been set since. For users that share this instance and may shut down
+     * in any order.
+     */
+    void ReleaseSystemLayer(System::Layer * systemLayer);
+
 private:
     CHIPDeviceCallbacksMgr() {}
 
-    template <typename T>
-    CHIP_ERROR CancelCallback(T & info, Callback::CallbackDeque & queue)
+    struct ResponseCallbackInfo
     {
-        Callback::Cancelable * ca = nullptr;
-        CHIP_ERROR err            = GetCallback(info, queue, &ca);
-        if (CHIP_NO_ERROR == err)
+        NodeId nodeId;
+        uint8_t sequenceNumber;
+        // Non-zero when the registration has a deadline in mResponseDeadlines. Not part of the key.
+        uint32_t timeoutId;
+
+        bool operator==(ResponseCallbackInfo const & other) const
         {
-            ca->Cancel();
-            queue.Dequeue(ca);
+            return nodeId == other.nodeId && sequenceNumber == other.sequenceNumber;
         }
+        uint32_t Hash() const;
+    };
 
-        return err;
-    }
-
-    template <typename T>
-    CHIP_ERROR GetCallback(T & info, Callback::CallbackDeque & queue, Callback::Cancelable ** callback)
+    struct ReportCallbackInfo
     {
-        Callback::Cancelable * ca = &queue;
-        while (ca != nullptr && ca->mNext != &queue)
+        NodeId nodeId;
+        EndpointId endpointId;
+        ClusterId clusterId;
+        AttributeId attributeId;
+
+        bool operator==(ReportCallbackInfo const & other) const
         {
-            if (*reinterpret_cast<T *>(&ca->mNext->mInfoPtr) == info)
-            {
-                *callback = ca->mNext;
-                return CHIP_NO_ERROR;
-            }
+            return nodeId == other.nodeId && endpointId == other.endpointId && clusterId == other.clusterId &&
+                attributeId == other.attributeId;
+        }
+        uint32_t Hash() const;
+    };
+
+    template <typename T, size_t kCapacity>
+    using Registry = Callback::CallbackRegistry<T, CHIP_CONFIG_DEVICE_CALLBACK_BUCKETS, kCapacity>;
 
-            ca = ca->mNext;
+    using ResponseRegistry = Registry<ResponseCallbackInfo, CHIP_CONFIG_DEVICE_MAX_PENDING_CALLBACKS>;
+    using ReportRegistry   = Registry<ReportCallbackInfo, CHIP_CONFIG_DEVICE_MAX_REPORT_CALLBACKS>;
+
+    template <typename T, size_t kCapacity>
+    static void CancelCallback(const T & info, Registry<T, kCapacity> & registry)
+    {
+        Callback::Cancelable * ca = registry.Find(info);
+        if (ca != nullptr)
+        {
+            ca->Cancel();
         }
+    }
 
-        return CHIP_ERROR_KEY_NOT_FOUND;
+    template <typename T, size_t kCapacity>
+    static CHIP_ERROR GetCallback(const T & info, Registry<T, kCapacity> & registry, Callback::Cancelable ** callback)
+    {
+        Callback::Cancelable * ca = registry.Find(info);
+        VerifyOrReturnError(ca != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+        *callback = ca;
+        return CHIP_NO_ERROR;
     }
 
-    Callback::CallbackDeque mResponsesSuccess;
-    Callback::CallbackDeque mResponsesFailure;
-    Callback::CallbackDeque mReports;
+    static void ExpiryTimerCallback(System::Layer * layer, void * param, System::Error error);
+    void ScheduleExpiryTimer();
+
+    ResponseRegistry mResponsesSuccess;
+    ResponseRegistry mResponsesFailure;
+    ReportRegistry mReports;
+
+    DeadlineQueue<ResponseCallbackInfo> mResponseDeadlines;
+    uint32_t mNextTimeoutId      = 0;
+    System::Layer * mSystemLayer = nullptr;
 };
 
 } // namespace app
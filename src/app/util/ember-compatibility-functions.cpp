@@ -24,6 +24,9 @@
 #include <app/util/ember-compatibility-functions.h>
 
 #include <app/Command.h>
+#include <app/InteractionModelEngine.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
 #include <app/util/util.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/CHIPTLV.h>
@@ -85,5 +88,31 @@ void ResetEmberAfObjects()
 }
 
 } // namespace Compatibility
+
+bool GetEndpointIdAtIndex(uint16_t aIndex, EndpointId & aEndpointId)
+{
+    VerifyOrReturnError(aIndex < emberAfEndpointCount(), false);
+    // A disabled endpoint is still listed; it has no cluster to report.
+    aEndpointId = emberAfEndpointFromIndex(static_cast<uint8_t>(aIndex));
+    return true;
+}
+
+bool GetClusterIdAtIndex(EndpointId aEndpointId, uint16_t aIndex, ClusterId & aClusterId)
+{
+    VerifyOrReturnError(aIndex <= UINT8_MAX, false);
+    EmberAfCluster * cluster = emberAfGetNthCluster(aEndpointId, static_cast<uint8_t>(aIndex), true /* server */);
+    VerifyOrReturnError(cluster != nullptr, false);
+    aClusterId = cluster->clusterId;
+    return true;
+}
+
+bool GetAttributeIdAtIndex(EndpointId aEndpointId, ClusterId aClusterId, uint16_t aIndex, AttributeId & aAttributeId)
+{
+    EmberAfCluster * cluster = emberAfFindCluster(aEndpointId, aClusterId, CLUSTER_MASK_SERVER);
+    VerifyOrReturnError(cluster != nullptr && aIndex < cluster->attributeCount, false);
+    aAttributeId = cluster->attributes[aIndex].attributeId;
+    return true;
+}
+
 } // namespace app
 } // namespace chip
@@ -54,7 +54,8 @@ CHIP_ERROR ClusterBase::SendCommand(uint8_t seqNum, chip::System::PacketBufferHa
 
     if (onSuccessCallback != nullptr || onFailureCallback != nullptr)
     {
-        mDevice->AddResponseHandler(seqNum, onSuccessCallback, onFailureCallback);
+        err = mDevice->AddResponseHandler(seqNum, onSuccessCallback, onFailureCallback);
+        SuccessOrExit(err);
     }
 
     err = mDevice->SendMessage(Protocols::TempZCL::Id, 0, std::move(payload));
@@ -75,7 +76,7 @@ CHIP_ERROR ClusterBase::RequestAttributeReporting(AttributeId attributeId, Callb
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     VerifyOrExit(onReportCallback != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
-    mDevice->AddReportHandler(mEndpoint, mClusterId, attributeId, onReportCallback);
+    err = mDevice->AddReportHandler(mEndpoint, mClusterId, attributeId, onReportCallback);
 
 exit:
     return err;
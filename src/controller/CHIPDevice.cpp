@@ -337,9 +337,7 @@ CHIP_ERROR Device::UpdateAddress(const Transport::PeerAddress & addr)
     VerifyOrReturnError(connectionState != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
     mDeviceAddress = addr;
-    connectionState->SetPeerAddress(addr);
-
-    return CHIP_NO_ERROR;
+    return mSessionManager->UpdatePeerAddress(mSecureSession, addr);
 }
 
 CHIP_ERROR Device::LoadSecureSessionParameters(ResetTransport resetNeeded)
@@ -394,9 +392,10 @@ bool Device::GetAddress(Inet::IPAddress & addr, uint16_t & port) const
     return true;
 }
 
-void Device::AddResponseHandler(uint8_t seqNum, Callback::Cancelable * onSuccessCallback, Callback::Cancelable * onFailureCallback)
+CHIP_ERROR Device::AddResponseHandler(uint8_t seqNum, Callback::Cancelable * onSuccessCallback,
+                                      Callback::Cancelable * onFailureCallback)
 {
-    mCallbacksMgr.AddResponseCallback(mDeviceId, seqNum, onSuccessCallback, onFailureCallback);
+    return mCallbacksMgr.AddResponseCallback(mDeviceId, seqNum, onSuccessCallback, onFailureCallback);
 }
 
 void Device::CancelResponseHandler(uint8_t seqNum)
@@ -404,10 +403,10 @@ void Device::CancelResponseHandler(uint8_t seqNum)
     mCallbacksMgr.CancelResponseCallback(mDeviceId, seqNum);
 }
 
-void Device::AddReportHandler(EndpointId endpoint, ClusterId cluster, AttributeId attribute,
-                              Callback::Cancelable * onReportCallback)
+CHIP_ERROR Device::AddReportHandler(EndpointId endpoint, ClusterId cluster, AttributeId attribute,
+                                    Callback::Cancelable * onReportCallback)
 {
-    mCallbacksMgr.AddReportCallback(mDeviceId, endpoint, cluster, attribute, onReportCallback);
+    return mCallbacksMgr.AddReportCallback(mDeviceId, endpoint, cluster, attribute, onReportCallback);
 }
 
 void Device::InitCommandSender()
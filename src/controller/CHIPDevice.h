@@ -306,9 +306,11 @@ public:
     PASESessionSerializable & GetPairing() { return mPairing; }
 
     uint8_t GetNextSequenceNumber() { return mSequenceNumber++; };
-    void AddResponseHandler(uint8_t seqNum, Callback::Cancelable * onSuccessCallback, Callback::Cancelable * onFailureCallback);
+    CHIP_ERROR AddResponseHandler(uint8_t seqNum, Callback::Cancelable * onSuccessCallback,
+                                  Callback::Cancelable * onFailureCallback);
     void CancelResponseHandler(uint8_t seqNum);
-    void AddReportHandler(EndpointId endpoint, ClusterId cluster, AttributeId attribute, Callback::Cancelable * onReportCallback);
+    CHIP_ERROR AddReportHandler(EndpointId endpoint, ClusterId cluster, AttributeId attribute,
+                                Callback::Cancelable * onReportCallback);
 
 private:
     enum class ConnectionState
@@ -186,6 +186,8 @@ CHIP_ERROR DeviceController::Init(NodeId localDeviceId, ControllerInitParams par
 
     mExchangeMgr->SetDelegate(this);
 
+    app::CHIPDeviceCallbacksMgr::GetInstance().SetSystemLayer(mSystemLayer);
+
 #if CHIP_DEVICE_CONFIG_ENABLE_MDNS
     if (params.mDeviceAddressUpdateDelegate != nullptr)
     {
@@ -215,6 +217,9 @@ CHIP_ERROR DeviceController::Shutdown()
 
     mState = State::NotInitialized;
 
+    // Another controller may have set its own layer since; leave that one in place.
+    app::CHIPDeviceCallbacksMgr::GetInstance().ReleaseSystemLayer(mSystemLayer);
+
 #if CONFIG_DEVICE_LAYER
     ReturnErrorOnFailure(DeviceLayer::PlatformMgr().Shutdown());
 #else
@@ -537,7 +542,7 @@ CHIP_ERROR DeviceController::InitializePairedDeviceList()
 
     if (!mPairedDevicesInitialized)
     {
-        constexpr uint16_t max_size = CHIP_MAX_SERIALIZED_SIZE_U64(kNumMaxPairedDevices);
+        constexpr uint16_t max_size = CHIP_MAX_COMPACT_SERIALIZED_SIZE_U64(kNumMaxPairedDevices);
         buffer                      = static_cast<char *>(chip::Platform::MemoryAlloc(max_size));
         uint16_t size               = max_size;
 
@@ -951,7 +956,7 @@ void DeviceCommissioner::PersistDeviceList()
 {
     if (mStorageDelegate != nullptr && mPairedDevicesUpdated)
     {
-        constexpr uint16_t size = CHIP_MAX_SERIALIZED_SIZE_U64(kNumMaxPairedDevices);
+        constexpr uint16_t size = CHIP_MAX_COMPACT_SERIALIZED_SIZE_U64(kNumMaxPairedDevices);
         char * serialized       = static_cast<char *>(chip::Platform::MemoryAlloc(size));
         uint16_t requiredSize   = size;
         if (serialized != nullptr)
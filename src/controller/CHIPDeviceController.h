@@ -215,7 +215,7 @@ protected:
     */
     Device mActiveDevices[kNumMaxActiveDevices];
 
-    SerializableU64Set<kNumMaxPairedDevices> mPairedDevices;
+    SerializableU64HashSet<kNumMaxPairedDevices> mPairedDevices;
     bool mPairedDevicesInitialized;
 
     NodeId mLocalDeviceId;
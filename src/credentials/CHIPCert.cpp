@@ -53,6 +53,35 @@ using namespace chip::Crypto;
 extern CHIP_ERROR DecodeConvertTBSCert(TLVReader & reader, ASN1Writer & writer, ChipCertificateData & certData);
 extern CHIP_ERROR DecodeECDSASignature(TLVReader & reader, ChipCertificateData & certData);
 
+namespace {
+
+// Marks an unused slot of the subject DN index. Never a valid mCerts index since mMaxCerts <= UINT8_MAX.
+constexpr uint8_t kSubjectIndexEmptySlot = UINT8_MAX;
+
+constexpr uint64_t kDNHashOffsetBasis = 0xcbf29ce484222325ULL;
+constexpr uint64_t kDNHashPrime       = 0x100000001b3ULL;
+
+// FNV-1a over the big-endian encoding of the low `size` bytes of val.
+inline uint64_t DNHashInteger(uint64_t hash, uint64_t val, uint8_t size)
+{
+    while (size-- > 0)
+    {
+        hash = (hash ^ static_cast<uint8_t>(val >> (size * 8))) * kDNHashPrime;
+    }
+    return hash;
+}
+
+inline uint64_t DNHashBytes(uint64_t hash, const uint8_t * val, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        hash = (hash ^ val[i]) * kDNHashPrime;
+    }
+    return hash;
+}
+
+} // namespace
+
 ChipCertificateSet::ChipCertificateSet()
 {
     mCerts               = nullptr;
@@ -60,6 +89,8 @@ ChipCertificateSet::ChipCertificateSet()
     mMaxCerts            = 0;
     mDecodeBuf           = nullptr;
     mDecodeBufSize       = 0;
+    mSubjectIndex        = nullptr;
+    mSubjectIndexSize    = 0;
     mMemoryAllocInternal = false;
 }
 
@@ -80,6 +111,16 @@ CHIP_ERROR ChipCertificateSet::Init(uint8_t maxCertsArraySize, uint16_t decodeBu
     mDecodeBuf = reinterpret_cast<uint8_t *>(chip::Platform::MemoryAlloc(decodeBufSize));
     VerifyOrExit(mDecodeBuf != nullptr, err = CHIP_ERROR_NO_MEMORY);
 
+    // Size the subject DN index to at least twice the number of certificates, so that it always has
+    // empty slots to terminate a probe sequence and the probe sequences stay short.
+    mSubjectIndexSize = 2;
+    while (mSubjectIndexSize < 2 * maxCertsArraySize)
+    {
+        mSubjectIndexSize = static_cast<uint16_t>(mSubjectIndexSize << 1);
+    }
+    mSubjectIndex = reinterpret_cast<uint8_t *>(chip::Platform::MemoryAlloc(mSubjectIndexSize));
+    VerifyOrExit(mSubjectIndex != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
     mMaxCerts            = maxCertsArraySize;
     mDecodeBufSize       = decodeBufSize;
     mMemoryAllocInternal = true;
@@ -109,6 +150,8 @@ CHIP_ERROR ChipCertificateSet::Init(ChipCertificateData * certsArray, uint8_t ce
     mMaxCerts            = certsArraySize;
     mDecodeBuf           = decodeBuf;
     mDecodeBufSize       = decodeBufSize;
+    mSubjectIndex        = nullptr;
+    mSubjectIndexSize    = 0;
     mMemoryAllocInternal = false;
 
     Clear();
@@ -132,6 +175,11 @@ void ChipCertificateSet::Release()
             chip::Platform::MemoryFree(mDecodeBuf);
             mDecodeBuf = nullptr;
         }
+        if (mSubjectIndex != nullptr)
+        {
+            chip::Platform::MemoryFree(mSubjectIndex);
+            mSubjectIndex = nullptr;
+        }
     }
 }
 
@@ -143,6 +191,42 @@ void ChipCertificateSet::Clear()
     }
 
     mCertCount = 0;
+
+    RebuildSubjectIndex();
+}
+
+void ChipCertificateSet::IndexCert(uint8_t certIndex)
+{
+    if (mSubjectIndex == nullptr)
+    {
+        return;
+    }
+
+    const uint16_t mask = static_cast<uint16_t>(mSubjectIndexSize - 1);
+    uint16_t slot       = static_cast<uint16_t>(mCerts[certIndex].mSubjectDN.GetHash() & mask);
+
+    // Linear probing keeps certificates with the same subject DN in load order along their probe sequence,
+    // so indexed lookups visit candidate certificates in the same order as a scan of mCerts would.
+    while (mSubjectIndex[slot] != kSubjectIndexEmptySlot)
+    {
+        slot = static_cast<uint16_t>((slot + 1) & mask);
+    }
+    mSubjectIndex[slot] = certIndex;
+}
+
+void ChipCertificateSet::RebuildSubjectIndex()
+{
+    if (mSubjectIndex == nullptr)
+    {
+        return;
+    }
+
+    memset(mSubjectIndex, kSubjectIndexEmptySlot, mSubjectIndexSize);
+
+    for (uint8_t i = 0; i < mCertCount; i++)
+    {
+        IndexCert(i);
+    }
 }
 
 CHIP_ERROR ChipCertificateSet::LoadCert(const uint8_t * chipCert, uint32_t chipCertLen, BitFlags<CertDecodeFlags> decodeFlags)
@@ -230,6 +314,8 @@ CHIP_ERROR ChipCertificateSet::LoadCert(TLVReader & reader, BitFlags<CertDecodeF
         cert->mCertFlags.Set(CertFlags::kIsTrustAnchor);
     }
 
+    IndexCert(mCertCount);
+
     mCertCount++;
 
 exit:
@@ -315,7 +401,11 @@ exit:
         {
             mCerts[i].~ChipCertificateData();
         }
-        mCertCount = initialCertCount;
+        if (mCertCount != initialCertCount)
+        {
+            mCertCount = initialCertCount;
+            RebuildSubjectIndex();
+        }
     }
 
     return err;
@@ -547,6 +637,8 @@ CHIP_ERROR ChipCertificateSet::FindValidCert(const ChipDN & subjectDN, const Cer
                                              ChipCertificateData *& cert)
 {
     CHIP_ERROR err;
+    bool useSubjectIndex;
+    uint16_t slot = 0;
 
     // Default error if we don't find any matching cert.
     err = (depth > 0) ? CHIP_ERROR_CA_CERT_NOT_FOUND : CHIP_ERROR_CERT_NOT_FOUND;
@@ -557,10 +649,36 @@ CHIP_ERROR ChipCertificateSet::FindValidCert(const ChipDN & subjectDN, const Cer
         ExitNow();
     }
 
-    // For each cert in the set...
-    for (uint8_t i = 0; i < mCertCount; i++)
+    // When searching by subject DN in an indexed set, only walk the probe sequence of the DN hash in the
+    // subject index rather than every cert in the set.
+    useSubjectIndex = (mSubjectIndex != nullptr && !subjectDN.IsEmpty());
+    if (useSubjectIndex)
     {
-        ChipCertificateData * candidateCert = &mCerts[i];
+        slot = static_cast<uint16_t>(subjectDN.GetHash() & (mSubjectIndexSize - 1));
+    }
+
+    // For each candidate cert in the set...
+    for (uint8_t i = 0;; i++)
+    {
+        ChipCertificateData * candidateCert;
+
+        if (useSubjectIndex)
+        {
+            if (mSubjectIndex[slot] == kSubjectIndexEmptySlot)
+            {
+                break;
+            }
+            candidateCert = &mCerts[mSubjectIndex[slot]];
+            slot          = static_cast<uint16_t>((slot + 1) & (mSubjectIndexSize - 1));
+        }
+        else
+        {
+            if (i >= mCertCount)
+            {
+                break;
+            }
+            candidateCert = &mCerts[i];
+        }
 
         // Skip the certificate if its subject DN and key id do not match the input criteria.
         if (!subjectDN.IsEmpty() && !candidateCert->mSubjectDN.IsEqual(subjectDN))
@@ -646,7 +764,10 @@ bool ChipRDN::IsEqual(const ChipRDN & other) const
     }
 }
 
-ChipDN::ChipDN() {}
+ChipDN::ChipDN()
+{
+    Clear();
+}
 
 ChipDN::~ChipDN() {}
 
@@ -656,6 +777,8 @@ void ChipDN::Clear()
     {
         rdn[i].Clear();
     }
+
+    mHash = kDNHashOffsetBasis;
 }
 
 uint8_t ChipDN::RDNCount() const
@@ -689,6 +812,9 @@ CHIP_ERROR ChipDN::AddAttribute(chip::ASN1::OID oid, uint64_t val)
     rdn[rdnCount].mAttrOID            = oid;
     rdn[rdnCount].mAttrValue.mChipVal = val;
 
+    mHash = DNHashInteger(mHash, oid, sizeof(oid));
+    mHash = DNHashInteger(mHash, val, sizeof(val));
+
 exit:
     return err;
 }
@@ -706,6 +832,10 @@ CHIP_ERROR ChipDN::AddAttribute(chip::ASN1::OID oid, const uint8_t * val, uint32
     rdn[rdnCount].mAttrValue.mString.mValue = val;
     rdn[rdnCount].mAttrValue.mString.mLen   = valLen;
 
+    mHash = DNHashInteger(mHash, oid, sizeof(oid));
+    mHash = DNHashInteger(mHash, valLen, sizeof(valLen));
+    mHash = DNHashBytes(mHash, val, valLen);
+
 exit:
     return err;
 }
@@ -770,6 +900,8 @@ bool ChipDN::IsEqual(const ChipDN & other) const
     bool res         = true;
     uint8_t rdnCount = RDNCount();
 
+    // Unequal hashes imply unequal DNs; equal hashes still require the attribute comparison below.
+    VerifyOrExit(mHash == other.mHash, res = false);
     VerifyOrExit(rdnCount > 0, res = false);
     VerifyOrExit(rdnCount == other.RDNCount(), res = false);
 
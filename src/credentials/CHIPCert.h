@@ -260,8 +260,20 @@ public:
      **/
     bool IsEmpty() const { return RDNCount() == 0; }
 
+    /**
+     * @brief Get the 64-bit hash of the DN.
+     *        The hash is computed over a canonical encoding of the DN attributes, in order: for each
+     *        attribute its OID, followed by either the 64-bit CHIP-specific value or the string length
+     *        and bytes. Equal DNs always have equal hashes, which makes the hash suitable for indexing
+     *        and for rejecting unequal DNs early. IsEqual() remains the authoritative comparison.
+     *
+     * @return The DN hash.
+     **/
+    uint64_t GetHash() const { return mHash; }
+
 protected:
     ChipRDN rdn[CHIP_CONFIG_CERT_MAX_RDN_ATTRIBUTES];
+    uint64_t mHash; /**< Hash of the DN canonical encoding, updated as attributes are added. */
 
     uint8_t RDNCount() const;
 };
@@ -370,6 +382,9 @@ public:
         mDecodeBuf           = aOther.mDecodeBuf;
         aOther.mDecodeBuf    = nullptr;
         mDecodeBufSize       = aOther.mDecodeBufSize;
+        mSubjectIndex        = aOther.mSubjectIndex;
+        aOther.mSubjectIndex = nullptr;
+        mSubjectIndexSize    = aOther.mSubjectIndexSize;
         mMemoryAllocInternal = aOther.mMemoryAllocInternal;
 
         return *this;
@@ -379,6 +394,8 @@ public:
      * @brief Initialize ChipCertificateSet.
      *        This initialization method is used when all memory structures needed for operation are
      *        allocated internally using chip::Platform::MemoryAlloc() and freed with chip::Platform::MemoryFree().
+     *        A set initialized this way also indexes the loaded certificates by subject DN hash, so that
+     *        issuer lookups while building a certificate chain do not scan the whole set.
      *
      * @param maxCertsArraySize  Maximum number of CHIP certificates to be loaded to the set.
      * @param decodeBufSize      Size of the buffer that should be allocated to perform CHIP certificate decoding.
@@ -391,6 +408,7 @@ public:
      * @brief Initialize ChipCertificateSet.
      *        This initialization method is used when all memory structures needed for operation are
      *        allocated externally and methods in this class don't need to deal with memory allocations.
+     *        A set initialized this way has no subject DN index and searches the certificates linearly.
      *
      * @param certsArray      A pointer to the array of the ChipCertificateData structures.
      * @param certsArraySize  Number of ChipCertificateData entries in the array.
@@ -545,8 +563,21 @@ private:
     uint8_t mMaxCerts;            /**< Length of mCerts array. */
     uint8_t * mDecodeBuf;         /**< Certificate decode buffer. */
     uint16_t mDecodeBufSize;      /**< Certificate decode buffer size. */
+    uint8_t * mSubjectIndex;      /**< Open-addressed hash table of mCerts indexes keyed by subject DN hash,
+                                     or nullptr if the set is not indexed. */
+    uint16_t mSubjectIndexSize;   /**< Number of slots in mSubjectIndex, a power of two. */
     bool mMemoryAllocInternal;    /**< Indicates whether temporary memory buffers are allocated internally. */
 
+    /**
+     * @brief Add the certificate at the specified position of mCerts to the subject DN index.
+     **/
+    void IndexCert(uint8_t certIndex);
+
+    /**
+     * @brief Rebuild the subject DN index from the first mCertCount certificates.
+     **/
+    void RebuildSubjectIndex();
+
     /**
      * @brief Find and validate CHIP certificate.
      *
@@ -677,7 +677,26 @@ DLL_EXPORT CHIP_ERROR ConvertX509CertToChipCert(const uint8_t * x509Cert, uint32
     ASN1Reader reader;
     TLVWriter writer;
 
+#if CHIP_CONFIG_X509_CERT_MAX_ASN1_ELEMENTS > 0
+    // Decode all the element heads in one pass, so that a malformed encoding is rejected before anything is written
+    // and the conversion below steps from element to element without decoding them again.
+    ASN1Element elems[CHIP_CONFIG_X509_CERT_MAX_ASN1_ELEMENTS];
+    uint16_t numElems;
+
+    err = TokenizeASN1(x509Cert, x509CertLen, elems, CHIP_CONFIG_X509_CERT_MAX_ASN1_ELEMENTS, numElems);
+    if (err == ASN1_ERROR_OVERFLOW)
+    {
+        // Too many elements to index; convert straight from the encoding.
+        reader.Init(x509Cert, x509CertLen);
+    }
+    else
+    {
+        SuccessOrExit(err);
+        reader.Init(x509Cert, x509CertLen, elems, numElems);
+    }
+#else
     reader.Init(x509Cert, x509CertLen);
+#endif
 
     writer.Init(chipCertBuf, chipCertBufSize);
 
@@ -635,6 +635,100 @@ static void TestChipCert_CertType(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+static void TestChipCert_DNHash(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    ChipDN dn1;
+    ChipDN dn2;
+    ChipDN emptyDN;
+    static const uint8_t sCommonName[]  = { 'T', 'e', 's', 't', ' ', 'C', 'A' };
+    static const uint8_t sCommonName2[] = { 'T', 'e', 's', 't', ' ', 'C', 'B' };
+
+    // Equal DNs have equal hashes.
+    NL_TEST_ASSERT(inSuite, dn1.AddAttribute(kOID_AttributeType_ChipFabricId, 0xFAB000000000001DULL) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dn1.AddAttribute(kOID_AttributeType_CommonName, sCommonName, sizeof(sCommonName)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dn2.AddAttribute(kOID_AttributeType_ChipFabricId, 0xFAB000000000001DULL) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dn2.AddAttribute(kOID_AttributeType_CommonName, sCommonName, sizeof(sCommonName)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dn1.GetHash() == dn2.GetHash());
+    NL_TEST_ASSERT(inSuite, dn1.IsEqual(dn2));
+    NL_TEST_ASSERT(inSuite, dn1.GetHash() != emptyDN.GetHash());
+
+    // DNs differing in a single attribute value byte are not equal.
+    dn2.Clear();
+    NL_TEST_ASSERT(inSuite, dn2.GetHash() == emptyDN.GetHash());
+    NL_TEST_ASSERT(inSuite, dn2.AddAttribute(kOID_AttributeType_ChipFabricId, 0xFAB000000000001DULL) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dn2.AddAttribute(kOID_AttributeType_CommonName, sCommonName2, sizeof(sCommonName2)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dn1.GetHash() != dn2.GetHash());
+    NL_TEST_ASSERT(inSuite, !dn1.IsEqual(dn2));
+
+    // The same attributes in a different order are not equal.
+    dn2.Clear();
+    NL_TEST_ASSERT(inSuite, dn2.AddAttribute(kOID_AttributeType_CommonName, sCommonName, sizeof(sCommonName)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dn2.AddAttribute(kOID_AttributeType_ChipFabricId, 0xFAB000000000001DULL) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !dn1.IsEqual(dn2));
+
+    // Chain building through the subject DN index in a large set finds the same chain as a linear search.
+    {
+        constexpr uint8_t kFillerCertsCount = 60;
+        ChipCertificateSet indexedSet;
+        ChipCertificateSet linearSet;
+        ChipCertificateData * linearCerts = nullptr;
+        uint8_t * linearDecodeBuf         = nullptr;
+        ValidationContext validContext;
+
+        err = indexedSet.Init(kFillerCertsCount + kStandardCertsCount, kTestCertBufSize);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        linearCerts = reinterpret_cast<ChipCertificateData *>(
+            chip::Platform::MemoryAlloc(sizeof(ChipCertificateData) * (kFillerCertsCount + kStandardCertsCount)));
+        linearDecodeBuf = reinterpret_cast<uint8_t *>(chip::Platform::MemoryAlloc(kTestCertBufSize));
+        NL_TEST_ASSERT(inSuite, linearCerts != nullptr && linearDecodeBuf != nullptr);
+        err = linearSet.Init(linearCerts, kFillerCertsCount + kStandardCertsCount, linearDecodeBuf, kTestCertBufSize);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        // Fill both sets with certificates from an unrelated chain, which includes a trust anchor.
+        for (uint8_t i = 0; i < kFillerCertsCount; i++)
+        {
+            const uint8_t fillerCert = (i % 2 == 0) ? TestCert::kRoot02 : TestCert::kICA02;
+            const BitFlags<CertDecodeFlags> decodeFlags =
+                (fillerCert == TestCert::kRoot02) ? sTrustAnchorFlag : sGenTBSHashFlag;
+            NL_TEST_ASSERT(inSuite, LoadTestCert(indexedSet, fillerCert, sNullLoadFlag, decodeFlags) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, LoadTestCert(linearSet, fillerCert, sNullLoadFlag, decodeFlags) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, LoadTestCertSet01(indexedSet) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadTestCertSet01(linearSet) == CHIP_NO_ERROR);
+
+        validContext.Reset();
+        err = SetEffectiveTime(validContext, 2021, 1, 1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+        validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+
+        err = indexedSet.ValidateCert(indexedSet.GetLastCert(), validContext);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, validContext.mTrustAnchor == &indexedSet.GetCertSet()[kFillerCertsCount]);
+
+        validContext.mTrustAnchor = nullptr;
+        err                       = linearSet.ValidateCert(linearSet.GetLastCert(), validContext);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, validContext.mTrustAnchor == &linearSet.GetCertSet()[kFillerCertsCount]);
+
+        // Certificates of the unrelated chain still validate against their own trust anchor.
+        validContext.Reset();
+        err = SetEffectiveTime(validContext, 2021, 1, 1);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kKeyCertSign);
+        err = indexedSet.ValidateCert(&indexedSet.GetCertSet()[1], validContext);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, validContext.mTrustAnchor == &indexedSet.GetCertSet()[0]);
+
+        indexedSet.Release();
+        linearSet.Clear();
+        chip::Platform::MemoryFree(linearCerts);
+        chip::Platform::MemoryFree(linearDecodeBuf);
+    }
+}
+
 /**
  *  Set up the test suite.
  */
@@ -670,6 +764,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test CHIP Certificate Validation time", TestChipCert_CertValidTime),
     NL_TEST_DEF("Test CHIP Certificate Usage", TestChipCert_CertUsage),
     NL_TEST_DEF("Test CHIP Certificate Type", TestChipCert_CertType),
+    NL_TEST_DEF("Test CHIP Certificate DN Hash", TestChipCert_DNHash),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,391 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Implements the generation of per-device factory credential bundles.
+ *
+ *      Certificates are encoded directly in the CHIP TLV format. The signature
+ *      covers the X.509 DER encoding of the TBS portion, which is recovered by
+ *      loading the unsigned certificate into a ChipCertificateSet, the same
+ *      way a device validating the certificate computes it.
+ */
+
+#include "credential_bundle.h"
+
+#include <asn1/ASN1.h>
+#include <asn1/ASN1Macros.h>
+#include <protocols/Protocols.h>
+#include <protocols/secure_channel/PASESession.h>
+#include <setup_payload/SetupPayload.h>
+#include <support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace FactoryTool {
+
+using namespace chip::ASN1;
+using namespace chip::Credentials;
+using namespace chip::Crypto;
+using namespace chip::TLV;
+
+namespace {
+
+constexpr size_t kSerialNumberLength = 8;
+
+struct CertFields
+{
+    uint8_t serialNumber[kSerialNumberLength];
+    // Issuer DN, or nullptr if the certificate is self-signed
+    const TLVReader * issuer;
+    OID subjectIdOID;
+    uint64_t subjectId;
+    // Fabric id, included in the subject DN if non-zero
+    uint64_t fabricId;
+    uint32_t notBefore;
+    uint32_t notAfter;
+    const uint8_t * publicKey;
+    bool isCA;
+    BitFlags<KeyUsageFlags> keyUsage;
+    uint8_t subjectKeyId[kKeyIdentifierLength];
+    const uint8_t * authorityKeyId;
+};
+
+CHIP_ERROR WriteSubjectDN(const CertFields & fields, uint64_t tag, TLVWriter & writer)
+{
+    TLVType outerContainer;
+
+    ReturnErrorOnFailure(writer.StartContainer(tag, kTLVType_List, outerContainer));
+    ReturnErrorOnFailure(writer.Put(ContextTag(GetOIDEnum(fields.subjectIdOID)), fields.subjectId));
+    if (fields.fabricId != 0)
+    {
+        ReturnErrorOnFailure(writer.Put(ContextTag(GetOIDEnum(kOID_AttributeType_ChipFabricId)), fields.fabricId));
+    }
+    return writer.EndContainer(outerContainer);
+}
+
+CHIP_ERROR WriteExtensions(const CertFields & fields, TLVWriter & writer)
+{
+    TLVType outerContainer;
+    TLVType innerContainer;
+
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(kTag_Extensions), kTLVType_List, outerContainer));
+
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(kTag_BasicConstraints), kTLVType_Structure, innerContainer));
+    ReturnErrorOnFailure(writer.PutBoolean(ContextTag(kTag_BasicConstraints_IsCA), fields.isCA));
+    ReturnErrorOnFailure(writer.EndContainer(innerContainer));
+
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_KeyUsage), fields.keyUsage.Raw()));
+
+    if (!fields.isCA)
+    {
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(kTag_ExtendedKeyUsage), kTLVType_Array, innerContainer));
+        ReturnErrorOnFailure(writer.Put(AnonymousTag, GetOIDEnum(kOID_KeyPurpose_ClientAuth)));
+        ReturnErrorOnFailure(writer.Put(AnonymousTag, GetOIDEnum(kOID_KeyPurpose_ServerAuth)));
+        ReturnErrorOnFailure(writer.EndContainer(innerContainer));
+    }
+
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_SubjectKeyIdentifier), fields.subjectKeyId, kKeyIdentifierLength));
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_AuthorityKeyIdentifier), fields.authorityKeyId, kKeyIdentifierLength));
+
+    return writer.EndContainer(outerContainer);
+}
+
+CHIP_ERROR WriteCert(const CertFields & fields, const uint8_t * r, uint32_t rLen, const uint8_t * s, uint32_t sLen,
+                     uint8_t * certBuf, uint32_t certBufSize, uint32_t & certLen)
+{
+    TLVWriter writer;
+    TLVType outerContainer;
+    TLVType signatureContainer;
+
+    writer.Init(certBuf, certBufSize);
+
+    ReturnErrorOnFailure(writer.StartContainer(ProfileTag(Protocols::OpCredentials::Id.ToTLVProfileId(), kTag_ChipCertificate),
+                                               kTLVType_Structure, outerContainer));
+
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_SerialNumber), fields.serialNumber, sizeof(fields.serialNumber)));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_SignatureAlgorithm), GetOIDEnum(kOID_SigAlgo_ECDSAWithSHA256)));
+
+    if (fields.issuer != nullptr)
+    {
+        TLVReader issuer = *fields.issuer;
+        ReturnErrorOnFailure(writer.CopyContainer(ContextTag(kTag_Issuer), issuer));
+    }
+    else
+    {
+        ReturnErrorOnFailure(WriteSubjectDN(fields, ContextTag(kTag_Issuer), writer));
+    }
+
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_NotBefore), fields.notBefore));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_NotAfter), fields.notAfter));
+
+    ReturnErrorOnFailure(WriteSubjectDN(fields, ContextTag(kTag_Subject), writer));
+
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_PublicKeyAlgorithm), GetOIDEnum(kOID_PubKeyAlgo_ECPublicKey)));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_EllipticCurveIdentifier), GetOIDEnum(kOID_EllipticCurve_prime256v1)));
+    ReturnErrorOnFailure(
+        writer.PutBytes(ContextTag(kTag_EllipticCurvePublicKey), fields.publicKey, static_cast<uint32_t>(kP256_PublicKey_Length)));
+
+    ReturnErrorOnFailure(WriteExtensions(fields, writer));
+
+    ReturnErrorOnFailure(writer.StartContainer(ContextTag(kTag_ECDSASignature), kTLVType_Structure, signatureContainer));
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_ECDSASignature_r), r, rLen));
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_ECDSASignature_s), s, sLen));
+    ReturnErrorOnFailure(writer.EndContainer(signatureContainer));
+
+    ReturnErrorOnFailure(writer.EndContainer(outerContainer));
+    ReturnErrorOnFailure(writer.Finalize());
+
+    certLen = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * Encode the certificate described by @p fields, signed with @p signer.
+ */
+CHIP_ERROR SignCert(const CertFields & fields, P256Keypair & signer, ChipCertificateSet & scratch, uint8_t * certBuf,
+                    uint32_t certBufSize, uint32_t & certLen)
+{
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    const uint8_t placeholder[] = { 0 };
+    P256ECDSASignature signature;
+    ASN1Reader reader;
+    const uint8_t * r;
+    uint32_t rLen;
+
+    // Encode the certificate with a placeholder signature to compute the hash of its TBS portion.
+    ReturnErrorOnFailure(WriteCert(fields, placeholder, sizeof(placeholder), placeholder, sizeof(placeholder), certBuf,
+                                   certBufSize, certLen));
+
+    scratch.Clear();
+    ReturnErrorOnFailure(scratch.LoadCert(certBuf, certLen, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
+    ReturnErrorOnFailure(signer.ECDSA_sign_hash(scratch.GetLastCert()->mTBSHash, kSHA256_Hash_Length, signature));
+
+    // The signature is an Ecdsa-Sig-Value; the certificate carries the contents of its r and s INTEGERs.
+    reader.Init(signature, static_cast<uint32_t>(signature.Length()));
+
+    // Ecdsa-Sig-Value ::= SEQUENCE
+    ASN1_PARSE_ENTER_SEQUENCE
+    {
+        // r INTEGER
+        ASN1_PARSE_ELEMENT(kASN1TagClass_Universal, kASN1UniversalTag_Integer);
+        r    = reader.GetValue();
+        rLen = reader.GetValueLen();
+
+        // s INTEGER
+        ASN1_PARSE_ELEMENT(kASN1TagClass_Universal, kASN1UniversalTag_Integer);
+        err = WriteCert(fields, r, rLen, reader.GetValue(), reader.GetValueLen(), certBuf, certBufSize, certLen);
+        SuccessOrExit(err);
+    }
+    ASN1_EXIT_SEQUENCE;
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MakeSerialNumber(uint8_t (&serialNumber)[kSerialNumberLength])
+{
+    ReturnErrorOnFailure(DRBG_get_bytes(serialNumber, sizeof(serialNumber)));
+
+    // Keep the DER INTEGER positive and minimally encoded.
+    serialNumber[0] = static_cast<uint8_t>((serialNumber[0] & 0x7F) | 0x40);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MakeKeyIdentifier(const P256PublicKey & publicKey, uint8_t (&keyId)[kKeyIdentifierLength])
+{
+    uint8_t hash[kSHA256_Hash_Length];
+
+    // RFC 7093 method 1: the leftmost 160 bits of the SHA-256 hash of the public key.
+    ReturnErrorOnFailure(Hash_SHA256(publicKey, publicKey.Length(), hash));
+    memcpy(keyId, hash, sizeof(keyId));
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+CHIP_ERROR CertificateAuthority::Create(uint64_t rootId, uint32_t notBefore, uint32_t notAfter)
+{
+    CertFields fields;
+    ChipCertificateData certData[1];
+    uint8_t decodeBuf[kCertDecodeBufferSize];
+    ChipCertificateSet scratch;
+
+    ReturnErrorOnFailure(mKeypair.Initialize());
+    ReturnErrorOnFailure(mKeypair.Serialize(mSerializedKeypair));
+
+    ReturnErrorOnFailure(MakeSerialNumber(fields.serialNumber));
+    ReturnErrorOnFailure(MakeKeyIdentifier(mKeypair.Pubkey(), fields.subjectKeyId));
+    fields.issuer         = nullptr;
+    fields.subjectIdOID   = kOID_AttributeType_ChipRootId;
+    fields.subjectId      = rootId;
+    fields.fabricId       = 0;
+    fields.notBefore      = notBefore;
+    fields.notAfter       = notAfter;
+    fields.publicKey      = mKeypair.Pubkey();
+    fields.isCA           = true;
+    fields.keyUsage       = BitFlags<KeyUsageFlags>(KeyUsageFlags::kKeyCertSign, KeyUsageFlags::kCRLSign);
+    fields.authorityKeyId = fields.subjectKeyId;
+
+    ReturnErrorOnFailure(scratch.Init(certData, ArraySize(certData), decodeBuf, sizeof(decodeBuf)));
+    ReturnErrorOnFailure(SignCert(fields, mKeypair, scratch, mCert, sizeof(mCert), mCertLen));
+
+    return IndexCert();
+}
+
+CHIP_ERROR CertificateAuthority::Load(const uint8_t * cert, uint32_t certLen, P256SerializedKeypair & serializedKeypair)
+{
+    // An X.509 certificate starts with a DER SEQUENCE, which is not a valid CHIP TLV control byte for a certificate.
+    if (certLen > 0 && cert[0] == 0x30)
+    {
+        ReturnErrorOnFailure(ConvertX509CertToChipCert(cert, certLen, mCert, sizeof(mCert), mCertLen));
+    }
+    else
+    {
+        VerifyOrReturnError(certLen <= sizeof(mCert), CHIP_ERROR_BUFFER_TOO_SMALL);
+        memcpy(mCert, cert, certLen);
+        mCertLen = certLen;
+    }
+
+    VerifyOrReturnError(serializedKeypair.Length() <= mSerializedKeypair.Capacity(), CHIP_ERROR_INVALID_ARGUMENT);
+    memcpy(mSerializedKeypair, serializedKeypair, serializedKeypair.Length());
+    ReturnErrorOnFailure(mSerializedKeypair.SetLength(serializedKeypair.Length()));
+    ReturnErrorOnFailure(mKeypair.Deserialize(mSerializedKeypair));
+
+    ReturnErrorOnFailure(IndexCert());
+
+    // The keypair must match the certificate
+    VerifyOrReturnError(memcmp(mPublicKey, mKeypair.Pubkey(), kP256_PublicKey_Length) == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CertificateAuthority::IndexCert()
+{
+    CHIP_ERROR err;
+    TLVReader reader;
+    TLVType containerType;
+    ChipCertificateData certData;
+
+    ReturnErrorOnFailure(DecodeChipCert(mCert, mCertLen, certData));
+    VerifyOrReturnError(certData.mCertFlags.Has(CertFlags::kIsCA), CHIP_ERROR_WRONG_CERT_TYPE);
+    VerifyOrReturnError(certData.mKeyUsageFlags.Has(KeyUsageFlags::kKeyCertSign), CHIP_ERROR_CERT_USAGE_NOT_ALLOWED);
+    VerifyOrReturnError(certData.mSubjectKeyId.mLen == kKeyIdentifierLength, CHIP_ERROR_UNSUPPORTED_CERT_FORMAT);
+    VerifyOrReturnError(certData.mPublicKeyLen == kP256_PublicKey_Length, CHIP_ERROR_UNSUPPORTED_CERT_FORMAT);
+    memcpy(mSubjectKeyId, certData.mSubjectKeyId.mId, kKeyIdentifierLength);
+    memcpy(mPublicKey, certData.mPublicKey, kP256_PublicKey_Length);
+
+    // Remember where the subject DN is, to copy it into the issuer DN of the certificates this CA issues.
+    reader.Init(mCert, mCertLen);
+    ReturnErrorOnFailure(
+        reader.Next(kTLVType_Structure, ProfileTag(Protocols::OpCredentials::Id.ToTLVProfileId(), kTag_ChipCertificate)));
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (reader.GetTag() == ContextTag(kTag_Subject))
+        {
+            mSubjectReader = reader;
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    return err == CHIP_END_OF_TLV ? CHIP_ERROR_UNSUPPORTED_CERT_FORMAT : err;
+}
+
+CHIP_ERROR CertificateAuthority::IssueNodeCert(uint64_t nodeId, uint64_t fabricId, const P256PublicKey & publicKey,
+                                               uint32_t notBefore, uint32_t notAfter, P256Keypair & signer,
+                                               ChipCertificateSet & scratch, uint8_t * certBuf, uint32_t certBufSize,
+                                               uint32_t & certLen) const
+{
+    CertFields fields;
+
+    ReturnErrorOnFailure(MakeSerialNumber(fields.serialNumber));
+    ReturnErrorOnFailure(MakeKeyIdentifier(publicKey, fields.subjectKeyId));
+    fields.issuer         = &mSubjectReader;
+    fields.subjectIdOID   = kOID_AttributeType_ChipNodeId;
+    fields.subjectId      = nodeId;
+    fields.fabricId       = fabricId;
+    fields.notBefore      = notBefore;
+    fields.notAfter       = notAfter;
+    fields.publicKey      = publicKey;
+    fields.isCA           = false;
+    fields.keyUsage       = BitFlags<KeyUsageFlags>(KeyUsageFlags::kDigitalSignature);
+    fields.authorityKeyId = mSubjectKeyId;
+
+    return SignCert(fields, signer, scratch, certBuf, certBufSize, certLen);
+}
+
+CHIP_ERROR BundleGenerator::Init(const CertificateAuthority & ca)
+{
+    P256SerializedKeypair serializedKeypair;
+
+    // Each generator signs with its own copy of the CA key, so that no crypto state is shared between threads.
+    memcpy(serializedKeypair, ca.GetSerializedKeypair(), ca.GetSerializedKeypair().Length());
+    ReturnErrorOnFailure(serializedKeypair.SetLength(ca.GetSerializedKeypair().Length()));
+    ReturnErrorOnFailure(mSigner.Deserialize(serializedKeypair));
+
+    return mScratch.Init(mCertData, ArraySize(mCertData), mDecodeBuf, sizeof(mDecodeBuf));
+}
+
+CHIP_ERROR BundleGenerator::Generate(const CertificateAuthority & ca, uint64_t fabricId, uint64_t nodeId, uint32_t notBefore,
+                                     uint32_t notAfter, TLVWriter & writer)
+{
+    TLVType outerContainer;
+    PASEVerifier verifier;
+    P256Keypair keypair;
+    P256SerializedKeypair serializedKeypair;
+    uint32_t setUpPINCode;
+    uint16_t discriminator;
+    uint32_t certLen;
+
+    ReturnErrorOnFailure(GenerateRandomSetupPINCode(setUpPINCode));
+
+    ReturnErrorOnFailure(DRBG_get_bytes(reinterpret_cast<uint8_t *>(&discriminator), sizeof(discriminator)));
+    discriminator &= kMaxDiscriminatorValue;
+
+    ReturnErrorOnFailure(PASESession::GeneratePASEVerifier(verifier, false, setUpPINCode));
+
+    ReturnErrorOnFailure(keypair.Initialize());
+    ReturnErrorOnFailure(keypair.Serialize(serializedKeypair));
+
+    ReturnErrorOnFailure(ca.IssueNodeCert(nodeId, fabricId, keypair.Pubkey(), notBefore, notAfter, mSigner, mScratch, mCertBuf,
+                                          sizeof(mCertBuf), certLen));
+
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainer));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_Bundle_NodeId), nodeId));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_Bundle_SetupPINCode), setUpPINCode));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_Bundle_Discriminator), discriminator));
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_Bundle_PASEVerifier), &verifier[0][0], sizeof(verifier)));
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_Bundle_OperationalKeypair), serializedKeypair,
+                                         static_cast<uint32_t>(serializedKeypair.Length())));
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_Bundle_OperationalCert), mCertBuf, certLen));
+    return writer.EndContainer(outerContainer);
+}
+
+CHIP_ERROR WriteArchiveHeader(const CertificateAuthority & ca, uint64_t fabricId, TLVWriter & writer)
+{
+    TLVType outerContainer;
+
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainer));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_Header_FormatVersion), kArchiveFormatVersion));
+    ReturnErrorOnFailure(writer.Put(ContextTag(kTag_Header_FabricId), fabricId));
+    ReturnErrorOnFailure(writer.PutBytes(ContextTag(kTag_Header_CACert), ca.GetCert(), ca.GetCertLength()));
+    return writer.EndContainer(outerContainer);
+}
+
+} // namespace FactoryTool
+} // namespace chip
@@ -0,0 +1,149 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Generation of per-device factory credential bundles.
+ *
+ *      A credential archive is a stream of anonymous CHIP TLV structures: a
+ *      header describing the certificate authority, followed by one bundle
+ *      per device:
+ *
+ *          header := {
+ *              1: format version (unsigned int),
+ *              2: fabric id (unsigned int),
+ *              3: CA certificate, CHIP TLV encoded (byte string),
+ *          }
+ *
+ *          bundle := {
+ *              1: node id (unsigned int),
+ *              2: setup PIN code (unsigned int),
+ *              3: discriminator (unsigned int),
+ *              4: PASE verifier (byte string),
+ *              5: serialized operational keypair (byte string),
+ *              6: operational certificate, CHIP TLV encoded (byte string),
+ *          }
+ */
+
+#pragma once
+
+#include <core/CHIPTLV.h>
+#include <credentials/CHIPCert.h>
+#include <crypto/CHIPCryptoPAL.h>
+
+namespace chip {
+namespace FactoryTool {
+
+constexpr uint32_t kArchiveFormatVersion = 1;
+
+enum
+{
+    // Archive header tags
+    kTag_Header_FormatVersion = 1,
+    kTag_Header_FabricId      = 2,
+    kTag_Header_CACert        = 3,
+
+    // Device bundle tags
+    kTag_Bundle_NodeId             = 1,
+    kTag_Bundle_SetupPINCode       = 2,
+    kTag_Bundle_Discriminator      = 3,
+    kTag_Bundle_PASEVerifier       = 4,
+    kTag_Bundle_OperationalKeypair = 5,
+    kTag_Bundle_OperationalCert    = 6,
+};
+
+// Upper bound on the CHIP TLV encoding of the certificates issued by this tool
+constexpr uint32_t kMaxChipCertLength = 400;
+// Upper bound on the TLV encoding of a device bundle
+constexpr uint32_t kMaxBundleLength = 600;
+// Size of the buffer a ChipCertificateSet needs to re-encode a certificate TBS in DER
+constexpr uint16_t kCertDecodeBufferSize = 800;
+
+/**
+ * The certificate authority that signs the operational certificates.
+ */
+class CertificateAuthority
+{
+public:
+    /**
+     * Create a new self-signed root CA certificate and keypair.
+     *
+     * @param rootId     Value of the ChipRootId attribute of the CA subject.
+     * @param notBefore  Start of the validity period, in CHIP epoch seconds.
+     * @param notAfter   End of the validity period, in CHIP epoch seconds.
+     */
+    CHIP_ERROR Create(uint64_t rootId, uint32_t notBefore, uint32_t notAfter);
+
+    /**
+     * Load a CA from its certificate, in X.509 DER or CHIP TLV encoding, and its serialized keypair.
+     */
+    CHIP_ERROR Load(const uint8_t * cert, uint32_t certLen, Crypto::P256SerializedKeypair & serializedKeypair);
+
+    const uint8_t * GetCert() const { return mCert; }
+    uint32_t GetCertLength() const { return mCertLen; }
+    const Crypto::P256SerializedKeypair & GetSerializedKeypair() const { return mSerializedKeypair; }
+
+    /**
+     * Issue a node operational certificate for @p publicKey, signed with @p signer, which holds the CA key.
+     * Safe to call concurrently from several threads, each with its own @p signer and @p scratch certificate set.
+     */
+    CHIP_ERROR IssueNodeCert(uint64_t nodeId, uint64_t fabricId, const Crypto::P256PublicKey & publicKey, uint32_t notBefore,
+                             uint32_t notAfter, Crypto::P256Keypair & signer, Credentials::ChipCertificateSet & scratch,
+                             uint8_t * certBuf, uint32_t certBufSize, uint32_t & certLen) const;
+
+private:
+    CHIP_ERROR IndexCert();
+
+    Crypto::P256Keypair mKeypair;
+    Crypto::P256SerializedKeypair mSerializedKeypair;
+    uint8_t mCert[kMaxChipCertLength];
+    uint32_t mCertLen = 0;
+    uint8_t mPublicKey[Crypto::kP256_PublicKey_Length];
+    uint8_t mSubjectKeyId[Credentials::kKeyIdentifierLength];
+    // Positioned on the subject DN of mCert, which is the issuer DN of the certificates this CA issues.
+    TLV::TLVReader mSubjectReader;
+};
+
+/**
+ * Per-thread state for generating device bundles.
+ */
+class BundleGenerator
+{
+public:
+    CHIP_ERROR Init(const CertificateAuthority & ca);
+
+    /**
+     * Generate the credentials of device @p nodeId and append its bundle to @p writer.
+     */
+    CHIP_ERROR Generate(const CertificateAuthority & ca, uint64_t fabricId, uint64_t nodeId, uint32_t notBefore,
+                        uint32_t notAfter, TLV::TLVWriter & writer);
+
+private:
+    Crypto::P256Keypair mSigner;
+    Credentials::ChipCertificateData mCertData[1];
+    uint8_t mDecodeBuf[kCertDecodeBufferSize];
+    Credentials::ChipCertificateSet mScratch;
+    uint8_t mCertBuf[kMaxChipCertLength];
+};
+
+/**
+ * Write the archive header for @p ca to @p writer.
+ */
+CHIP_ERROR WriteArchiveHeader(const CertificateAuthority & ca, uint64_t fabricId, TLV::TLVWriter & writer);
+
+} // namespace FactoryTool
+} // namespace chip
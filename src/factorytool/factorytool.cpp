@@ -0,0 +1,506 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Host tool generating factory credentials for a batch of devices: a
+ *      setup PIN code and PASE verifier, an operational keypair and an
+ *      operational certificate per device, streamed to a TLV archive (see
+ *      credential_bundle.h). Devices are spread across all cores.
+ */
+
+#include "credential_bundle.h"
+
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::FactoryTool;
+
+namespace {
+
+// Number of devices each thread generates before the archive is written out; bounds the memory used.
+constexpr uint64_t kBlockSize        = 1024;
+constexpr uint32_t kDefaultValidity  = 10;
+constexpr uint64_t kDefaultRootId    = 1;
+constexpr size_t kMaxCACertFileSize  = 1024;
+constexpr uint64_t kMaxValidityYears = 100;
+
+struct Options
+{
+    const char * caKeyPath  = nullptr;
+    const char * caCertPath = nullptr;
+    const char * outputPath = nullptr;
+    uint64_t rootId         = kDefaultRootId;
+    uint64_t fabricId       = 0;
+    uint64_t count          = 0;
+    uint64_t firstNodeId    = 1;
+    uint64_t validityYears  = kDefaultValidity;
+    unsigned threadCount    = 0;
+};
+
+bool ParseUnsigned(const char * str, uint64_t & value)
+{
+    char * end;
+    errno = 0;
+    value = strtoull(str, &end, 0);
+    return errno == 0 && end != str && *end == '\0';
+}
+
+bool ParseOptions(int argc, char * const * argv, const char * optstring, Options & options)
+{
+    int ch;
+    uint64_t value;
+
+    optind = 1;
+    while ((ch = getopt(argc, argv, optstring)) != -1)
+    {
+        switch (ch)
+        {
+        case 'k':
+            options.caKeyPath = optarg;
+            break;
+
+        case 'c':
+            options.caCertPath = optarg;
+            break;
+
+        case 'o':
+            options.outputPath = optarg;
+            break;
+
+        case 'r':
+            if (!ParseUnsigned(optarg, options.rootId))
+            {
+                return false;
+            }
+            break;
+
+        case 'f':
+            if (!ParseUnsigned(optarg, options.fabricId) || options.fabricId == 0)
+            {
+                return false;
+            }
+            break;
+
+        case 'n':
+            if (!ParseUnsigned(optarg, options.count))
+            {
+                return false;
+            }
+            break;
+
+        case 's':
+            if (!ParseUnsigned(optarg, options.firstNodeId))
+            {
+                return false;
+            }
+            break;
+
+        case 'y':
+            if (!ParseUnsigned(optarg, options.validityYears) || options.validityYears == 0 ||
+                options.validityYears > kMaxValidityYears)
+            {
+                return false;
+            }
+            break;
+
+        case 't':
+            if (!ParseUnsigned(optarg, value) || value == 0 || value > 1024)
+            {
+                return false;
+            }
+            options.threadCount = static_cast<unsigned>(value);
+            break;
+
+        case '?':
+        default:
+            return false;
+        }
+    }
+
+    if (options.threadCount == 0)
+    {
+        options.threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    return true;
+}
+
+/**
+ * Compute the validity period of the certificates: from now, for @p years years.
+ */
+CHIP_ERROR GetValidity(uint64_t years, uint32_t & notBefore, uint32_t & notAfter)
+{
+    time_t now = time(nullptr);
+    struct tm utc;
+    ASN1::ASN1UniversalTime asn1Time;
+
+    VerifyOrReturnError(gmtime_r(&now, &utc) != nullptr, CHIP_ERROR_INTERNAL);
+
+    asn1Time.Year   = static_cast<uint16_t>(utc.tm_year + 1900);
+    asn1Time.Month  = static_cast<uint8_t>(utc.tm_mon + 1);
+    asn1Time.Day    = static_cast<uint8_t>(utc.tm_mday);
+    asn1Time.Hour   = static_cast<uint8_t>(utc.tm_hour);
+    asn1Time.Minute = static_cast<uint8_t>(utc.tm_min);
+    asn1Time.Second = static_cast<uint8_t>(std::min(utc.tm_sec, 59));
+    ReturnErrorOnFailure(Credentials::ASN1ToChipEpochTime(asn1Time, notBefore));
+
+    asn1Time.Year = static_cast<uint16_t>(asn1Time.Year + years);
+    if (asn1Time.Month == 2 && asn1Time.Day == 29)
+    {
+        asn1Time.Day = 28;
+    }
+    return Credentials::ASN1ToChipEpochTime(asn1Time, notAfter);
+}
+
+bool ReadFile(const char * path, uint8_t * buf, size_t bufSize, size_t & length)
+{
+    FILE * file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        ChipLogError(chipTool, "Failed to open %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    length    = fread(buf, 1, bufSize, file);
+    bool full = length == bufSize && fgetc(file) != EOF;
+    bool ok   = ferror(file) == 0 && !full;
+    fclose(file);
+
+    if (!ok)
+    {
+        ChipLogError(chipTool, "Failed to read %s", path);
+    }
+    return ok;
+}
+
+/**
+ * Opens a file for writing that only its owner can read, since the CA key and
+ * the archive hold private keys. An existing file is truncated and its mode
+ * tightened.
+ */
+FILE * OpenPrivateFile(const char * path)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrReturnError(fd >= 0, nullptr);
+
+    FILE * file = (fchmod(fd, S_IRUSR | S_IWUSR) == 0) ? fdopen(fd, "wb") : nullptr;
+    if (file == nullptr)
+    {
+        int savedErrno = errno;
+        close(fd);
+        errno = savedErrno;
+    }
+    return file;
+}
+
+bool WriteFile(const char * path, const uint8_t * buf, size_t length)
+{
+    FILE * file = OpenPrivateFile(path);
+    if (file == nullptr)
+    {
+        ChipLogError(chipTool, "Failed to open %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    bool ok = fwrite(buf, 1, length, file) == length;
+    ok      = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        ChipLogError(chipTool, "Failed to write %s", path);
+    }
+    return ok;
+}
+
+CHIP_ERROR LoadCA(const Options & options, CertificateAuthority & ca)
+{
+    uint8_t cert[kMaxCACertFileSize];
+    size_t certLen;
+    Crypto::P256SerializedKeypair serializedKeypair;
+    size_t keypairLen;
+
+    VerifyOrReturnError(ReadFile(options.caCertPath, cert, sizeof(cert), certLen), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(ReadFile(options.caKeyPath, serializedKeypair, serializedKeypair.Capacity(), keypairLen),
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(serializedKeypair.SetLength(keypairLen));
+
+    return ca.Load(cert, static_cast<uint32_t>(certLen), serializedKeypair);
+}
+
+// Generates the devices [first, first + count) into output.
+CHIP_ERROR GenerateBlock(BundleGenerator & generator, const CertificateAuthority & ca, const Options & options, uint32_t notBefore,
+                         uint32_t notAfter, uint64_t first, uint64_t count, std::vector<uint8_t> & output, uint32_t & length)
+{
+    TLV::TLVWriter writer;
+
+    output.resize(static_cast<size_t>(count * kMaxBundleLength));
+    writer.Init(output.data(), static_cast<uint32_t>(output.size()));
+
+    for (uint64_t nodeId = first; nodeId < first + count; nodeId++)
+    {
+        ReturnErrorOnFailure(generator.Generate(ca, options.fabricId, nodeId, notBefore, notAfter, writer));
+    }
+
+    ReturnErrorOnFailure(writer.Finalize());
+    length = writer.GetLengthWritten();
+    return CHIP_NO_ERROR;
+}
+
+int CommandNewCA(int argc, char * const * argv)
+{
+    Options options;
+    CertificateAuthority ca;
+    uint32_t notBefore;
+    uint32_t notAfter;
+    CHIP_ERROR err;
+
+    if (!ParseOptions(argc, argv, "k:c:r:y:", options) || options.caKeyPath == nullptr || options.caCertPath == nullptr)
+    {
+        return 2;
+    }
+
+    err = GetValidity(options.validityYears, notBefore, notAfter);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = ca.Create(options.rootId, notBefore, notAfter);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipTool, "Failed to create the CA: %s", ErrorStr(err));
+        return 2;
+    }
+
+    if (!WriteFile(options.caKeyPath, ca.GetSerializedKeypair(), ca.GetSerializedKeypair().Length()) ||
+        !WriteFile(options.caCertPath, ca.GetCert(), ca.GetCertLength()))
+    {
+        return 2;
+    }
+
+    ChipLogDetail(chipTool, "Created root CA 0x%016" PRIX64, options.rootId);
+    return 0;
+}
+
+int CommandGenerate(int argc, char * const * argv)
+{
+    Options options;
+    CertificateAuthority ca;
+    uint32_t notBefore;
+    uint32_t notAfter;
+    CHIP_ERROR err;
+
+    if (!ParseOptions(argc, argv, "k:c:f:n:o:s:t:y:", options) || options.caKeyPath == nullptr ||
+        options.caCertPath == nullptr || options.outputPath == nullptr || options.fabricId == 0 || options.count == 0)
+    {
+        return 2;
+    }
+
+    err = LoadCA(options, ca);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = GetValidity(options.validityYears, notBefore, notAfter);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipTool, "Failed to load the CA: %s", ErrorStr(err));
+        return 2;
+    }
+
+    std::unique_ptr<BundleGenerator[]> generators(new BundleGenerator[options.threadCount]);
+    for (unsigned worker = 0; worker < options.threadCount; worker++)
+    {
+        err = generators[worker].Init(ca);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(chipTool, "Failed to initialize: %s", ErrorStr(err));
+            return 2;
+        }
+    }
+
+    FILE * output = OpenPrivateFile(options.outputPath);
+    if (output == nullptr)
+    {
+        ChipLogError(chipTool, "Failed to open %s: %s", options.outputPath, strerror(errno));
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    {
+        uint8_t header[kMaxChipCertLength + 32];
+        TLV::TLVWriter writer;
+
+        writer.Init(header, sizeof(header));
+        err = WriteArchiveHeader(ca, options.fabricId, writer);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = writer.Finalize();
+        }
+        if (err == CHIP_NO_ERROR && fwrite(header, 1, writer.GetLengthWritten(), output) != writer.GetLengthWritten())
+        {
+            err = CHIP_ERROR_WRITE_FAILED;
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> outputs(options.threadCount);
+    std::vector<uint32_t> lengths(options.threadCount);
+    std::vector<CHIP_ERROR> errors(options.threadCount);
+
+    for (uint64_t done = 0; done < options.count && err == CHIP_NO_ERROR;)
+    {
+        uint64_t blockCount = std::min(kBlockSize * options.threadCount, options.count - done);
+        uint64_t share      = (blockCount + options.threadCount - 1) / options.threadCount;
+        uint64_t blockStart = options.firstNodeId + done;
+        std::vector<std::thread> threads;
+
+        for (unsigned worker = 0; worker < options.threadCount; worker++)
+        {
+            uint64_t first = blockStart + std::min(worker * share, blockCount);
+            uint64_t count = std::min(share, blockStart + blockCount - first);
+
+            threads.emplace_back([&, worker, first, count]() {
+                errors[worker] = GenerateBlock(generators[worker], ca, options, notBefore, notAfter, first, count, outputs[worker],
+                                               lengths[worker]);
+            });
+        }
+
+        for (std::thread & thread : threads)
+        {
+            thread.join();
+        }
+
+        for (unsigned worker = 0; worker < options.threadCount && err == CHIP_NO_ERROR; worker++)
+        {
+            err = errors[worker];
+            if (err == CHIP_NO_ERROR && fwrite(outputs[worker].data(), 1, lengths[worker], output) != lengths[worker])
+            {
+                err = CHIP_ERROR_WRITE_FAILED;
+            }
+        }
+
+        done += blockCount;
+        if (err == CHIP_NO_ERROR && done < options.count)
+        {
+            ChipLogProgress(chipTool, "%" PRIu64 "/%" PRIu64 " devices", done, options.count);
+        }
+    }
+
+    if (fclose(output) != 0 && err == CHIP_NO_ERROR)
+    {
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipTool, "Credential generation failed: %s", ErrorStr(err));
+        return 2;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ChipLogDetail(chipTool, "Generated credentials for %" PRIu64 " devices on %u threads in %.3f s (%.1f devices/s)", options.count,
+                  options.threadCount, elapsed, static_cast<double>(options.count) / elapsed);
+    return 0;
+}
+
+struct Command
+{
+    const char * name;
+    int (*func)(int argc, char * const * argv);
+    const char * usage;
+};
+
+const Command kCommands[] = {
+    { "new-ca", CommandNewCA,
+      "-k key-path -c cert-path [-r root-id] [-y years]\n"
+      "    Create a self-signed root CA.\n"
+      "    -k File path the serialized CA keypair is written to.\n"
+      "    -c File path the CHIP TLV encoded CA certificate is written to.\n"
+      "    -r Root id of the CA, 1 by default.\n"
+      "    -y Validity period in years, 10 by default.\n" },
+    { "generate", CommandGenerate,
+      "-k key-path -c cert-path -f fabric-id -n count -o output-path [-s first-node-id] [-t threads] [-y years]\n"
+      "    Generate the credentials of a batch of devices.\n"
+      "    -k File path of the serialized CA keypair.\n"
+      "    -c File path of the CA certificate, X.509 DER or CHIP TLV encoded.\n"
+      "    -f Fabric id of the operational certificates.\n"
+      "    -n Number of devices.\n"
+      "    -o File path of the credential archive.\n"
+      "    -s Node id of the first device, 1 by default.\n"
+      "    -t Number of threads, one per core by default.\n"
+      "    -y Validity period in years, 10 by default.\n" },
+};
+
+int Usage(const char * progName)
+{
+    ChipLogDetail(chipTool, "Usage: %s command [opt ...]", progName);
+    for (const Command & command : kCommands)
+    {
+        ChipLogDetail(chipTool, "%s %s", command.name, command.usage);
+    }
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    const char * progName = strrchr(argv[0], '/');
+    progName              = progName ? progName + 1 : argv[0];
+
+    if (argc < 2)
+    {
+        return Usage(progName);
+    }
+
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        return 2;
+    }
+
+    for (const Command & command : kCommands)
+    {
+        if (strcmp(command.name, argv[1]) == 0)
+        {
+            int result = command.func(argc - 1, argv + 1);
+            if (result == 2)
+            {
+                Usage(progName);
+            }
+            Platform::MemoryShutdown();
+            return result;
+        }
+    }
+
+    Platform::MemoryShutdown();
+    return Usage(progName);
+}
@@ -0,0 +1,172 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Unit tests for the factory credential bundle generator.
+ *
+ */
+
+#include <factorytool/credential_bundle.h>
+
+#include <core/CHIPTLV.h>
+#include <credentials/CHIPCert.h>
+#include <setup_payload/SetupPayload.h>
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Credentials;
+using namespace chip::FactoryTool;
+using namespace chip::TLV;
+
+namespace {
+
+constexpr uint64_t kTestRootId    = 1;
+constexpr uint64_t kTestFabricId  = 0xFAB000000000001D;
+constexpr uint64_t kTestNodeId    = 0xDEDEDEDE00010001;
+constexpr uint32_t kTestNotBefore = 100000000;
+constexpr uint32_t kTestNotAfter  = 200000000;
+
+void TestCredentialBundle_Generate(nlTestSuite * inSuite, void * inContext)
+{
+    CertificateAuthority ca;
+    BundleGenerator generator;
+    uint8_t bundle[kMaxBundleLength];
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainer;
+    uint64_t nodeId          = 0;
+    uint32_t setUpPINCode    = 0;
+    uint16_t discriminator   = UINT16_MAX;
+    const uint8_t * nodeCert = nullptr;
+    uint32_t nodeCertLen     = 0;
+    ChipCertificateSet certSet;
+    ValidationContext validContext;
+
+    NL_TEST_ASSERT(inSuite, ca.Create(kTestRootId, kTestNotBefore, kTestNotAfter) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, generator.Init(ca) == CHIP_NO_ERROR);
+
+    writer.Init(bundle, sizeof(bundle));
+    NL_TEST_ASSERT(inSuite,
+                   generator.Generate(ca, kTestFabricId, kTestNodeId, kTestNotBefore, kTestNotAfter, writer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    reader.Init(bundle, writer.GetLengthWritten());
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_Structure, AnonymousTag) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.EnterContainer(outerContainer) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_Bundle_NodeId)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Get(nodeId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, nodeId == kTestNodeId);
+
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_Bundle_SetupPINCode)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Get(setUpPINCode) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsValidSetupPINCode(setUpPINCode));
+
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_Bundle_Discriminator)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Get(discriminator) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, discriminator <= kMaxDiscriminatorValue);
+
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_ByteString, ContextTag(kTag_Bundle_PASEVerifier)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_ByteString, ContextTag(kTag_Bundle_OperationalKeypair)) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, reader.Next(kTLVType_ByteString, ContextTag(kTag_Bundle_OperationalCert)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetDataPtr(nodeCert) == CHIP_NO_ERROR);
+    nodeCertLen = reader.GetLength();
+
+    NL_TEST_ASSERT(inSuite, reader.ExitContainer(outerContainer) == CHIP_NO_ERROR);
+
+    // The operational certificate must chain to the CA.
+    NL_TEST_ASSERT(inSuite, certSet.Init(2, kCertDecodeBufferSize) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   certSet.LoadCert(ca.GetCert(), ca.GetCertLength(), BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   certSet.LoadCert(nodeCert, nodeCertLen, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)) ==
+                       CHIP_NO_ERROR);
+
+    validContext.Reset();
+    validContext.mEffectiveTime = (kTestNotBefore + kTestNotAfter) / 2;
+    validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+    validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+    validContext.mRequiredCertType = kCertType_Node;
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(certSet.GetLastCert(), validContext) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, validContext.mTrustAnchor == &certSet.GetCertSet()[0]);
+
+    // Outside the validity period of the CA the chain must be rejected.
+    validContext.Reset();
+    validContext.mEffectiveTime = kTestNotAfter + 1;
+    NL_TEST_ASSERT(inSuite, certSet.ValidateCert(certSet.GetLastCert(), validContext) != CHIP_NO_ERROR);
+
+    certSet.Release();
+}
+
+/**
+ *  Set up the test suite.
+ */
+int TestCredentialBundle_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+
+    if (error != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestCredentialBundle_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test Credential Bundle Generation", TestCredentialBundle_Generate),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestCredentialBundle()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "FactoryTool-Credential-Bundle",
+        &sTests[0],
+        TestCredentialBundle_Setup,
+        TestCredentialBundle_Teardown
+    };
+    // clang-format on
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCredentialBundle);
@@ -281,6 +281,15 @@ INET_ERROR DNSResolver::Cancel()
     inet.mAsyncDNSResolver.Cancel(*this);
 
 #endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+    InetLayer & inet = Layer();
+
+    OnComplete = nullptr;
+    AppState   = nullptr;
+    inet.mUDPDNSResolver.Cancel(*this);
+
+#endif // INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     return INET_NO_ERROR;
@@ -519,7 +528,89 @@ uint8_t DNSResolver::CountAddresses(int family, const struct addrinfo * addrs)
     return count;
 }
 
-#if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+/**
+ *  Copy a list of resolved addresses into the application's output array,
+ *  honoring the address family option of the request in the same way as
+ *  ProcessGetAddrInfoResult().
+ *
+ *  @return #INET_ERROR_HOST_NOT_FOUND if no address of a requested family was
+ *          present, otherwise #INET_NO_ERROR.
+ */
+INET_ERROR DNSResolver::ProcessAddressList(const IPAddress * addrs, uint8_t count)
+{
+    IPAddressType primaryType   = kIPAddressType_Any;
+    IPAddressType secondaryType = kIPAddressType_Unknown;
+
+    NumAddrs = 0;
+
+#if INET_CONFIG_ENABLE_IPV4
+    switch (DNSOptions & kDNSOption_AddrFamily_Mask)
+    {
+    case kDNSOption_AddrFamily_IPv4Only:
+        primaryType = kIPAddressType_IPv4;
+        break;
+    case kDNSOption_AddrFamily_IPv4Preferred:
+        primaryType   = kIPAddressType_IPv4;
+        secondaryType = kIPAddressType_IPv6;
+        break;
+    case kDNSOption_AddrFamily_IPv6Only:
+        primaryType = kIPAddressType_IPv6;
+        break;
+    case kDNSOption_AddrFamily_IPv6Preferred:
+        primaryType   = kIPAddressType_IPv6;
+        secondaryType = kIPAddressType_IPv4;
+        break;
+    default:
+        break;
+    }
+#else  // INET_CONFIG_ENABLE_IPV4
+    primaryType = kIPAddressType_IPv6;
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    uint8_t numPrimaryAddrs   = 0;
+    uint8_t numSecondaryAddrs = 0;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        IPAddressType type = addrs[i].Type();
+        if (primaryType == kIPAddressType_Any || type == primaryType)
+            numPrimaryAddrs++;
+        else if (type == secondaryType)
+            numSecondaryAddrs++;
+    }
+
+    // As with getaddrinfo() results, make room for at least one secondary address.
+    if (numPrimaryAddrs + numSecondaryAddrs > MaxAddrs && MaxAddrs > 1 && numPrimaryAddrs > 0 && numSecondaryAddrs > 0)
+    {
+        numPrimaryAddrs = ::chip::min(numPrimaryAddrs, static_cast<uint8_t>(MaxAddrs - 1));
+    }
+
+    for (uint8_t i = 0; i < count && NumAddrs < MaxAddrs && numPrimaryAddrs > 0; i++)
+    {
+        if (primaryType == kIPAddressType_Any || addrs[i].Type() == primaryType)
+        {
+            AddrArray[NumAddrs++] = addrs[i];
+            numPrimaryAddrs--;
+        }
+    }
+
+    for (uint8_t i = 0; i < count && NumAddrs < MaxAddrs && numSecondaryAddrs > 0; i++)
+    {
+        if (addrs[i].Type() == secondaryType)
+        {
+            AddrArray[NumAddrs++] = addrs[i];
+            numSecondaryAddrs--;
+        }
+    }
+
+    return (NumAddrs > 0) ? INET_NO_ERROR : INET_ERROR_HOST_NOT_FOUND;
+}
+
+#endif // INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+#if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 
 void DNSResolver::HandleAsyncResolveComplete()
 {
@@ -531,7 +622,7 @@ void DNSResolver::HandleAsyncResolveComplete()
 
     Release();
 }
-#endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
@@ -76,8 +76,9 @@ private:
     friend class InetLayer;
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-#if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
     friend class AsyncDNSResolverSockets;
+    friend class UDPDNSResolverSockets;
 
     /// States of the DNSResolver object with respect to hostname resolution.
     typedef enum DNSResolverState{
@@ -86,8 +87,8 @@ private:
         kState_Complete = 3, ///< Used to indicate that the DNS resolution on the DNSResolver object is complete.
         kState_Canceled = 4, ///< Used to indicate that the DNS resolution on the DNSResolver has been canceled.
     } DNSResolverState;
+#endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
-#endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
     /**
      * @brief   Type of event handling function called when a DNS request completes.
@@ -137,7 +138,11 @@ private:
     void CopyAddresses(int family, uint8_t maxAddrs, const struct addrinfo * addrs);
     uint8_t CountAddresses(int family, const struct addrinfo * addrs);
 
-#if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+    INET_ERROR ProcessAddressList(const IPAddress * addrs, uint8_t count);
+#endif // INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+#if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 
     /* Hostname that requires resolution */
     char asyncHostNameBuf[NL_DNS_HOSTNAME_MAX_LEN + 1]; // DNS limits hostnames to 253 max characters.
@@ -150,7 +155,7 @@ private:
 
     void HandleAsyncResolveComplete();
 
-#endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -19,127 +19,341 @@
 /**
  *    @file
  *      This file implements the human-readable string formatting and
- *      parsing methods from class <tt>Inet::IPAddress</tt>.
+ *      parsing methods from class <tt>Inet::IPAddress</tt>. They do not
+ *      depend on the C library or the network stack, so the behavior and
+ *      the cost are the same on every platform.
  *
  */
 
-#ifndef __STDC_LIMIT_MACROS
-#define __STDC_LIMIT_MACROS
-#endif
-#include <limits>
 #include <stdint.h>
 #include <string.h>
 
 #include <inet/InetLayer.h>
 #include <support/CodeUtils.h>
 
-#if !CHIP_SYSTEM_CONFIG_USE_LWIP
-#include <arpa/inet.h>
-#endif
-
 namespace chip {
 namespace Inet {
 
-char * IPAddress::ToString(char * buf, uint32_t bufSize) const
+namespace {
+
+// Longest output: "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff".
+constexpr size_t kMaxFormattedLength = 39;
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+char * FormatDecimalOctet(char * out, uint8_t value)
 {
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-#if INET_CONFIG_ENABLE_IPV4
-    if (IsIPv4())
+    if (value >= 100)
     {
-#if LWIP_VERSION_MAJOR > 1 || LWIP_VERSION_MINOR >= 5
-        ip4_addr_t ip4_addr = ToIPv4();
-        ip4addr_ntoa_r(&ip4_addr, buf, (int) bufSize);
-#else  // LWIP_VERSION_MAJOR <= 1
-        ip_addr_t ip4_addr = ToIPv4();
-        ipaddr_ntoa_r(&ip4_addr, buf, (int) bufSize);
-#endif // LWIP_VERSION_MAJOR <= 1
+        *out++ = static_cast<char>('0' + value / 100);
+        value  = static_cast<uint8_t>(value % 100);
+        *out++ = static_cast<char>('0' + value / 10);
+        value  = static_cast<uint8_t>(value % 10);
     }
-    else
-#endif // INET_CONFIG_ENABLE_IPV4
+    else if (value >= 10)
     {
-        ip6_addr_t ip6_addr = ToIPv6();
-        ip6addr_ntoa_r(&ip6_addr, buf, (int) bufSize);
+        *out++ = static_cast<char>('0' + value / 10);
+        value  = static_cast<uint8_t>(value % 10);
     }
-#else // !CHIP_SYSTEM_CONFIG_USE_LWIP
-    // socklen_t is sometimes signed, sometimes not, so the only safe way to do
-    // this is to promote everything to an unsigned type that's known to be big
-    // enough for everything, then cast back to uint32_t after taking the min.
-    bufSize =
-        static_cast<uint32_t>(min(static_cast<uintmax_t>(std::numeric_limits<socklen_t>::max()), static_cast<uintmax_t>(bufSize)));
-#if INET_CONFIG_ENABLE_IPV4
-    if (IsIPv4())
+    *out++ = static_cast<char>('0' + value);
+
+    return out;
+}
+
+char * FormatIPv4(char * out, const uint8_t * bytes)
+{
+    out    = FormatDecimalOctet(out, bytes[0]);
+    *out++ = '.';
+    out    = FormatDecimalOctet(out, bytes[1]);
+    *out++ = '.';
+    out    = FormatDecimalOctet(out, bytes[2]);
+    *out++ = '.';
+    return FormatDecimalOctet(out, bytes[3]);
+}
+
+char * FormatHexWord(char * out, uint16_t value)
+{
+    // RFC 5952 section 4.1: leading zeros are suppressed.
+    if (value >= 0x1000)
+        *out++ = kHexDigits[value >> 12];
+    if (value >= 0x100)
+        *out++ = kHexDigits[(value >> 8) & 0xF];
+    if (value >= 0x10)
+        *out++ = kHexDigits[(value >> 4) & 0xF];
+    *out++ = kHexDigits[value & 0xF];
+
+    return out;
+}
+
+char * FormatIPv6(char * out, const uint8_t * bytes)
+{
+    uint16_t words[8];
+    int hexWords   = 8;
+    int bestStart  = -1;
+    int bestLength = 1;
+    int runStart   = -1;
+    bool afterGap  = false;
+
+    for (int i = 0; i < 8; i++)
     {
-        const void * addr = &Addr[3];
-        const char * s    = inet_ntop(AF_INET, addr, buf, static_cast<socklen_t>(bufSize));
-        // This cast is safe because |s| points into |buf| which is not const.
-        buf = const_cast<char *>(s);
+        words[i] = static_cast<uint16_t>((bytes[2 * i] << 8) | bytes[2 * i + 1]);
     }
-    else
-#endif // INET_CONFIG_ENABLE_IPV4
+
+    // RFC 5952 section 5: IPv4-mapped addresses end in dotted decimal.
+    if (words[0] == 0 && words[1] == 0 && words[2] == 0 && words[3] == 0 && words[4] == 0 && words[5] == 0xFFFF)
     {
-        const void * addr = &Addr[0];
-        const char * s    = inet_ntop(AF_INET6, addr, buf, static_cast<socklen_t>(bufSize));
-        // This cast is safe because |s| points into |buf| which is not const.
-        buf = const_cast<char *>(s);
+        hexWords = 6;
     }
-#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 
-    return buf;
+    // RFC 5952 section 4.2: compress the longest run of two or more zero words, the first one on a tie.
+    for (int i = 0; i <= hexWords; i++)
+    {
+        if (i < hexWords && words[i] == 0)
+        {
+            if (runStart < 0)
+                runStart = i;
+        }
+        else if (runStart >= 0)
+        {
+            if (i - runStart > bestLength)
+            {
+                bestStart  = runStart;
+                bestLength = i - runStart;
+            }
+            runStart = -1;
+        }
+    }
+
+    for (int i = 0; i < hexWords; i++)
+    {
+        if (i == bestStart)
+        {
+            *out++ = ':';
+            *out++ = ':';
+
+            i += bestLength - 1;
+            afterGap = true;
+            continue;
+        }
+
+        if (i > 0 && !afterGap)
+            *out++ = ':';
+        afterGap = false;
+
+        out = FormatHexWord(out, words[i]);
+    }
+
+    if (hexWords == 6)
+    {
+        if (!afterGap)
+            *out++ = ':';
+        out = FormatIPv4(out, &bytes[12]);
+    }
+
+    return out;
 }
 
-bool IPAddress::FromString(const char * str, IPAddress & output)
+inline int HexDigitValue(char c)
 {
-#if INET_CONFIG_ENABLE_IPV4
-    if (strchr(str, ':') == nullptr)
+    const unsigned decimal = static_cast<unsigned>(c - '0');
+    const unsigned letter  = static_cast<unsigned>((c | 0x20) - 'a');
+
+    if (decimal < 10)
+        return static_cast<int>(decimal);
+    if (letter < 6)
+        return static_cast<int>(letter + 10);
+
+    return -1;
+}
+
+// Scans exactly four dotted decimal octets, without leading zeros, filling [str, end).
+bool ParseIPv4(const char * str, const char * end, uint8_t * bytes)
+{
+    for (int i = 0; i < 4; i++)
     {
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-#if LWIP_VERSION_MAJOR > 1 || LWIP_VERSION_MINOR >= 5
-        ip4_addr_t ipv4Addr;
-        if (!ip4addr_aton(str, &ipv4Addr))
-            return false;
-#else  // LWIP_VERSION_MAJOR <= 1
-        ip_addr_t ipv4Addr;
-        if (!ipaddr_aton(str, &ipv4Addr))
+        const char * start = str;
+        unsigned value     = 0;
+
+        while (str < end && *str >= '0' && *str <= '9' && str - start < 3)
+        {
+            value = value * 10 + static_cast<unsigned>(*str - '0');
+            str++;
+        }
+
+        if (str == start || value > 255 || (str - start > 1 && *start == '0'))
             return false;
-#endif // LWIP_VERSION_MAJOR <= 1
-#else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
-        struct in_addr ipv4Addr;
-        if (inet_pton(AF_INET, str, &ipv4Addr) < 1)
+
+        bytes[i] = static_cast<uint8_t>(value);
+
+        if (i < 3)
+        {
+            if (str == end || *str != '.')
+                return false;
+            str++;
+        }
+    }
+
+    return str == end;
+}
+
+bool ParseIPv6(const char * str, const char * end, uint8_t * bytes)
+{
+    uint16_t words[8];
+    int count = 0;
+    int gap   = -1;
+
+    if (str < end && *str == ':')
+    {
+        if (end - str < 2 || str[1] != ':')
             return false;
-#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
-        output = FromIPv4(ipv4Addr);
+        gap = 0;
+        str += 2;
     }
-    else
-#endif // INET_CONFIG_ENABLE_IPV4
+
+    while (str < end)
     {
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-        ip6_addr_t ipv6Addr;
-        if (!ip6addr_aton(str, &ipv6Addr))
+        const char * start = str;
+        uint32_t value     = 0;
+        int digit;
+
+        if (count == 8)
+            return false;
+
+        while (str < end && (digit = HexDigitValue(*str)) >= 0)
+        {
+            value = (value << 4) | static_cast<uint32_t>(digit);
+            str++;
+        }
+
+        // An embedded IPv4 address takes the place of the last two words.
+        if (str < end && *str == '.')
+        {
+            if (count > 6 || !ParseIPv4(start, end, &bytes[12]))
+                return false;
+            words[count++] = static_cast<uint16_t>((bytes[12] << 8) | bytes[13]);
+            words[count++] = static_cast<uint16_t>((bytes[14] << 8) | bytes[15]);
+            str            = end;
+            break;
+        }
+
+        if (str == start || str - start > 4)
+            return false;
+
+        words[count++] = static_cast<uint16_t>(value);
+
+        if (str == end)
+            break;
+        if (*str++ != ':')
+            return false;
+
+        if (str < end && *str == ':')
+        {
+            if (gap >= 0)
+                return false;
+            gap = count;
+            str++;
+        }
+        else if (str == end)
+        {
             return false;
-#else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
-        struct in6_addr ipv6Addr;
-        if (inet_pton(AF_INET6, str, &ipv6Addr) < 1)
+        }
+    }
+
+    if (gap >= 0)
+    {
+        // "::" stands for at least one zero word.
+        if (count == 8)
             return false;
-#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
-        output = FromIPv6(ipv6Addr);
+
+        const int zeros = 8 - count;
+        memmove(&words[gap + zeros], &words[gap], static_cast<size_t>(count - gap) * sizeof(words[0]));
+        for (int i = gap; i < gap + zeros; i++)
+        {
+            words[i] = 0;
+        }
+    }
+    else if (count != 8)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        bytes[2 * i]     = static_cast<uint8_t>(words[i] >> 8);
+        bytes[2 * i + 1] = static_cast<uint8_t>(words[i]);
     }
 
     return true;
 }
 
+} // namespace
+
+char * IPAddress::ToString(char * buf, uint32_t bufSize) const
+{
+    const uint8_t * bytes = reinterpret_cast<const uint8_t *>(Addr);
+    char text[kMaxFormattedLength + 1];
+    // Format in place when the buffer is certainly large enough.
+    char * out = (bufSize > kMaxFormattedLength) ? buf : text;
+    char * end;
+
+#if INET_CONFIG_ENABLE_IPV4
+    if (IsIPv4())
+    {
+        end = FormatIPv4(out, &bytes[12]);
+    }
+    else
+#endif // INET_CONFIG_ENABLE_IPV4
+    {
+        end = FormatIPv6(out, bytes);
+    }
+
+    const size_t length = static_cast<size_t>(end - out);
+
+    if (out == text)
+    {
+        if (length >= bufSize)
+        {
+            if (bufSize > 0)
+                buf[0] = '\0';
+            return nullptr;
+        }
+        memcpy(buf, text, length);
+    }
+    buf[length] = '\0';
+
+    return buf;
+}
+
+bool IPAddress::FromString(const char * str, IPAddress & output)
+{
+    return FromString(str, strlen(str), output);
+}
+
 bool IPAddress::FromString(const char * str, size_t strLen, IPAddress & output)
 {
-    bool res = false;
+    const char * end = str + strLen;
+    IPAddress result;
+    uint8_t * bytes = reinterpret_cast<uint8_t *>(result.Addr);
 
-    if (strLen < INET6_ADDRSTRLEN)
+#if INET_CONFIG_ENABLE_IPV4
+    if (memchr(str, ':', strLen) == nullptr)
     {
-        char hostNameBuf[INET6_ADDRSTRLEN];
-        memcpy(hostNameBuf, str, strLen);
-        hostNameBuf[strLen] = 0;
-        res                 = IPAddress::FromString(hostNameBuf, output);
+        // IPv4-mapped, as IPAddress::FromIPv4() produces.
+        memset(bytes, 0, 10);
+        bytes[10] = 0xFF;
+        bytes[11] = 0xFF;
+        if (!ParseIPv4(str, end, &bytes[12]))
+            return false;
+    }
+    else
+#endif // INET_CONFIG_ENABLE_IPV4
+    {
+        if (!ParseIPv6(str, end, bytes))
+            return false;
     }
 
-    return res;
+    output = result;
+    return true;
 }
 
 } // namespace Inet
@@ -30,6 +30,9 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+
+#include <functional>
 
 #include <support/DLLUtil.h>
 
@@ -309,6 +312,20 @@ public:
      */
     bool operator!=(const IPAddress & other) const;
 
+    /**
+     * @brief   Compute a hash of this IP address.
+     *
+     * @details
+     *  Equivalent addresses have equal hashes, and the bits of every word
+     *  of the address affect every bit of the result, so the low bits may be
+     *  used directly as a bucket index. The hash is not keyed and must not be
+     *  relied on where an attacker chooses the addresses and can observe
+     *  the table.
+     *
+     * @return  The hash value.
+     */
+    size_t Hash() const;
+
     /**
      * @brief   Conventional assignment operator.
      *
@@ -330,10 +347,13 @@ public:
      *  located at \c buf and extending as much as \c bufSize bytes, including
      *  its NUL termination character.
      *
-     *  Note Well: not compliant with RFC 5952 on some platforms. Specifically,
-     *  zero compression may not be applied according to section 4.2.
+     *  IPv6 addresses are emitted in the canonical form of RFC 5952, with
+     *  IPv4-mapped addresses in mixed notation (section 5). The same code is
+     *  used on all platforms.
      *
-     * @return  The argument \c buf if no formatting error, or zero otherwise.
+     * @return  The argument \c buf if no formatting error, or zero if
+     *          \c bufSize is too small for the text, in which case \c buf
+     *          holds an empty string (if \c bufSize is non-zero).
      */
     char * ToString(char * buf, uint32_t bufSize) const;
 
@@ -693,5 +713,53 @@ public:
     static IPAddress Any;
 };
 
+/*
+ * The comparisons and hash load the address as two 64-bit words, which
+ * compilers lower to a single vector compare or a pair of scalar ones.
+ */
+
+inline bool IPAddress::operator==(const IPAddress & other) const
+{
+    uint64_t a[2];
+    uint64_t b[2];
+
+    memcpy(a, Addr, sizeof(a));
+    memcpy(b, other.Addr, sizeof(b));
+
+    return ((a[0] ^ b[0]) | (a[1] ^ b[1])) == 0;
+}
+
+inline bool IPAddress::operator!=(const IPAddress & other) const
+{
+    return !(*this == other);
+}
+
+inline size_t IPAddress::Hash() const
+{
+    uint64_t w[2];
+
+    memcpy(w, Addr, sizeof(w));
+
+    // 64-bit finalizer from MurmurHash3, applied to a multiplicative combination of the two words.
+    uint64_t h = w[0] * UINT64_C(0x9E3779B97F4A7C15) + w[1];
+    h ^= h >> 33;
+    h *= UINT64_C(0xFF51AFD7ED558CCD);
+    h ^= h >> 33;
+    h *= UINT64_C(0xC4CEB9FE1A85EC53);
+    h ^= h >> 33;
+
+    return static_cast<size_t>(h);
+}
+
 } // namespace Inet
 } // namespace chip
+
+namespace std {
+
+template <>
+struct hash<chip::Inet::IPAddress>
+{
+    size_t operator()(const chip::Inet::IPAddress & addr) const { return addr.Hash(); }
+};
+
+} // namespace std
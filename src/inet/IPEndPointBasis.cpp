@@ -57,6 +57,7 @@
 #include <netinet/in.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <time.h>
 #include <unistd.h>
 #if HAVE_SYS_SOCKET_H
 #include <sys/socket.h>
@@ -626,6 +627,158 @@ exit:
     return (lRetval);
 }
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+/**
+ *  @brief Filter the packets received by the endpoint in the kernel.
+ *
+ *  @param[in]   aProgram   A classic BPF program, or NULL to remove the current one.
+ *
+ *  @param[in]   aLength    The number of instructions in \c aProgram.
+ *
+ *  @retval  INET_NO_ERROR               success: the program is attached (or removed)
+ *  @retval  INET_ERROR_INCORRECT_STATE  the endpoint has no socket yet
+ *  @retval  INET_ERROR_BAD_ARGS         \c aProgram and \c aLength disagree
+ *  @retval  other                       the kernel rejected the program
+ *
+ *  @details
+ *     Packets for which the program returns zero are discarded before they
+ *     wake the event loop. The program is copied, and replaces any program
+ *     attached before. Absolute loads are relative to the UDP header for
+ *     UDP endpoints, to the IPv4 header for ICMPv4 raw endpoints, and to the
+ *     ICMPv6 header for ICMPv6 raw endpoints.
+ *
+ *     The endpoint must have been bound.
+ */
+INET_ERROR IPEndPointBasis::SetSocketFilter(const struct sock_filter * aProgram, uint16_t aLength)
+{
+    VerifyOrReturnError(mSocket != INET_INVALID_SOCKET_FD, INET_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError((aProgram == nullptr) == (aLength == 0), INET_ERROR_BAD_ARGS);
+
+    if (aProgram == nullptr)
+    {
+        const int lDummy = 0;
+
+        // ENOENT only means that no program was attached.
+        if (setsockopt(mSocket, SOL_SOCKET, SO_DETACH_FILTER, &lDummy, sizeof(lDummy)) != 0 && errno != ENOENT)
+        {
+            return chip::System::MapErrorPOSIX(errno);
+        }
+        return INET_NO_ERROR;
+    }
+
+    struct sock_fprog lProgram;
+    lProgram.len    = aLength;
+    lProgram.filter = const_cast<struct sock_filter *>(aProgram);
+
+    if (setsockopt(mSocket, SOL_SOCKET, SO_ATTACH_FILTER, &lProgram, sizeof(lProgram)) != 0)
+    {
+        return chip::System::MapErrorPOSIX(errno);
+    }
+
+    return INET_NO_ERROR;
+}
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+/**
+ *  @brief Have the kernel timestamp the packets received by the endpoint.
+ *
+ *  @retval  INET_NO_ERROR                   success: received packets carry a kernel timestamp
+ *  @retval  INET_ERROR_INCORRECT_STATE      the endpoint has no socket yet
+ *  @retval  INET_ERROR_NOT_IMPLEMENTED      the platform cannot timestamp received packets
+ *  @retval  other                           the kernel refused the option
+ *
+ *  @details
+ *     Without kernel timestamps, IPPacketInfo::ReceiveTime is the time the
+ *     endpoint read the packet, which does not account for the time the
+ *     packet waited in the socket's receive queue.
+ *
+ *     The endpoint must have been bound.
+ */
+INET_ERROR IPEndPointBasis::EnableReceiveTimestamps()
+{
+    VerifyOrReturnError(mSocket != INET_INVALID_SOCKET_FD, INET_ERROR_INCORRECT_STATE);
+
+#if defined(SO_TIMESTAMPNS) || defined(SO_TIMESTAMP)
+    const int lEnable = 1;
+
+#ifdef SO_TIMESTAMPNS
+    if (setsockopt(mSocket, SOL_SOCKET, SO_TIMESTAMPNS, &lEnable, sizeof(lEnable)) != 0)
+#else  // !defined(SO_TIMESTAMPNS)
+    if (setsockopt(mSocket, SOL_SOCKET, SO_TIMESTAMP, &lEnable, sizeof(lEnable)) != 0)
+#endif // !defined(SO_TIMESTAMPNS)
+    {
+        return chip::System::MapErrorPOSIX(errno);
+    }
+
+    return INET_NO_ERROR;
+#else  // !defined(SO_TIMESTAMPNS) && !defined(SO_TIMESTAMP)
+    return INET_ERROR_NOT_IMPLEMENTED;
+#endif // !defined(SO_TIMESTAMPNS) && !defined(SO_TIMESTAMP)
+}
+
+/**
+ *  @brief Get the time a packet received with recvmsg() reached the host.
+ *
+ *  @param[in]   aMsgHeader   The message header filled in by recvmsg().
+ *
+ *  @return  The kernel timestamp of the packet (see EnableReceiveTimestamps()),
+ *           or the current time if it has none, on the
+ *           System::Layer::GetClock_MonotonicHiRes() clock.
+ *
+ *  @details
+ *     Kernel timestamps are taken on the real time clock, so they are
+ *     converted using the age of the packet, which is not affected by a step
+ *     of the real time clock unless the step happens while the packet is
+ *     queued.
+ */
+uint64_t IPEndPointBasis::GetReceiveTime(const struct msghdr & aMsgHeader)
+{
+    const uint64_t lNow = System::Layer::GetClock_MonotonicHiRes();
+
+#if defined(SO_TIMESTAMPNS) || defined(SO_TIMESTAMP)
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&aMsgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(const_cast<struct msghdr *>(&aMsgHeader), controlHdr))
+    {
+        if (controlHdr->cmsg_level != SOL_SOCKET)
+            continue;
+
+        int64_t lStampUs;
+
+#ifdef SO_TIMESTAMPNS
+        if (controlHdr->cmsg_type != SCM_TIMESTAMPNS)
+            continue;
+
+        struct timespec lStamp;
+        memcpy(&lStamp, CMSG_DATA(controlHdr), sizeof(lStamp));
+        lStampUs = static_cast<int64_t>(lStamp.tv_sec) * 1000000 + lStamp.tv_nsec / 1000;
+#else  // !defined(SO_TIMESTAMPNS)
+        if (controlHdr->cmsg_type != SCM_TIMESTAMP)
+            continue;
+
+        struct timeval lStamp;
+        memcpy(&lStamp, CMSG_DATA(controlHdr), sizeof(lStamp));
+        lStampUs = static_cast<int64_t>(lStamp.tv_sec) * 1000000 + lStamp.tv_usec;
+#endif // !defined(SO_TIMESTAMPNS)
+
+        struct timespec lRealNow;
+        if (clock_gettime(CLOCK_REALTIME, &lRealNow) != 0)
+            break;
+
+        const int64_t lAgeUs = static_cast<int64_t>(lRealNow.tv_sec) * 1000000 + lRealNow.tv_nsec / 1000 - lStampUs;
+
+        // A negative or absurd age means the real time clock was stepped; the read time is then the best estimate.
+        if (lAgeUs < 0 || static_cast<uint64_t>(lAgeUs) > lNow)
+            break;
+
+        return lNow - static_cast<uint64_t>(lAgeUs);
+    }
+#endif // defined(SO_TIMESTAMPNS) || defined(SO_TIMESTAMP)
+
+    return lNow;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 void IPEndPointBasis::Init(InetLayer * aInetLayer)
 {
     InitEndPointBasis(*aInetLayer);
@@ -675,7 +828,7 @@ void IPEndPointBasis::HandleDataReceived(System::PacketBufferHandle aBuffer)
  *     In most cases this trick of storing information before the data
  *     works because the first buffer in an LwIP IP message contains
  *     the space that was used for the Ethernet/IP/UDP headers. However,
- *     given the current size of the IPPacketInfo structure (40 bytes),
+ *     given the current size of the IPPacketInfo structure (48 bytes),
  *     it is possible for there to not be enough room to store the
  *     structure along with the payload in a single packet buffer. In
  *     practice, this should only happen for extremely large IPv4
@@ -715,6 +868,47 @@ System::Error IPEndPointBasis::PostPacketBufferEvent(chip::System::Layer & aLaye
     return error;
 }
 
+/**
+ *  @brief Take ownership of a packet handed to a receive callback by LwIP.
+ *
+ *  @param[in]   aPbuf         the received packet; ownership passes to this function
+ *
+ *  @returns  a packet buffer holding the received message, or a null
+ *            handle if a copy was needed and no buffer was available.
+ *
+ *  @details
+ *     PacketBuffer assumes that every pbuf it manages was drawn from the
+ *     LwIP pbuf pool and has the capacity of a pool buffer. Packets that
+ *     reach an endpoint by other paths, such as the copy made by the
+ *     loopback netif, are allocated to their exact size, so they are
+ *     copied into a new packet buffer before being handed on.
+ */
+System::PacketBufferHandle IPEndPointBasis::AdoptReceivedPbuf(struct pbuf * aPbuf)
+{
+    System::PacketBufferHandle lBuffer = System::PacketBufferHandle::Adopt(aPbuf);
+
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_LWIP_POOL
+#if LWIP_VERSION_MAJOR > 2 || (LWIP_VERSION_MAJOR == 2 && LWIP_VERSION_MINOR >= 1)
+    if (pbuf_get_allocsrc(aPbuf) != PBUF_TYPE_ALLOC_SRC_MASK_STD_MEMP_PBUF_POOL)
+#else  // LWIP_VERSION_MAJOR < 2 || (LWIP_VERSION_MAJOR == 2 && LWIP_VERSION_MINOR < 1)
+    if (aPbuf->type != PBUF_POOL)
+#endif // LWIP_VERSION_MAJOR < 2 || (LWIP_VERSION_MAJOR == 2 && LWIP_VERSION_MINOR < 1)
+    {
+        System::PacketBufferHandle lCopy = System::PacketBufferHandle::New(aPbuf->tot_len);
+
+        if (!lCopy.IsNull())
+        {
+            pbuf_copy_partial(aPbuf, lCopy->Start(), aPbuf->tot_len, 0);
+            lCopy->SetDataLength(aPbuf->tot_len);
+        }
+
+        return lCopy;
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_LWIP_POOL
+
+    return lBuffer;
+}
+
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -1144,6 +1338,8 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
         if (lStatus == INET_NO_ERROR)
         {
+            lPacketInfo.ReceiveTime = GetReceiveTime(msgHeader);
+
             for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
                  controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
             {
@@ -35,6 +35,14 @@
 #include <lwip/netif.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+#include <linux/filter.h>
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+struct msghdr;
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 namespace chip {
 namespace Inet {
 
@@ -110,6 +118,15 @@ public:
     INET_ERROR JoinMulticastGroup(InterfaceId aInterfaceId, const IPAddress & aAddress);
     INET_ERROR LeaveMulticastGroup(InterfaceId aInterfaceId, const IPAddress & aAddress);
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    INET_ERROR SetSocketFilter(const struct sock_filter * aProgram, uint16_t aLength);
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    INET_ERROR EnableReceiveTimestamps();
+    static uint64_t GetReceiveTime(const struct msghdr & aMsgHeader);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 protected:
     void Init(InetLayer * aInetLayer);
 
@@ -129,6 +146,7 @@ protected:
     void HandleDataReceived(chip::System::PacketBufferHandle aBuffer);
 
     static IPPacketInfo * GetPacketInfo(const chip::System::PacketBufferHandle & aBuffer);
+    static System::PacketBufferHandle AdoptReceivedPbuf(struct pbuf * aPbuf);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -381,15 +381,30 @@
 #define INET_CONFIG_TEST                                   0
 #endif
 
+/**
+ * @def INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+ *
+ * @brief Enable non-blocking DNS name resolution over UDP, performed on the
+ * InetLayer event loop, for sockets. Replaces the getaddrinfo() thread pool
+ * of #INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS.
+ */
+#ifndef INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+#define INET_CONFIG_ENABLE_UDP_DNS_SOCKETS                 0
+#endif // INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
 /**
  * @def INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
  *
  * @brief Enable asynchronous dns name resolution for Linux sockets.
  */
 #ifndef INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
-#define INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS               1
+#define INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS               (!INET_CONFIG_ENABLE_UDP_DNS_SOCKETS)
 #endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
+#if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+#error "INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS and INET_CONFIG_ENABLE_UDP_DNS_SOCKETS are mutually exclusive"
+#endif
+
 /**
  * @def INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT
  *
@@ -400,6 +415,131 @@
 #define INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT             2
 #endif // INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT
 
+/**
+ * @def INET_CONFIG_DNS_MAX_SERVERS
+ *
+ * @brief The maximum number of name servers used by the UDP DNS resolver.
+ */
+#ifndef INET_CONFIG_DNS_MAX_SERVERS
+#define INET_CONFIG_DNS_MAX_SERVERS                        3
+#endif // INET_CONFIG_DNS_MAX_SERVERS
+
+/**
+ * @def INET_CONFIG_DNS_MAX_PENDING_QUERIES
+ *
+ * @brief The maximum number of distinct host names the UDP DNS resolver
+ * queries concurrently. Requests for a name that is already being queried
+ * share the outstanding query.
+ */
+#ifndef INET_CONFIG_DNS_MAX_PENDING_QUERIES
+#define INET_CONFIG_DNS_MAX_PENDING_QUERIES                INET_CONFIG_NUM_DNS_RESOLVERS
+#endif // INET_CONFIG_DNS_MAX_PENDING_QUERIES
+
+/**
+ * @def INET_CONFIG_DNS_CACHE_SIZE
+ *
+ * @brief The number of host names whose results are cached by the UDP DNS
+ * resolver. Zero disables caching.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_SIZE
+#define INET_CONFIG_DNS_CACHE_SIZE                         8
+#endif // INET_CONFIG_DNS_CACHE_SIZE
+
+/**
+ * @def INET_CONFIG_DNS_CACHE_MAX_TTL_SECS
+ *
+ * @brief The upper bound applied to record TTLs when caching positive
+ * answers.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_MAX_TTL_SECS
+#define INET_CONFIG_DNS_CACHE_MAX_TTL_SECS                 3600
+#endif // INET_CONFIG_DNS_CACHE_MAX_TTL_SECS
+
+/**
+ * @def INET_CONFIG_DNS_NEGATIVE_CACHE_TTL_SECS
+ *
+ * @brief How long a "host not found" answer is cached.
+ */
+#ifndef INET_CONFIG_DNS_NEGATIVE_CACHE_TTL_SECS
+#define INET_CONFIG_DNS_NEGATIVE_CACHE_TTL_SECS            30
+#endif // INET_CONFIG_DNS_NEGATIVE_CACHE_TTL_SECS
+
+/**
+ * @def INET_CONFIG_DNS_QUERY_TIMEOUT_MS
+ *
+ * @brief How long the UDP DNS resolver waits for an answer before
+ * retransmitting to the next name server.
+ */
+#ifndef INET_CONFIG_DNS_QUERY_TIMEOUT_MS
+#define INET_CONFIG_DNS_QUERY_TIMEOUT_MS                   2000
+#endif // INET_CONFIG_DNS_QUERY_TIMEOUT_MS
+
+/**
+ * @def INET_CONFIG_DNS_QUERY_ATTEMPTS
+ *
+ * @brief The number of times a UDP DNS query is sent before the request
+ * fails with #INET_ERROR_DNS_TRY_AGAIN.
+ */
+#ifndef INET_CONFIG_DNS_QUERY_ATTEMPTS
+#define INET_CONFIG_DNS_QUERY_ATTEMPTS                     3
+#endif // INET_CONFIG_DNS_QUERY_ATTEMPTS
+
+/**
+ *  @def INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+ *
+ *  @brief
+ *    Defines whether (1) or not (0) the interface and interface address
+ *    iterators read from a process-wide table maintained from an rtnetlink
+ *    socket instead of querying the system on every iteration.
+ *
+ *  @details
+ *    Only available on Linux sockets-based systems. When enabled, the
+ *    InetLayer also services the netlink socket from its select loop and
+ *    dispatches interface change notifications.
+ */
+#ifndef INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS && defined(__linux__) && !defined(__ANDROID__)
+#define INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE         1
+#else
+#define INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE         0
+#endif
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
+/**
+ *  @def INET_CONFIG_INTERFACE_TABLE_MAX_INTERFACES
+ *
+ *  @brief
+ *    The maximum number of network interfaces held by the netlink
+ *    interface table. Iterators fall back to direct system queries
+ *    if this is exceeded.
+ */
+#ifndef INET_CONFIG_INTERFACE_TABLE_MAX_INTERFACES
+#define INET_CONFIG_INTERFACE_TABLE_MAX_INTERFACES         16
+#endif // INET_CONFIG_INTERFACE_TABLE_MAX_INTERFACES
+
+/**
+ *  @def INET_CONFIG_INTERFACE_TABLE_MAX_ADDRESSES
+ *
+ *  @brief
+ *    The maximum number of interface addresses held by the netlink
+ *    interface table. Iterators fall back to direct system queries
+ *    if this is exceeded.
+ */
+#ifndef INET_CONFIG_INTERFACE_TABLE_MAX_ADDRESSES
+#define INET_CONFIG_INTERFACE_TABLE_MAX_ADDRESSES          64
+#endif // INET_CONFIG_INTERFACE_TABLE_MAX_ADDRESSES
+
+/**
+ *  @def INET_CONFIG_INTERFACE_TABLE_MAX_CHANGE_HANDLERS
+ *
+ *  @brief
+ *    The maximum number of interface change handlers that may be
+ *    registered with the netlink interface table.
+ */
+#ifndef INET_CONFIG_INTERFACE_TABLE_MAX_CHANGE_HANDLERS
+#define INET_CONFIG_INTERFACE_TABLE_MAX_CHANGE_HANDLERS    4
+#endif // INET_CONFIG_INTERFACE_TABLE_MAX_CHANGE_HANDLERS
+
 /**
  *  @def INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
  *
@@ -490,6 +630,63 @@
 #define INET_CONFIG_DEFAULT_TCP_USER_TIMEOUT_MSEC          (5 * 60 * 1000)
 #endif // INET_CONFIG_DEFAULT_TCP_USER_TIMEOUT_MSEC
 
+/**
+ *  @def INET_CONFIG_TCP_SEND_MAX_IOVECS
+ *
+ *  @brief
+ *    The maximum number of queued packet buffers handed to the
+ *    kernel in a single send call on sockets-based platforms.
+ *
+ *  @details
+ *    TCPEndPoint gathers the buffers of its send queue into an
+ *    I/O vector so that a queue of small messages is written with
+ *    one system call. The value is further limited to the
+ *    platform IOV_MAX. A value of 1 restores one call per buffer.
+ */
+#ifndef INET_CONFIG_TCP_SEND_MAX_IOVECS
+#define INET_CONFIG_TCP_SEND_MAX_IOVECS                    16
+#endif // INET_CONFIG_TCP_SEND_MAX_IOVECS
+
+/**
+ *  @def INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE
+ *
+ *  @brief
+ *    The number of receive buffers each connected TCPEndPoint keeps
+ *    for reuse on sockets-based platforms.
+ *
+ *  @details
+ *    The buffers are allocated when the connection is established
+ *    and are handed back to the receive path once the application
+ *    has released the data delivered in them, instead of being
+ *    returned to the PacketBuffer pool and allocated again for
+ *    every readable event. A value of 0 disables recycling.
+ */
+#ifndef INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE
+#define INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE           2
+#endif // INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE
+
+/**
+ *  @def INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+ *
+ *  @brief
+ *    Defines whether (1) or not (0) endpoints can attach classic BPF
+ *    programs to their sockets (SO_ATTACH_FILTER), so that the kernel
+ *    discards unwanted packets without waking the event loop.
+ *
+ *  @details
+ *    Only available on Linux sockets-based systems. When enabled,
+ *    IPEndPointBasis::SetSocketFilter() is available and
+ *    RawEndPoint::SetICMPFilter() also filters ICMPv4 endpoints, and
+ *    ICMPv6 endpoints where the ICMP6_FILTER socket option is missing.
+ */
+#ifndef INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__)
+#define INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS              1
+#else
+#define INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS              0
+#endif
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
 /**
  *  @def INET_CONFIG_IP_MULTICAST_HOP_LIMIT
  *
@@ -29,6 +29,7 @@
 
 #include "InetInterface.h"
 
+#include "InetInterfaceTable.h"
 #include "InetLayer.h"
 #include "InetLayerEvents.h"
 
@@ -398,6 +399,9 @@ InterfaceIterator::InterfaceIterator()
     mCurIntf         = 0;
     mIntfFlags       = 0;
     mIntfFlagsCached = false;
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    mSnapshot = nullptr;
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -428,6 +432,11 @@ InterfaceIterator::~InterfaceIterator()
 #endif
         mIntfArray = nullptr;
     }
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    InterfaceTable::Instance().ReleaseSnapshot(mSnapshot);
+    mSnapshot = nullptr;
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -444,6 +453,13 @@ InterfaceIterator::~InterfaceIterator()
 #if CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 bool InterfaceIterator::HasCurrent()
 {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot != nullptr)
+    {
+        return mCurIntf < mSnapshot->InterfaceCount();
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
     return (mIntfArray != nullptr) ? mIntfArray[mCurIntf].if_index != 0 : Next();
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -479,6 +495,22 @@ bool InterfaceIterator::Next()
 {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot == nullptr && mIntfArray == nullptr)
+    {
+        mSnapshot = InterfaceTable::Instance().AcquireSnapshot();
+    }
+    else if (mSnapshot != nullptr && mCurIntf < mSnapshot->InterfaceCount())
+    {
+        mCurIntf++;
+    }
+
+    if (mSnapshot != nullptr)
+    {
+        return mCurIntf < mSnapshot->InterfaceCount();
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
     if (mIntfArray == nullptr)
     {
 #if __ANDROID__ && __ANDROID_API__ < 24
@@ -543,7 +575,19 @@ bool InterfaceIterator::Next()
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 InterfaceId InterfaceIterator::GetInterfaceId()
 {
-    return (HasCurrent()) ? mIntfArray[mCurIntf].if_index : INET_NULL_INTERFACEID;
+    if (!HasCurrent())
+    {
+        return INET_NULL_INTERFACEID;
+    }
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot != nullptr)
+    {
+        return mSnapshot->GetInterface(mCurIntf).Id;
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
+    return mIntfArray[mCurIntf].if_index;
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 
@@ -576,8 +620,15 @@ INET_ERROR InterfaceIterator::GetInterfaceName(char * nameBuf, size_t nameBufSiz
     VerifyOrReturnError(HasCurrent(), INET_ERROR_INCORRECT_STATE);
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
-    VerifyOrReturnError(strlen(mIntfArray[mCurIntf].if_name) < nameBufSize, INET_ERROR_NO_MEMORY);
-    strncpy(nameBuf, mIntfArray[mCurIntf].if_name, nameBufSize);
+    const char * intfName = mIntfArray != nullptr ? mIntfArray[mCurIntf].if_name : nullptr;
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot != nullptr)
+    {
+        intfName = mSnapshot->GetInterface(mCurIntf).Name;
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    VerifyOrReturnError(strlen(intfName) < nameBufSize, INET_ERROR_NO_MEMORY);
+    strncpy(nameBuf, intfName, nameBufSize);
     return INET_NO_ERROR;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 
@@ -672,6 +723,13 @@ short InterfaceIterator::GetFlags()
 {
     struct ifreq intfData;
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot != nullptr)
+    {
+        return HasCurrent() ? static_cast<short>(mSnapshot->GetInterface(mCurIntf).Flags) : 0;
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
     if (!mIntfFlagsCached && HasCurrent())
     {
         strncpy(intfData.ifr_name, mIntfArray[mCurIntf].if_name, IFNAMSIZ);
@@ -704,6 +762,10 @@ InterfaceAddressIterator::InterfaceAddressIterator()
 {
     mAddrsList = nullptr;
     mCurAddr   = nullptr;
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    mSnapshot     = nullptr;
+    mCurAddrIndex = 0;
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 
@@ -728,6 +790,11 @@ InterfaceAddressIterator::~InterfaceAddressIterator()
         freeifaddrs(mAddrsList);
         mAddrsList = mCurAddr = nullptr;
     }
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    InterfaceTable::Instance().ReleaseSnapshot(mSnapshot);
+    mSnapshot = nullptr;
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 
@@ -741,6 +808,13 @@ InterfaceAddressIterator::~InterfaceAddressIterator()
  */
 bool InterfaceAddressIterator::HasCurrent()
 {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot != nullptr)
+    {
+        return mCurAddrIndex < mSnapshot->AddressCount();
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
     return (mAddrsList != nullptr) ? (mCurAddr != nullptr) : Next();
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -773,6 +847,22 @@ bool InterfaceAddressIterator::HasCurrent()
 bool InterfaceAddressIterator::Next()
 {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot == nullptr && mAddrsList == nullptr)
+    {
+        mSnapshot = InterfaceTable::Instance().AcquireSnapshot();
+    }
+    else if (mSnapshot != nullptr && mCurAddrIndex < mSnapshot->AddressCount())
+    {
+        mCurAddrIndex++;
+    }
+
+    if (mSnapshot != nullptr)
+    {
+        return mCurAddrIndex < mSnapshot->AddressCount();
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
     while (true)
     {
         if (mAddrsList == nullptr)
@@ -872,6 +962,13 @@ IPAddress InterfaceAddressIterator::GetAddress()
 {
     if (HasCurrent())
     {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        if (mSnapshot != nullptr)
+        {
+            return mSnapshot->GetAddress(mCurAddrIndex).Address;
+        }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
         return IPAddress::FromSockAddr(*mCurAddr->ifa_addr);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -920,6 +1017,13 @@ uint8_t InterfaceAddressIterator::GetPrefixLength()
 {
     if (HasCurrent())
     {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        if (mSnapshot != nullptr)
+        {
+            return mSnapshot->GetAddress(mCurAddrIndex).PrefixLength;
+        }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
         if (mCurAddr->ifa_addr->sa_family == AF_INET6)
         {
@@ -969,6 +1073,13 @@ InterfaceId InterfaceAddressIterator::GetInterfaceId()
 {
     if (HasCurrent())
     {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        if (mSnapshot != nullptr)
+        {
+            return mSnapshot->GetAddress(mCurAddrIndex).Interface;
+        }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
         return if_nametoindex(mCurAddr->ifa_name);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -1004,6 +1115,18 @@ INET_ERROR InterfaceAddressIterator::GetInterfaceName(char * nameBuf, size_t nam
 {
     VerifyOrReturnError(HasCurrent(), INET_ERROR_INCORRECT_STATE);
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    if (mSnapshot != nullptr)
+    {
+        const InterfaceTableSnapshot::InterfaceEntry * intf =
+            mSnapshot->FindInterface(mSnapshot->GetAddress(mCurAddrIndex).Interface);
+        VerifyOrReturnError(intf != nullptr, INET_ERROR_UNKNOWN_INTERFACE);
+        VerifyOrReturnError(strlen(intf->Name) < nameBufSize, INET_ERROR_NO_MEMORY);
+        strncpy(nameBuf, intf->Name, nameBufSize);
+        return INET_NO_ERROR;
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
     VerifyOrReturnError(strlen(mCurAddr->ifa_name) < nameBufSize, INET_ERROR_NO_MEMORY);
     strncpy(nameBuf, mCurAddr->ifa_name, nameBufSize);
@@ -1030,6 +1153,13 @@ bool InterfaceAddressIterator::IsUp()
 {
     if (HasCurrent())
     {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        if (mSnapshot != nullptr)
+        {
+            return (mSnapshot->GetAddress(mCurAddrIndex).Flags & IFF_UP) != 0;
+        }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
         return (mCurAddr->ifa_flags & IFF_UP) != 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -1054,6 +1184,13 @@ bool InterfaceAddressIterator::SupportsMulticast()
 {
     if (HasCurrent())
     {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        if (mSnapshot != nullptr)
+        {
+            return (mSnapshot->GetAddress(mCurAddrIndex).Flags & IFF_MULTICAST) != 0;
+        }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
         return (mCurAddr->ifa_flags & IFF_MULTICAST) != 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
@@ -1078,6 +1215,13 @@ bool InterfaceAddressIterator::HasBroadcastAddress()
 {
     if (HasCurrent())
     {
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        if (mSnapshot != nullptr)
+        {
+            return (mSnapshot->GetAddress(mCurAddrIndex).Flags & IFF_BROADCAST) != 0;
+        }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
         return (mCurAddr->ifa_flags & IFF_BROADCAST) != 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
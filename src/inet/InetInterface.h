@@ -58,6 +58,10 @@ namespace Inet {
 class IPAddress;
 class IPPrefix;
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+class InterfaceTableSnapshot;
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 /**
  * @typedef     InterfaceId
  *
@@ -133,7 +137,9 @@ extern uint8_t NetmaskToPrefixLength(const uint8_t * netmask, uint16_t netmaskLe
  *  themselves are never destroyed.
  *
  *  On sockets-based systems, iteration is always stable in the face of changes
- *  to the underlying system's interfaces.
+ *  to the underlying system's interfaces. On Linux, when
+ *  #INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE is set, iteration reads a
+ *  snapshot of the \c InterfaceTable rather than querying the system.
  *
  *  On LwIP systems, iteration is stable except in the case where the currently
  *  selected interface is removed from the list, in which case iteration ends
@@ -181,6 +187,10 @@ protected:
     short GetFlags();
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    const InterfaceTableSnapshot * mSnapshot;
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_ZEPHYR_NET_IF
     InterfaceId mCurrentId     = 1;
     net_if * mCurrentInterface = nullptr;
@@ -203,7 +213,9 @@ protected:
  *  themselves are never destroyed.
  *
  *  On sockets-based systems, iteration is always stable in the face of changes
- *  to the underlying system's interfaces and/or addresses.
+ *  to the underlying system's interfaces and/or addresses. On Linux, when
+ *  #INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE is set, iteration reads a
+ *  snapshot of the \c InterfaceTable rather than querying the system.
  *
  *  On LwIP systems, iteration is stable except in the case where the interface
  *  associated with the current address is removed, in which case iteration may
@@ -244,6 +256,11 @@ private:
     struct ifaddrs * mCurAddr;
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    const InterfaceTableSnapshot * mSnapshot;
+    size_t mCurAddrIndex;
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 #if CHIP_SYSTEM_CONFIG_USE_ZEPHYR_NET_IF
     InterfaceIterator mIntfIter;
     net_if_ipv6 * mIpv6 = nullptr;
@@ -0,0 +1,818 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Implementation of the netlink-driven network interface table.
+ *
+ */
+
+#include "InetInterfaceTable.h"
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <errno.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace chip {
+namespace Inet {
+
+namespace {
+
+constexpr size_t kReceiveBufferSize = 8192;
+
+// Netlink dump replies are normally immediate; bound the wait so a misbehaving
+// kernel interface can never wedge the caller.
+constexpr time_t kDumpTimeoutSec = 1;
+
+/**
+ * Walks the rtattr list that follows a fixed-size netlink message header.
+ */
+class AttributeIterator
+{
+public:
+    AttributeIterator(const struct nlmsghdr * msg, size_t headerLen)
+    {
+        mCursor    = reinterpret_cast<const uint8_t *>(NLMSG_DATA(msg)) + NLMSG_ALIGN(headerLen);
+        mRemaining = msg->nlmsg_len - NLMSG_LENGTH(headerLen);
+    }
+
+    const struct rtattr * Next()
+    {
+        if (mRemaining < sizeof(struct rtattr))
+        {
+            return nullptr;
+        }
+
+        const struct rtattr * attr = reinterpret_cast<const struct rtattr *>(mCursor);
+        if (attr->rta_len < sizeof(struct rtattr) || attr->rta_len > mRemaining)
+        {
+            mRemaining = 0;
+            return nullptr;
+        }
+
+        size_t step = RTA_ALIGN(attr->rta_len);
+        mCursor += step;
+        mRemaining = (step < mRemaining) ? mRemaining - step : 0;
+        return attr;
+    }
+
+    static size_t PayloadLength(const struct rtattr * attr) { return attr->rta_len - RTA_LENGTH(0); }
+
+private:
+    const uint8_t * mCursor;
+    size_t mRemaining;
+};
+
+} // namespace
+
+const InterfaceTableSnapshot::InterfaceEntry * InterfaceTableSnapshot::FindInterface(InterfaceId id) const
+{
+    for (size_t i = 0; i < mInterfaceCount; i++)
+    {
+        if (mInterfaces[i].Id == id)
+        {
+            return &mInterfaces[i];
+        }
+    }
+    return nullptr;
+}
+
+InterfaceTableSnapshot::InterfaceEntry * InterfaceTableSnapshot::FindInterface(InterfaceId id)
+{
+    return const_cast<InterfaceEntry *>(static_cast<const InterfaceTableSnapshot *>(this)->FindInterface(id));
+}
+
+bool InterfaceTableSnapshot::SetInterface(InterfaceId id, unsigned flags, const char * name)
+{
+    InterfaceEntry * entry = FindInterface(id);
+    bool changed           = false;
+
+    if (entry == nullptr)
+    {
+        if (mInterfaceCount == kMaxInterfaces)
+        {
+            // Only the transition to unavailable is a change; the entries that fit are unchanged.
+            VerifyOrReturnError(!mOverflow, false);
+            mOverflow = true;
+            return true;
+        }
+        entry          = &mInterfaces[mInterfaceCount++];
+        entry->Id      = id;
+        entry->Name[0] = '\0';
+        changed        = true;
+    }
+    else if (entry->Flags != flags)
+    {
+        changed = true;
+    }
+
+    entry->Flags = flags;
+
+    if (name != nullptr && strncmp(entry->Name, name, sizeof(entry->Name)) != 0)
+    {
+        strncpy(entry->Name, name, sizeof(entry->Name) - 1);
+        entry->Name[sizeof(entry->Name) - 1] = '\0';
+        changed                              = true;
+    }
+
+    if (changed)
+    {
+        for (size_t i = 0; i < mAddressCount; i++)
+        {
+            if (mAddresses[i].Interface == id)
+            {
+                mAddresses[i].Flags = flags;
+            }
+        }
+    }
+
+    return changed;
+}
+
+bool InterfaceTableSnapshot::RemoveInterface(InterfaceId id)
+{
+    bool changed = false;
+
+    for (size_t i = 0; i < mInterfaceCount; i++)
+    {
+        if (mInterfaces[i].Id == id)
+        {
+            mInterfaces[i] = mInterfaces[--mInterfaceCount];
+            changed        = true;
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < mAddressCount;)
+    {
+        if (mAddresses[i].Interface == id)
+        {
+            mAddresses[i] = mAddresses[--mAddressCount];
+            changed       = true;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return changed;
+}
+
+bool InterfaceTableSnapshot::SetAddress(InterfaceId id, const IPAddress & address, uint8_t prefixLength)
+{
+    for (size_t i = 0; i < mAddressCount; i++)
+    {
+        AddressEntry & entry = mAddresses[i];
+        if (entry.Interface == id && entry.Address == address)
+        {
+            VerifyOrReturnError(entry.PrefixLength != prefixLength, false);
+            entry.PrefixLength = prefixLength;
+            return true;
+        }
+    }
+
+    if (mAddressCount == kMaxAddresses)
+    {
+        VerifyOrReturnError(!mOverflow, false);
+        mOverflow = true;
+        return true;
+    }
+
+    const InterfaceEntry * intf = FindInterface(id);
+    AddressEntry & entry        = mAddresses[mAddressCount++];
+
+    entry.Address      = address;
+    entry.Interface    = id;
+    entry.Flags        = (intf != nullptr) ? intf->Flags : 0;
+    entry.PrefixLength = prefixLength;
+    return true;
+}
+
+bool InterfaceTableSnapshot::RemoveAddress(InterfaceId id, const IPAddress & address)
+{
+    for (size_t i = 0; i < mAddressCount; i++)
+    {
+        if (mAddresses[i].Interface == id && mAddresses[i].Address == address)
+        {
+            mAddresses[i] = mAddresses[--mAddressCount];
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Compares the snapshot with an earlier one. Entries are matched regardless of
+ * their order, since a reload lists them in a different order than the
+ * notifications that built the earlier snapshot.
+ *
+ * @return  the \c InterfaceTable::ChangeFlags describing what differs.
+ */
+uint8_t InterfaceTableSnapshot::ChangesFrom(const InterfaceTableSnapshot & other) const
+{
+    uint8_t changes = 0;
+
+    if (mOverflow != other.mOverflow)
+    {
+        return InterfaceTable::kChange_Link | InterfaceTable::kChange_Address;
+    }
+
+    if (mInterfaceCount != other.mInterfaceCount)
+    {
+        changes |= InterfaceTable::kChange_Link;
+    }
+    for (size_t i = 0; i < mInterfaceCount && (changes & InterfaceTable::kChange_Link) == 0; i++)
+    {
+        const InterfaceEntry * entry = other.FindInterface(mInterfaces[i].Id);
+        if (entry == nullptr || entry->Flags != mInterfaces[i].Flags || strcmp(entry->Name, mInterfaces[i].Name) != 0)
+        {
+            changes |= InterfaceTable::kChange_Link;
+        }
+    }
+
+    if (mAddressCount != other.mAddressCount)
+    {
+        changes |= InterfaceTable::kChange_Address;
+    }
+    for (size_t i = 0; i < mAddressCount && (changes & InterfaceTable::kChange_Address) == 0; i++)
+    {
+        bool found = false;
+        for (size_t j = 0; j < other.mAddressCount && !found; j++)
+        {
+            found = other.mAddresses[j].Interface == mAddresses[i].Interface &&
+                other.mAddresses[j].Address == mAddresses[i].Address &&
+                other.mAddresses[j].PrefixLength == mAddresses[i].PrefixLength;
+        }
+        if (!found)
+        {
+            changes |= InterfaceTable::kChange_Address;
+        }
+    }
+
+    return changes;
+}
+
+InterfaceTable & InterfaceTable::Instance()
+{
+    static InterfaceTable sInstance;
+    return sInstance;
+}
+
+const InterfaceTable::Snapshot * InterfaceTable::AcquireSnapshot()
+{
+    const Snapshot * snapshot = nullptr;
+
+    pthread_mutex_lock(&mLock);
+
+    if (InitLocked() == INET_NO_ERROR)
+    {
+        if (!mServiced)
+        {
+            mPendingChanges |= DrainLocked();
+        }
+
+        uint8_t reloadChanges;
+        if (mStale && LoadLocked(reloadChanges) == INET_NO_ERROR)
+        {
+            mPendingChanges |= reloadChanges;
+        }
+
+        if (!mSnapshot->mOverflow)
+        {
+            mSnapshot->mRefCount++;
+            snapshot = mSnapshot;
+        }
+    }
+
+    pthread_mutex_unlock(&mLock);
+
+    return snapshot;
+}
+
+void InterfaceTable::ReleaseSnapshot(const Snapshot * snapshot)
+{
+    VerifyOrReturn(snapshot != nullptr);
+
+    Snapshot * mutableSnapshot = const_cast<Snapshot *>(snapshot);
+
+    pthread_mutex_lock(&mLock);
+    bool last = (--mutableSnapshot->mRefCount == 0);
+    pthread_mutex_unlock(&mLock);
+
+    if (last)
+    {
+        chip::Platform::Delete(mutableSnapshot);
+    }
+}
+
+INET_ERROR InterfaceTable::AddChangeHandler(OnChangeFunct handler, void * appState)
+{
+    ChangeHandler * freeEntry = nullptr;
+    INET_ERROR err            = INET_NO_ERROR;
+
+    pthread_mutex_lock(&mLock);
+    for (ChangeHandler & entry : mHandlers)
+    {
+        if (entry.Handler == handler && entry.AppState == appState)
+        {
+            ExitNow();
+        }
+        if (entry.Handler == nullptr && freeEntry == nullptr)
+        {
+            freeEntry = &entry;
+        }
+    }
+
+    VerifyOrExit(freeEntry != nullptr, err = INET_ERROR_NO_MEMORY);
+    freeEntry->Handler  = handler;
+    freeEntry->AppState = appState;
+
+exit:
+    pthread_mutex_unlock(&mLock);
+    return err;
+}
+
+void InterfaceTable::RemoveChangeHandler(OnChangeFunct handler, void * appState)
+{
+    pthread_mutex_lock(&mLock);
+    for (ChangeHandler & entry : mHandlers)
+    {
+        if (entry.Handler == handler && entry.AppState == appState)
+        {
+            entry.Handler  = nullptr;
+            entry.AppState = nullptr;
+        }
+    }
+    pthread_mutex_unlock(&mLock);
+}
+
+int InterfaceTable::GetNotificationSocket()
+{
+    pthread_mutex_lock(&mLock);
+    int sock = (InitLocked() == INET_NO_ERROR) ? mSocket : -1;
+    pthread_mutex_unlock(&mLock);
+
+    return sock;
+}
+
+void InterfaceTable::HandleNotifications()
+{
+    uint8_t changes;
+
+    pthread_mutex_lock(&mLock);
+
+    changes = mPendingChanges;
+    if (InitLocked() == INET_NO_ERROR)
+    {
+        changes |= DrainLocked();
+
+        uint8_t reloadChanges;
+        if (mStale && LoadLocked(reloadChanges) == INET_NO_ERROR)
+        {
+            changes |= reloadChanges;
+        }
+    }
+    mPendingChanges = 0;
+
+    pthread_mutex_unlock(&mLock);
+
+    if (changes != 0)
+    {
+        NotifyChange(changes);
+    }
+}
+
+void InterfaceTable::SetServiced(bool serviced)
+{
+    pthread_mutex_lock(&mLock);
+    mServiced = serviced;
+    pthread_mutex_unlock(&mLock);
+}
+
+void InterfaceTable::Shutdown()
+{
+    Snapshot * snapshot = nullptr;
+
+    pthread_mutex_lock(&mLock);
+
+    if (mSocket >= 0)
+    {
+        close(mSocket);
+        mSocket = -1;
+    }
+
+    if (mSnapshot != nullptr && --mSnapshot->mRefCount == 0)
+    {
+        snapshot = mSnapshot;
+    }
+    mSnapshot       = nullptr;
+    mInitialized    = false;
+    mInitFailed     = false;
+    mStale          = false;
+    mPendingChanges = 0;
+
+    pthread_mutex_unlock(&mLock);
+
+    if (snapshot != nullptr)
+    {
+        chip::Platform::Delete(snapshot);
+    }
+}
+
+/**
+ * Opens the notification socket and loads the initial table contents. Must be
+ * called with the lock held. Failure is remembered so that platforms without
+ * rtnetlink do not retry on every call.
+ */
+INET_ERROR InterfaceTable::InitLocked()
+{
+    struct sockaddr_nl addr;
+    INET_ERROR err = INET_NO_ERROR;
+    uint8_t changes;
+
+    VerifyOrReturnError(!mInitialized, INET_NO_ERROR);
+    VerifyOrReturnError(!mInitFailed, INET_ERROR_NOT_SUPPORTED);
+
+    mSnapshot = chip::Platform::New<Snapshot>();
+    VerifyOrExit(mSnapshot != nullptr, err = INET_ERROR_NO_MEMORY);
+
+    mSocket = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+    VerifyOrExit(mSocket >= 0, err = chip::System::MapErrorPOSIX(errno));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV6_IFADDR;
+#if INET_CONFIG_ENABLE_IPV4
+    addr.nl_groups |= RTMGRP_IPV4_IFADDR;
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    VerifyOrExit(bind(mSocket, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) == 0,
+                 err = chip::System::MapErrorPOSIX(errno));
+
+    // Subscribing before the dump guarantees no change is missed; notifications
+    // that duplicate the dump are idempotent. The initial contents are not a change.
+    err = LoadLocked(changes);
+    SuccessOrExit(err);
+
+    mInitialized = true;
+
+exit:
+    if (err != INET_NO_ERROR)
+    {
+        ChipLogError(Inet, "Interface table unavailable, falling back to direct queries: %s", ErrorStr(err));
+
+        if (mSocket >= 0)
+        {
+            close(mSocket);
+            mSocket = -1;
+        }
+        if (mSnapshot != nullptr)
+        {
+            chip::Platform::Delete(mSnapshot);
+            mSnapshot = nullptr;
+        }
+        mInitFailed = true;
+    }
+    return err;
+}
+
+/**
+ * Replaces the table contents with a fresh link and address dump. Must be
+ * called with the lock held.
+ *
+ * @param[out] changes  the \c ChangeFlags describing how the new contents
+ *                      differ from the previous ones.
+ */
+INET_ERROR InterfaceTable::LoadLocked(uint8_t & changes)
+{
+    static const uint16_t kDumpTypes[] = { RTM_GETLINK, RTM_GETADDR };
+
+    alignas(struct nlmsghdr) uint8_t buf[kReceiveBufferSize];
+    struct timeval timeout = { kDumpTimeoutSec, 0 };
+    INET_ERROR err         = INET_NO_ERROR;
+    Snapshot * previous    = mSnapshot;
+    Snapshot * snapshot;
+    int sock = -1;
+
+    changes = 0;
+
+    // Holding a reference to the previous contents makes the dump go to a copy,
+    // which is then compared with them.
+    previous->mRefCount++;
+    snapshot = WritableSnapshotLocked();
+    VerifyOrExit(snapshot != nullptr, err = INET_ERROR_NO_MEMORY);
+
+    sock = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    VerifyOrExit(sock >= 0, err = chip::System::MapErrorPOSIX(errno));
+
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    snapshot->mInterfaceCount = 0;
+    snapshot->mAddressCount   = 0;
+    snapshot->mOverflow       = false;
+
+    for (uint16_t type : kDumpTypes)
+    {
+        struct
+        {
+            struct nlmsghdr header;
+            struct rtgenmsg body;
+        } request;
+        bool done = false;
+
+        memset(&request, 0, sizeof(request));
+        request.header.nlmsg_len   = NLMSG_LENGTH(sizeof(request.body));
+        request.header.nlmsg_type  = type;
+        request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+        request.header.nlmsg_seq   = ++mDumpSequence;
+        request.body.rtgen_family  = AF_UNSPEC;
+
+        VerifyOrExit(send(sock, &request, request.header.nlmsg_len, 0) >= 0, err = chip::System::MapErrorPOSIX(errno));
+
+        while (!done)
+        {
+            ssize_t len = recv(sock, buf, sizeof(buf), 0);
+            VerifyOrExit(len > 0, err = (len < 0) ? chip::System::MapErrorPOSIX(errno) : INET_ERROR_UNEXPECTED_EVENT);
+
+            ProcessMessagesLocked(buf, static_cast<size_t>(len), done);
+        }
+    }
+
+    mStale = false;
+
+exit:
+    if (sock >= 0)
+    {
+        close(sock);
+    }
+
+    if (snapshot != nullptr)
+    {
+        if (err != INET_NO_ERROR)
+        {
+            // A partial dump is not usable; report the table as unavailable until
+            // a reload succeeds.
+            snapshot->mOverflow = true;
+            mStale              = true;
+        }
+        changes = snapshot->ChangesFrom(*previous);
+    }
+
+    if (--previous->mRefCount == 0)
+    {
+        chip::Platform::Delete(previous);
+    }
+    return err;
+}
+
+/**
+ * Reads all queued notifications from the netlink socket without blocking.
+ * Must be called with the lock held.
+ *
+ * @return  the \c ChangeFlags describing what changed.
+ */
+uint8_t InterfaceTable::DrainLocked()
+{
+    alignas(struct nlmsghdr) uint8_t buf[kReceiveBufferSize];
+    uint8_t changes = 0;
+
+    while (true)
+    {
+        ssize_t len = recv(mSocket, buf, sizeof(buf), MSG_DONTWAIT);
+
+        if (len < 0)
+        {
+            // The kernel drops notifications when the socket buffer overruns;
+            // the only way to resynchronize is a full reload.
+            if (errno == ENOBUFS)
+            {
+                mStale = true;
+                continue;
+            }
+            break;
+        }
+
+        bool done;
+        changes |= ProcessMessagesLocked(buf, static_cast<size_t>(len), done);
+    }
+
+    return changes;
+}
+
+uint8_t InterfaceTable::ProcessMessagesLocked(const uint8_t * buf, size_t len, bool & done)
+{
+    uint8_t changes = 0;
+
+    done = false;
+
+    while (len >= sizeof(struct nlmsghdr))
+    {
+        const struct nlmsghdr * msg = reinterpret_cast<const struct nlmsghdr *>(buf);
+
+        if (msg->nlmsg_len < sizeof(struct nlmsghdr) || msg->nlmsg_len > len)
+        {
+            break;
+        }
+
+        if (msg->nlmsg_type == NLMSG_DONE || msg->nlmsg_type == NLMSG_ERROR)
+        {
+            done = true;
+        }
+        else
+        {
+            changes |= ProcessMessageLocked(msg);
+        }
+
+        size_t step = NLMSG_ALIGN(msg->nlmsg_len);
+        if (step >= len)
+        {
+            break;
+        }
+        buf += step;
+        len -= step;
+    }
+
+    return changes;
+}
+
+uint8_t InterfaceTable::ProcessMessageLocked(const struct nlmsghdr * msg)
+{
+    const struct rtattr * attr;
+    Snapshot * snapshot;
+
+    switch (msg->nlmsg_type)
+    {
+    case RTM_NEWLINK:
+    case RTM_DELLINK: {
+        VerifyOrReturnError(msg->nlmsg_len >= NLMSG_LENGTH(sizeof(struct ifinfomsg)), 0);
+
+        const struct ifinfomsg * info = reinterpret_cast<const struct ifinfomsg *>(NLMSG_DATA(msg));
+        const InterfaceId id          = static_cast<InterfaceId>(info->ifi_index);
+        char name[IF_NAMESIZE]        = "";
+        bool hasName                  = false;
+
+        for (AttributeIterator iter(msg, sizeof(struct ifinfomsg)); (attr = iter.Next()) != nullptr;)
+        {
+            if (attr->rta_type == IFLA_IFNAME)
+            {
+                size_t nameLen = AttributeIterator::PayloadLength(attr);
+                nameLen        = (nameLen < sizeof(name)) ? nameLen : sizeof(name) - 1;
+                memcpy(name, RTA_DATA(attr), nameLen);
+                name[nameLen] = '\0';
+                hasName       = true;
+            }
+        }
+
+        snapshot = WritableSnapshotLocked();
+        VerifyOrReturnError(snapshot != nullptr, 0);
+
+        if (msg->nlmsg_type == RTM_DELLINK)
+        {
+            // Entries may have been dropped while full; reload to recover them.
+            // The reload reports whatever it changes.
+            mStale = mStale || snapshot->mOverflow;
+            return snapshot->RemoveInterface(id) ? (kChange_Link | kChange_Address) : 0;
+        }
+
+        return snapshot->SetInterface(id, info->ifi_flags, hasName ? name : nullptr) ? kChange_Link : 0;
+    }
+
+    case RTM_NEWADDR:
+    case RTM_DELADDR: {
+        VerifyOrReturnError(msg->nlmsg_len >= NLMSG_LENGTH(sizeof(struct ifaddrmsg)), 0);
+
+        const struct ifaddrmsg * info = reinterpret_cast<const struct ifaddrmsg *>(NLMSG_DATA(msg));
+        const InterfaceId id          = static_cast<InterfaceId>(info->ifa_index);
+        const struct rtattr * addrAttr  = nullptr;
+        const struct rtattr * localAttr = nullptr;
+        IPAddress address;
+
+        for (AttributeIterator iter(msg, sizeof(struct ifaddrmsg)); (attr = iter.Next()) != nullptr;)
+        {
+            if (attr->rta_type == IFA_ADDRESS)
+            {
+                addrAttr = attr;
+            }
+            else if (attr->rta_type == IFA_LOCAL)
+            {
+                localAttr = attr;
+            }
+        }
+
+        // As with getifaddrs(), IFA_LOCAL is the local address on point-to-point
+        // links where IFA_ADDRESS carries the peer address.
+        attr = (localAttr != nullptr) ? localAttr : addrAttr;
+        VerifyOrReturnError(attr != nullptr, 0);
+
+        if (info->ifa_family == AF_INET6)
+        {
+            struct in6_addr in6;
+            VerifyOrReturnError(AttributeIterator::PayloadLength(attr) >= sizeof(in6), 0);
+            memcpy(&in6, RTA_DATA(attr), sizeof(in6));
+            address = IPAddress::FromIPv6(in6);
+        }
+#if INET_CONFIG_ENABLE_IPV4
+        else if (info->ifa_family == AF_INET)
+        {
+            struct in_addr in4;
+            VerifyOrReturnError(AttributeIterator::PayloadLength(attr) >= sizeof(in4), 0);
+            memcpy(&in4, RTA_DATA(attr), sizeof(in4));
+            address = IPAddress::FromIPv4(in4);
+        }
+#endif // INET_CONFIG_ENABLE_IPV4
+        else
+        {
+            return 0;
+        }
+
+        snapshot = WritableSnapshotLocked();
+        VerifyOrReturnError(snapshot != nullptr, 0);
+
+        if (msg->nlmsg_type == RTM_DELADDR)
+        {
+            mStale = mStale || snapshot->mOverflow;
+            return snapshot->RemoveAddress(id, address) ? kChange_Address : 0;
+        }
+
+        return snapshot->SetAddress(id, address, info->ifa_prefixlen) ? kChange_Address : 0;
+    }
+
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Returns the current snapshot, copying it first if readers still hold it.
+ * Must be called with the lock held.
+ */
+InterfaceTable::Snapshot * InterfaceTable::WritableSnapshotLocked()
+{
+    if (mSnapshot->mRefCount > 1)
+    {
+        Snapshot * copy = chip::Platform::New<Snapshot>(*mSnapshot);
+        if (copy == nullptr)
+        {
+            // Drop the update; the table will be reloaded on next use.
+            mStale = true;
+            return nullptr;
+        }
+
+        copy->mRefCount = 1;
+        mSnapshot->mRefCount--;
+        mSnapshot = copy;
+    }
+
+    return mSnapshot;
+}
+
+void InterfaceTable::NotifyChange(uint8_t changeFlags)
+{
+    ChangeHandler handlers[kMaxChangeHandlers];
+
+    // Handlers are invoked without the lock held since they typically iterate
+    // the table again.
+    pthread_mutex_lock(&mLock);
+    memcpy(handlers, mHandlers, sizeof(handlers));
+    pthread_mutex_unlock(&mLock);
+
+    for (const ChangeHandler & entry : handlers)
+    {
+        if (entry.Handler != nullptr)
+        {
+            entry.Handler(entry.AppState, changeFlags);
+        }
+    }
+}
+
+} // namespace Inet
+} // namespace chip
+
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
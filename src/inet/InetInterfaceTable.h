@@ -0,0 +1,208 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file defines the <tt>Inet::InterfaceTable</tt> class, a process-wide
+ *  cache of the system network interfaces and their addresses that is kept
+ *  up to date from an rtnetlink socket on Linux.
+ */
+
+#pragma once
+
+#include <inet/InetConfig.h>
+
+#include <inet/IPAddress.h>
+#include <inet/InetError.h>
+#include <inet/InetInterface.h>
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
+#include <net/if.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct nlmsghdr;
+
+namespace chip {
+namespace Inet {
+
+/**
+ * @brief   An immutable view of the \c InterfaceTable.
+ *
+ * @details
+ *  Obtained with \c InterfaceTable::AcquireSnapshot and returned with
+ *  \c InterfaceTable::ReleaseSnapshot. The contents never change while the
+ *  snapshot is held; updates to the table are applied to a copy.
+ */
+class DLL_EXPORT InterfaceTableSnapshot
+{
+public:
+    static constexpr size_t kMaxInterfaces = INET_CONFIG_INTERFACE_TABLE_MAX_INTERFACES;
+    static constexpr size_t kMaxAddresses  = INET_CONFIG_INTERFACE_TABLE_MAX_ADDRESSES;
+
+    struct InterfaceEntry
+    {
+        InterfaceId Id;
+        unsigned Flags; /**< IFF_* flags, as reported by SIOCGIFFLAGS. */
+        char Name[IF_NAMESIZE];
+    };
+
+    struct AddressEntry
+    {
+        IPAddress Address;
+        InterfaceId Interface;
+        unsigned Flags; /**< IFF_* flags of the owning interface. */
+        uint8_t PrefixLength;
+    };
+
+    size_t InterfaceCount() const { return mInterfaceCount; }
+    size_t AddressCount() const { return mAddressCount; }
+    const InterfaceEntry & GetInterface(size_t index) const { return mInterfaces[index]; }
+    const AddressEntry & GetAddress(size_t index) const { return mAddresses[index]; }
+    const InterfaceEntry * FindInterface(InterfaceId id) const;
+
+private:
+    friend class InterfaceTable;
+
+    InterfaceEntry * FindInterface(InterfaceId id);
+    bool SetInterface(InterfaceId id, unsigned flags, const char * name);
+    bool RemoveInterface(InterfaceId id);
+    bool SetAddress(InterfaceId id, const IPAddress & address, uint8_t prefixLength);
+    bool RemoveAddress(InterfaceId id, const IPAddress & address);
+    uint8_t ChangesFrom(const InterfaceTableSnapshot & other) const;
+
+    InterfaceEntry mInterfaces[kMaxInterfaces];
+    AddressEntry mAddresses[kMaxAddresses];
+    size_t mInterfaceCount = 0;
+    size_t mAddressCount   = 0;
+    uint32_t mRefCount     = 1;
+    bool mOverflow         = false;
+};
+
+/**
+ * @brief   Process-wide table of system network interfaces and addresses.
+ *
+ * @details
+ *  The table is populated with a netlink dump on first use and then updated
+ *  incrementally from RTM_NEWLINK, RTM_DELLINK, RTM_NEWADDR and RTM_DELADDR
+ *  notifications. Consumers read reference counted snapshots, so
+ *  \c InterfaceIterator and \c InterfaceAddressIterator no longer issue
+ *  \c getifaddrs() or per-interface \c ioctl() calls.
+ *
+ *  Notifications are drained by \c InetLayer::HandleSelectResult when an
+ *  InetLayer is servicing the table's socket, and opportunistically (without
+ *  blocking) whenever a snapshot is acquired otherwise.
+ *
+ *  Registered change handlers are invoked from \c HandleNotifications, only
+ *  when the contents of the table actually changed.
+ *
+ *  If the table overflows its configured capacity, snapshots are reported as
+ *  unavailable and the iterators fall back to querying the system directly.
+ *  The overflow is latched until a reload fits; while it lasts, only changes to
+ *  the entries that fit are reported.
+ */
+class DLL_EXPORT InterfaceTable
+{
+public:
+    using Snapshot = InterfaceTableSnapshot;
+
+    static constexpr size_t kMaxChangeHandlers = INET_CONFIG_INTERFACE_TABLE_MAX_CHANGE_HANDLERS;
+
+    /**
+     * Bits passed to change handlers describing what kind of change occurred.
+     */
+    enum ChangeFlags : uint8_t
+    {
+        kChange_Link    = 0x01, /**< An interface was added, removed or changed state. */
+        kChange_Address = 0x02, /**< An interface address was added or removed. */
+    };
+
+    typedef void (*OnChangeFunct)(void * appState, uint8_t changeFlags);
+
+    static InterfaceTable & Instance();
+
+    /**
+     * Returns the current snapshot, initializing the table if needed.
+     *
+     * @return  the snapshot, or \c nullptr if the table is unavailable (netlink
+     *          could not be opened or the configured capacity was exceeded).
+     */
+    const Snapshot * AcquireSnapshot();
+    void ReleaseSnapshot(const Snapshot * snapshot);
+
+    INET_ERROR AddChangeHandler(OnChangeFunct handler, void * appState);
+    void RemoveChangeHandler(OnChangeFunct handler, void * appState);
+
+    /**
+     * Returns the netlink notification socket, initializing the table if needed,
+     * or -1 if unavailable. Used by \c InetLayer to include it in its select set.
+     */
+    int GetNotificationSocket();
+
+    /**
+     * Drains all pending netlink notifications without blocking and invokes the
+     * change handlers if the table contents changed.
+     */
+    void HandleNotifications();
+
+    /**
+     * Marks whether an event loop is draining the notification socket. When
+     * not serviced, snapshot acquisition drains notifications itself.
+     */
+    void SetServiced(bool serviced);
+
+    /**
+     * Closes the netlink socket and discards the cached table. The table is
+     * re-created on next use.
+     */
+    void Shutdown();
+
+private:
+    struct ChangeHandler
+    {
+        OnChangeFunct Handler;
+        void * AppState;
+    };
+
+    InterfaceTable() = default;
+
+    INET_ERROR InitLocked();
+    INET_ERROR LoadLocked(uint8_t & changes);
+    uint8_t DrainLocked();
+    uint8_t ProcessMessagesLocked(const uint8_t * buf, size_t len, bool & done);
+    uint8_t ProcessMessageLocked(const struct nlmsghdr * msg);
+    Snapshot * WritableSnapshotLocked();
+    void NotifyChange(uint8_t changeFlags);
+
+    pthread_mutex_t mLock                       = PTHREAD_MUTEX_INITIALIZER;
+    Snapshot * mSnapshot                        = nullptr;
+    int mSocket                                 = -1;
+    uint32_t mDumpSequence                      = 0;
+    uint8_t mPendingChanges                     = 0;
+    bool mInitialized                           = false;
+    bool mInitFailed                            = false;
+    bool mServiced                              = false;
+    bool mStale                                 = false;
+    ChangeHandler mHandlers[kMaxChangeHandlers] = {};
+};
+
+} // namespace Inet
+} // namespace chip
+
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
@@ -47,6 +47,7 @@
 #include "InetLayer.h"
 
 #include "InetFaultInjection.h"
+#include "InetInterfaceTable.h"
 
 #include <system/SystemTimer.h>
 
@@ -287,8 +288,19 @@ INET_ERROR InetLayer::Init(chip::System::Layer & aSystemLayer, void * aContext)
     SuccessOrExit(err);
 
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+    err = mUDPDNSResolver.Init(this);
+    SuccessOrExit(err);
+
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    // Interface change notifications are drained from the select loop.
+    InterfaceTable::Instance().SetServiced(true);
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 exit:
     Platform::InetLayer::DidInit(this, mContext, err);
     return err;
@@ -334,6 +346,11 @@ INET_ERROR InetLayer::Shutdown()
         err = mAsyncDNSResolver.Shutdown();
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+        err = mUDPDNSResolver.Shutdown();
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
@@ -371,6 +388,10 @@ INET_ERROR InetLayer::Shutdown()
             }
         }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        InterfaceTable::Instance().SetServiced(false);
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
     }
 
     State = kState_NotInitialized;
@@ -828,6 +849,7 @@ INET_ERROR InetLayer::ResolveHostAddress(const char * hostName, uint16_t hostNam
 
     // After this point, the resolver will be released by:
     // - mAsyncDNSResolver (in case of ASYNC_DNS_SOCKETS)
+    // - mUDPDNSResolver (in case of UDP_DNS_SOCKETS)
     // - resolver->Resolve() (in case of synchronous resolving)
     // - the event handlers (in case of LwIP)
 
@@ -841,9 +863,22 @@ INET_ERROR InetLayer::ResolveHostAddress(const char * hostName, uint16_t hostNam
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
-#if !INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+    err = mUDPDNSResolver.PrepareDNSResolver(*resolver, hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
+    SuccessOrExit(err);
+
+    err = mUDPDNSResolver.EnqueueRequest(*resolver);
+    if (err != INET_NO_ERROR)
+    {
+        resolver->Release();
+    }
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+#if !INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS && !INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
     err = resolver->Resolve(hostName, hostNameLen, options, maxAddrs, addrArray, onComplete, appState);
-#endif // !INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#endif // !INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS && !INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 exit:
 
     return err;
@@ -894,18 +929,50 @@ void InetLayer::CancelResolveHostAddress(DNSResolveCompleteFunct onComplete, voi
             continue;
         }
 
-#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && (INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS)
         if (lResolver->mState == DNSResolver::kState_Canceled)
         {
             continue;
         }
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && (INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS || INET_CONFIG_ENABLE_UDP_DNS_SOCKETS)
 
         lResolver->Cancel();
         break;
     }
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+/**
+ *  Replace the name servers used for host name resolution, which default to
+ *  those listed in /etc/resolv.conf.
+ *
+ *  @param[in]    servers   The name server addresses, tried in order.
+ *
+ *  @param[in]    count     The number of addresses in \c servers, at most
+ *                          #INET_CONFIG_DNS_MAX_SERVERS.
+ *
+ *  @param[in]    port      The UDP port the name servers listen on.
+ *
+ *  @retval #INET_NO_ERROR              on success.
+ *  @retval #INET_ERROR_BAD_ARGS        if \c count is out of range.
+ *
+ */
+INET_ERROR InetLayer::SetDNSServers(const IPAddress * servers, uint8_t count, uint16_t port)
+{
+    return mUDPDNSResolver.SetServers(servers, count, port);
+}
+
+/**
+ *  Discard all cached host name resolution results.
+ */
+void InetLayer::FlushDNSCache()
+{
+    mUDPDNSResolver.FlushCache();
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
 /**
@@ -1129,6 +1196,14 @@ void InetLayer::PrepareSelect(int & nfds, fd_set * readfds, fd_set * writefds, f
             lEndPoint->mRequestIO.SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
     }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    {
+        SocketEvents interfaceEvents;
+        interfaceEvents.SetRead();
+        interfaceEvents.SetFDs(InterfaceTable::Instance().GetNotificationSocket(), nfds, readfds, writefds, exceptfds);
+    }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
 }
 
 /**
@@ -1235,6 +1310,19 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
             }
         }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+        // Interface change handlers may close and re-open endpoints, so they
+        // run only after all endpoint I/O above has been handled.
+        {
+            int interfaceSocket = InterfaceTable::Instance().GetNotificationSocket();
+            if (interfaceSocket != INET_INVALID_SOCKET_FD &&
+                SocketEvents::FromFDs(interfaceSocket, readfds, writefds, exceptfds).IsReadable())
+            {
+                InterfaceTable::Instance().HandleNotifications();
+            }
+        }
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
     }
 }
 
@@ -1251,6 +1339,7 @@ void IPPacketInfo::Clear()
     Interface   = INET_NULL_INTERFACEID;
     SrcPort     = 0;
     DestPort    = 0;
+    ReceiveTime = 0;
 }
 
 #if !INET_CONFIG_WILL_OVERRIDE_PLATFORM_XTOR_FUNCS
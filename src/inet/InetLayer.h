@@ -77,6 +77,10 @@
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 #include <inet/AsyncDNSResolverSockets.h>
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+#include <inet/UDPDNSResolverSockets.h>
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #include <system/SystemLayer.h>
@@ -159,6 +163,10 @@ class DLL_EXPORT InetLayer
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
     friend class AsyncDNSResolverSockets;
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+    friend class UDPDNSResolverSockets;
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 public:
@@ -207,6 +215,11 @@ public:
                                   DNSResolveCompleteFunct onComplete, void * appState);
     void CancelResolveHostAddress(DNSResolveCompleteFunct onComplete, void * appState);
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+    INET_ERROR SetDNSServers(const IPAddress * servers, uint8_t count, uint16_t port = UDPDNSResolverSockets::kDNSPort);
+    void FlushDNSCache();
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
     INET_ERROR GetInterfaceFromAddr(const IPAddress & addr, InterfaceId & intfId);
@@ -295,6 +308,9 @@ private:
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
     AsyncDNSResolverSockets mAsyncDNSResolver;
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+    UDPDNSResolverSockets mUDPDNSResolver;
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -330,6 +346,7 @@ public:
     InterfaceId Interface; /**< The interface identifier for the connection. */
     uint16_t SrcPort;      /**< The source port in the packet. */
     uint16_t DestPort;     /**< The destination port in the packet. */
+    uint64_t ReceiveTime;  /**< When the packet reached the host, in System::Layer::GetClock_MonotonicHiRes() time, or 0. */
 
     void Clear();
 };
@@ -657,10 +657,10 @@ exit:
 }
 
 /**
- * @brief   Set the ICMP6 filter parameters in the network stack.
+ * @brief   Set the ICMP filter parameters in the network stack.
  *
  * @param[in]   numICMPTypes    length of array at \c aICMPTypes
- * @param[in]   aICMPTypes      the set of ICMPv6 type codes to filter.
+ * @param[in]   aICMPTypes      the set of ICMP type codes to filter.
  *
  * @retval  INET_NO_ERROR                   success: filter parameters set
  * @retval  INET_ERROR_NOT_IMPLEMENTED      system does not implement
@@ -671,18 +671,26 @@ exit:
  *
  * @details
  *  Apply the ICMPv6 filtering parameters for the codes in \c aICMPTypes to
- *  the underlying endpoint in the system networking stack.
+ *  the underlying endpoint in the system networking stack. Where
+ *  #INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS is enabled, ICMPv4 endpoints may be
+ *  filtered as well.
  */
 INET_ERROR RawEndPoint::SetICMPFilter(uint8_t numICMPTypes, const uint8_t * aICMPTypes)
 {
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
-#if !(HAVE_NETINET_ICMP6_H && HAVE_ICMP6_FILTER)
+#if !(HAVE_NETINET_ICMP6_H && HAVE_ICMP6_FILTER) && !INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
     return INET_ERROR_NOT_IMPLEMENTED;
-#endif //!(HAVE_NETINET_ICMP6_H && HAVE_ICMP6_FILTER)
+#endif //!(HAVE_NETINET_ICMP6_H && HAVE_ICMP6_FILTER) && !INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
-    VerifyOrReturnError(IPVer == kIPVersion_6, INET_ERROR_WRONG_ADDRESS_TYPE);
-    VerifyOrReturnError(IPProto == kIPProtocol_ICMPv6, INET_ERROR_WRONG_PROTOCOL_TYPE);
+#if INET_CONFIG_ENABLE_IPV4 && INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    const bool isICMPv4 = (IPVer == kIPVersion_4);
+#else
+    const bool isICMPv4 = false;
+#endif // INET_CONFIG_ENABLE_IPV4 && INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
+    VerifyOrReturnError(IPVer == kIPVersion_6 || isICMPv4, INET_ERROR_WRONG_ADDRESS_TYPE);
+    VerifyOrReturnError(IPProto == (isICMPv4 ? kIPProtocol_ICMPv4 : kIPProtocol_ICMPv6), INET_ERROR_WRONG_PROTOCOL_TYPE);
     VerifyOrReturnError((numICMPTypes == 0 && aICMPTypes == nullptr) || (numICMPTypes != 0 && aICMPTypes != nullptr),
                         INET_ERROR_BAD_ARGS);
 
@@ -695,28 +703,76 @@ INET_ERROR RawEndPoint::SetICMPFilter(uint8_t numICMPTypes, const uint8_t * aICM
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #if HAVE_NETINET_ICMP6_H && HAVE_ICMP6_FILTER
-    struct icmp6_filter filter;
-    if (numICMPTypes > 0)
+    // ICMP6_FILTER is applied before the packet is queued to the socket, so it is preferred over a BPF program.
+    if (!isICMPv4)
     {
-        ICMP6_FILTER_SETBLOCKALL(&filter);
-        for (int j = 0; j < numICMPTypes; ++j)
+        struct icmp6_filter filter;
+        if (numICMPTypes > 0)
+        {
+            ICMP6_FILTER_SETBLOCKALL(&filter);
+            for (int j = 0; j < numICMPTypes; ++j)
+            {
+                ICMP6_FILTER_SETPASS(aICMPTypes[j], &filter);
+            }
+        }
+        else
+        {
+            ICMP6_FILTER_SETPASSALL(&filter);
+        }
+        if (setsockopt(mSocket, IPPROTO_ICMPV6, ICMP6_FILTER, &filter, sizeof(filter)) == -1)
         {
-            ICMP6_FILTER_SETPASS(aICMPTypes[j], &filter);
+            return chip::System::MapErrorPOSIX(errno);
         }
+        return INET_NO_ERROR;
+    }
+#endif // HAVE_NETINET_ICMP6_H && HAVE_ICMP6_FILTER
+
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    return SetICMPSocketFilter(numICMPTypes, aICMPTypes);
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+    return INET_NO_ERROR;
+}
+
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+/*
+ * Attach a classic BPF program accepting only the given ICMP types. An ICMPv6 raw socket sees packets from the ICMPv6
+ * header, whereas an ICMPv4 raw socket sees them from the IPv4 header, so the IPv4 header length is loaded into X first.
+ */
+INET_ERROR RawEndPoint::SetICMPSocketFilter(uint8_t numICMPTypes, const uint8_t * aICMPTypes)
+{
+    // An optional header length load, the type load, one comparison per type, and the two returns.
+    struct sock_filter program[1 + 1 + UINT8_MAX + 2];
+    uint16_t length = 0;
+
+    if (numICMPTypes == 0)
+    {
+        return SetSocketFilter(nullptr, 0);
+    }
+
+    if (IPVer == kIPVersion_6)
+    {
+        program[length++] = BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0);
     }
     else
     {
-        ICMP6_FILTER_SETPASSALL(&filter);
+        program[length++] = BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, 0);
+        program[length++] = BPF_STMT(BPF_LD | BPF_B | BPF_IND, 0);
     }
-    if (setsockopt(mSocket, IPPROTO_ICMPV6, ICMP6_FILTER, &filter, sizeof(filter)) == -1)
+
+    // On a match, jump over the remaining comparisons and the drop to the accept.
+    for (uint8_t j = 0; j < numICMPTypes; ++j)
     {
-        return chip::System::MapErrorPOSIX(errno);
+        program[length++] = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, aICMPTypes[j], static_cast<uint8_t>(numICMPTypes - j), 0);
     }
-#endif // HAVE_NETINET_ICMP6_H && HAVE_ICMP6_FILTER
-#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
-    return INET_NO_ERROR;
+    program[length++] = BPF_STMT(BPF_RET | BPF_K, 0);
+    program[length++] = BPF_STMT(BPF_RET | BPF_K, UINT32_MAX);
+
+    return SetSocketFilter(program, length);
 }
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
 
 /**
  * @brief   Bind the endpoint to a network interface.
@@ -974,9 +1030,10 @@ u8_t RawEndPoint::LwIPReceiveRawMessage(void * arg, struct raw_pcb * pcb, struct
 #endif // INET_CONFIG_ENABLE_IPV4
 #endif // LWIP_VERSION_MAJOR <= 1
 
-            pktInfo->Interface = ip_current_netif();
-            pktInfo->SrcPort   = 0;
-            pktInfo->DestPort  = 0;
+            pktInfo->Interface   = ip_current_netif();
+            pktInfo->SrcPort     = 0;
+            pktInfo->DestPort    = 0;
+            pktInfo->ReceiveTime = System::Layer::GetClock_MonotonicHiRes();
         }
 
         PostPacketBufferEvent(lSystemLayer, *ep, kInetEvent_RawDataReceived, std::move(buf));
@@ -110,6 +110,10 @@ private:
     INET_ERROR GetSocket(IPAddressType addrType);
     void HandlePendingIO();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    INET_ERROR SetICMPSocketFilter(uint8_t numICMPTypes, const uint8_t * aICMPTypes);
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
 };
 
 } // namespace Inet
@@ -50,11 +50,13 @@
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <net/if.h>
 #include <netinet/tcp.h>
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -87,6 +89,15 @@
 #define TCP_IDLE_INTERVAL_OPT_NAME TCP_KEEPALIVE
 #endif
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+// Number of queued buffers gathered into a single sendmsg() call.
+#if defined(IOV_MAX) && IOV_MAX < INET_CONFIG_TCP_SEND_MAX_IOVECS
+#define TCP_SEND_MAX_IOVECS IOV_MAX
+#else
+#define TCP_SEND_MAX_IOVECS INET_CONFIG_TCP_SEND_MAX_IOVECS
+#endif
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 /*
  * This logic to register a null operation callback with the LwIP TCP/IP task
  * ensures that the TCP timer loop is started when a connection is established,
@@ -494,6 +505,7 @@ INET_ERROR TCPEndPoint::Connect(const IPAddress & addr, uint16_t port, Interface
     if (conRes == 0)
     {
         State = kState_Connected;
+        PrepostReceiveBuffers();
         // Wait for ability to read on this endpoint.
         mRequestIO.SetRead();
         if (OnConnectComplete != nullptr)
@@ -809,6 +821,41 @@ INET_ERROR TCPEndPoint::EnableNoDelay()
     return res;
 }
 
+INET_ERROR TCPEndPoint::EnableSendCoalescing()
+{
+    if (!IsConnected())
+        return INET_ERROR_INCORRECT_STATE;
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#ifdef TCP_CORK
+    mSendCoalescing = true;
+
+    // Hold back partial segments if a backlog has already built up.
+    if (!mSendQueue.IsNull() && mSendQueue->HasChainedBuffer())
+        return SetCork(true);
+#else  // !defined(TCP_CORK)
+    return INET_ERROR_NOT_IMPLEMENTED;
+#endif // defined(TCP_CORK)
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+    return INET_NO_ERROR;
+}
+
+INET_ERROR TCPEndPoint::DisableSendCoalescing()
+{
+    if (!IsConnected())
+        return INET_ERROR_INCORRECT_STATE;
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    mSendCoalescing = false;
+
+    if (mCorked)
+        return SetCork(false);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+    return INET_NO_ERROR;
+}
+
 INET_ERROR TCPEndPoint::EnableKeepAlive(uint16_t interval, uint16_t timeoutCount)
 {
     INET_ERROR res = INET_NO_ERROR;
@@ -1184,6 +1231,11 @@ void TCPEndPoint::Init(InetLayer * inetLayer)
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     mUnackedLength = 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    mSendCoalescing = false;
+    mCorked         = false;
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
 INET_ERROR TCPEndPoint::DriveSending()
@@ -1307,11 +1359,43 @@ INET_ERROR TCPEndPoint::DriveSending()
         return err;
     });
 
-    while (!mSendQueue.IsNull())
+    if (mSendCoalescing && !mCorked && !mSendQueue.IsNull() && mSendQueue->HasChainedBuffer())
+    {
+        err = SetCork(true);
+    }
+
+    while (err == INET_NO_ERROR && !mSendQueue.IsNull())
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        // Gather the queued buffers into a single call, so that a queue of small messages does not
+        // cost one system call (and, without corking, one segment) per buffer.
+        struct iovec iov[TCP_SEND_MAX_IOVECS];
+        struct msghdr msg;
+        size_t queuedLen = 0;
+        int msgFlags     = sendFlags;
 
-        ssize_t lenSentRaw = send(mSocket, mSendQueue->Start(), bufLen, sendFlags);
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+
+        System::PacketBufferHandle buf = mSendQueue.Retain();
+        for (; !buf.IsNull() && msg.msg_iovlen < TCP_SEND_MAX_IOVECS; buf.Advance())
+        {
+            if (buf->DataLength() == 0)
+                continue;
+
+            iov[msg.msg_iovlen].iov_base = buf->Start();
+            iov[msg.msg_iovlen].iov_len  = buf->DataLength();
+            queuedLen += buf->DataLength();
+            msg.msg_iovlen++;
+        }
+
+#ifdef MSG_MORE
+        // More data follows immediately if the queue did not fit in one call.
+        if (!buf.IsNull())
+            msgFlags |= MSG_MORE;
+#endif // defined(MSG_MORE)
+        buf = nullptr;
+
+        ssize_t lenSentRaw = (queuedLen > 0) ? sendmsg(mSocket, &msg, msgFlags) : 0;
 
         if (lenSentRaw == -1)
         {
@@ -1320,34 +1404,43 @@ INET_ERROR TCPEndPoint::DriveSending()
             break;
         }
 
-        if (lenSentRaw < 0 || lenSentRaw > bufLen)
+        if (lenSentRaw < 0 || static_cast<size_t>(lenSentRaw) > queuedLen)
         {
             err = INET_ERROR_INCORRECT_STATE;
             break;
         }
 
-        // Cast is safe because bufLen is uint16_t.
-        uint16_t lenSent = static_cast<uint16_t>(lenSentRaw);
+        size_t lenSent = static_cast<size_t>(lenSentRaw);
 
-        // Mark the connection as being active.
-        MarkActive();
+        // Free the buffers that were sent in full and advance the start of a partially sent one.
+        ConsumeSent(lenSent);
 
-        if (lenSent < bufLen)
+        if (mSendQueue.IsNull())
         {
-            mSendQueue->ConsumeHead(lenSent);
+            // Do not wait for ability to write on this endpoint.
+            mRequestIO.ClearWrite();
         }
-        else
+
+        if (lenSent == 0)
         {
-            mSendQueue.FreeHead();
-            if (mSendQueue.IsNull())
-            {
-                // Do not wait for ability to write on this endpoint.
-                mRequestIO.ClearWrite();
-            }
+            // Only empty buffers were queued, and they have been dropped.
+            if (queuedLen == 0)
+                continue;
+            break;
         }
 
+        // Mark the connection as being active.
+        MarkActive();
+
         if (OnDataSent != nullptr)
-            OnDataSent(this, lenSent);
+        {
+            for (size_t remaining = lenSent; remaining > 0;)
+            {
+                uint16_t chunk = static_cast<uint16_t>(remaining > UINT16_MAX ? UINT16_MAX : remaining);
+                OnDataSent(this, chunk);
+                remaining -= chunk;
+            }
+        }
 
 #if INET_CONFIG_ENABLE_TCP_SEND_IDLE_CALLBACKS
         // TCP Send is not Idle; Set state and notify if needed
@@ -1356,7 +1449,7 @@ INET_ERROR TCPEndPoint::DriveSending()
 #endif // INET_CONFIG_ENABLE_TCP_SEND_IDLE_CALLBACKS
 
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
-        mBytesWrittenSinceLastProbe += lenSent;
+        mBytesWrittenSinceLastProbe += static_cast<uint32_t>(lenSent);
 
         bool isProgressing = false;
 
@@ -1382,10 +1475,17 @@ INET_ERROR TCPEndPoint::DriveSending()
         }
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
-        if (lenSent < bufLen)
+        // The socket buffer is full; wait until it is writable again.
+        if (lenSent < queuedLen)
             break;
     }
 
+    // Release any partial segment held back while the queue was backed up.
+    if (err == INET_NO_ERROR && mCorked && mSendQueue.IsNull())
+    {
+        err = SetCork(false);
+    }
+
     if (err == INET_NO_ERROR)
     {
         // If we're in the SendShutdown state and the send queue is now empty, shutdown writing on the socket.
@@ -1406,6 +1506,36 @@ INET_ERROR TCPEndPoint::DriveSending()
     return err;
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+INET_ERROR TCPEndPoint::SetCork(bool corked)
+{
+#ifdef TCP_CORK
+    int val = corked ? 1 : 0;
+    if (setsockopt(mSocket, TCP_SOCKOPT_LEVEL, TCP_CORK, &val, sizeof(val)) != 0)
+        return chip::System::MapErrorPOSIX(errno);
+    mCorked = corked;
+    return INET_NO_ERROR;
+#else  // !defined(TCP_CORK)
+    return corked ? INET_ERROR_NOT_IMPLEMENTED : INET_NO_ERROR;
+#endif // defined(TCP_CORK)
+}
+
+void TCPEndPoint::ConsumeSent(size_t len)
+{
+    while (!mSendQueue.IsNull() && mSendQueue->DataLength() <= len)
+    {
+        len -= mSendQueue->DataLength();
+        mSendQueue.FreeHead();
+    }
+
+    if (len > 0)
+    {
+        VerifyOrDie(!mSendQueue.IsNull());
+        mSendQueue->ConsumeHead(static_cast<uint16_t>(len));
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 void TCPEndPoint::DriveReceiving()
 {
     // If there's data in the receive queue and the app is ready to receive it then call the app's callback
@@ -1444,6 +1574,8 @@ void TCPEndPoint::HandleConnectComplete(INET_ERROR err)
         State = kState_Connected;
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+        PrepostReceiveBuffers();
+
         // Wait for ability to read or write on this endpoint.
         mRequestIO.SetRead();
         mRequestIO.SetWrite();
@@ -1604,6 +1736,9 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
         mUnackedLength = 0;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+        ReleaseReceiveBuffers();
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
         // Call the appropriate app callback if allowed.
         if (!suppressCallback)
@@ -2415,13 +2550,13 @@ void TCPEndPoint::ReceiveData()
     bool isNewBuf = true;
 
     if (mRcvQueue.IsNull())
-        rcvBuf = System::PacketBufferHandle::New(kMaxReceiveMessageSize, 0);
+        rcvBuf = GetReceiveBuffer();
     else
     {
         rcvBuf = mRcvQueue->Last();
         if (rcvBuf->AvailableDataLength() == 0)
         {
-            rcvBuf = System::PacketBufferHandle::New(kMaxReceiveMessageSize, 0);
+            rcvBuf = GetReceiveBuffer();
         }
         else
         {
@@ -2524,6 +2659,7 @@ void TCPEndPoint::ReceiveData()
             if (isNewBuf)
             {
                 rcvBuf->SetDataLength(static_cast<uint16_t>(newDataLength));
+                // Leaves recycled buffers, which are shared with mRcvRing, at full size.
                 rcvBuf.RightSize();
                 if (mRcvQueue.IsNull())
                     mRcvQueue = std::move(rcvBuf);
@@ -2541,6 +2677,64 @@ void TCPEndPoint::ReceiveData()
     DriveReceiving();
 }
 
+void TCPEndPoint::PrepostReceiveBuffers()
+{
+#if INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+    // Allocate receive buffers up front, so that a burst of incoming data does not compete with the rest of
+    // the system for the PacketBuffer pool. Failure is not fatal; ReceiveData() allocates on demand.
+    for (System::PacketBufferHandle & slot : mRcvRing)
+    {
+        if (slot.IsNull())
+            slot = System::PacketBufferHandle::New(kMaxReceiveMessageSize, 0);
+    }
+#endif // INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+}
+
+void TCPEndPoint::ReleaseReceiveBuffers()
+{
+#if INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+    for (System::PacketBufferHandle & slot : mRcvRing)
+        slot = nullptr;
+#endif // INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+}
+
+System::PacketBufferHandle TCPEndPoint::GetReceiveBuffer()
+{
+#if INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+    // Reuse a ring buffer that neither the receive queue nor the application references any longer.
+    for (System::PacketBufferHandle & slot : mRcvRing)
+    {
+        if (slot.IsNull() || !slot.HasSoleOwnership())
+            continue;
+
+        // The application may have freed the data chain from an earlier buffer, leaving the rest of
+        // the chain linked to this one; detach and free it.
+        System::PacketBufferHandle buf = slot.PopHead();
+        slot                           = buf.Retain();
+
+        buf->SetStart(buf->Start() - buf->ReservedSize());
+        buf->SetDataLength(0);
+        return buf;
+    }
+#endif // INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+
+    System::PacketBufferHandle buf = System::PacketBufferHandle::New(kMaxReceiveMessageSize, 0);
+
+#if INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+    // Keep the buffer for reuse if a ring slot is empty, e.g. because pre-posting failed.
+    for (System::PacketBufferHandle & slot : mRcvRing)
+    {
+        if (slot.IsNull() && !buf.IsNull())
+        {
+            slot = buf.Retain();
+            break;
+        }
+    }
+#endif // INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+
+    return buf;
+}
+
 void TCPEndPoint::HandleIncomingConnection()
 {
     INET_ERROR err      = INET_NO_ERROR;
@@ -2605,6 +2799,7 @@ void TCPEndPoint::HandleIncomingConnection()
         conEP->mAddrType = kIPAddressType_IPv6;
 #endif // !INET_CONFIG_ENABLE_IPV4
         conEP->Retain();
+        conEP->PrepostReceiveBuffers();
 
         // Wait for ability to read on this endpoint.
         conEP->mRequestIO.SetRead();
@@ -226,6 +226,33 @@ public:
      */
     INET_ERROR EnableNoDelay();
 
+    /**
+     * @brief   Coalesce queued data into full-sized segments.
+     *
+     * @details
+     *  While more than one buffer is waiting in the send queue, set the
+     *  TCP_CORK socket option so that the kernel emits only full segments,
+     *  and clear it (flushing any partial segment) once the queue drains.
+     *  Intended for bulk transfers made of many small messages. On LwIP,
+     *  queued data is always written with TCP_WRITE_FLAG_MORE and this
+     *  method has no further effect.
+     *
+     * @retval  INET_NO_ERROR                success.
+     * @retval  INET_ERROR_INCORRECT_STATE   TCP connection not established.
+     * @retval  INET_ERROR_NOT_IMPLEMENTED   TCP_CORK not supported by the platform.
+     */
+    INET_ERROR EnableSendCoalescing();
+
+    /**
+     * @brief   Stop coalescing queued data; any held partial segment is sent.
+     *
+     * @retval  INET_NO_ERROR                success.
+     * @retval  INET_ERROR_INCORRECT_STATE   TCP connection not established.
+     *
+     * @retval  other                        another system or platform error
+     */
+    INET_ERROR DisableSendCoalescing();
+
     /**
      * @brief
      *    Enable TCP keepalive probes on the associated TCP connection.
@@ -672,6 +699,18 @@ private:
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    bool mSendCoalescing; // Cork the socket while more than one buffer is queued for sending.
+    bool mCorked;         // TCP_CORK is currently set on the socket.
+#if INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+    // Receive buffers owned by this endpoint. A buffer is free for reuse once this is its only reference.
+    chip::System::PacketBufferHandle mRcvRing[INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE];
+#endif // INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+
+    INET_ERROR SetCork(bool corked);
+    void ConsumeSent(size_t len);
+    void PrepostReceiveBuffers();
+    void ReleaseReceiveBuffers();
+    chip::System::PacketBufferHandle GetReceiveBuffer();
     INET_ERROR GetSocket(IPAddressType addrType);
     void HandlePendingIO();
     void ReceiveData();
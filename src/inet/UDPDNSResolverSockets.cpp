@@ -0,0 +1,860 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements UDPDNSResolverSockets, the object that performs
+ *      non-blocking Domain Name System (DNS) resolution over UDP on the
+ *      InetLayer event loop.
+ *
+ */
+#include <inet/InetLayer.h>
+
+#include <core/CHIPEncoding.h>
+#include <crypto/CHIPCryptoPAL.h> // nogncheck
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+#include <net/if.h>
+
+#include "UDPDNSResolverSockets.h"
+
+namespace chip {
+namespace Inet {
+
+namespace {
+
+using namespace chip::Encoding;
+
+constexpr uint16_t kHeaderSize      = 12;
+constexpr uint16_t kMaxMessageSize  = 512;
+constexpr uint16_t kFlag_Response   = 0x8000;
+constexpr uint16_t kFlag_Recursion  = 0x0100;
+constexpr uint16_t kMask_Opcode     = 0x7800;
+constexpr uint16_t kMask_RCode      = 0x000F;
+constexpr uint16_t kClass_IN        = 1;
+constexpr uint16_t kType_A          = 1;
+constexpr uint16_t kType_AAAA       = 28;
+constexpr uint8_t kRCode_NoError    = 0;
+constexpr uint8_t kRCode_ServFail   = 2;
+constexpr uint8_t kRCode_NXDomain   = 3;
+constexpr uint8_t kMaxLabelLength   = 63;
+constexpr uint8_t kMaxPointerHops   = 16;
+constexpr uint32_t kMillisecsPerSec = 1000;
+
+constexpr uint16_t kRecordTypes[] = { kType_A, kType_AAAA };
+
+/**
+ * Decode the (possibly compressed) name at \c offset into dotted text.
+ *
+ * @param[out] next  Offset of the first byte after the name in the original position.
+ *
+ * @return false if the name is malformed or does not fit in \c out.
+ */
+bool ReadName(const uint8_t * msg, uint16_t msgLen, uint16_t offset, char * out, size_t outSize, uint16_t & next)
+{
+    size_t outLen = 0;
+    uint8_t hops  = 0;
+    bool jumped   = false;
+
+    while (true)
+    {
+        VerifyOrReturnError(offset < msgLen, false);
+        uint8_t labelLen = msg[offset];
+
+        if ((labelLen & 0xC0) == 0xC0)
+        {
+            VerifyOrReturnError(offset + 1 < msgLen && ++hops <= kMaxPointerHops, false);
+            if (!jumped)
+            {
+                next = static_cast<uint16_t>(offset + 2);
+            }
+            jumped = true;
+            offset = static_cast<uint16_t>(BigEndian::Get16(&msg[offset]) & 0x3FFF);
+            continue;
+        }
+
+        VerifyOrReturnError(labelLen <= kMaxLabelLength, false);
+        offset++;
+
+        if (labelLen == 0)
+        {
+            break;
+        }
+
+        VerifyOrReturnError(offset + labelLen <= msgLen, false);
+        if (out != nullptr)
+        {
+            VerifyOrReturnError(outLen + labelLen + 1 < outSize, false);
+            if (outLen != 0)
+            {
+                out[outLen++] = '.';
+            }
+            memcpy(&out[outLen], &msg[offset], labelLen);
+            outLen += labelLen;
+        }
+        offset = static_cast<uint16_t>(offset + labelLen);
+    }
+
+    if (!jumped)
+    {
+        next = offset;
+    }
+    if (out != nullptr)
+    {
+        out[outLen] = 0;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ *  The explicit initializer for the UDPDNSResolverSockets class. Loads the
+ *  system name servers; no sockets are opened until the first query.
+ *
+ *  @param[in]  aInet  A pointer to the InetLayer object.
+ *
+ *  @retval #INET_NO_ERROR unconditionally.
+ */
+INET_ERROR UDPDNSResolverSockets::Init(InetLayer * aInet)
+{
+    mInet = aInet;
+
+    // Clear every field, so no waiter list or record state survives a previous Shutdown().
+    for (Query & query : mQueries)
+    {
+        query = Query();
+    }
+
+    FlushCache();
+    LoadSystemServers();
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  This is the explicit deinitializer of the UDPDNSResolverSockets class.
+ *  Outstanding queries are abandoned and their requests completed as
+ *  canceled; the resolver objects themselves are canceled by InetLayer.
+ *
+ *  @retval #INET_NO_ERROR unconditionally.
+ */
+INET_ERROR UDPDNSResolverSockets::Shutdown()
+{
+    mInet->SystemLayer()->CancelTimer(HandleQueryTimeout, this);
+
+    for (Query & query : mQueries)
+    {
+        query.InUse = false;
+        ReleaseEndPoints(query);
+        while (query.Waiters != nullptr)
+        {
+            DNSResolver * resolver = query.Waiters;
+            query.Waiters          = resolver->pNextAsyncDNSResolver;
+            resolver->mState       = DNSResolver::kState_Canceled;
+            resolver->HandleAsyncResolveComplete();
+        }
+    }
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  Replace the name servers used for subsequent queries.
+ *
+ *  @param[in]  servers  The name server addresses, tried in order.
+ *  @param[in]  count    The number of entries in \c servers.
+ *  @param[in]  port     The UDP port the name servers listen on.
+ *
+ *  @retval #INET_NO_ERROR           on success.
+ *  @retval #INET_ERROR_BAD_ARGS     if \c count is zero or exceeds #INET_CONFIG_DNS_MAX_SERVERS.
+ */
+INET_ERROR UDPDNSResolverSockets::SetServers(const IPAddress * servers, uint8_t count, uint16_t port)
+{
+    VerifyOrReturnError(servers != nullptr && count > 0 && count <= INET_CONFIG_DNS_MAX_SERVERS, INET_ERROR_BAD_ARGS);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        mServers[i].Address   = servers[i];
+        mServers[i].Interface = INET_NULL_INTERFACEID;
+    }
+    mServerCount = count;
+    mServerPort  = port;
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  Discard all cached answers.
+ */
+void UDPDNSResolverSockets::FlushCache()
+{
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    for (CacheEntry & entry : mCache)
+    {
+        entry.HostName[0] = 0;
+    }
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+}
+
+/**
+ *  This method prepares a DNSResolver object prior to resolution. See
+ *  AsyncDNSResolverSockets::PrepareDNSResolver() for a description of the
+ *  parameters.
+ *
+ *  @retval #INET_NO_ERROR unconditionally.
+ */
+INET_ERROR UDPDNSResolverSockets::PrepareDNSResolver(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen,
+                                                     uint8_t options, uint8_t maxAddrs, IPAddress * addrArray,
+                                                     DNSResolver::OnResolveCompleteFunct onComplete, void * appState)
+{
+    // A single trailing dot denotes the same (fully qualified) name.
+    if (hostNameLen > 0 && hostName[hostNameLen - 1] == '.')
+    {
+        hostNameLen--;
+    }
+
+    memcpy(resolver.asyncHostNameBuf, hostName, hostNameLen);
+    resolver.asyncHostNameBuf[hostNameLen] = 0;
+    resolver.MaxAddrs                      = maxAddrs;
+    resolver.NumAddrs                      = 0;
+    resolver.DNSOptions                    = options;
+    resolver.AddrArray                     = addrArray;
+    resolver.AppState                      = appState;
+    resolver.OnComplete                    = onComplete;
+    resolver.asyncDNSResolveResult         = INET_NO_ERROR;
+    resolver.mState                        = DNSResolver::kState_Active;
+    resolver.pNextAsyncDNSResolver         = nullptr;
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  Start resolving the host name of a prepared DNSResolver object. The request
+ *  is answered from the cache when possible, joins an outstanding query for
+ *  the same name, or starts a new query. Completion is always reported
+ *  asynchronously.
+ *
+ *  @param[in]  resolver    A reference to the DNSResolver object.
+ *
+ *  @retval #INET_NO_ERROR                if the request was accepted.
+ *  @retval #INET_ERROR_NO_MEMORY         if #INET_CONFIG_DNS_MAX_PENDING_QUERIES
+ *                                        distinct names are already being queried.
+ *  @retval #INET_ERROR_BAD_ARGS          if the host name is not a valid DNS name.
+ *  @retval other appropriate POSIX network or OS error.
+ */
+INET_ERROR UDPDNSResolverSockets::EnqueueRequest(DNSResolver & resolver)
+{
+    INET_ERROR err = INET_NO_ERROR;
+    Query * query;
+
+    const CacheEntry * entry = LookupCache(resolver.asyncHostNameBuf);
+    if (entry != nullptr)
+    {
+        resolver.asyncDNSResolveResult = entry->Result;
+        if (entry->Result == INET_NO_ERROR)
+        {
+            resolver.asyncDNSResolveResult = resolver.ProcessAddressList(entry->Addrs, entry->NumAddrs);
+        }
+        resolver.mState = DNSResolver::kState_Complete;
+        return mInet->SystemLayer()->ScheduleWork(DNSResultEventHandler, &resolver);
+    }
+
+    query = FindQuery(resolver.asyncHostNameBuf);
+    if (query == nullptr)
+    {
+        query = AllocQuery();
+        VerifyOrReturnError(query != nullptr, INET_ERROR_NO_MEMORY);
+
+        // A reclaimed query may still hold the endpoints of its previous name.
+        ReleaseEndPoints(*query);
+
+        strcpy(query->HostName, resolver.asyncHostNameBuf);
+        query->Waiters      = nullptr;
+        query->NumAddrs     = 0;
+        query->Attempt      = 0;
+        query->ResponseCode = kRCode_NoError;
+        query->MinTTL       = UINT32_MAX;
+#if INET_CONFIG_ENABLE_IPV4
+        query->PendingRecords = (1 << kRecordIndex_A) | (1 << kRecordIndex_AAAA);
+#else
+        query->PendingRecords = (1 << kRecordIndex_AAAA);
+#endif // INET_CONFIG_ENABLE_IPV4
+
+        err = SendQuery(*query);
+        if (err != INET_NO_ERROR)
+        {
+            query->InUse = false;
+            ReleaseEndPoints(*query);
+            return err;
+        }
+    }
+
+    resolver.pNextAsyncDNSResolver = query->Waiters;
+    query->Waiters                 = &resolver;
+
+    return INET_NO_ERROR;
+}
+
+/**
+ *  Cancel an outstanding DNS request. The query it was waiting on is left
+ *  running so that its answer is still cached.
+ *
+ *  @param[in]    resolver   A reference to the DNSResolver object.
+ */
+INET_ERROR UDPDNSResolverSockets::Cancel(DNSResolver & resolver)
+{
+    bool found = false;
+
+    for (Query & query : mQueries)
+    {
+        for (DNSResolver ** link = &query.Waiters; query.InUse && *link != nullptr; link = &(*link)->pNextAsyncDNSResolver)
+        {
+            if (*link == &resolver)
+            {
+                *link = resolver.pNextAsyncDNSResolver;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    resolver.mState = DNSResolver::kState_Canceled;
+
+    // A request answered from the cache already has its completion scheduled,
+    // which releases it; one detached from a query is released here.
+    if (found)
+    {
+        return mInet->SystemLayer()->ScheduleWork(DNSResultEventHandler, &resolver);
+    }
+
+    return INET_NO_ERROR;
+}
+
+void UDPDNSResolverSockets::LoadSystemServers()
+{
+    char line[128];
+    FILE * file = fopen("/etc/resolv.conf", "r");
+
+    mServerCount = 0;
+    mServerPort  = kDNSPort;
+
+    while (file != nullptr && mServerCount < INET_CONFIG_DNS_MAX_SERVERS && fgets(line, sizeof(line), file) != nullptr)
+    {
+        char * saveptr;
+        char * keyword = strtok_r(line, " \t\r\n", &saveptr);
+        char * value   = strtok_r(nullptr, " \t\r\n", &saveptr);
+
+        if (keyword == nullptr || value == nullptr || strcmp(keyword, "nameserver") != 0)
+        {
+            continue;
+        }
+
+        // Link-local servers carry their interface as a zone suffix.
+        InterfaceId intfId = INET_NULL_INTERFACEID;
+        char * zone        = strchr(value, '%');
+        if (zone != nullptr)
+        {
+            *zone++ = 0;
+            intfId  = if_nametoindex(zone);
+        }
+
+        Server & server = mServers[mServerCount];
+        if (IPAddress::FromString(value, server.Address))
+        {
+            server.Interface = intfId;
+            mServerCount++;
+        }
+    }
+
+    if (file != nullptr)
+    {
+        fclose(file);
+    }
+
+    // Like the system resolver, fall back to a server on the local host.
+    if (mServerCount == 0)
+    {
+#if INET_CONFIG_ENABLE_IPV4
+        IPAddress::FromString("127.0.0.1", mServers[0].Address);
+#else
+        IPAddress::FromString("::1", mServers[0].Address);
+#endif // INET_CONFIG_ENABLE_IPV4
+        mServers[0].Interface = INET_NULL_INTERFACEID;
+        mServerCount          = 1;
+    }
+}
+
+UDPDNSResolverSockets::Query * UDPDNSResolverSockets::FindQuery(const char * hostName)
+{
+    for (Query & query : mQueries)
+    {
+        if (query.InUse && HostNameMatches(query.HostName, hostName))
+        {
+            return &query;
+        }
+    }
+    return nullptr;
+}
+
+UDPDNSResolverSockets::Query * UDPDNSResolverSockets::AllocQuery()
+{
+    Query * orphan = nullptr;
+
+    for (Query & query : mQueries)
+    {
+        if (!query.InUse)
+        {
+            query.InUse = true;
+            return &query;
+        }
+        if (query.Waiters == nullptr)
+        {
+            orphan = &query;
+        }
+    }
+
+    // Reclaim a query whose requests have all been canceled.
+    return orphan;
+}
+
+INET_ERROR UDPDNSResolverSockets::SendQuery(Query & query)
+{
+    INET_ERROR err        = INET_ERROR_DNS_NO_RECOVERY;
+    const Server & server = mServers[query.Attempt % mServerCount];
+    bool sent             = false;
+
+    for (uint8_t i = 0; i < kRecordIndex_Count; i++)
+    {
+        if (query.PendingRecords & (1 << i))
+        {
+            err  = SendQueryRecord(query, i, server);
+            sent = sent || (err == INET_NO_ERROR);
+        }
+    }
+    VerifyOrReturnError(sent, err);
+
+    query.Attempt++;
+    query.DeadlineMS = System::Layer::GetClock_MonotonicMS() + INET_CONFIG_DNS_QUERY_TIMEOUT_MS;
+    RestartTimer();
+
+    return INET_NO_ERROR;
+}
+
+void UDPDNSResolverSockets::RestartTimer()
+{
+    uint64_t now      = System::Layer::GetClock_MonotonicMS();
+    uint64_t deadline = UINT64_MAX;
+
+    for (const Query & query : mQueries)
+    {
+        if (query.InUse)
+        {
+            deadline = ::chip::min(deadline, query.DeadlineMS);
+        }
+    }
+
+    if (deadline == UINT64_MAX)
+    {
+        mInet->SystemLayer()->CancelTimer(HandleQueryTimeout, this);
+    }
+    else
+    {
+        mInet->SystemLayer()->StartTimer(static_cast<uint32_t>((deadline > now) ? deadline - now : 0), HandleQueryTimeout, this);
+    }
+}
+
+INET_ERROR UDPDNSResolverSockets::SendQueryRecord(Query & query, uint8_t recordIndex, const Server & server)
+{
+    UDPEndPoint * endPoint = nullptr;
+    System::PacketBufferHandle msg;
+
+    ReturnErrorOnFailure(GetEndPoint(query, server.Address.Type(), &endPoint));
+
+    msg = System::PacketBufferHandle::New(kMaxMessageSize);
+    VerifyOrReturnError(!msg.IsNull(), INET_ERROR_NO_MEMORY);
+
+    uint8_t * p   = msg->Start();
+    uint8_t * end = p + msg->AvailableDataLength();
+
+    // Together with the per-query source port, an unpredictable id keeps off-path answers out of the cache.
+    uint8_t id[sizeof(query.Ids[recordIndex])];
+    ReturnErrorOnFailure(Crypto::DRBG_get_bytes(id, sizeof(id)));
+    query.Ids[recordIndex] = BigEndian::Get16(id);
+
+    BigEndian::Put16(p + 0, query.Ids[recordIndex]);
+    BigEndian::Put16(p + 2, kFlag_Recursion);
+    BigEndian::Put16(p + 4, 1); // QDCOUNT
+    BigEndian::Put16(p + 6, 0);
+    BigEndian::Put16(p + 8, 0);
+    BigEndian::Put16(p + 10, 0);
+    p += kHeaderSize;
+
+    for (const char * label = query.HostName; *label != 0;)
+    {
+        const char * dot = strchr(label, '.');
+        size_t labelLen  = (dot != nullptr) ? static_cast<size_t>(dot - label) : strlen(label);
+
+        VerifyOrReturnError(labelLen > 0 && labelLen <= kMaxLabelLength, INET_ERROR_BAD_ARGS);
+        VerifyOrReturnError(p + 1 + labelLen < end, INET_ERROR_HOST_NAME_TOO_LONG);
+
+        *p++ = static_cast<uint8_t>(labelLen);
+        memcpy(p, label, labelLen);
+        p += labelLen;
+        label += labelLen + ((dot != nullptr) ? 1 : 0);
+    }
+
+    VerifyOrReturnError(p + 5 <= end, INET_ERROR_HOST_NAME_TOO_LONG);
+    *p++ = 0;
+    BigEndian::Put16(p, kRecordTypes[recordIndex]);
+    BigEndian::Put16(p + 2, kClass_IN);
+    p += 4;
+
+    msg->SetDataLength(static_cast<uint16_t>(p - msg->Start()));
+
+    return endPoint->SendTo(server.Address, mServerPort, server.Interface, std::move(msg));
+}
+
+INET_ERROR UDPDNSResolverSockets::GetEndPoint(Query & query, IPAddressType addrType, UDPEndPoint ** outEndPoint)
+{
+    UDPEndPoint *& endPoint = query.EndPoints[EndPointIndex(addrType)];
+
+    if (endPoint == nullptr)
+    {
+        // Each query binds its own ephemeral port, so the source port changes from one query to the next.
+        INET_ERROR err = mInet->NewUDPEndPoint(&endPoint);
+        SuccessOrExit(err);
+
+        err = endPoint->Bind(addrType, IPAddress::Any, 0);
+        SuccessOrExit(err);
+
+        err = endPoint->Listen(HandleMessageReceived, nullptr, this);
+        SuccessOrExit(err);
+
+    exit:
+        if (err != INET_NO_ERROR)
+        {
+            if (endPoint != nullptr)
+            {
+                endPoint->Free();
+                endPoint = nullptr;
+            }
+            return err;
+        }
+    }
+
+    *outEndPoint = endPoint;
+    return INET_NO_ERROR;
+}
+
+void UDPDNSResolverSockets::ReleaseEndPoints(Query & query)
+{
+    for (UDPEndPoint *& endPoint : query.EndPoints)
+    {
+        if (endPoint != nullptr)
+        {
+            endPoint->Free();
+            endPoint = nullptr;
+        }
+    }
+}
+
+void UDPDNSResolverSockets::HandleMessageReceived(IPEndPointBasis * endPoint, chip::System::PacketBufferHandle msg,
+                                                  const IPPacketInfo * pktInfo)
+{
+    UDPDNSResolverSockets * self = static_cast<UDPDNSResolverSockets *>(endPoint->AppState);
+
+    // Answers larger than a single buffer are not expected over UDP.
+    if (pktInfo != nullptr && !msg->HasChainedBuffer())
+    {
+        // Completing the query frees the endpoint; keep it valid until the receive handler returns.
+        endPoint->Retain();
+        self->HandleResponse(endPoint, msg->Start(), msg->DataLength(), *pktInfo);
+        endPoint->Release();
+    }
+}
+
+void UDPDNSResolverSockets::HandleResponse(const IPEndPointBasis * endPoint, const uint8_t * msg, uint16_t msgLen,
+                                           const IPPacketInfo & pktInfo)
+{
+    char name[NL_DNS_HOSTNAME_MAX_LEN + 1];
+    Query * query       = nullptr;
+    uint8_t recordIndex = 0;
+    uint16_t offset;
+
+    VerifyOrReturn(msgLen >= kHeaderSize && pktInfo.SrcPort == mServerPort);
+
+    uint16_t id      = BigEndian::Get16(msg + 0);
+    uint16_t flags   = BigEndian::Get16(msg + 2);
+    uint16_t qdCount = BigEndian::Get16(msg + 4);
+    uint16_t anCount = BigEndian::Get16(msg + 6);
+
+    VerifyOrReturn((flags & kFlag_Response) != 0 && (flags & kMask_Opcode) == 0 && qdCount == 1);
+
+    for (Query & q : mQueries)
+    {
+        for (uint8_t i = 0; q.InUse && i < kRecordIndex_Count; i++)
+        {
+            if ((q.PendingRecords & (1 << i)) && q.Ids[i] == id &&
+                (q.EndPoints[0] == endPoint || q.EndPoints[1] == endPoint))
+            {
+                query       = &q;
+                recordIndex = i;
+            }
+        }
+    }
+    VerifyOrReturn(query != nullptr);
+
+    // Only accept answers from a configured server that echo the question asked.
+    bool fromServer = false;
+    for (uint8_t i = 0; i < mServerCount; i++)
+    {
+        fromServer = fromServer || (mServers[i].Address == pktInfo.SrcAddress);
+    }
+    VerifyOrReturn(fromServer);
+
+    VerifyOrReturn(ReadName(msg, msgLen, kHeaderSize, name, sizeof(name), offset) && HostNameMatches(name, query->HostName));
+    VerifyOrReturn(offset + 4 <= msgLen && BigEndian::Get16(msg + offset) == kRecordTypes[recordIndex] &&
+                   BigEndian::Get16(msg + offset + 2) == kClass_IN);
+    offset = static_cast<uint16_t>(offset + 4);
+
+    uint8_t rcode = static_cast<uint8_t>(flags & kMask_RCode);
+    if (rcode != kRCode_NoError && query->ResponseCode != kRCode_NXDomain)
+    {
+        query->ResponseCode = rcode;
+    }
+
+    // Collect the addresses of the requested type. CNAME records leading to
+    // them are skipped; the answer section is trusted to only contain the chain
+    // for the question.
+    for (uint16_t i = 0; i < anCount; i++)
+    {
+        VerifyOrExit(ReadName(msg, msgLen, offset, nullptr, 0, offset) && offset + 10 <= msgLen, );
+
+        uint16_t type     = BigEndian::Get16(msg + offset);
+        uint16_t rrClass  = BigEndian::Get16(msg + offset + 2);
+        uint32_t ttl      = BigEndian::Get32(msg + offset + 4);
+        uint16_t rdLength = BigEndian::Get16(msg + offset + 8);
+        const uint8_t * rdata = msg + offset + 10;
+
+        VerifyOrExit(offset + 10 + rdLength <= msgLen, );
+        offset = static_cast<uint16_t>(offset + 10 + rdLength);
+
+        if (rrClass != kClass_IN || type != kRecordTypes[recordIndex] || query->NumAddrs >= INET_CONFIG_MAX_DNS_ADDRS)
+        {
+            continue;
+        }
+
+        if (type == kType_AAAA && rdLength == sizeof(struct in6_addr))
+        {
+            struct in6_addr addr;
+            memcpy(&addr, rdata, sizeof(addr));
+            query->Addrs[query->NumAddrs++] = IPAddress::FromIPv6(addr);
+        }
+#if INET_CONFIG_ENABLE_IPV4
+        else if (type == kType_A && rdLength == sizeof(struct in_addr))
+        {
+            struct in_addr addr;
+            memcpy(&addr, rdata, sizeof(addr));
+            query->Addrs[query->NumAddrs++] = IPAddress::FromIPv4(addr);
+        }
+#endif // INET_CONFIG_ENABLE_IPV4
+        else
+        {
+            continue;
+        }
+
+        query->MinTTL = ::chip::min(query->MinTTL, ttl);
+    }
+
+exit:
+    query->PendingRecords = static_cast<uint8_t>(query->PendingRecords & ~(1 << recordIndex));
+
+    if (query->PendingRecords == 0)
+    {
+        INET_ERROR err;
+
+        if (query->NumAddrs > 0 || query->ResponseCode == kRCode_NoError || query->ResponseCode == kRCode_NXDomain)
+            err = INET_NO_ERROR;
+        else if (query->ResponseCode == kRCode_ServFail)
+            err = INET_ERROR_DNS_TRY_AGAIN;
+        else
+            err = INET_ERROR_DNS_NO_RECOVERY;
+
+        CompleteQuery(*query, err);
+    }
+}
+
+/**
+ *  Report the outcome of a query to every request waiting on it and cache it.
+ *
+ *  @param[in]  err  #INET_NO_ERROR if all record types were answered,
+ *                   otherwise the error to report.
+ */
+void UDPDNSResolverSockets::CompleteQuery(Query & query, INET_ERROR err)
+{
+    DNSResolver * waiters = query.Waiters;
+
+    if (err == INET_NO_ERROR)
+    {
+        err = (query.NumAddrs > 0) ? INET_NO_ERROR : INET_ERROR_HOST_NOT_FOUND;
+        UpdateCache(query, err);
+    }
+    else if (query.NumAddrs > 0)
+    {
+        // Some record types went unanswered; report what did arrive, uncached.
+        err = INET_NO_ERROR;
+    }
+
+    // Free the query before calling out, so that completion handlers may start new requests.
+    query.InUse   = false;
+    query.Waiters = nullptr;
+    ReleaseEndPoints(query);
+    RestartTimer();
+
+    while (waiters != nullptr)
+    {
+        DNSResolver * resolver = waiters;
+        waiters                = resolver->pNextAsyncDNSResolver;
+
+        resolver->asyncDNSResolveResult = err;
+        if (err == INET_NO_ERROR)
+        {
+            resolver->asyncDNSResolveResult = resolver->ProcessAddressList(query.Addrs, query.NumAddrs);
+        }
+        resolver->mState = DNSResolver::kState_Complete;
+        resolver->HandleAsyncResolveComplete();
+    }
+}
+
+const UDPDNSResolverSockets::CacheEntry * UDPDNSResolverSockets::LookupCache(const char * hostName)
+{
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    uint64_t now = System::Layer::GetClock_MonotonicMS();
+
+    for (CacheEntry & entry : mCache)
+    {
+        if (entry.HostName[0] != 0 && HostNameMatches(entry.HostName, hostName))
+        {
+            if (entry.ExpiryMS > now)
+            {
+                return &entry;
+            }
+            entry.HostName[0] = 0;
+        }
+    }
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
+    return nullptr;
+}
+
+void UDPDNSResolverSockets::UpdateCache(const Query & query, INET_ERROR result)
+{
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    uint32_t ttl = (result == INET_NO_ERROR) ? ::chip::min(query.MinTTL, static_cast<uint32_t>(INET_CONFIG_DNS_CACHE_MAX_TTL_SECS))
+                                             : INET_CONFIG_DNS_NEGATIVE_CACHE_TTL_SECS;
+    VerifyOrReturn(ttl > 0);
+
+    // Replace an entry for the same name, else an empty one, else the one expiring first.
+    CacheEntry * victim = &mCache[0];
+    for (CacheEntry & entry : mCache)
+    {
+        if (entry.HostName[0] != 0 && HostNameMatches(entry.HostName, query.HostName))
+        {
+            victim = &entry;
+            break;
+        }
+        if (victim->HostName[0] != 0 && (entry.HostName[0] == 0 || entry.ExpiryMS < victim->ExpiryMS))
+        {
+            victim = &entry;
+        }
+    }
+
+    strcpy(victim->HostName, query.HostName);
+    for (uint8_t i = 0; i < query.NumAddrs; i++)
+    {
+        victim->Addrs[i] = query.Addrs[i];
+    }
+    victim->NumAddrs = query.NumAddrs;
+    victim->Result   = result;
+    victim->ExpiryMS = System::Layer::GetClock_MonotonicMS() + static_cast<uint64_t>(ttl) * kMillisecsPerSec;
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+}
+
+uint8_t UDPDNSResolverSockets::EndPointIndex(IPAddressType addrType)
+{
+#if INET_CONFIG_ENABLE_IPV4
+    return (addrType == kIPAddressType_IPv4) ? 1 : 0;
+#else
+    return 0;
+#endif // INET_CONFIG_ENABLE_IPV4
+}
+
+bool UDPDNSResolverSockets::HostNameMatches(const char * a, const char * b)
+{
+    // DNS names compare case-insensitively.
+    return strcasecmp(a, b) == 0;
+}
+
+/* Timer event handler retransmitting or failing queries that went unanswered. */
+void UDPDNSResolverSockets::HandleQueryTimeout(chip::System::Layer * aLayer, void * aAppState, chip::System::Error aError)
+{
+    UDPDNSResolverSockets * self = static_cast<UDPDNSResolverSockets *>(aAppState);
+    uint64_t now                 = System::Layer::GetClock_MonotonicMS();
+
+    for (Query & query : self->mQueries)
+    {
+        if (!query.InUse || query.DeadlineMS > now)
+        {
+            continue;
+        }
+
+        if (query.Attempt < INET_CONFIG_DNS_QUERY_ATTEMPTS && self->SendQuery(query) == INET_NO_ERROR)
+        {
+            ChipLogDetail(Inet, "DNS query for %s timed out, retrying", query.HostName);
+            continue;
+        }
+
+        self->CompleteQuery(query, INET_ERROR_DNS_TRY_AGAIN);
+    }
+
+    self->RestartTimer();
+}
+
+/* Event handler function for completions that are reported without a query. */
+void UDPDNSResolverSockets::DNSResultEventHandler(chip::System::Layer * aLayer, void * aAppState, chip::System::Error aError)
+{
+    DNSResolver * resolver = static_cast<DNSResolver *>(aAppState);
+
+    if (resolver)
+    {
+        resolver->HandleAsyncResolveComplete();
+    }
+}
+
+} // namespace Inet
+} // namespace chip
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -0,0 +1,159 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines UDPDNSResolverSockets, the object that performs
+ *      non-blocking Domain Name System (DNS) resolution over UDP on the
+ *      InetLayer event loop.
+ */
+#pragma once
+
+#include <inet/IPAddress.h>
+#include <inet/InetError.h>
+#include <inet/InetInterface.h>
+
+#if INET_CONFIG_ENABLE_DNS_RESOLVER
+#include <inet/DNSResolver.h>
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER
+
+#include <system/SystemPacketBuffer.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+namespace chip {
+namespace Inet {
+
+class IPEndPointBasis;
+class IPPacketInfo;
+class UDPEndPoint;
+
+/**
+ *  @class UDPDNSResolverSockets
+ *  @brief
+ *    This is an internal class to InetLayer that resolves host names by
+ *    sending A and AAAA queries to the configured name servers from a
+ *    UDPEndPoint, without blocking and without helper threads.
+ *
+ *    Concurrent requests for the same host name share one outstanding
+ *    query, and answers are cached for the lifetime of their records
+ *    (bounded by #INET_CONFIG_DNS_CACHE_MAX_TTL_SECS). "Host not found"
+ *    answers are cached for #INET_CONFIG_DNS_NEGATIVE_CACHE_TTL_SECS.
+ *
+ *    Name servers are read from /etc/resolv.conf at initialization and may
+ *    be overridden with SetServers(). Search domains and /etc/hosts are not
+ *    consulted, and truncated answers are used as received.
+ */
+class UDPDNSResolverSockets
+{
+    friend class InetLayer;
+    friend class DNSResolver;
+
+public:
+    static constexpr uint16_t kDNSPort = 53;
+
+    INET_ERROR Init(InetLayer * inet);
+
+    INET_ERROR Shutdown();
+
+    INET_ERROR SetServers(const IPAddress * servers, uint8_t count, uint16_t port = kDNSPort);
+
+    void FlushCache();
+
+    INET_ERROR PrepareDNSResolver(DNSResolver & resolver, const char * hostName, uint16_t hostNameLen, uint8_t options,
+                                  uint8_t maxAddrs, IPAddress * addrArray, DNSResolver::OnResolveCompleteFunct onComplete,
+                                  void * appState);
+
+    INET_ERROR EnqueueRequest(DNSResolver & resolver);
+
+    INET_ERROR Cancel(DNSResolver & resolver);
+
+private:
+    enum
+    {
+        kRecordIndex_A    = 0,
+        kRecordIndex_AAAA = 1,
+        kRecordIndex_Count
+    };
+
+    struct Server
+    {
+        IPAddress Address;
+        InterfaceId Interface;
+    };
+
+    struct Query
+    {
+        char HostName[NL_DNS_HOSTNAME_MAX_LEN + 1];
+        IPAddress Addrs[INET_CONFIG_MAX_DNS_ADDRS];
+        DNSResolver * Waiters; /* Requests waiting on this query, linked through pNextAsyncDNSResolver. */
+        UDPEndPoint * EndPoints[2]; /* Bound to a fresh ephemeral port for this query; indexed by EndPointIndex(). */
+        uint64_t DeadlineMS;
+        uint32_t MinTTL;
+        uint16_t Ids[kRecordIndex_Count];
+        uint8_t PendingRecords; /* Bit mask of record types not yet answered. */
+        uint8_t NumAddrs;
+        uint8_t Attempt;
+        uint8_t ResponseCode;
+        bool InUse;
+    };
+
+    struct CacheEntry
+    {
+        char HostName[NL_DNS_HOSTNAME_MAX_LEN + 1];
+        IPAddress Addrs[INET_CONFIG_MAX_DNS_ADDRS];
+        uint64_t ExpiryMS;
+        INET_ERROR Result;
+        uint8_t NumAddrs;
+    };
+
+    InetLayer * mInet;
+    Server mServers[INET_CONFIG_DNS_MAX_SERVERS];
+    Query mQueries[INET_CONFIG_DNS_MAX_PENDING_QUERIES];
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    CacheEntry mCache[INET_CONFIG_DNS_CACHE_SIZE];
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+    uint16_t mServerPort;
+    uint8_t mServerCount;
+
+    void LoadSystemServers();
+    Query * FindQuery(const char * hostName);
+    Query * AllocQuery();
+    INET_ERROR SendQuery(Query & query);
+    void RestartTimer();
+    INET_ERROR SendQueryRecord(Query & query, uint8_t recordIndex, const Server & server);
+    INET_ERROR GetEndPoint(Query & query, IPAddressType addrType, UDPEndPoint ** outEndPoint);
+    void ReleaseEndPoints(Query & query);
+    void HandleResponse(const IPEndPointBasis * endPoint, const uint8_t * msg, uint16_t msgLen, const IPPacketInfo & pktInfo);
+    void CompleteQuery(Query & query, INET_ERROR err);
+
+    const CacheEntry * LookupCache(const char * hostName);
+    void UpdateCache(const Query & query, INET_ERROR result);
+
+    static uint8_t EndPointIndex(IPAddressType addrType);
+    static bool HostNameMatches(const char * a, const char * b);
+    static void HandleQueryTimeout(chip::System::Layer * aLayer, void * aAppState, chip::System::Error aError);
+    static void DNSResultEventHandler(chip::System::Layer * aLayer, void * aAppState, chip::System::Error aError);
+    static void HandleMessageReceived(IPEndPointBasis * endPoint, chip::System::PacketBufferHandle msg,
+                                      const IPPacketInfo * pktInfo);
+};
+
+} // namespace Inet
+} // namespace chip
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -859,7 +859,12 @@ void UDPEndPoint::LwIPReceiveUDPMessage(void * arg, struct udp_pcb * pcb, struct
     UDPEndPoint * ep                   = static_cast<UDPEndPoint *>(arg);
     chip::System::Layer & lSystemLayer = ep->SystemLayer();
     IPPacketInfo * pktInfo             = NULL;
-    System::PacketBufferHandle buf     = System::PacketBufferHandle::Adopt(p);
+    System::PacketBufferHandle buf     = AdoptReceivedPbuf(p);
+
+    if (buf.IsNull())
+    {
+        return;
+    }
 
     pktInfo = GetPacketInfo(buf);
     if (pktInfo != NULL)
@@ -882,9 +887,10 @@ void UDPEndPoint::LwIPReceiveUDPMessage(void * arg, struct udp_pcb * pcb, struct
 #endif // INET_CONFIG_ENABLE_IPV4
 #endif // LWIP_VERSION_MAJOR <= 1
 
-        pktInfo->Interface = ip_current_netif();
-        pktInfo->SrcPort   = port;
-        pktInfo->DestPort  = pcb->local_port;
+        pktInfo->Interface   = ip_current_netif();
+        pktInfo->SrcPort     = port;
+        pktInfo->DestPort    = pcb->local_port;
+        pktInfo->ReceiveTime = System::Layer::GetClock_MonotonicHiRes();
     }
 
     PostPacketBufferEvent(lSystemLayer, *ep, kInetEvent_UDPDataReceived, std::move(buf));
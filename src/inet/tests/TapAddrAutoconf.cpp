@@ -0,0 +1,92 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   This file implements functions for taking configuration for the LwIP stack
+ *   from the corresponding configuration on the tap interface.
+ */
+
+#include "TapAddrAutoconf.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <ifaddrs.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
+#include <support/CHIPMem.h>
+
+/**
+ * Append the IPv4 and IPv6 addresses assigned to the host interface @p ifName to @p addresses, as strings allocated with
+ * chip::Platform::MemoryAlloc.
+ *
+ * @return 0 on success, otherwise an errno value.
+ */
+int CollectTapAddresses(std::vector<char *> & addresses, const char * ifName)
+{
+    struct ifaddrs * addrsList;
+
+    if (getifaddrs(&addrsList) != 0)
+    {
+        return errno;
+    }
+
+    for (struct ifaddrs * addr = addrsList; addr != nullptr; addr = addr->ifa_next)
+    {
+        const void * inAddr;
+
+        if (addr->ifa_addr == nullptr || strcmp(addr->ifa_name, ifName) != 0)
+        {
+            continue;
+        }
+
+        if (addr->ifa_addr->sa_family == AF_INET)
+        {
+            inAddr = &reinterpret_cast<struct sockaddr_in *>(addr->ifa_addr)->sin_addr;
+        }
+        else if (addr->ifa_addr->sa_family == AF_INET6)
+        {
+            inAddr = &reinterpret_cast<struct sockaddr_in6 *>(addr->ifa_addr)->sin6_addr;
+        }
+        else
+        {
+            continue;
+        }
+
+        char * addrStr = static_cast<char *>(chip::Platform::MemoryAlloc(INET6_ADDRSTRLEN));
+        if (addrStr == nullptr)
+        {
+            freeifaddrs(addrsList);
+            return ENOMEM;
+        }
+
+        if (inet_ntop(addr->ifa_addr->sa_family, inAddr, addrStr, INET6_ADDRSTRLEN) == nullptr)
+        {
+            chip::Platform::MemoryFree(addrStr);
+            continue;
+        }
+
+        addresses.push_back(addrStr);
+    }
+
+    freeifaddrs(addrsList);
+
+    return 0;
+}
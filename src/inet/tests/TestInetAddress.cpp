@@ -28,6 +28,8 @@
 
 #include <string.h>
 
+#include <unordered_set>
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
 #include <lwip/ip_addr.h>
@@ -793,6 +795,32 @@ void CheckToString(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+/**
+ *  Test that addresses survive a text round trip: parsing canonical text and
+ *  formatting the result yields the same text and an equal address.
+ */
+void CheckStringRoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    static const char * const kAddressStrings[] = {
+        "fe80::1", "2001:db8:85a3::8a2e:370:7334", "fd00:1:2:3:4:5:6:7", "ff02::fb", "64:ff9b::c0a8:101",
+#if INET_CONFIG_ENABLE_IPV4
+        "10.0.0.1",
+#endif // INET_CONFIG_ENABLE_IPV4
+    };
+    char lAddressBuffer[INET6_ADDRSTRLEN];
+
+    for (const char * lAddressString : kAddressStrings)
+    {
+        IPAddress lAddress;
+        IPAddress lParsed;
+
+        NL_TEST_ASSERT(inSuite, IPAddress::FromString(lAddressString, lAddress));
+        CheckAddressString(inSuite, lAddress.ToString(lAddressBuffer), lAddressString);
+        NL_TEST_ASSERT(inSuite, IPAddress::FromString(lAddressBuffer, lParsed));
+        NL_TEST_ASSERT(inSuite, lParsed == lAddress);
+    }
+}
+
 /**
  *  Test correct identification of IPv6 ULA addresses.
  */
@@ -955,6 +983,63 @@ void CheckOperatorNotEqual(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+/**
+ *  Test IPAddress hash.
+ */
+void CheckHash(nlTestSuite * inSuite, void * inContext)
+{
+    const struct TestContext * lContext            = static_cast<const struct TestContext *>(inContext);
+    IPAddressExpandedContextIterator lFirstCurrent = lContext->mIPAddressExpandedContextRange.mBegin;
+    IPAddressExpandedContextIterator lFirstEnd     = lContext->mIPAddressExpandedContextRange.mEnd;
+
+    while (lFirstCurrent != lFirstEnd)
+    {
+        IPAddressExpandedContextIterator lSecondCurrent = lContext->mIPAddressExpandedContextRange.mBegin;
+        IPAddress test_addr_1;
+
+        SetupIPAddress(test_addr_1, lFirstCurrent);
+
+        NL_TEST_ASSERT(inSuite, std::hash<IPAddress>()(test_addr_1) == test_addr_1.Hash());
+
+        // Equal addresses must hash equally, and the distinct addresses of the context must not collide.
+        while (lSecondCurrent != lFirstEnd)
+        {
+            IPAddress test_addr_2;
+
+            SetupIPAddress(test_addr_2, lSecondCurrent);
+
+            if (test_addr_1 == test_addr_2)
+            {
+                NL_TEST_ASSERT(inSuite, test_addr_1.Hash() == test_addr_2.Hash());
+            }
+            else
+            {
+                NL_TEST_ASSERT(inSuite, test_addr_1.Hash() != test_addr_2.Hash());
+            }
+
+            ++lSecondCurrent;
+        }
+
+        ++lFirstCurrent;
+    }
+
+    // Addresses differing in a single bit of any word must not collide in the low bits used for bucket selection.
+    {
+        std::unordered_set<size_t> lBuckets;
+        IPAddress lBase = IPAddress::MakeULA(0x1122334455, 0x6677, 0x8899AABBCCDDEEFF);
+
+        for (int i = 0; i < 128; i++)
+        {
+            IPAddress lAddr = lBase;
+
+            lAddr.Addr[i / 32] ^= static_cast<uint32_t>(1) << (i % 32);
+            lBuckets.insert(lAddr.Hash() & 0xFFFF);
+        }
+
+        NL_TEST_ASSERT(inSuite, lBuckets.size() >= 120);
+    }
+}
+
 /**
  *  Test IPAddress assign operator.
  */
@@ -1724,6 +1809,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Address Encode / Decode Symmetricity",        CheckEcodeDecodeSymmetricity),
     NL_TEST_DEF("From String Conversion",                      CheckFromString),
     NL_TEST_DEF("To String Conversion",                        CheckToString),
+    NL_TEST_DEF("String Conversion Round Trip",                CheckStringRoundTrip),
 #if INET_CONFIG_ENABLE_IPV4
     NL_TEST_DEF("IPv4 Detection",                              CheckIsIPv4),
     NL_TEST_DEF("IPv4 Multicast Detection",                    CheckIsIPv4Multicast),
@@ -1737,6 +1823,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Multicast Detection",                         CheckIsMulticast),
     NL_TEST_DEF("Equivalence Operator",                        CheckOperatorEqual),
     NL_TEST_DEF("Non-Equivalence Operator",                    CheckOperatorNotEqual),
+    NL_TEST_DEF("Hash",                                        CheckHash),
     NL_TEST_DEF("Assign Operator",                             CheckOperatorAssign),
     NL_TEST_DEF("Convert IPv6 to IPAddress",                   CheckFromIPv6),
     NL_TEST_DEF("Convert IPAddress to IPv6",                   CheckToIPv6),
@@ -55,6 +55,7 @@
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/dns.h>
 #include <lwip/init.h>
+#include <lwip/ip6_route_table.h>
 #include <lwip/netif.h>
 #include <lwip/sys.h>
 #include <lwip/tcpip.h>
@@ -80,14 +81,14 @@ using namespace chip;
 using namespace chip::Inet;
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
-static sys_mbox_t * sLwIPEventQueue   = NULL;
+static sys_mbox_t sLwIPEventQueue     = NULL;
 static unsigned int sLwIPAcquireCount = 0;
 
 static void AcquireLwIP(void)
 {
     if (sLwIPAcquireCount++ == 0)
     {
-        sys_mbox_new(sLwIPEventQueue, 100);
+        sys_mbox_new(&sLwIPEventQueue, 100);
     }
 }
 
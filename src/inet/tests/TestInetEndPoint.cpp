@@ -36,6 +36,7 @@
 #include <CHIPVersion.h>
 
 #include <inet/InetError.h>
+#include <inet/InetInterfaceTable.h>
 #include <inet/InetLayer.h>
 
 #include <support/CHIPArgParser.hpp>
@@ -304,6 +305,56 @@ static void TestInetInterface(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !addrIterator.HasBroadcastAddress());
 }
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+static void TestInetInterfaceTable(nlTestSuite * inSuite, void * inContext)
+{
+    InterfaceTable & table                  = InterfaceTable::Instance();
+    const InterfaceTable::Snapshot * first  = table.AcquireSnapshot();
+    const InterfaceTable::Snapshot * second = table.AcquireSnapshot();
+    struct if_nameindex * intfArray         = if_nameindex();
+    size_t intfCount                        = 0;
+
+    NL_TEST_ASSERT(inSuite, first != nullptr);
+    NL_TEST_ASSERT(inSuite, intfArray != nullptr);
+    if (first == nullptr || intfArray == nullptr)
+    {
+        table.ReleaseSnapshot(first);
+        table.ReleaseSnapshot(second);
+        return;
+    }
+
+    // With no intervening changes, snapshots are shared.
+    NL_TEST_ASSERT(inSuite, first == second);
+
+    // Every interface known to the system is in the table, with the same name.
+    for (; intfArray[intfCount].if_index != 0; intfCount++)
+    {
+        const InterfaceTable::Snapshot::InterfaceEntry * entry = first->FindInterface(intfArray[intfCount].if_index);
+        NL_TEST_ASSERT(inSuite, entry != nullptr);
+        NL_TEST_ASSERT(inSuite, entry == nullptr || strcmp(entry->Name, intfArray[intfCount].if_name) == 0);
+    }
+    NL_TEST_ASSERT(inSuite, first->InterfaceCount() == intfCount);
+    if_freenameindex(intfArray);
+
+    // Every address in the table belongs to a known interface.
+    for (size_t i = 0; i < first->AddressCount(); i++)
+    {
+        NL_TEST_ASSERT(inSuite, first->FindInterface(first->GetAddress(i).Interface) != nullptr);
+    }
+
+    // Iterators read the same snapshot.
+    size_t addrCount = 0;
+    for (InterfaceAddressIterator addrIterator; addrIterator.HasCurrent(); addrIterator.Next())
+    {
+        addrCount++;
+    }
+    NL_TEST_ASSERT(inSuite, addrCount == first->AddressCount());
+
+    table.ReleaseSnapshot(second);
+    table.ReleaseSnapshot(first);
+}
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
 {
     INET_ERROR err;
@@ -396,6 +447,21 @@ static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
     err = testRaw6EP->SetICMPFilter(0, ICMP6Types);
     NL_TEST_ASSERT(inSuite, err == INET_ERROR_BAD_ARGS);
 
+#if INET_CONFIG_ENABLE_IPV4 && INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    // ICMPv4 endpoints are filtered with a BPF program, which needs the socket created by a bind.
+    err = testRaw4EP->Bind(kIPAddressType_IPv4, addr_any);
+    NL_TEST_ASSERT(inSuite, (err == INET_NO_ERROR) || (err == System::MapErrorPOSIX(EPERM)));
+    if (err == INET_NO_ERROR)
+    {
+        uint8_t ICMP4Types[2] = { 0, 8 };
+
+        err = testRaw4EP->SetICMPFilter(2, ICMP4Types);
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+        err = testRaw4EP->SetICMPFilter(0, nullptr);
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4 && INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
 #if INET_CONFIG_ENABLE_IPV4
     // We should never be able to send an IPv4-addressed message on an
     // IPv6 raw socket.
@@ -485,6 +551,162 @@ static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
     testTCPEP1->Shutdown();
 }
 
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+namespace {
+
+constexpr uint16_t kTCPSendTestPort        = 4242;
+constexpr size_t kTCPSendTestMessageCount  = 200;
+constexpr uint16_t kTCPSendTestMessageSize = 37;
+
+struct TCPSendTestContext
+{
+    TCPEndPoint * Accepted;
+    const uint8_t * ReceiveBuffers[8];
+    size_t ReceiveBufferCount;
+    size_t BytesSent;
+    size_t BytesReceived;
+    bool Connected;
+    bool PayloadIntact;
+};
+
+TCPSendTestContext sTCPSendTest;
+
+INET_ERROR HandleTCPSendTestDataReceived(TCPEndPoint * endPoint, PacketBufferHandle data)
+{
+    for (PacketBufferHandle buf = data.Retain(); !buf.IsNull(); buf.Advance())
+    {
+        // Remember which buffers carried data, to check that the endpoint recycles them.
+        const uint8_t * base = buf->Start() - buf->ReservedSize();
+        size_t j             = 0;
+        while (j < sTCPSendTest.ReceiveBufferCount && sTCPSendTest.ReceiveBuffers[j] != base)
+            j++;
+        if (j == sTCPSendTest.ReceiveBufferCount && j < ArraySize(sTCPSendTest.ReceiveBuffers))
+            sTCPSendTest.ReceiveBuffers[sTCPSendTest.ReceiveBufferCount++] = base;
+
+        for (uint16_t i = 0; i < buf->DataLength(); i++)
+        {
+            // Every byte carries the low bits of its offset in the stream.
+            if (buf->Start()[i] != static_cast<uint8_t>(sTCPSendTest.BytesReceived + i))
+                sTCPSendTest.PayloadIntact = false;
+        }
+        sTCPSendTest.BytesReceived += buf->DataLength();
+    }
+
+    gDone = (sTCPSendTest.BytesReceived >= kTCPSendTestMessageCount * kTCPSendTestMessageSize);
+    return INET_NO_ERROR;
+}
+
+void HandleTCPSendTestConnectionReceived(TCPEndPoint * listeningEndPoint, TCPEndPoint * conEndPoint,
+                                         const IPAddress & peerAddr, uint16_t peerPort)
+{
+    conEndPoint->OnDataReceived = HandleTCPSendTestDataReceived;
+    sTCPSendTest.Accepted       = conEndPoint;
+}
+
+void HandleTCPSendTestConnectComplete(TCPEndPoint * endPoint, INET_ERROR err)
+{
+    sTCPSendTest.Connected = (err == INET_NO_ERROR);
+    gDone                  = true;
+}
+
+void HandleTCPSendTestDataSent(TCPEndPoint * endPoint, uint16_t len)
+{
+    sTCPSendTest.BytesSent += len;
+}
+
+void ServiceNetworkUntilDone(uint32_t timeoutMS)
+{
+    uint64_t timeoutTimeMS = System::Layer::GetClock_MonotonicMS() + timeoutMS;
+    struct timeval sleepTime;
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = 10000;
+
+    while (!gDone && System::Layer::GetClock_MonotonicMS() < timeoutTimeMS)
+    {
+        ServiceNetwork(sleepTime);
+    }
+}
+
+} // namespace
+
+// Queue many small messages on a loopback connection and check that they arrive intact and fully accounted for.
+static void TestInetTCPQueuedSend(nlTestSuite * inSuite, void * inContext)
+{
+    TCPEndPoint * listener = nullptr;
+    TCPEndPoint * client   = nullptr;
+    IPAddress loopback;
+    INET_ERROR err;
+
+    IPAddress::FromString("::1", loopback);
+    memset(&sTCPSendTest, 0, sizeof(sTCPSendTest));
+    sTCPSendTest.PayloadIntact = true;
+
+    err = gInet.NewTCPEndPoint(&listener);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    err = gInet.NewTCPEndPoint(&client);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    if (listener == nullptr || client == nullptr)
+        return;
+
+    listener->OnConnectionReceived = HandleTCPSendTestConnectionReceived;
+    err = listener->Bind(kIPAddressType_IPv6, loopback, kTCPSendTestPort, true);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    err = listener->Listen(1);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    client->OnConnectComplete = HandleTCPSendTestConnectComplete;
+    client->OnDataSent        = HandleTCPSendTestDataSent;
+    gDone                     = false;
+    err                       = client->Connect(loopback, kTCPSendTestPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    ServiceNetworkUntilDone(5000);
+    NL_TEST_ASSERT(inSuite, sTCPSendTest.Connected);
+
+    if (sTCPSendTest.Connected)
+    {
+        err = client->EnableSendCoalescing();
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR || err == INET_ERROR_NOT_IMPLEMENTED);
+
+        // Queue every message without pushing, so that the send queue holds many buffers when the socket
+        // becomes writable.
+        gDone = false;
+        for (size_t i = 0; i < kTCPSendTestMessageCount; i++)
+        {
+            PacketBufferHandle buf = PacketBufferHandle::New(kTCPSendTestMessageSize);
+            NL_TEST_ASSERT(inSuite, !buf.IsNull());
+            if (buf.IsNull())
+                break;
+            for (uint16_t j = 0; j < kTCPSendTestMessageSize; j++)
+                buf->Start()[j] = static_cast<uint8_t>(i * kTCPSendTestMessageSize + j);
+            buf->SetDataLength(kTCPSendTestMessageSize);
+
+            err = client->Send(std::move(buf), false);
+            NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+        }
+        NL_TEST_ASSERT(inSuite, client->PendingSendLength() == kTCPSendTestMessageCount * kTCPSendTestMessageSize);
+
+        ServiceNetworkUntilDone(5000);
+
+        NL_TEST_ASSERT(inSuite, sTCPSendTest.BytesReceived == kTCPSendTestMessageCount * kTCPSendTestMessageSize);
+        NL_TEST_ASSERT(inSuite, sTCPSendTest.BytesSent == kTCPSendTestMessageCount * kTCPSendTestMessageSize);
+        NL_TEST_ASSERT(inSuite, sTCPSendTest.PayloadIntact);
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+        // Data is released as soon as it is delivered, so the pre-posted buffers are all that is needed.
+        NL_TEST_ASSERT(inSuite, sTCPSendTest.ReceiveBufferCount <= INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_TCP_RECEIVE_BUFFER_RING_SIZE > 0
+        NL_TEST_ASSERT(inSuite, client->PendingSendLength() == 0);
+
+        err = client->DisableSendCoalescing();
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    }
+
+    if (sTCPSendTest.Accepted != nullptr)
+        sTCPSendTest.Accepted->Free();
+    client->Free();
+    listener->Free();
+}
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
 // Test the InetLayer resource limitation
 static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
 {
@@ -533,7 +755,13 @@ static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPr
                                  NL_TEST_DEF("InetEndPoint::TestParseHost", TestParseHost),
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+                                 NL_TEST_DEF("InetEndPoint::TestInetInterfaceTable", TestInetInterfaceTable),
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+                                 NL_TEST_DEF("InetEndPoint::TestInetTCPQueuedSend", TestInetTCPQueuedSend),
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
                                  NL_TEST_SENTINEL() };
 
@@ -36,6 +36,7 @@
 
 #include <CHIPVersion.h>
 
+#include <core/CHIPEncoding.h>
 #include <inet/InetLayer.h>
 #include <support/CodeUtils.h>
 #include <support/UnitTestRegistration.h>
@@ -501,6 +502,188 @@ static void TestDNSResolution_Simultaneous(nlTestSuite * testSuite, void * inCon
     NL_TEST_ASSERT(testSuite, sNumResInProgress == 0);
 }
 
+#if INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
+constexpr char kStandInHostName[] = "stand-in.chip.test";
+
+/**
+ * A stand-in name server on the loopback interface. It answers A and AAAA
+ * queries for kStandInHostName and NXDOMAIN for any other name, and counts
+ * the queries it receives.
+ */
+class StandInNameServer
+{
+public:
+    INET_ERROR Start()
+    {
+        QueryCount = 0;
+#if INET_CONFIG_ENABLE_IPV4
+        IPAddress::FromString("127.0.0.1", mAddress);
+#else
+        IPAddress::FromString("::1", mAddress);
+#endif // INET_CONFIG_ENABLE_IPV4
+
+        ReturnErrorOnFailure(gInet.NewUDPEndPoint(&mEndPoint));
+        ReturnErrorOnFailure(mEndPoint->Bind(mAddress.Type(), mAddress, 0));
+        ReturnErrorOnFailure(mEndPoint->Listen(HandleQuery, nullptr, this));
+        ReturnErrorOnFailure(gInet.SetDNSServers(&mAddress, 1, mEndPoint->GetBoundPort()));
+        gInet.FlushDNSCache();
+        return INET_NO_ERROR;
+    }
+
+    void Stop()
+    {
+        if (mEndPoint != nullptr)
+        {
+            mEndPoint->Free();
+            mEndPoint = nullptr;
+        }
+    }
+
+    unsigned QueryCount;
+
+private:
+    static void HandleQuery(IPEndPointBasis * endPoint, System::PacketBufferHandle msg, const IPPacketInfo * pktInfo)
+    {
+        StandInNameServer * self = static_cast<StandInNameServer *>(endPoint->AppState);
+        const uint8_t * query    = msg->Start();
+        uint16_t queryLen        = msg->DataLength();
+        char name[NL_DNS_HOSTNAME_MAX_LEN + 1];
+        size_t nameLen = 0;
+        uint16_t offset;
+
+        self->QueryCount++;
+
+        // Decode the (uncompressed) question name.
+        for (offset = 12; offset < queryLen && query[offset] != 0; offset = static_cast<uint16_t>(offset + 1 + query[offset]))
+        {
+            if (nameLen != 0)
+                name[nameLen++] = '.';
+            memcpy(&name[nameLen], &query[offset + 1], query[offset]);
+            nameLen += query[offset];
+        }
+        name[nameLen] = 0;
+
+        uint16_t questionEnd = static_cast<uint16_t>(offset + 5);
+        uint16_t qtype       = Encoding::BigEndian::Get16(&query[offset + 1]);
+        bool known           = (strcmp(name, kStandInHostName) == 0);
+
+        System::PacketBufferHandle resp = System::PacketBufferHandle::New(512);
+        uint8_t * p                     = resp->Start();
+
+        memcpy(p, query, questionEnd);
+        Encoding::BigEndian::Put16(p + 2, known ? 0x8180 : 0x8183); // QR RD RA, NXDOMAIN if unknown
+        Encoding::BigEndian::Put16(p + 6, known ? 1 : 0);
+        p += questionEnd;
+
+        if (known)
+        {
+            IPAddress addr;
+            IPAddress::FromString((qtype == 28) ? "2001:db8::1" : "192.0.2.1", addr);
+
+            Encoding::BigEndian::Put16(p, 0xC00C); // pointer to the question name
+            Encoding::BigEndian::Put16(p + 2, qtype);
+            Encoding::BigEndian::Put16(p + 4, 1);
+            Encoding::BigEndian::Put32(p + 6, 300);
+            if (qtype == 28)
+            {
+                Encoding::BigEndian::Put16(p + 10, 16);
+                memcpy(p + 12, addr.Addr, 16);
+                p += 28;
+            }
+            else
+            {
+                Encoding::BigEndian::Put16(p + 10, 4);
+                memcpy(p + 12, &addr.Addr[3], 4);
+                p += 16;
+            }
+        }
+
+        resp->SetDataLength(static_cast<uint16_t>(p - resp->Start()));
+        static_cast<UDPEndPoint *>(endPoint)->SendTo(pktInfo->SrcAddress, pktInfo->SrcPort, std::move(resp));
+    }
+
+    IPAddress mAddress;
+    UDPEndPoint * mEndPoint = nullptr;
+};
+
+/**
+ * Test that answers from the name server are cached, including negative answers.
+ */
+static void TestDNSResolution_StandInCache(nlTestSuite * testSuite, void * testContext)
+{
+    StandInNameServer server;
+
+    NL_TEST_ASSERT(testSuite, server.Start() == INET_NO_ERROR);
+
+    // clang-format off
+    RunTestCase(testSuite,
+        DNSResolutionTestCase
+        {
+            kStandInHostName,
+            kDNSOption_AddrFamily_Any,
+            kMaxResults,
+            INET_NO_ERROR,
+            INET_CONFIG_ENABLE_IPV4 != 0,
+            true
+        }
+    );
+    // clang-format on
+
+    unsigned queryCount = server.QueryCount;
+    NL_TEST_ASSERT(testSuite, queryCount > 0);
+
+    // The same name, in different case and fully qualified, with other options.
+    RunTestCase(testSuite,
+                DNSResolutionTestCase{ "Stand-In.CHIP.test.", kDNSOption_AddrFamily_IPv6Only, kMaxResults, INET_NO_ERROR, false, true });
+    NL_TEST_ASSERT(testSuite, server.QueryCount == queryCount);
+
+    RunTestCase(testSuite,
+                DNSResolutionTestCase{ "missing.chip.test", kDNSOption_Default, kMaxResults, INET_ERROR_HOST_NOT_FOUND, false, false });
+    queryCount = server.QueryCount;
+    RunTestCase(testSuite,
+                DNSResolutionTestCase{ "missing.chip.test", kDNSOption_Default, kMaxResults, INET_ERROR_HOST_NOT_FOUND, false, false });
+    NL_TEST_ASSERT(testSuite, server.QueryCount == queryCount);
+
+    server.Stop();
+}
+
+/**
+ * Test that simultaneous requests for the same name share one query.
+ */
+static void TestDNSResolution_StandInDeduplication(nlTestSuite * testSuite, void * inContext)
+{
+    StandInNameServer server;
+
+    NL_TEST_ASSERT(testSuite, server.Start() == INET_NO_ERROR);
+
+    // clang-format off
+    DNSResolutionTestContext tests[] =
+    {
+        { testSuite, DNSResolutionTestCase{ kStandInHostName, kDNSOption_Default, kMaxResults, INET_NO_ERROR, false, true } },
+        { testSuite, DNSResolutionTestCase{ kStandInHostName, kDNSOption_AddrFamily_IPv6Only, 1, INET_NO_ERROR, false, true } },
+        { testSuite, DNSResolutionTestCase{ kStandInHostName, kDNSOption_Default, kMaxResults, INET_NO_ERROR, false, true } },
+    };
+    // clang-format on
+
+    for (DNSResolutionTestContext & testContext : tests)
+    {
+        StartTestCase(testContext);
+    }
+
+    ServiceNetworkUntilDone(DEFAULT_TEST_DURATION_MILLISECS);
+
+    NL_TEST_ASSERT(testSuite, gDone == true);
+    NL_TEST_ASSERT(testSuite, sNumResInProgress == 0);
+
+    // One query per record type, regardless of the number of requests.
+    NL_TEST_ASSERT(testSuite, server.QueryCount == (INET_CONFIG_ENABLE_IPV4 ? 2u : 1u));
+
+    server.Stop();
+}
+
+#endif // INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+
 static void RunTestCase(nlTestSuite * testSuite, const DNSResolutionTestCase & testCase)
 {
     DNSResolutionTestContext testContext{ testSuite, testCase };
@@ -687,6 +870,10 @@ int TestInetLayerDNSInternal()
         NL_TEST_DEF("TestDNSResolution:NoHostRecord",      TestDNSResolution_NoHostRecord),
         NL_TEST_DEF("TestDNSResolution:Cancel",            TestDNSResolution_Cancel),
         NL_TEST_DEF("TestDNSResolution:Simultaneous",      TestDNSResolution_Simultaneous),
+#if INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
+        NL_TEST_DEF("TestDNSResolution:StandInCache",         TestDNSResolution_StandInCache),
+        NL_TEST_DEF("TestDNSResolution:StandInDeduplication", TestDNSResolution_StandInDeduplication),
+#endif // INET_CONFIG_ENABLE_UDP_DNS_SOCKETS
         NL_TEST_SENTINEL() };
 
     nlTestSuite DNSTestSuite =
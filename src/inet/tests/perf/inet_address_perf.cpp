@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements chip-inet-address-perf, which times
+ *      IPAddress::ToString and IPAddress::FromString on a fixed set of
+ *      addresses.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <inet/IPAddress.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::Inet;
+
+#define kToolName "chip-inet-address-perf"
+
+namespace {
+
+const char * const kAddressStrings[] = {
+    "fe80::1", "2001:db8:85a3::8a2e:370:7334", "fd00:1:2:3:4:5:6:7", "ff02::fb", "64:ff9b::c0a8:101", "10.0.0.1",
+};
+constexpr size_t kAddressCount = sizeof(kAddressStrings) / sizeof(kAddressStrings[0]);
+constexpr uint32_t kIterations = 20000;
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    IPAddress addresses[kAddressCount];
+    char addressBuffer[INET6_ADDRSTRLEN];
+    size_t formattedLength = 0;
+    bool parsedAll         = true;
+    uint64_t start;
+    uint64_t formatTime;
+    uint64_t parseTime;
+
+    for (size_t i = 0; i < kAddressCount; i++)
+    {
+        if (!IPAddress::FromString(kAddressStrings[i], addresses[i]))
+        {
+            printf("%s: cannot parse %s\n", kToolName, kAddressStrings[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t n = 0; n < kIterations; n++)
+    {
+        for (size_t i = 0; i < kAddressCount; i++)
+        {
+            formattedLength += strlen(addresses[i].ToString(addressBuffer));
+        }
+    }
+    formatTime = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (uint32_t n = 0; n < kIterations; n++)
+    {
+        for (size_t i = 0; i < kAddressCount; i++)
+        {
+            IPAddress parsed;
+
+            parsedAll = IPAddress::FromString(kAddressStrings[i], parsed) && parsed == addresses[i] && parsedAll;
+        }
+    }
+    parseTime = System::Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+    if (formattedLength == 0 || !parsedAll)
+    {
+        printf("%s: conversions failed\n", kToolName);
+        return EXIT_FAILURE;
+    }
+
+    printf("%s: IPAddress::ToString: %u ns/op, IPAddress::FromString: %u ns/op\n", kToolName,
+           static_cast<unsigned>(formatTime * 1000 / (kIterations * kAddressCount)),
+           static_cast<unsigned>(parseTime * 1000 / (kIterations * kAddressCount)));
+
+    return EXIT_SUCCESS;
+}
@@ -97,11 +97,37 @@ struct ASN1UniversalTime
     uint8_t Second;
 };
 
+/**
+ * An entry in a flat, pre-order index of the elements of a DER encoding, as built by TokenizeASN1().
+ *
+ * Elements nested in a constructed element follow it directly. A primitive OCTET STRING or BIT STRING
+ * whose content is itself a complete DER encoding is marked Encapsulating and is likewise followed by
+ * the elements of that encoding.
+ */
+struct ASN1Element
+{
+    uint32_t Offset;      ///< Offset of the element in the encoding.
+    uint32_t ValueLen;    ///< Length of the element value.
+    uint32_t Tag;         ///< Element tag number.
+    uint16_t NextSibling; ///< Index of the entry following this element and all the elements nested in it.
+    uint8_t HeadLen;      ///< Length of the tag and length octets.
+    uint8_t Class;        ///< Element tag class.
+    uint8_t Depth;        ///< Number of elements this element is nested in.
+    bool Constructed;
+    bool Encapsulating;
+};
+
 class DLL_EXPORT ASN1Reader
 {
 public:
     void Init(const uint8_t * buf, uint32_t len);
 
+    /**
+     * Initialize the reader over an encoding that has been indexed by TokenizeASN1(). Next() and
+     * ExitConstructedType() then move to the following element without decoding the elements in between.
+     */
+    void Init(const uint8_t * buf, uint32_t len, const ASN1Element * elems, uint16_t numElems);
+
     uint8_t GetClass(void) const { return Class; };
     uint32_t GetTag(void) const { return Tag; };
     const uint8_t * GetValue(void) const { return Value; };
@@ -134,6 +160,8 @@ private:
         uint32_t ValueLen;
         bool IndefiniteLen;
         const uint8_t * ContainerEnd;
+        uint16_t NextElem;
+        uint16_t ContainerEndElem;
     };
 
     uint8_t Class;
@@ -152,7 +180,15 @@ private:
     ASN1ParseContext mSavedContexts[kMaxContextDepth];
     uint32_t mNumSavedContexts;
 
+    // Element index, when initialized with one. mCurElem is the entry of the current element, mNextElem
+    // the entry Next() moves to and mContainerEndElem the entry that ends the current container.
+    const ASN1Element * mElems;
+    uint16_t mCurElem;
+    uint16_t mNextElem;
+    uint16_t mContainerEndElem;
+
     ASN1_ERROR DecodeHead(void);
+    void LoadElement(uint16_t index);
     void ResetElementState(void);
     ASN1_ERROR EnterContainer(uint32_t offset);
     ASN1_ERROR ExitContainer(void);
@@ -208,6 +244,19 @@ const char * GetOIDName(OID oid);
 
 ASN1_ERROR DumpASN1(ASN1Reader & reader, const char * prefix, const char * indent);
 
+/**
+ * Decode the element heads of a DER encoding in a single pass, recording each element in @p elems.
+ *
+ * @param[in]  buf       The encoding.
+ * @param[in]  len       Length of the encoding.
+ * @param[out] elems     Table that receives the elements, in encoding order.
+ * @param[in]  maxElems  Capacity of @p elems.
+ * @param[out] numElems  Number of elements recorded.
+ *
+ * @retval  #ASN1_ERROR_OVERFLOW  If the encoding has more than @p maxElems elements.
+ */
+ASN1_ERROR TokenizeASN1(const uint8_t * buf, uint32_t len, ASN1Element * elems, uint16_t maxElems, uint16_t & numElems);
+
 inline OID GetOID(OIDCategory category, uint8_t id)
 {
     return static_cast<OID>(category | id);
@@ -34,6 +34,12 @@
 namespace chip {
 namespace ASN1 {
 
+// Maximum nesting of the elements indexed by TokenizeASN1(), matching how deep an ASN1Reader can enter.
+static constexpr uint8_t kMaxTokenizeDepth = 32;
+
+static inline ASN1_ERROR DecodeElementHead(const uint8_t * elemStart, const uint8_t * bufEnd, uint8_t & cls, bool & constructed,
+                                           uint32_t & tag, uint32_t & valueLen, bool & indefiniteLen, uint32_t & headLen);
+
 void ASN1Reader::Init(const uint8_t * buf, uint32_t len)
 {
     ResetElementState();
@@ -42,6 +48,17 @@ void ASN1Reader::Init(const uint8_t * buf, uint32_t len)
     mElemStart        = buf;
     mContainerEnd     = mBufEnd;
     mNumSavedContexts = 0;
+    mElems            = nullptr;
+    mCurElem          = 0;
+    mNextElem         = 0;
+    mContainerEndElem = 0;
+}
+
+void ASN1Reader::Init(const uint8_t * buf, uint32_t len, const ASN1Element * elems, uint16_t numElems)
+{
+    Init(buf, len);
+    mElems            = elems;
+    mContainerEndElem = numElems;
 }
 
 ASN1_ERROR ASN1Reader::Next()
@@ -49,6 +66,17 @@ ASN1_ERROR ASN1Reader::Next()
     if (EndOfContents)
         return ASN1_END;
 
+    if (mElems != nullptr)
+    {
+        ResetElementState();
+
+        if (mNextElem == mContainerEndElem)
+            return ASN1_END;
+
+        LoadElement(mNextElem);
+        return ASN1_NO_ERROR;
+    }
+
     if (IndefiniteLen)
     {
         return ASN1_ERROR_UNSUPPORTED_ENCODING;
@@ -108,17 +136,28 @@ ASN1_ERROR ASN1Reader::EnterContainer(uint32_t offset)
     if (mNumSavedContexts == kMaxContextDepth)
         return ASN1_ERROR_MAX_DEPTH_EXCEEDED;
 
-    mSavedContexts[mNumSavedContexts].ElemStart     = mElemStart;
-    mSavedContexts[mNumSavedContexts].HeadLen       = mHeadLen;
-    mSavedContexts[mNumSavedContexts].ValueLen      = ValueLen;
-    mSavedContexts[mNumSavedContexts].IndefiniteLen = IndefiniteLen;
-    mSavedContexts[mNumSavedContexts].ContainerEnd  = mContainerEnd;
+    mSavedContexts[mNumSavedContexts].ElemStart        = mElemStart;
+    mSavedContexts[mNumSavedContexts].HeadLen          = mHeadLen;
+    mSavedContexts[mNumSavedContexts].ValueLen         = ValueLen;
+    mSavedContexts[mNumSavedContexts].IndefiniteLen    = IndefiniteLen;
+    mSavedContexts[mNumSavedContexts].ContainerEnd     = mContainerEnd;
+    mSavedContexts[mNumSavedContexts].NextElem         = mNextElem;
+    mSavedContexts[mNumSavedContexts].ContainerEndElem = mContainerEndElem;
     mNumSavedContexts++;
 
     mElemStart = Value + offset;
     if (!IndefiniteLen)
         mContainerEnd = Value + ValueLen;
 
+    if (mElems != nullptr)
+    {
+        // The nested elements, if any, directly follow the current one in the index.
+        const ASN1Element & elem = mElems[mCurElem];
+        bool hasNested           = elem.Constructed || elem.Encapsulating;
+        mContainerEndElem        = elem.NextSibling;
+        mNextElem                = hasNested ? static_cast<uint16_t>(mCurElem + 1) : mContainerEndElem;
+    }
+
     ResetElementState();
 
     return ASN1_NO_ERROR;
@@ -138,7 +177,9 @@ ASN1_ERROR ASN1Reader::ExitContainer()
     else
         mElemStart = prevContext.ElemStart + prevContext.HeadLen + prevContext.ValueLen;
 
-    mContainerEnd = prevContext.ContainerEnd;
+    mContainerEnd     = prevContext.ContainerEnd;
+    mNextElem         = prevContext.NextElem;
+    mContainerEndElem = prevContext.ContainerEndElem;
 
     ResetElementState();
 
@@ -284,80 +325,222 @@ ASN1_ERROR ASN1Reader::GetBitString(uint32_t & outVal)
 
 ASN1_ERROR ASN1Reader::DecodeHead()
 {
-    const uint8_t * p = mElemStart;
+    ASN1_ERROR err = DecodeElementHead(mElemStart, mContainerEnd, Class, Constructed, Tag, ValueLen, IndefiniteLen, mHeadLen);
+
+    // The value must end within the enclosing element, or Next() would step past it, and past the end of the buffer.
+    if (err == ASN1_NO_ERROR && !IndefiniteLen && ValueLen > static_cast<uint32_t>(mContainerEnd - mElemStart) - mHeadLen)
+        err = ASN1_ERROR_UNDERRUN;
+
+    if (err != ASN1_NO_ERROR)
+    {
+        ResetElementState();
+        return err;
+    }
+
+    EndOfContents = (Class == kASN1TagClass_Universal && Tag == 0 && Constructed == false && ValueLen == 0);
+
+    Value = mElemStart + mHeadLen;
+
+    return ASN1_NO_ERROR;
+}
 
-    if (p >= mBufEnd)
+void ASN1Reader::LoadElement(uint16_t index)
+{
+    const ASN1Element & elem = mElems[index];
+
+    mCurElem      = index;
+    mNextElem     = elem.NextSibling;
+    mElemStart    = mBuf + elem.Offset;
+    mHeadLen      = elem.HeadLen;
+    Class         = elem.Class;
+    Tag           = elem.Tag;
+    Constructed   = elem.Constructed;
+    ValueLen      = elem.ValueLen;
+    IndefiniteLen = false;
+    EndOfContents = (Class == kASN1TagClass_Universal && Tag == 0 && Constructed == false && ValueLen == 0);
+    Value         = mElemStart + mHeadLen;
+}
+
+void ASN1Reader::ResetElementState()
+{
+    Class         = 0;
+    Tag           = 0;
+    Value         = nullptr;
+    ValueLen      = 0;
+    Constructed   = false;
+    IndefiniteLen = false;
+    EndOfContents = false;
+    mHeadLen      = 0;
+}
+
+static inline ASN1_ERROR DecodeElementHead(const uint8_t * elemStart, const uint8_t * bufEnd, uint8_t & cls, bool & constructed,
+                                           uint32_t & tag, uint32_t & valueLen, bool & indefiniteLen, uint32_t & headLen)
+{
+    const uint8_t * p = elemStart;
+
+    if (p >= bufEnd)
         return ASN1_ERROR_UNDERRUN;
 
-    Class       = *p & 0xC0;
-    Constructed = (*p & 0x20) != 0;
+    // Fast path for the common single-octet tag and short-form length.
+    if (bufEnd - p >= 2 && (p[0] & 0x1F) != 0x1F && (p[1] & 0x80) == 0)
+    {
+        cls           = p[0] & 0xC0;
+        constructed   = (p[0] & 0x20) != 0;
+        tag           = p[0] & 0x1F;
+        valueLen      = p[1];
+        indefiniteLen = false;
+        headLen       = 2;
+        return ASN1_NO_ERROR;
+    }
+
+    cls         = *p & 0xC0;
+    constructed = (*p & 0x20) != 0;
 
-    Tag = *p & 0x1F;
+    tag = *p & 0x1F;
     p++;
-    if (Tag == 0x1F)
+    if (tag == 0x1F)
     {
-        Tag = 0;
+        tag = 0;
         do
         {
-            if (p >= mBufEnd)
+            if (p >= bufEnd)
                 return ASN1_ERROR_UNDERRUN;
-            if ((Tag & 0xFE000000) != 0)
+            if ((tag & 0xFE000000) != 0)
                 return ASN1_ERROR_TAG_OVERFLOW;
-            Tag = (Tag << 7) | (*p & 0x7F);
+            tag = (tag << 7) | (*p & 0x7F);
             p++;
-        } while ((*p & 0x80) != 0);
+        } while ((p[-1] & 0x80) != 0);
     }
 
-    if (p >= mBufEnd)
+    if (p >= bufEnd)
         return ASN1_ERROR_UNDERRUN;
 
     if ((*p & 0x80) == 0)
     {
-        ValueLen      = *p & 0x7F;
-        IndefiniteLen = false;
+        valueLen      = *p & 0x7F;
+        indefiniteLen = false;
         p++;
     }
     else if (*p == 0x80)
     {
-        ValueLen      = 0;
-        IndefiniteLen = true;
+        valueLen      = 0;
+        indefiniteLen = true;
         p++;
     }
     else
     {
-        ValueLen       = 0;
+        valueLen       = 0;
         uint8_t lenLen = *p & 0x7F;
         p++;
         for (; lenLen > 0; lenLen--, p++)
         {
-            if (p >= mBufEnd)
+            if (p >= bufEnd)
                 return ASN1_ERROR_UNDERRUN;
-            if ((ValueLen & 0xFF000000) != 0)
+            if ((valueLen & 0xFF000000) != 0)
                 return ASN1_ERROR_LENGTH_OVERFLOW;
-            ValueLen = (ValueLen << 8) | *p;
+            valueLen = (valueLen << 8) | *p;
         }
-        IndefiniteLen = false;
+        indefiniteLen = false;
     }
 
-    mHeadLen = p - mElemStart;
-
-    EndOfContents = (Class == kASN1TagClass_Universal && Tag == 0 && Constructed == false && ValueLen == 0);
-
-    Value = p;
+    headLen = static_cast<uint32_t>(p - elemStart);
 
     return ASN1_NO_ERROR;
 }
 
-void ASN1Reader::ResetElementState()
+ASN1_ERROR TokenizeASN1(const uint8_t * buf, uint32_t len, ASN1Element * elems, uint16_t maxElems, uint16_t & numElems)
 {
-    Class         = 0;
-    Tag           = 0;
-    Value         = nullptr;
-    ValueLen      = 0;
-    Constructed   = false;
-    IndefiniteLen = false;
-    EndOfContents = false;
-    mHeadLen      = 0;
+    // Entries of the elements enclosing the next element, and the offsets at which they end.
+    uint16_t openElems[kMaxTokenizeDepth];
+    uint32_t openEnds[kMaxTokenizeDepth];
+    uint8_t depth = 0;
+    uint32_t pos  = 0;
+    uint16_t n    = 0;
+
+    numElems = 0;
+
+    while (true)
+    {
+        // Close the elements that end here; their next sibling is whatever comes next.
+        while (depth > 0 && pos == openEnds[depth - 1])
+        {
+            elems[openElems[--depth]].NextSibling = n;
+        }
+
+        if (pos == len)
+            break;
+
+        if (n == maxElems)
+            return ASN1_ERROR_OVERFLOW;
+
+        uint32_t containerEnd = (depth > 0) ? openEnds[depth - 1] : len;
+        ASN1Element & elem    = elems[n];
+        bool indefiniteLen;
+        uint32_t headLen;
+
+        ASN1_ERROR err = DecodeElementHead(buf + pos, buf + containerEnd, elem.Class, elem.Constructed, elem.Tag, elem.ValueLen,
+                                           indefiniteLen, headLen);
+        if (err == ASN1_NO_ERROR && indefiniteLen)
+            err = ASN1_ERROR_UNSUPPORTED_ENCODING;
+        if (err == ASN1_NO_ERROR && elem.ValueLen > containerEnd - pos - headLen)
+            err = ASN1_ERROR_UNDERRUN;
+        if (err == ASN1_NO_ERROR && elem.Constructed && elem.ValueLen > 0 && depth == kMaxTokenizeDepth)
+            err = ASN1_ERROR_MAX_DEPTH_EXCEEDED;
+
+        if (err != ASN1_NO_ERROR)
+        {
+            // Within an OCTET STRING or BIT STRING that was only presumed to encapsulate DER, the error just means
+            // that it does not: drop the entries recorded for its content and resume after it.
+            while (depth > 0 && !elems[openElems[depth - 1]].Encapsulating)
+                depth--;
+            if (depth == 0)
+                return err;
+
+            depth--;
+            n                      = openElems[depth];
+            elems[n].Encapsulating = false;
+            elems[n].NextSibling   = static_cast<uint16_t>(n + 1);
+            pos                    = openEnds[depth];
+            n++;
+            continue;
+        }
+
+        uint32_t valueStart = pos + headLen;
+        uint32_t valueEnd   = valueStart + elem.ValueLen;
+        uint32_t childStart = valueStart;
+
+        elem.Offset        = pos;
+        elem.HeadLen       = static_cast<uint8_t>(headLen);
+        elem.Depth         = depth;
+        elem.NextSibling   = static_cast<uint16_t>(n + 1);
+        elem.Encapsulating = false;
+
+        // Presume that a non-empty OCTET STRING, or a BIT STRING without unused bits, encapsulates DER.
+        if (!elem.Constructed && elem.Class == kASN1TagClass_Universal && depth < kMaxTokenizeDepth)
+        {
+            if (elem.Tag == kASN1UniversalTag_BitString && elem.ValueLen > 1 && buf[valueStart] == 0)
+                childStart++;
+            elem.Encapsulating = (elem.Tag == kASN1UniversalTag_OctetString || childStart != valueStart) && childStart < valueEnd;
+        }
+
+        if ((elem.Constructed || elem.Encapsulating) && childStart < valueEnd)
+        {
+            openElems[depth] = n;
+            openEnds[depth]  = valueEnd;
+            depth++;
+            pos = childStart;
+        }
+        else
+        {
+            pos = valueEnd;
+        }
+
+        n++;
+    }
+
+    numElems = n;
+
+    return ASN1_NO_ERROR;
 }
 
 ASN1_ERROR DumpASN1(ASN1Reader & asn1Parser, const char * prefix, const char * indent)
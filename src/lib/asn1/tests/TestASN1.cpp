@@ -184,17 +184,14 @@ static void TestASN1_Encode(nlTestSuite * inSuite, void * inContext)
 #endif
 }
 
-static void TestASN1_Decode(nlTestSuite * inSuite, void * inContext)
+static void DecodeASN1TestData(nlTestSuite * inSuite, ASN1Reader & reader)
 {
     ASN1_ERROR err = ASN1_NO_ERROR;
-    ASN1Reader reader;
     bool boolVal;
     uint32_t bitStringVal;
     int64_t intVal;
     OID oidVal;
 
-    reader.Init(TestASN1_EncodedData, sizeof(TestASN1_EncodedData));
-
     ASN1_PARSE_ENTER_SEQUENCE
     {
         ASN1_PARSE_BOOLEAN(boolVal);
@@ -288,6 +285,64 @@ exit:
     NL_TEST_ASSERT(inSuite, err == ASN1_NO_ERROR);
 }
 
+static void TestASN1_Decode(nlTestSuite * inSuite, void * inContext)
+{
+    ASN1Reader reader;
+
+    reader.Init(TestASN1_EncodedData, sizeof(TestASN1_EncodedData));
+
+    DecodeASN1TestData(inSuite, reader);
+}
+
+static void TestASN1_Tokenize(nlTestSuite * inSuite, void * inContext)
+{
+    ASN1_ERROR err;
+    ASN1Element elems[64];
+    uint16_t numElems;
+    ASN1Reader reader;
+
+    err = TokenizeASN1(TestASN1_EncodedData, sizeof(TestASN1_EncodedData), elems, 64, numElems);
+    NL_TEST_ASSERT(inSuite, err == ASN1_NO_ERROR);
+
+    // One top-level SEQUENCE, whose last element is an OCTET STRING encapsulating SEQUENCE { OID, BIT STRING { INTEGER } }.
+    NL_TEST_ASSERT(inSuite, numElems == 35);
+    NL_TEST_ASSERT(inSuite, elems[0].Constructed && elems[0].Depth == 0 && elems[0].NextSibling == numElems);
+    NL_TEST_ASSERT(inSuite, elems[numElems - 5].Tag == kASN1UniversalTag_OctetString && elems[numElems - 5].Encapsulating);
+    NL_TEST_ASSERT(inSuite, elems[numElems - 2].Tag == kASN1UniversalTag_BitString && elems[numElems - 2].Encapsulating);
+    NL_TEST_ASSERT(inSuite, elems[numElems - 1].Tag == kASN1UniversalTag_Integer && elems[numElems - 1].Depth == 4);
+
+    // Octet strings that do not hold a DER encoding are leaves.
+    NL_TEST_ASSERT(inSuite, elems[numElems - 11].Tag == kASN1UniversalTag_OctetString && !elems[numElems - 11].Encapsulating);
+
+    reader.Init(TestASN1_EncodedData, sizeof(TestASN1_EncodedData), elems, numElems);
+
+    DecodeASN1TestData(inSuite, reader);
+
+    err = TokenizeASN1(TestASN1_EncodedData, sizeof(TestASN1_EncodedData), elems, 10, numElems);
+    NL_TEST_ASSERT(inSuite, err == ASN1_ERROR_OVERFLOW);
+
+    err = TokenizeASN1(TestASN1_EncodedData, sizeof(TestASN1_EncodedData) - 1, elems, 64, numElems);
+    NL_TEST_ASSERT(inSuite, err == ASN1_ERROR_UNDERRUN);
+}
+
+static void TestASN1_Truncated(nlTestSuite * inSuite, void * inContext)
+{
+    // A SEQUENCE whose length runs past the end of the encoding.
+    static const uint8_t kTruncatedSequence[] = { 0x30, 0x05, 0x02, 0x01 };
+    // A SEQUENCE holding an INTEGER whose length runs past the end of the SEQUENCE, though not of the encoding.
+    static const uint8_t kOverlongInteger[] = { 0x30, 0x03, 0x02, 0x05, 0x01, 0x02, 0x03, 0x04, 0x05 };
+    ASN1Reader reader;
+
+    reader.Init(kTruncatedSequence, sizeof(kTruncatedSequence));
+    NL_TEST_ASSERT(inSuite, reader.Next() == ASN1_ERROR_UNDERRUN);
+
+    reader.Init(kOverlongInteger, sizeof(kOverlongInteger));
+    NL_TEST_ASSERT(inSuite, reader.Next() == ASN1_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.EnterConstructedType() == ASN1_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Next() == ASN1_ERROR_UNDERRUN);
+    NL_TEST_ASSERT(inSuite, reader.Next() == ASN1_ERROR_UNDERRUN);
+}
+
 static void TestASN1_NullWriter(nlTestSuite * inSuite, void * inContext)
 {
     ASN1_ERROR err;
@@ -382,6 +437,8 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("Test ASN1 encoding macros", TestASN1_Encode),
     NL_TEST_DEF("Test ASN1 decoding macros", TestASN1_Decode),
+    NL_TEST_DEF("Test ASN1 tokenizer", TestASN1_Tokenize),
+    NL_TEST_DEF("Test ASN1 truncated decoding", TestASN1_Truncated),
     NL_TEST_DEF("Test ASN1 NULL writer", TestASN1_NullWriter),
     NL_TEST_DEF("Test ASN1 Object IDs", TestASN1_ObjectID),
     NL_TEST_SENTINEL()
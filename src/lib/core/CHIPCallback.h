@@ -289,5 +289,132 @@ private:
     }
 };
 
+/**
+ * @brief hash table of Cancelables, keyed by a small struct.
+ *
+ *   Each bucket is a CallbackDeque, so registration keeps the usual cancel
+ *   semantics: Cancel() on a registered Cancelable removes it from the registry.
+ *   Lookups only walk the bucket of the key.
+ *
+ *   Keys need not fit in a Cancelable: they are kept in an array of kCapacity
+ *   slots, and a registered Cancelable holds the registry in mInfoPtr and the
+ *   index of its slot in mInfoScalar.
+ *
+ *   Key must be copy-assignable and provide operator== and a "uint32_t Hash() const" member.
+ */
+template <typename Key, size_t kBucketCount, size_t kCapacity>
+class CallbackRegistry
+{
+public:
+    CallbackRegistry()
+    {
+        for (size_t slot = 0; slot < kCapacity; slot++)
+        {
+            mNextFreeSlot[slot] = static_cast<uint16_t>(slot + 1);
+        }
+    }
+
+    ~CallbackRegistry()
+    {
+        for (CallbackDeque & bucket : mBuckets)
+        {
+            while (!bucket.IsEmpty())
+            {
+                bucket.First()->Cancel();
+            }
+        }
+    }
+
+    CallbackRegistry(const CallbackRegistry &) = delete;
+    CallbackRegistry & operator=(const CallbackRegistry &) = delete;
+
+    /**
+     * @brief registers ca under key, after cancelling any previous registration of ca.
+     *   Several Cancelables can be registered under one key, Find() returns the
+     *   earliest one.
+     *
+     * @return false, leaving ca unregistered, if kCapacity Cancelables are already registered
+     */
+    bool Register(Cancelable * ca, const Key & key)
+    {
+        ca->Cancel();
+        if (mFreeSlot == kCapacity)
+        {
+            return false;
+        }
+
+        uint16_t slot = mFreeSlot;
+        mFreeSlot     = mNextFreeSlot[slot];
+        mKeys[slot]   = key;
+
+        ca->mInfoPtr    = this;
+        ca->mInfoScalar = slot;
+
+        CallbackDeque & bucket = BucketFor(key);
+        bucket.InsertBefore(ca, &bucket, Deregister);
+        return true;
+    }
+
+    /**
+     * @brief returns the earliest Cancelable registered under key, or NULL
+     */
+    Cancelable * Find(const Key & key)
+    {
+        CallbackDeque & bucket = BucketFor(key);
+        for (Cancelable * ca = bucket.mNext; ca != &bucket; ca = ca->mNext)
+        {
+            if (mKeys[ca->mInfoScalar] == key)
+            {
+                return ca;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief the key a Cancelable was registered under.  Only meaningful while ca is registered.
+     */
+    static const Key & GetKey(const Cancelable * ca)
+    {
+        return static_cast<const CallbackRegistry *>(ca->mInfoPtr)->mKeys[ca->mInfoScalar];
+    }
+
+    /**
+     * @brief empty?
+     */
+    bool IsEmpty()
+    {
+        for (CallbackDeque & bucket : mBuckets)
+        {
+            if (!bucket.IsEmpty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static_assert((kBucketCount & (kBucketCount - 1)) == 0, "kBucketCount must be a power of two");
+    static_assert(kCapacity < UINT16_MAX, "kCapacity is too large");
+
+    static void Deregister(Cancelable * ca)
+    {
+        CallbackRegistry * registry   = static_cast<CallbackRegistry *>(ca->mInfoPtr);
+        uint16_t slot                 = static_cast<uint16_t>(ca->mInfoScalar);
+        registry->mNextFreeSlot[slot] = registry->mFreeSlot;
+        registry->mFreeSlot           = slot;
+        CallbackDeque::Dequeue(ca);
+    }
+
+    CallbackDeque & BucketFor(const Key & key) { return mBuckets[key.Hash() & (kBucketCount - 1)]; }
+
+    CallbackDeque mBuckets[kBucketCount];
+    Key mKeys[kCapacity];
+    // Free slots form a list through mNextFreeSlot, ending at kCapacity.
+    uint16_t mNextFreeSlot[kCapacity];
+    uint16_t mFreeSlot = 0;
+};
+
 } // namespace Callback
 } // namespace chip
@@ -1475,6 +1475,28 @@
 #define CHIP_CONFIG_CERT_MAX_RDN_ATTRIBUTES 5
 #endif // CHIP_CONFIG_CERT_MAX_RDN_ATTRIBUTES
 
+/**
+ *  @def CHIP_CONFIG_X509_CERT_MAX_ASN1_ELEMENTS
+ *
+ *  @brief
+ *    When non-zero, X.509 certificate conversion first indexes the
+ *    certificate with TokenizeASN1(), which checks every element length
+ *    against the enclosing element and rejects malformed encodings before
+ *    any output is written, and then converts from the index. This is the
+ *    maximum number of ASN.1 elements, including those encapsulated in
+ *    OCTET STRINGs and BIT STRINGs, that the index can hold; certificates
+ *    with more elements are converted without one. Operational
+ *    certificates have fewer than 90 elements.
+ *
+ *    The index is built on the stack, at 20 bytes per element. Platforms
+ *    short of stack may set this to 0 and convert straight from the
+ *    encoding, whose element lengths the ASN.1 reader also checks.
+ *
+ */
+#ifndef CHIP_CONFIG_X509_CERT_MAX_ASN1_ELEMENTS
+#define CHIP_CONFIG_X509_CERT_MAX_ASN1_ELEMENTS 96
+#endif // CHIP_CONFIG_X509_CERT_MAX_ASN1_ELEMENTS
+
 /**
  *  @def CHIP_CONFIG_DEBUG_CERT_VALIDATION
  *
@@ -2355,6 +2377,125 @@
 #define CHIP_CONFIG_MAX_DEVICE_ADMINS 16
 #endif // CHIP_CONFIG_MAX_DEVICE_ADMINS
 
+/**
+ *  @def CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+ *
+ *  @brief
+ *    Enable (1) or disable (0) support for receiving on the UDP transport
+ *    from several SO_REUSEPORT sockets, each serviced by its own thread that
+ *    also decrypts secure messages before handing them to the CHIP thread.
+ *    Requires a POSIX sockets platform with SO_REUSEPORT load balancing,
+ *    i.e. Linux. See Transport::UdpListenParameters::SetReceiveShards.
+ */
+#ifndef CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+#define CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS 0
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
+/**
+ *  @def CHIP_CONFIG_UDP_MAX_RECEIVE_SHARDS
+ *
+ *  @brief
+ *    Maximum number of receive shards (sockets and threads) per UDP transport.
+ */
+#ifndef CHIP_CONFIG_UDP_MAX_RECEIVE_SHARDS
+#define CHIP_CONFIG_UDP_MAX_RECEIVE_SHARDS 8
+#endif // CHIP_CONFIG_UDP_MAX_RECEIVE_SHARDS
+
+/**
+ *  @def CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE
+ *
+ *  @brief
+ *    Number of received messages each UDP receive shard can hold for the
+ *    CHIP thread. Messages arriving while the queue is full are dropped.
+ */
+#ifndef CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE
+#define CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE 32
+#endif // CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE
+
+/**
+ *  @def CHIP_CONFIG_DEVICE_CALLBACK_BUCKETS
+ *
+ *  @brief
+ *    Number of hash buckets (a power of two) in each of the response and report
+ *    callback registries of chip::app::CHIPDeviceCallbacksMgr. A lookup walks
+ *    the callbacks of one bucket, so controllers with many requests in flight
+ *    may want more buckets. Each bucket costs one Callback::Cancelable.
+ */
+#ifndef CHIP_CONFIG_DEVICE_CALLBACK_BUCKETS
+#define CHIP_CONFIG_DEVICE_CALLBACK_BUCKETS 64
+#endif // CHIP_CONFIG_DEVICE_CALLBACK_BUCKETS
+
+/**
+ *  @def CHIP_CONFIG_DEVICE_MAX_PENDING_CALLBACKS
+ *
+ *  @brief
+ *    Maximum number of callbacks each of the response success and failure
+ *    callback registries of chip::app::CHIPDeviceCallbacksMgr holds at once,
+ *    that is, the number of responses a controller can await. Registering a
+ *    callback beyond that fails with CHIP_ERROR_NO_MEMORY. Each callback costs
+ *    its key, of up to 16 bytes, and a 2-byte free list link.
+ */
+#ifndef CHIP_CONFIG_DEVICE_MAX_PENDING_CALLBACKS
+#define CHIP_CONFIG_DEVICE_MAX_PENDING_CALLBACKS 64
+#endif // CHIP_CONFIG_DEVICE_MAX_PENDING_CALLBACKS
+
+/**
+ *  @def CHIP_CONFIG_DEVICE_MAX_REPORT_CALLBACKS
+ *
+ *  @brief
+ *    Maximum number of attribute report callbacks the report callback registry
+ *    of chip::app::CHIPDeviceCallbacksMgr holds at once. Report callbacks stay
+ *    registered for as long as the attribute is reported, so a controller
+ *    subscribed to many attributes across many nodes needs far more of them
+ *    than pending responses. Registering a callback beyond that fails with
+ *    CHIP_ERROR_NO_MEMORY. Each callback costs its key, of up to 16 bytes, and
+ *    a 2-byte free list link.
+ */
+#ifndef CHIP_CONFIG_DEVICE_MAX_REPORT_CALLBACKS
+#define CHIP_CONFIG_DEVICE_MAX_REPORT_CALLBACKS 256
+#endif // CHIP_CONFIG_DEVICE_MAX_REPORT_CALLBACKS
+
+/**
+ *  @def CHIP_CONFIG_DEVICE_CALLBACK_RESPONSE_TIMEOUT
+ *
+ *  @brief
+ *    Default time, in milliseconds, a controller waits for the response to a
+ *    cluster command or attribute request before its failure callback is
+ *    called with a timeout status. 0 waits forever.
+ */
+#ifndef CHIP_CONFIG_DEVICE_CALLBACK_RESPONSE_TIMEOUT
+#define CHIP_CONFIG_DEVICE_CALLBACK_RESPONSE_TIMEOUT 60000
+#endif // CHIP_CONFIG_DEVICE_CALLBACK_RESPONSE_TIMEOUT
+
+/**
+ *  @def CHIP_CONFIG_IM_MAX_NUM_READ_CLIENT
+ *
+ *  @brief
+ *    Number of read clients in the interaction model engine pool, which is
+ *    the number of read interactions a controller can run at the same time
+ *    across all its peers. Each read client uses its own exchange.
+ */
+#ifndef CHIP_CONFIG_IM_MAX_NUM_READ_CLIENT
+#define CHIP_CONFIG_IM_MAX_NUM_READ_CLIENT 4
+#endif // CHIP_CONFIG_IM_MAX_NUM_READ_CLIENT
+
+/**
+ *  @def CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION
+ *
+ *  @brief
+ *    Maximum number of read requests of the read client pool that can be
+ *    outstanding at the same time with one peer, identified by its node id
+ *    and admin id. Requests above this cap fail with
+ *    #CHIP_ERROR_RATE_LIMIT_EXCEEDED, so that the peer, which answers them
+ *    from a read handler each, is not sent more than it can serve.
+ *
+ *    Defaults to CHIP_MAX_NUM_READ_HANDLER, the size of the read handler
+ *    pool of a peer built from this stack.
+ */
+#ifndef CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION
+#define CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION CHIP_MAX_NUM_READ_HANDLER
+#endif // CHIP_CONFIG_IM_MAX_READ_CLIENTS_PER_SESSION
+
 /**
  * @def CHIP_NON_PRODUCTION_MARKER
  *
@@ -218,6 +218,124 @@ static void NotifierTest(nlTestSuite * inSuite, void * inContext)
     cancelcb.Cancel();
 }
 
+/**
+ * A (node, sequence number) key, like the ones controllers use to correlate responses.
+ */
+struct ExchangeKey
+{
+    uint64_t mNode;
+    uint8_t mSeq;
+
+    bool operator==(const ExchangeKey & other) const { return mNode == other.mNode && mSeq == other.mSeq; }
+    uint32_t Hash() const { return static_cast<uint32_t>((((mNode << 8) | mSeq) * 0x9E3779B97F4A7C15ULL) >> 32); }
+};
+
+constexpr size_t kRegistryBuckets  = 1024;
+constexpr size_t kRegistryCapacity = 16;
+
+static void RegistryTest(nlTestSuite * inSuite, void * inContext)
+{
+    typedef CallbackRegistry<ExchangeKey, kRegistryBuckets, kRegistryCapacity> Registry;
+
+    int n = 1;
+    Callback<> cb1(reinterpret_cast<CallFn>(increment), &n);
+    Callback<> cb2(reinterpret_cast<CallFn>(increment), &n);
+    Callback<> cb3(reinterpret_cast<CallFn>(increment), &n);
+    Registry registry;
+
+    const ExchangeKey key1 = { 1, 1 };
+    const ExchangeKey key2 = { 1, 2 };
+
+    NL_TEST_ASSERT(inSuite, registry.IsEmpty());
+    NL_TEST_ASSERT(inSuite, registry.Find(key1) == nullptr);
+
+    registry.Register(cb1.Cancel(), key1);
+    registry.Register(cb2.Cancel(), key2);
+    registry.Register(cb3.Cancel(), key1);
+    NL_TEST_ASSERT(inSuite, cb1.IsRegistered() && cb2.IsRegistered() && cb3.IsRegistered());
+    NL_TEST_ASSERT(inSuite, !registry.IsEmpty());
+
+    // Find() returns the earliest registration of a key
+    Cancelable * found = registry.Find(key1);
+    NL_TEST_ASSERT(inSuite, found != nullptr && Registry::GetKey(found) == key1);
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(found) == &cb1);
+
+    // Cancel() removes a callback from the registry
+    cb1.Cancel();
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(registry.Find(key1)) == &cb3);
+    cb3.Cancel();
+    NL_TEST_ASSERT(inSuite, registry.Find(key1) == nullptr);
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(registry.Find(key2)) == &cb2);
+
+    // registering again moves a callback to its new key
+    const ExchangeKey key3 = { 2, 1 };
+    registry.Register(cb2.Cancel(), key3);
+    NL_TEST_ASSERT(inSuite, registry.Find(key2) == nullptr);
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(registry.Find(key3)) == &cb2);
+
+    // keys sharing a bucket are told apart, and cancel on destruct removes the callback
+    Callback<> * pcb = chip::Platform::New<Callback<>>(reinterpret_cast<CallFn>(increment), &n);
+    CallbackRegistry<ExchangeKey, 1, kRegistryCapacity> list;
+    list.Register(pcb->Cancel(), key1);
+    list.Register(cb1.Cancel(), key2);
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(list.Find(key2)) == &cb1);
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(list.Find(key1)) == pcb);
+    chip::Platform::Delete(pcb);
+    NL_TEST_ASSERT(inSuite, list.Find(key1) == nullptr);
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(list.Find(key2)) == &cb1);
+
+    cb1.Cancel();
+    cb2.Cancel();
+    NL_TEST_ASSERT(inSuite, registry.IsEmpty());
+    NL_TEST_ASSERT(inSuite, list.IsEmpty());
+}
+
+static void RegistryCapacityTest(nlTestSuite * inSuite, void * inContext)
+{
+    typedef CallbackRegistry<ExchangeKey, 2, 2> Registry;
+
+    int n = 1;
+    Callback<> cb1(reinterpret_cast<CallFn>(increment), &n);
+    Callback<> cb2(reinterpret_cast<CallFn>(increment), &n);
+    Callback<> cb3(reinterpret_cast<CallFn>(increment), &n);
+    Registry registry;
+
+    const ExchangeKey key1 = { 1, 1 };
+    const ExchangeKey key2 = { 1, 2 };
+    const ExchangeKey key3 = { 1, 3 };
+
+    NL_TEST_ASSERT(inSuite, registry.Register(cb1.Cancel(), key1));
+    NL_TEST_ASSERT(inSuite, registry.Register(cb2.Cancel(), key2));
+
+    // a full registry refuses the callback and leaves it unregistered
+    NL_TEST_ASSERT(inSuite, !registry.Register(cb3.Cancel(), key3));
+    NL_TEST_ASSERT(inSuite, !cb3.IsRegistered());
+    NL_TEST_ASSERT(inSuite, registry.Find(key3) == nullptr);
+
+    // registering a callback again reuses its own slot
+    NL_TEST_ASSERT(inSuite, registry.Register(cb2.Cancel(), key3));
+    NL_TEST_ASSERT(inSuite, registry.Find(key2) == nullptr);
+
+    // Cancel() frees the slot of a callback
+    cb1.Cancel();
+    NL_TEST_ASSERT(inSuite, registry.Register(cb3.Cancel(), key1));
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(registry.Find(key1)) == &cb3);
+    NL_TEST_ASSERT(inSuite, Callback<>::FromCancelable(registry.Find(key3)) == &cb2);
+    NL_TEST_ASSERT(inSuite, Registry::GetKey(registry.Find(key1)) == key1);
+
+    // the registry cancels the callbacks it still holds when destroyed
+    {
+        Registry scoped;
+        NL_TEST_ASSERT(inSuite, scoped.Register(cb1.Cancel(), key1));
+        NL_TEST_ASSERT(inSuite, cb1.IsRegistered());
+    }
+    NL_TEST_ASSERT(inSuite, !cb1.IsRegistered());
+
+    cb2.Cancel();
+    cb3.Cancel();
+    NL_TEST_ASSERT(inSuite, registry.IsEmpty());
+}
+
 /**
  *  Set up the test suite.
  */
@@ -247,6 +365,8 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("ResumerTest", ResumerTest),
     NL_TEST_DEF("NotifierTest", NotifierTest),
+    NL_TEST_DEF("RegistryTest", RegistryTest),
+    NL_TEST_DEF("RegistryCapacityTest", RegistryCapacityTest),
 
     NL_TEST_SENTINEL()
 };
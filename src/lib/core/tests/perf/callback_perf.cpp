@@ -0,0 +1,122 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements chip-callback-perf, which times lookups in a
+ *      Callback::CallbackRegistry among many outstanding callbacks, with a
+ *      single bucket (i.e. a CallbackDeque scan) and with many buckets.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <core/CHIPCallback.h>
+#include <support/CHIPMem.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::Callback;
+
+#define kToolName "chip-callback-perf"
+
+namespace {
+
+constexpr size_t kCallbackCount = 10000;
+constexpr size_t kPerNode       = 200;
+constexpr size_t kBucketCount   = 1024;
+
+/**
+ * A (node, sequence number) key, like the ones controllers use to correlate responses.
+ */
+struct ExchangeKey
+{
+    uint64_t mNode;
+    uint8_t mSeq;
+
+    bool operator==(const ExchangeKey & other) const { return mNode == other.mNode && mSeq == other.mSeq; }
+    uint32_t Hash() const { return static_cast<uint32_t>((((mNode << 8) | mSeq) * 0x9E3779B97F4A7C15ULL) >> 32); }
+};
+
+ExchangeKey KeyOf(size_t index)
+{
+    return { 0x1000 + index / kPerNode, static_cast<uint8_t>(index % kPerNode) };
+}
+
+/**
+ * Register kCallbackCount callbacks, then look each of them up and return the mean lookup time, in nanoseconds.
+ */
+template <size_t kBuckets>
+bool TimeFind(uint64_t & nsPerFind)
+{
+    struct State
+    {
+        CallbackRegistry<ExchangeKey, kBuckets, kCallbackCount> registry;
+        Cancelable callbacks[kCallbackCount];
+    };
+
+    State * state = Platform::New<State>();
+    if (state == nullptr)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < kCallbackCount; i++)
+    {
+        state->registry.Register(&state->callbacks[i], KeyOf(i));
+    }
+
+    bool foundAll  = true;
+    uint64_t start = System::Platform::Layer::GetClock_MonotonicHiRes();
+    for (size_t i = 0; i < kCallbackCount; i++)
+    {
+        foundAll = state->registry.Find(KeyOf(i)) == &state->callbacks[i] && foundAll;
+    }
+    nsPerFind = (System::Platform::Layer::GetClock_MonotonicHiRes() - start) * 1000 / kCallbackCount;
+
+    Platform::Delete(state);
+    return foundAll;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    uint64_t listTime;
+    uint64_t hashedTime;
+
+    if (Platform::MemoryInit() != CHIP_NO_ERROR)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (!TimeFind<1>(listTime) || !TimeFind<kBucketCount>(hashedTime))
+    {
+        printf("%s: lookups failed\n", kToolName);
+        return EXIT_FAILURE;
+    }
+
+    printf("%s: %u callbacks, Find: %u ns/op with 1 bucket, %u ns/op with %u buckets\n", kToolName,
+           static_cast<unsigned>(kCallbackCount), static_cast<unsigned>(listTime), static_cast<unsigned>(hashedTime),
+           static_cast<unsigned>(kBucketCount));
+
+    Platform::MemoryShutdown();
+    return EXIT_SUCCESS;
+}
@@ -96,13 +96,15 @@ void LogQuery(const QueryData & data) {}
 #endif
 
 class AdvertiserMinMdns : public ServiceAdvertiser,
-                          public MdnsPacketDelegate, // receive query packets
-                          public ParserDelegate      // parses queries
+                          public MdnsPacketDelegate,   // receive query packets
+                          public MdnsRelistenDelegate, // re-advertise on interface changes
+                          public ParserDelegate        // parses queries
 {
 public:
     AdvertiserMinMdns() : mResponseSender(&GlobalMinimalMdnsServer::Server(), &mQueryResponder)
     {
         GlobalMinimalMdnsServer::Instance().SetQueryDelegate(this);
+        GlobalMinimalMdnsServer::Instance().SetRelistenDelegate(this);
 
         for (size_t i = 0; i < kMaxAllocatedResponders; i++)
         {
@@ -123,6 +125,9 @@ public:
     // MdnsPacketDelegate
     void OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info) override;
 
+    // MdnsRelistenDelegate: new interfaces/addresses need the boot-time advertisement
+    void OnMdnsRelisten() override { AdvertiseRecords(); }
+
     // ParserDelegate
     void OnHeader(ConstHeaderRef & header) override { mMessageId = header.GetMessageId(); }
     void OnResource(ResourceType type, const ResourceData & data) override {}
@@ -16,6 +16,9 @@
  */
 #include "MinimalMdnsServer.h"
 
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+
 namespace chip {
 namespace Mdns {
 namespace {
@@ -102,10 +105,44 @@ GlobalMinimalMdnsServer & GlobalMinimalMdnsServer::Instance()
 
 CHIP_ERROR GlobalMinimalMdnsServer::StartServer(chip::Inet::InetLayer * inetLayer, uint16_t port)
 {
+    mInetLayer = inetLayer;
+    mPort      = port;
+
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    // Registering twice is a no-op, so restarts keep a single handler.
+    ReturnErrorOnFailure(chip::Inet::InterfaceTable::Instance().AddChangeHandler(OnInterfacesChanged, this));
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
     GlobalMinimalMdnsServer::Server().Shutdown();
     AllInterfaces allInterfaces;
     return GlobalMinimalMdnsServer::Server().Listen(inetLayer, &allInterfaces, port);
 }
 
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+void GlobalMinimalMdnsServer::OnInterfacesChanged(void * appState, uint8_t changeFlags)
+{
+    GlobalMinimalMdnsServer * self = static_cast<GlobalMinimalMdnsServer *>(appState);
+
+    if (self->mInetLayer == nullptr || !self->mServer.IsListening())
+    {
+        return;
+    }
+
+    ChipLogProgress(Discovery, "Network interfaces changed (0x%02x), restarting mDNS listeners", changeFlags);
+
+    CHIP_ERROR err = self->StartServer(self->mInetLayer, self->mPort);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to restart mDNS listeners: %s", ErrorStr(err));
+        return;
+    }
+
+    if (self->mRelistenDelegate != nullptr)
+    {
+        self->mRelistenDelegate->OnMdnsRelisten();
+    }
+}
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
 } // namespace Mdns
 } // namespace chip
@@ -15,6 +15,7 @@
  *    limitations under the License.
  */
 
+#include <inet/InetInterfaceTable.h>
 #include <mdns/minimal/Server.h>
 
 namespace chip {
@@ -63,6 +64,15 @@ public:
     virtual void OnMdnsPacketData(const mdns::Minimal::BytesRange & data, const chip::Inet::IPPacketInfo * info) = 0;
 };
 
+/// Notified after the global server re-listened because the set of network
+/// interfaces or addresses changed
+class MdnsRelistenDelegate
+{
+public:
+    virtual ~MdnsRelistenDelegate() {}
+    virtual void OnMdnsRelisten() = 0;
+};
+
 /// A global mdns::Minimal::Server wrapper
 /// used to share the same server between MDNS Advertiser and resolver
 /// as advertiser responds to 'onquery' and resolver expects 'onresponse'
@@ -83,6 +93,7 @@ public:
 
     void SetQueryDelegate(MdnsPacketDelegate * delegate) { mQueryDelegate = delegate; }
     void SetResponseDelegate(MdnsPacketDelegate * delegate) { mResponseDelegate = delegate; }
+    void SetRelistenDelegate(MdnsRelistenDelegate * delegate) { mRelistenDelegate = delegate; }
 
     // ServerDelegate implementation
     void OnQuery(const mdns::Minimal::BytesRange & data, const chip::Inet::IPPacketInfo * info) override
@@ -102,9 +113,16 @@ public:
     }
 
 private:
+#if INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+    static void OnInterfacesChanged(void * appState, uint8_t changeFlags);
+#endif // INET_CONFIG_ENABLE_NETLINK_INTERFACE_TABLE
+
     ServerType mServer;
-    MdnsPacketDelegate * mQueryDelegate    = nullptr;
-    MdnsPacketDelegate * mResponseDelegate = nullptr;
+    MdnsPacketDelegate * mQueryDelegate      = nullptr;
+    MdnsPacketDelegate * mResponseDelegate   = nullptr;
+    MdnsRelistenDelegate * mRelistenDelegate = nullptr;
+    chip::Inet::InetLayer * mInetLayer       = nullptr;
+    uint16_t mPort                           = 0;
 };
 
 } // namespace Mdns
@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *   Defines DeadlineQueue, a queue of values ordered by deadline.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ * A growable ring buffer of (deadline, value) entries, ordered by deadline.
+ *
+ * Entries pushed with non-decreasing deadlines, e.g. with a common timeout, are appended in O(1). Expired entries are
+ * popped from the front, so expiring k entries costs O(k) whatever the number of pending entries. Entries are never
+ * removed before their deadline: owners that no longer care about an entry leave it in place and ignore it when it
+ * expires.
+ *
+ * T must be trivially copyable. Storage is allocated with Platform::MemoryAlloc.
+ */
+template <typename T>
+class DeadlineQueue
+{
+public:
+    DeadlineQueue() = default;
+    ~DeadlineQueue() { Clear(); }
+
+    DeadlineQueue(const DeadlineQueue &) = delete;
+    DeadlineQueue & operator=(const DeadlineQueue &) = delete;
+
+    /**
+     * Add @p value, to expire at @p deadline. Entries with equal deadlines expire in the order they were pushed.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if the queue could not grow.
+     */
+    CHIP_ERROR Push(uint64_t deadline, const T & value)
+    {
+        if (mCount == mCapacity)
+        {
+            ReturnErrorOnFailure(Grow());
+        }
+
+        size_t position = mCount;
+        while (position > 0 && At(position - 1).mDeadline > deadline)
+        {
+            At(position) = At(position - 1);
+            position--;
+        }
+
+        At(position).mDeadline = deadline;
+        At(position).mValue    = value;
+        mCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Remove the earliest entry into @p value if its deadline is not after @p now.
+     *
+     * @return whether an entry was removed.
+     */
+    bool PopExpired(uint64_t now, T & value)
+    {
+        if (mCount == 0 || At(0).mDeadline > now)
+        {
+            return false;
+        }
+
+        value = At(0).mValue;
+        mHead = (mHead + 1) & (mCapacity - 1);
+        mCount--;
+        return true;
+    }
+
+    /**
+     * Get the deadline of the earliest entry.
+     *
+     * @return false if the queue is empty.
+     */
+    bool GetEarliestDeadline(uint64_t & deadline) const
+    {
+        if (mCount == 0)
+        {
+            return false;
+        }
+
+        deadline = At(0).mDeadline;
+        return true;
+    }
+
+    size_t Count() const { return mCount; }
+    bool IsEmpty() const { return mCount == 0; }
+
+    /**
+     * Remove all entries and release the storage.
+     */
+    void Clear()
+    {
+        Platform::MemoryFree(mEntries);
+        mEntries  = nullptr;
+        mCapacity = 0;
+        mHead     = 0;
+        mCount    = 0;
+    }
+
+private:
+    static constexpr size_t kInitialCapacity = 16;
+
+    struct Entry
+    {
+        uint64_t mDeadline;
+        T mValue;
+    };
+
+    Entry & At(size_t index) { return mEntries[(mHead + index) & (mCapacity - 1)]; }
+    const Entry & At(size_t index) const { return mEntries[(mHead + index) & (mCapacity - 1)]; }
+
+    CHIP_ERROR Grow()
+    {
+        const size_t capacity = (mCapacity == 0) ? kInitialCapacity : mCapacity * 2;
+        VerifyOrReturnError(capacity > mCapacity, CHIP_ERROR_NO_MEMORY);
+
+        Entry * entries = static_cast<Entry *>(Platform::MemoryAlloc(capacity * sizeof(Entry)));
+        VerifyOrReturnError(entries != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        for (size_t i = 0; i < mCount; i++)
+        {
+            entries[i] = At(i);
+        }
+        Platform::MemoryFree(mEntries);
+
+        mEntries  = entries;
+        mCapacity = capacity;
+        mHead     = 0;
+        return CHIP_NO_ERROR;
+    }
+
+    Entry * mEntries = nullptr;
+    // Always zero or a power of two.
+    size_t mCapacity = 0;
+    size_t mHead     = 0;
+    size_t mCount    = 0;
+};
+
+} // namespace chip
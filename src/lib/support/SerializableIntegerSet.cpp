@@ -19,9 +19,95 @@
 #include "SerializableIntegerSet.h"
 
 #include <core/CHIPEncoding.h>
+#include <support/CHIPMem.h>
+
+#include <algorithm>
+#include <ctype.h>
 
 namespace chip {
 
+namespace {
+
+/**
+ * Base64 encodes a byte stream, 3 bytes at a time.
+ */
+class Base64StreamWriter
+{
+public:
+    explicit Base64StreamWriter(char * out) : mOut(out) {}
+
+    void Put(uint8_t byte)
+    {
+        mBuf[mBufLen++] = byte;
+        if (mBufLen == sizeof(mBuf))
+        {
+            Flush();
+        }
+    }
+
+    void Flush()
+    {
+        mLen    = static_cast<uint16_t>(mLen + Base64Encode(mBuf, mBufLen, mOut + mLen));
+        mBufLen = 0;
+    }
+
+    uint16_t Length() const { return mLen; }
+
+private:
+    char * mOut;
+    uint16_t mLen = 0;
+    uint8_t mBuf[3];
+    uint8_t mBufLen = 0;
+};
+
+/**
+ * Base64 decodes a string into a byte stream, 4 characters at a time.
+ * Decoding stops at the first padding, space or control character.
+ */
+class Base64StreamReader
+{
+public:
+    Base64StreamReader(const char * in, uint16_t len) : mIn(in), mLen(len) {}
+
+    /**
+     * @return true if a byte was read, false at the end of the stream or on a decoding error.
+     */
+    bool Get(uint8_t & byte)
+    {
+        if (mBufPos == mBufLen)
+        {
+            VerifyOrReturnError(mLen > 0 && isgraph(*mIn) && *mIn != '=', false);
+
+            uint16_t chunkLen = std::min<uint16_t>(mLen, 4);
+            uint16_t decoded  = Base64Decode(mIn, chunkLen, mBuf);
+            if (decoded == UINT16_MAX || decoded == 0)
+            {
+                mError = true;
+                return false;
+            }
+            mIn += chunkLen;
+            mLen    = static_cast<uint16_t>(mLen - chunkLen);
+            mBufLen = static_cast<uint8_t>(decoded);
+            mBufPos = 0;
+        }
+
+        byte = mBuf[mBufPos++];
+        return true;
+    }
+
+    bool HasError() const { return mError; }
+
+private:
+    const char * mIn;
+    uint16_t mLen;
+    uint8_t mBuf[3];
+    uint8_t mBufLen = 0;
+    uint8_t mBufPos = 0;
+    bool mError     = false;
+};
+
+} // namespace
+
 const char * SerializableU64SetBase::SerializeBase64(char * buf, uint16_t & buflen)
 {
     char * out = nullptr;
@@ -151,4 +237,204 @@ uint16_t SerializableU64SetBase::FirstAvailableForUniqueId(uint64_t value)
     return available;
 }
 
+uint16_t SerializableU64HashSetBase::Home(uint64_t value) const
+{
+    // Mix all the bits of the value into the low bits used as table index, since node ids
+    // are often sequential or share their high bits.
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+
+    return static_cast<uint16_t>(value & (mTableSize - 1u));
+}
+
+uint16_t SerializableU64HashSetBase::FindSlot(uint64_t value) const
+{
+    uint16_t slot = Home(value);
+
+    // The table is never more than half full, so the probe sequence always ends on an empty slot.
+    while (mTable[slot] != value && mTable[slot] != mEmptyValue)
+    {
+        slot = static_cast<uint16_t>((slot + 1) & (mTableSize - 1u));
+    }
+
+    return slot;
+}
+
+CHIP_ERROR SerializableU64HashSetBase::Insert(uint64_t value)
+{
+    VerifyOrReturnError(value != mEmptyValue, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint16_t slot = FindSlot(value);
+    if (mTable[slot] != value)
+    {
+        VerifyOrReturnError(mCount < mCapacity, CHIP_ERROR_NO_MEMORY);
+        mTable[slot] = value;
+        mCount++;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void SerializableU64HashSetBase::Remove(uint64_t value)
+{
+    VerifyOrReturn(value != mEmptyValue);
+
+    uint16_t hole = FindSlot(value);
+    VerifyOrReturn(mTable[hole] == value);
+
+    // Shift back the values that follow in the probe sequence, unless that would move them before their home slot.
+    const uint16_t mask = static_cast<uint16_t>(mTableSize - 1u);
+    for (uint16_t next = static_cast<uint16_t>((hole + 1) & mask); mTable[next] != mEmptyValue;
+         next          = static_cast<uint16_t>((next + 1) & mask))
+    {
+        uint16_t home = Home(mTable[next]);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            mTable[hole] = mTable[next];
+            hole         = next;
+        }
+    }
+
+    mTable[hole] = mEmptyValue;
+    mCount--;
+}
+
+void SerializableU64HashSetBase::Clear()
+{
+    for (uint16_t i = 0; i < mTableSize; i++)
+    {
+        mTable[i] = mEmptyValue;
+    }
+    mCount = 0;
+}
+
+const char * SerializableU64HashSetBase::SerializeBase64(char * buf, uint16_t & buflen)
+{
+    uint64_t * sorted = nullptr;
+    uint16_t count    = 0;
+    uint64_t previous = 0;
+
+    if (buf == nullptr || buflen < SerializedSize())
+    {
+        buflen = SerializedSize();
+        return nullptr;
+    }
+
+    if (mCount > 0)
+    {
+        sorted = static_cast<uint64_t *>(chip::Platform::MemoryAlloc(sizeof(uint64_t) * mCount));
+        VerifyOrReturnError(sorted != nullptr, nullptr);
+
+        for (uint16_t i = 0; i < mTableSize; i++)
+        {
+            if (mTable[i] != mEmptyValue)
+            {
+                sorted[count++] = mTable[i];
+            }
+        }
+        std::sort(sorted, sorted + count);
+    }
+
+    buf[0] = kCompactFormatPrefix;
+    Base64StreamWriter writer(buf + 1);
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint64_t delta = sorted[i] - previous;
+        previous       = sorted[i];
+
+        while (delta >= 0x80)
+        {
+            writer.Put(static_cast<uint8_t>(delta | 0x80));
+            delta >>= 7;
+        }
+        writer.Put(static_cast<uint8_t>(delta));
+    }
+    writer.Flush();
+
+    chip::Platform::MemoryFree(sorted);
+
+    buflen      = static_cast<uint16_t>(writer.Length() + 1);
+    buf[buflen] = '\0';
+
+    return buf;
+}
+
+CHIP_ERROR SerializableU64HashSetBase::DeserializeBase64(const char * serialized, uint16_t buflen)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    uint8_t byte   = 0;
+
+    VerifyOrReturnError(buflen <= MaxSerializedSize(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Clear();
+
+    if (buflen > 0 && serialized[0] == kCompactFormatPrefix)
+    {
+        Base64StreamReader reader(serialized + 1, static_cast<uint16_t>(buflen - 1));
+        uint64_t value = 0;
+
+        while (reader.Get(byte))
+        {
+            uint64_t delta = 0;
+            uint8_t shift  = 0;
+
+            // Decode one varint.
+            while (true)
+            {
+                VerifyOrExit(shift < 64, err = CHIP_ERROR_INVALID_ARGUMENT);
+                delta |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                shift = static_cast<uint8_t>(shift + 7);
+                if ((byte & 0x80) == 0)
+                {
+                    break;
+                }
+                VerifyOrExit(reader.Get(byte), err = CHIP_ERROR_INVALID_ARGUMENT);
+            }
+
+            value += delta;
+            err = Insert(value);
+            SuccessOrExit(err);
+        }
+        VerifyOrExit(!reader.HasError(), err = CHIP_ERROR_INVALID_ARGUMENT);
+    }
+    else
+    {
+        // SerializableU64Set format: the base64 encoding of an array of little endian values,
+        // which may include empty values.
+        Base64StreamReader reader(serialized, buflen);
+        uint64_t value = 0;
+        uint8_t len    = 0;
+
+        while (reader.Get(byte))
+        {
+            value |= static_cast<uint64_t>(byte) << (8 * len++);
+            if (len == sizeof(uint64_t))
+            {
+                if (value != mEmptyValue)
+                {
+                    err = Insert(value);
+                    SuccessOrExit(err);
+                }
+                value = 0;
+                len   = 0;
+            }
+        }
+        VerifyOrExit(!reader.HasError() && len == 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        Clear();
+        if (err == CHIP_ERROR_NO_MEMORY)
+        {
+            err = CHIP_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    return err;
+}
+
 } // namespace chip
@@ -27,6 +27,12 @@
  *      The data is stored such that serialized data can be deserialized correctly
  *      on different machine architectures.
  *
+ *      SerializableU64HashSet is a variant backed by an open-addressing hash table,
+ *      with constant time Contains/Insert/Remove, that serializes to a compact
+ *      representation: the sorted values, delta encoded as unsigned LEB128 varints,
+ *      then base64 encoded behind a format prefix character. It still deserializes
+ *      the representation produced by SerializableU64Set.
+ *
  */
 
 #pragma once
@@ -38,6 +44,13 @@
 // So, we are adding 1 extra byte to the size requirement.
 #define CHIP_MAX_SERIALIZED_SIZE_U64(count) static_cast<uint16_t>(BASE64_ENCODED_LEN(sizeof(uint64_t) * (count)) + 1)
 
+// Maximum length of an unsigned LEB128 varint encoding a uint64_t.
+#define CHIP_MAX_VARINT_SIZE_U64 10
+
+// The compact serialization adds the format prefix character and the null termination to the base64 encoded varints.
+#define CHIP_MAX_COMPACT_SERIALIZED_SIZE_U64(count)                                                                                \
+    static_cast<uint16_t>(BASE64_ENCODED_LEN(CHIP_MAX_VARINT_SIZE_U64 * (count)) + 2)
+
 namespace chip {
 
 class SerializableU64SetBase
@@ -153,4 +166,132 @@ private:
     uint64_t mBuffer[kCapacity];
 };
 
+/**
+ * Set of uint64_t values stored in an open-addressing hash table with linear probing.
+ * The table array must have a power of two size, at least twice the capacity.
+ */
+class SerializableU64HashSetBase
+{
+public:
+    /**
+     * First character of the compact serialization. It is not part of the base64 alphabet,
+     * which tells the compact serialization apart from the SerializableU64Set one.
+     */
+    static constexpr char kCompactFormatPrefix = '~';
+
+    SerializableU64HashSetBase(uint64_t * table, uint16_t tableSize, uint16_t capacity, uint64_t emptyValue) :
+        mTable(table), mTableSize(tableSize), mCapacity(capacity), mEmptyValue(emptyValue), mCount(0)
+    {
+        Clear();
+    }
+
+    /**
+     * @brief
+     *   Serialize the set into its compact representation: a format prefix character
+     *   followed by the base64 encoding of the sorted values, each encoded as the
+     *   LEB128 varint of its difference with the previous value.
+     *
+     * @param[in] buf Buffer where serialized string is written
+     * @param[in,out] buflen Length of buf. Set to the length of the serialized string on success,
+     *                       or to SerializedSize() if buf is too small
+     * @return pointer to buf, or nullptr in case of error
+     */
+    const char * SerializeBase64(char * buf, uint16_t & buflen);
+
+    /**
+     * @brief
+     *   Deserialize a string produced by SerializeBase64(), or by SerializableU64SetBase::SerializeBase64(),
+     *   into the set. The previous content of the set is discarded.
+     *
+     * @param[in] serialized Serialized buffer
+     * @param[in] buflen Length of buffer
+     * @return CHIP_NO_ERROR in case of success, or the error code
+     */
+    CHIP_ERROR DeserializeBase64(const char * serialized, uint16_t buflen);
+
+    /**
+     * @brief
+     *   Get the maximum length of string if the set is serialized.
+     */
+    uint16_t SerializedSize() const { return CHIP_MAX_COMPACT_SERIALIZED_SIZE_U64(mCount); }
+
+    /**
+     * @brief
+     *   Get the maximum length of string if the set were full and serialized, in either format.
+     */
+    uint16_t MaxSerializedSize() const { return CHIP_MAX_COMPACT_SERIALIZED_SIZE_U64(mCapacity); }
+
+    /**
+     * @brief
+     *   Check if the value is in the set.
+     */
+    bool Contains(uint64_t value) const { return value != mEmptyValue && mTable[FindSlot(value)] == value; }
+
+    /**
+     * @brief
+     *   Insert the value in the set. If the value is duplicate, it won't be inserted.
+     *
+     * @return CHIP_NO_ERROR in case of success, or the error code
+     */
+    CHIP_ERROR Insert(uint64_t value);
+
+    /**
+     * @brief
+     *   Delete the value from the set.
+     */
+    void Remove(uint64_t value);
+
+    /**
+     * @brief
+     *   Remove all the values from the set.
+     */
+    void Clear();
+
+    uint16_t Count() const { return mCount; }
+
+private:
+    uint64_t * const mTable;
+    const uint16_t mTableSize;
+    const uint16_t mCapacity;
+    const uint64_t mEmptyValue;
+    uint16_t mCount;
+
+    uint16_t Home(uint64_t value) const;
+
+    /**
+     * @brief
+     *   Find the slot holding the value, or the empty slot ending its probe sequence.
+     */
+    uint16_t FindSlot(uint64_t value) const;
+};
+
+/**
+ * Size of the hash table of a SerializableU64HashSet of the given capacity:
+ * the smallest power of two that is at least twice the capacity.
+ */
+constexpr uint16_t SerializableU64HashSetTableSize(uint16_t capacity, uint16_t size = 2)
+{
+    return (size >= 2 * capacity) ? size : SerializableU64HashSetTableSize(capacity, static_cast<uint16_t>(size * 2));
+}
+
+template <uint16_t kCapacity, uint64_t kEmptyValue = 0>
+class SerializableU64HashSet : public SerializableU64HashSetBase
+{
+public:
+    SerializableU64HashSet() : SerializableU64HashSetBase(mBuffer, kTableSize, kCapacity, kEmptyValue)
+    {
+        /**
+         * Check that the serialized set will fit in a buffer of size UINT16_MAX, since APIs in
+         * this class are using uint16_t type for buffer sizes.
+         */
+        nlSTATIC_ASSERT_PRINT(BASE64_ENCODED_LEN(CHIP_MAX_VARINT_SIZE_U64 * kCapacity) + 2 <= UINT16_MAX,
+                              "Serializable u64 hash set capacity is too large for a uint16_t serialized size");
+    }
+
+private:
+    static constexpr uint16_t kTableSize = SerializableU64HashSetTableSize(kCapacity);
+
+    uint64_t mBuffer[kTableSize];
+};
+
 } // namespace chip
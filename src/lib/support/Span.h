@@ -45,5 +45,6 @@ private:
 };
 
 using ByteSpan = Span<uint8_t>;
+using CharSpan = Span<char>;
 
 } // namespace chip
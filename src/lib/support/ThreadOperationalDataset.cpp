@@ -18,6 +18,7 @@
 #include <assert.h>
 #include <string.h>
 
+#include <support/CodeUtils.h>
 #include <support/ThreadOperationalDataset.h>
 
 namespace chip {
@@ -40,18 +41,6 @@ class ThreadTLV final
                                                    ///< not allowed in Thread Operational Dataset TLVs.
 
 public:
-    enum : uint8_t
-    {
-        kChannel         = 0,
-        kPanId           = 1,
-        kExtendedPanId   = 2,
-        kNetworkName     = 3,
-        kPSKc            = 4,
-        kMasterKey       = 5,
-        kMeshLocalPrefix = 7,
-        kActiveTimestamp = 14,
-    };
-
     uint8_t GetSize(void) const { return static_cast<uint8_t>(sizeof(*this) + GetLength()); }
 
     uint8_t GetType(void) const { return mType; }
@@ -189,11 +178,184 @@ private:
     uint8_t mLength;
 };
 
+namespace {
+
+void IndexTlvs(const uint8_t * aData, size_t aLength, uint8_t (&aTlvIndex)[kSizeTlvIndex])
+{
+    const ThreadTLV * end = reinterpret_cast<const ThreadTLV *>(aData + aLength);
+
+    memset(aTlvIndex, 0, sizeof(aTlvIndex));
+
+    for (const ThreadTLV * tlv = reinterpret_cast<const ThreadTLV *>(aData); tlv < end; tlv = tlv->GetNext())
+    {
+        uint8_t type = tlv->GetType();
+
+        if (type < kSizeTlvIndex && aTlvIndex[type] == 0)
+        {
+            aTlvIndex[type] = static_cast<uint8_t>(reinterpret_cast<const uint8_t *>(tlv) - aData + 1);
+        }
+    }
+}
+
+const ThreadTLV * LocateTlv(const uint8_t * aData, size_t aLength, const uint8_t (&aTlvIndex)[kSizeTlvIndex], uint8_t aType)
+{
+    if (aType < kSizeTlvIndex)
+    {
+        return aTlvIndex[aType] != 0 ? reinterpret_cast<const ThreadTLV *>(aData + aTlvIndex[aType] - 1) : nullptr;
+    }
+
+    const ThreadTLV * tlv = reinterpret_cast<const ThreadTLV *>(aData);
+    const ThreadTLV * end = reinterpret_cast<const ThreadTLV *>(aData + aLength);
+
+    while (tlv < end && tlv->GetType() != aType)
+    {
+        tlv = tlv->GetNext();
+    }
+
+    return tlv < end ? tlv : nullptr;
+}
+
+CHIP_ERROR CheckTlv(const ThreadTLV * aTlv, size_t aMinLength, size_t aMaxLength)
+{
+    VerifyOrReturnError(aTlv != nullptr, CHIP_ERROR_TLV_TAG_NOT_FOUND);
+    VerifyOrReturnError(aMinLength <= aTlv->GetLength() && aTlv->GetLength() <= aMaxLength, CHIP_ERROR_INVALID_TLV_ELEMENT);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR GetValue(const ThreadTLV * aTlv, size_t aLength, ByteSpan & aValue)
+{
+    ReturnErrorOnFailure(CheckTlv(aTlv, aLength, aLength));
+    aValue = ByteSpan(static_cast<const uint8_t *>(aTlv->GetValue()), aLength);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+CHIP_ERROR OperationalDatasetView::Init(ByteSpan aData)
+{
+    if (aData.size() > kSizeOperationalDataset || !ThreadTLV::IsValid(aData))
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    mData = aData;
+    IndexTlvs(mData.data(), mData.size(), mTlvIndex);
+    return CHIP_NO_ERROR;
+}
+
+const ThreadTLV * OperationalDatasetView::Locate(uint8_t aType) const
+{
+    return LocateTlv(mData.data(), mData.size(), mTlvIndex, aType);
+}
+
+CHIP_ERROR OperationalDatasetView::GetActiveTimestamp(uint64_t & aActiveTimestamp) const
+{
+    const ThreadTLV * tlv = Locate(kTlvActiveTimestamp);
+
+    ReturnErrorOnFailure(CheckTlv(tlv, sizeof(aActiveTimestamp), sizeof(aActiveTimestamp)));
+    tlv->Get64(aActiveTimestamp);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OperationalDatasetView::GetChannel(uint16_t & aChannel) const
+{
+    ByteSpan value;
+
+    // Channel page, then the channel.
+    ReturnErrorOnFailure(GetValue(Locate(kTlvChannel), 3, value));
+    aChannel = static_cast<uint16_t>((value.data()[1] << 8) | value.data()[2]);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OperationalDatasetView::GetExtendedPanId(ByteSpan & aExtendedPanId) const
+{
+    return GetValue(Locate(kTlvExtendedPanId), kSizeExtendedPanId, aExtendedPanId);
+}
+
+CHIP_ERROR OperationalDatasetView::GetMasterKey(ByteSpan & aMasterKey) const
+{
+    return GetValue(Locate(kTlvMasterKey), kSizeMasterKey, aMasterKey);
+}
+
+CHIP_ERROR OperationalDatasetView::GetMeshLocalPrefix(ByteSpan & aMeshLocalPrefix) const
+{
+    return GetValue(Locate(kTlvMeshLocalPrefix), kSizeMeshLocalPrefix, aMeshLocalPrefix);
+}
+
+CHIP_ERROR OperationalDatasetView::GetNetworkName(CharSpan & aNetworkName) const
+{
+    const ThreadTLV * tlv = Locate(kTlvNetworkName);
+
+    ReturnErrorOnFailure(CheckTlv(tlv, 0, kSizeNetworkName));
+    aNetworkName = CharSpan(static_cast<const char *>(tlv->GetValue()), tlv->GetLength());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OperationalDatasetView::GetPanId(uint16_t & aPanId) const
+{
+    const ThreadTLV * tlv = Locate(kTlvPanId);
+
+    ReturnErrorOnFailure(CheckTlv(tlv, sizeof(aPanId), sizeof(aPanId)));
+    tlv->Get16(aPanId);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR OperationalDatasetView::GetPSKc(ByteSpan & aPSKc) const
+{
+    return GetValue(Locate(kTlvPSKc), kSizePSKc, aPSKc);
+}
+
+bool OperationalDatasetView::IsCommissioned(void) const
+{
+    return Locate(kTlvNetworkName) != nullptr && Locate(kTlvPanId) != nullptr && Locate(kTlvMasterKey) != nullptr &&
+        Locate(kTlvExtendedPanId) != nullptr && Locate(kTlvChannel) != nullptr;
+}
+
+uint64_t OperationalDatasetView::Diff(const OperationalDatasetView & aOther) const
+{
+    return DiffFirstTlvs(aOther, true) | aOther.DiffFirstTlvs(*this, false);
+}
+
+uint64_t OperationalDatasetView::DiffFirstTlvs(const OperationalDatasetView & aOther, bool aCompareValues) const
+{
+    const ThreadTLV * end = reinterpret_cast<const ThreadTLV *>(mData.data() + mData.size());
+    uint64_t diff         = 0;
+
+    for (const ThreadTLV * tlv = reinterpret_cast<const ThreadTLV *>(mData.data()); tlv < end; tlv = tlv->GetNext())
+    {
+        if (Locate(tlv->GetType()) != tlv)
+        {
+            // Not the first TLV of its type.
+            continue;
+        }
+
+        const ThreadTLV * other = aOther.Locate(tlv->GetType());
+
+        if (other == nullptr ||
+            (aCompareValues &&
+             (other->GetLength() != tlv->GetLength() || memcmp(other->GetValue(), tlv->GetValue(), tlv->GetLength()) != 0)))
+        {
+            diff |= DiffBit(tlv->GetType());
+        }
+    }
+
+    return diff;
+}
+
 bool OperationalDataset::IsValid(ByteSpan aData)
 {
     return ThreadTLV::IsValid(aData);
 }
 
+OperationalDatasetView OperationalDataset::View(void) const
+{
+    OperationalDatasetView view;
+
+    view.mData = AsByteSpan();
+    memcpy(view.mTlvIndex, mTlvIndex, sizeof(mTlvIndex));
+    return view;
+}
+
 CHIP_ERROR OperationalDataset::Init(ByteSpan aData)
 {
     if (aData.size() > sizeof(mData))
@@ -212,25 +374,18 @@ CHIP_ERROR OperationalDataset::Init(ByteSpan aData)
     }
 
     mLength = static_cast<uint8_t>(aData.size());
+    IndexTlvs(mData, mLength, mTlvIndex);
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR OperationalDataset::GetActiveTimestamp(uint64_t & aActiveTimestamp) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kActiveTimestamp);
-
-    if (tlv != nullptr)
-    {
-        tlv->Get64(aActiveTimestamp);
-        return CHIP_NO_ERROR;
-    }
-
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    return View().GetActiveTimestamp(aActiveTimestamp);
 }
 
 CHIP_ERROR OperationalDataset::SetActiveTimestamp(uint64_t aActiveTimestamp)
 {
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kActiveTimestamp, sizeof(*tlv) + sizeof(aActiveTimestamp));
+    ThreadTLV * tlv = MakeRoom(kTlvActiveTimestamp, sizeof(*tlv) + sizeof(aActiveTimestamp));
 
     if (tlv == nullptr)
     {
@@ -246,22 +401,13 @@ CHIP_ERROR OperationalDataset::SetActiveTimestamp(uint64_t aActiveTimestamp)
 
 CHIP_ERROR OperationalDataset::GetChannel(uint16_t & aChannel) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kChannel);
-
-    if (tlv != nullptr)
-    {
-        const uint8_t * value = reinterpret_cast<const uint8_t *>(tlv->GetValue());
-        aChannel              = static_cast<uint16_t>((value[1] << 8) | value[2]);
-        return CHIP_NO_ERROR;
-    }
-
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    return View().GetChannel(aChannel);
 }
 
 CHIP_ERROR OperationalDataset::SetChannel(uint16_t aChannel)
 {
     uint8_t value[] = { 0, static_cast<uint8_t>(aChannel >> 8), static_cast<uint8_t>(aChannel & 0xff) };
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kChannel, sizeof(*tlv) + sizeof(value));
+    ThreadTLV * tlv = MakeRoom(kTlvChannel, sizeof(*tlv) + sizeof(value));
 
     if (tlv == nullptr)
     {
@@ -277,20 +423,16 @@ CHIP_ERROR OperationalDataset::SetChannel(uint16_t aChannel)
 
 CHIP_ERROR OperationalDataset::GetExtendedPanId(uint8_t (&aExtendedPanId)[kSizeExtendedPanId]) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kExtendedPanId);
-
-    if (tlv != nullptr)
-    {
-        memcpy(aExtendedPanId, tlv->GetValue(), sizeof(aExtendedPanId));
-        return CHIP_NO_ERROR;
-    }
+    ByteSpan extendedPanId;
 
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    ReturnErrorOnFailure(View().GetExtendedPanId(extendedPanId));
+    memcpy(aExtendedPanId, extendedPanId.data(), extendedPanId.size());
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR OperationalDataset::SetExtendedPanId(const uint8_t (&aExtendedPanId)[kSizeExtendedPanId])
 {
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kExtendedPanId, sizeof(*tlv) + sizeof(aExtendedPanId));
+    ThreadTLV * tlv = MakeRoom(kTlvExtendedPanId, sizeof(*tlv) + sizeof(aExtendedPanId));
 
     if (tlv == nullptr)
     {
@@ -308,20 +450,16 @@ CHIP_ERROR OperationalDataset::SetExtendedPanId(const uint8_t (&aExtendedPanId)[
 
 CHIP_ERROR OperationalDataset::GetMasterKey(uint8_t (&aMasterKey)[kSizeMasterKey]) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kMasterKey);
+    ByteSpan masterKey;
 
-    if (tlv != nullptr)
-    {
-        memcpy(aMasterKey, tlv->GetValue(), sizeof(aMasterKey));
-        return CHIP_NO_ERROR;
-    }
-
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    ReturnErrorOnFailure(View().GetMasterKey(masterKey));
+    memcpy(aMasterKey, masterKey.data(), masterKey.size());
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR OperationalDataset::SetMasterKey(const uint8_t (&aMasterKey)[kSizeMasterKey])
 {
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kMasterKey, sizeof(*tlv) + sizeof(aMasterKey));
+    ThreadTLV * tlv = MakeRoom(kTlvMasterKey, sizeof(*tlv) + sizeof(aMasterKey));
 
     if (tlv == nullptr)
     {
@@ -339,20 +477,16 @@ CHIP_ERROR OperationalDataset::SetMasterKey(const uint8_t (&aMasterKey)[kSizeMas
 
 CHIP_ERROR OperationalDataset::GetMeshLocalPrefix(uint8_t (&aMeshLocalPrefix)[kSizeMeshLocalPrefix]) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kMeshLocalPrefix);
-
-    if (tlv != nullptr)
-    {
-        memcpy(aMeshLocalPrefix, tlv->GetValue(), sizeof(aMeshLocalPrefix));
-        return CHIP_NO_ERROR;
-    }
+    ByteSpan meshLocalPrefix;
 
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    ReturnErrorOnFailure(View().GetMeshLocalPrefix(meshLocalPrefix));
+    memcpy(aMeshLocalPrefix, meshLocalPrefix.data(), meshLocalPrefix.size());
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR OperationalDataset::SetMeshLocalPrefix(const uint8_t (&aMeshLocalPrefix)[kSizeMeshLocalPrefix])
 {
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kMeshLocalPrefix, sizeof(*tlv) + sizeof(aMeshLocalPrefix));
+    ThreadTLV * tlv = MakeRoom(kTlvMeshLocalPrefix, sizeof(*tlv) + sizeof(aMeshLocalPrefix));
 
     if (tlv == nullptr)
     {
@@ -368,16 +502,12 @@ CHIP_ERROR OperationalDataset::SetMeshLocalPrefix(const uint8_t (&aMeshLocalPref
 
 CHIP_ERROR OperationalDataset::GetNetworkName(char (&aNetworkName)[kSizeNetworkName + 1]) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kNetworkName);
+    CharSpan networkName;
 
-    if (tlv != nullptr)
-    {
-        memcpy(aNetworkName, tlv->GetValue(), tlv->GetLength());
-        aNetworkName[tlv->GetLength()] = '\0';
-        return CHIP_NO_ERROR;
-    }
-
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    ReturnErrorOnFailure(View().GetNetworkName(networkName));
+    memcpy(aNetworkName, networkName.data(), networkName.size());
+    aNetworkName[networkName.size()] = '\0';
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR OperationalDataset::SetNetworkName(const char * aNetworkName)
@@ -389,7 +519,7 @@ CHIP_ERROR OperationalDataset::SetNetworkName(const char * aNetworkName)
         return CHIP_ERROR_INVALID_STRING_LENGTH;
     }
 
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kNetworkName, static_cast<uint8_t>(sizeof(*tlv) + static_cast<uint8_t>(len)));
+    ThreadTLV * tlv = MakeRoom(kTlvNetworkName, static_cast<uint8_t>(sizeof(*tlv) + static_cast<uint8_t>(len)));
 
     if (tlv == nullptr)
     {
@@ -405,20 +535,12 @@ CHIP_ERROR OperationalDataset::SetNetworkName(const char * aNetworkName)
 
 CHIP_ERROR OperationalDataset::GetPanId(uint16_t & aPanId) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kPanId);
-
-    if (tlv != nullptr)
-    {
-        tlv->Get16(aPanId);
-        return CHIP_NO_ERROR;
-    }
-
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    return View().GetPanId(aPanId);
 }
 
 CHIP_ERROR OperationalDataset::SetPanId(uint16_t aPanId)
 {
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kPanId, sizeof(*tlv) + sizeof(aPanId));
+    ThreadTLV * tlv = MakeRoom(kTlvPanId, sizeof(*tlv) + sizeof(aPanId));
 
     if (tlv == nullptr)
     {
@@ -434,20 +556,16 @@ CHIP_ERROR OperationalDataset::SetPanId(uint16_t aPanId)
 
 CHIP_ERROR OperationalDataset::GetPSKc(uint8_t (&aPSKc)[kSizePSKc]) const
 {
-    const ThreadTLV * tlv = Locate(ThreadTLV::kPSKc);
-
-    if (tlv != nullptr)
-    {
-        memcpy(aPSKc, tlv->GetValue(), sizeof(aPSKc));
-        return CHIP_NO_ERROR;
-    }
+    ByteSpan pskc;
 
-    return CHIP_ERROR_TLV_TAG_NOT_FOUND;
+    ReturnErrorOnFailure(View().GetPSKc(pskc));
+    memcpy(aPSKc, pskc.data(), pskc.size());
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR OperationalDataset::SetPSKc(const uint8_t (&aPSKc)[kSizePSKc])
 {
-    ThreadTLV * tlv = MakeRoom(ThreadTLV::kPSKc, sizeof(*tlv) + sizeof(aPSKc));
+    ThreadTLV * tlv = MakeRoom(kTlvPSKc, sizeof(*tlv) + sizeof(aPSKc));
 
     if (tlv == nullptr)
     {
@@ -463,36 +581,22 @@ CHIP_ERROR OperationalDataset::SetPSKc(const uint8_t (&aPSKc)[kSizePSKc])
 
 void OperationalDataset::UnsetMasterKey(void)
 {
-    Remove(ThreadTLV::kMasterKey);
+    Remove(kTlvMasterKey);
 }
 
 void OperationalDataset::UnsetPSKc(void)
 {
-    Remove(ThreadTLV::kPSKc);
+    Remove(kTlvPSKc);
 }
 
 bool OperationalDataset::IsCommissioned(void) const
 {
-    return Has(ThreadTLV::kNetworkName) && Has(ThreadTLV::kPanId) && Has(ThreadTLV::kMasterKey) && Has(ThreadTLV::kExtendedPanId) &&
-        Has(ThreadTLV::kChannel);
+    return Has(kTlvNetworkName) && Has(kTlvPanId) && Has(kTlvMasterKey) && Has(kTlvExtendedPanId) && Has(kTlvChannel);
 }
 
 const ThreadTLV * OperationalDataset::Locate(uint8_t aType) const
 {
-    const ThreadTLV * tlv = &Begin();
-    const ThreadTLV * end = &End();
-
-    while (tlv < end)
-    {
-        if (tlv->GetType() == aType)
-            break;
-        else
-            tlv = tlv->GetNext();
-    }
-
-    assert(tlv < reinterpret_cast<const ThreadTLV *>(&mData[sizeof(mData)]));
-
-    return tlv != end ? tlv : nullptr;
+    return LocateTlv(mData, mLength, mTlvIndex, aType);
 }
 
 void OperationalDataset::Remove(ThreadTLV & aThreadTLV)
@@ -503,6 +607,7 @@ void OperationalDataset::Remove(ThreadTLV & aThreadTLV)
     {
         mLength = static_cast<uint8_t>(mLength - aThreadTLV.GetSize());
         memmove(&aThreadTLV, aThreadTLV.GetNext(), mLength - offset);
+        IndexTlvs(mData, mLength, mTlvIndex);
     }
 }
 
@@ -536,6 +641,12 @@ ThreadTLV * OperationalDataset::MakeRoom(uint8_t aType, uint8_t aSize)
         return nullptr;
     }
 
+    // A TLV of the same type further in the dataset, if any, remains the one getters find.
+    if (aType < kSizeTlvIndex && mTlvIndex[aType] == 0)
+    {
+        mTlvIndex[aType] = static_cast<uint8_t>(mLength + 1);
+    }
+
     End().SetType(aType);
 
     return &End();
@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <core/CHIPCore.h>
 #include <platform/internal/DeviceNetworkInfo.h>
@@ -41,9 +42,111 @@ constexpr size_t kSizeMasterKey       = 16;
 constexpr size_t kSizeMeshLocalPrefix = 8;
 constexpr size_t kSizePSKc            = 16;
 
+/**
+ * The MeshCoP TLV types of the Thread operational dataset fields.
+ */
+enum : uint8_t
+{
+    kTlvChannel          = 0,
+    kTlvPanId            = 1,
+    kTlvExtendedPanId    = 2,
+    kTlvNetworkName      = 3,
+    kTlvPSKc             = 4,
+    kTlvMasterKey        = 5,
+    kTlvMeshLocalPrefix  = 7,
+    kTlvSecurityPolicy   = 12,
+    kTlvActiveTimestamp  = 14,
+    kTlvPendingTimestamp = 51,
+    kTlvDelayTimer       = 52,
+    kTlvChannelMask      = 53,
+};
+
+/**
+ * TLVs of types below this value are located through an index of their offsets, others by scanning the dataset.
+ */
+constexpr size_t kSizeTlvIndex = 16;
+
+/**
+ * This function returns the bit of a mask returned by OperationalDatasetView::Diff() for TLVs of type @p aType.
+ * Types 63 and above share the most significant bit.
+ */
+constexpr uint64_t DiffBit(uint8_t aType)
+{
+    return static_cast<uint64_t>(1) << (aType < 63 ? aType : 63);
+}
+
+/**
+ * This class provides read-only access to a Thread operational dataset held in a buffer it does not own.
+ *
+ * The buffer must not change nor be freed while the view is in use.
+ *
+ */
+class OperationalDatasetView
+{
+public:
+    /**
+     * This method initializes the view over the given dataset, which is not copied.
+     *
+     * @param[in]   aData       Thread Operational dataset in octects.
+     *
+     * @retval CHIP_NO_ERROR                Successfully initialized the view.
+     * @retval CHIP_ERROR_INVALID_ARGUMENT  The dataset length @p aLength is too long or @p data is corrupted.
+     *
+     */
+    CHIP_ERROR Init(ByteSpan aData);
+
+    /**
+     * These methods retrieve fields of the dataset.
+     *
+     * Fields with variable-size values are returned as spans of the dataset.
+     *
+     * @retval CHIP_NO_ERROR                    Successfully retrieved the field.
+     * @retval CHIP_ERROR_TLV_TAG_NOT_FOUND     The field is not present in the dataset.
+     * @retval CHIP_ERROR_INVALID_TLV_ELEMENT   The value of the field has an invalid length.
+     *
+     */
+    CHIP_ERROR GetActiveTimestamp(uint64_t & aActiveTimestamp) const;
+    CHIP_ERROR GetChannel(uint16_t & aChannel) const;
+    CHIP_ERROR GetExtendedPanId(ByteSpan & aExtendedPanId) const;
+    CHIP_ERROR GetMasterKey(ByteSpan & aMasterKey) const;
+    CHIP_ERROR GetMeshLocalPrefix(ByteSpan & aMeshLocalPrefix) const;
+    CHIP_ERROR GetNetworkName(CharSpan & aNetworkName) const;
+    CHIP_ERROR GetPanId(uint16_t & aPanId) const;
+    CHIP_ERROR GetPSKc(ByteSpan & aPSKc) const;
+
+    /**
+     * This method checks if the dataset is ready for creating Thread network.
+     *
+     */
+    bool IsCommissioned(void) const;
+
+    /**
+     * This method compares the dataset with @p aOther, e.g. an active dataset with a pending one.
+     *
+     * @returns A mask with DiffBit(type) set for each TLV type present in only one of the datasets, or with
+     *          different values. When a dataset has several TLVs of a type, only the first one is compared.
+     *
+     */
+    uint64_t Diff(const OperationalDatasetView & aOther) const;
+
+    ByteSpan AsByteSpan(void) const { return mData; }
+
+private:
+    friend class OperationalDataset;
+
+    const ThreadTLV * Locate(uint8_t aType) const;
+    uint64_t DiffFirstTlvs(const OperationalDatasetView & aOther, bool aCompareValues) const;
+
+    ByteSpan mData;
+    // Offset + 1 of the first TLV of each type below kSizeTlvIndex, or 0 if there is none.
+    uint8_t mTlvIndex[kSizeTlvIndex] = {};
+};
+
 /**
  * This class provides methods to manipulate Thread operational dataset.
  *
+ * The offsets of the TLVs are indexed when the dataset changes, so that getters do not scan the dataset.
+ *
  */
 class OperationalDataset
 {
@@ -250,7 +353,11 @@ public:
     /**
      * This method clears all data stored in the dataset.
      */
-    void Clear(void) { mLength = 0; }
+    void Clear(void)
+    {
+        mLength = 0;
+        memset(mTlvIndex, 0, sizeof(mTlvIndex));
+    }
 
     /**
      * This method checks if the dataset is ready for creating Thread network.
@@ -268,6 +375,18 @@ public:
 
     ByteSpan AsByteSpan(void) const { return ByteSpan(mData, mLength); }
 
+    /**
+     * This method returns a view of the dataset, valid until the dataset changes.
+     *
+     */
+    OperationalDatasetView View(void) const;
+
+    /**
+     * This method compares the dataset with @p aOther, see OperationalDatasetView::Diff().
+     *
+     */
+    uint64_t Diff(const OperationalDataset & aOther) const { return View().Diff(aOther.View()); }
+
 private:
     ThreadTLV * Locate(uint8_t aType)
     {
@@ -285,6 +404,8 @@ private:
 
     uint8_t mData[kSizeOperationalDataset];
     uint8_t mLength;
+    // See OperationalDatasetView::mTlvIndex.
+    uint8_t mTlvIndex[kSizeTlvIndex];
 };
 
 } // namespace Thread
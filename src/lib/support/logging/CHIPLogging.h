@@ -144,6 +144,38 @@ void SetLogFilter(uint8_t category);
 #define ChipLogDetail(MOD, MSG, ...)
 #endif
 
+/**
+ * @def ChipLogIsEnabled(CAT)
+ *
+ * @brief
+ *   True if a chip message in the category CAT (Error, Progress or
+ *   Detail) would currently be emitted: the category is compiled in and
+ *   not filtered out at run time.
+ *
+ *   Use this to skip formatting arguments, such as peer addresses, that
+ *   are only needed by a log message.
+ *
+ */
+#if CHIP_ERROR_LOGGING
+#define _ChipLogIsEnabled_Error() chip::Logging::IsCategoryEnabled(chip::Logging::kLogCategory_Error)
+#else
+#define _ChipLogIsEnabled_Error() false
+#endif
+
+#if CHIP_PROGRESS_LOGGING
+#define _ChipLogIsEnabled_Progress() chip::Logging::IsCategoryEnabled(chip::Logging::kLogCategory_Progress)
+#else
+#define _ChipLogIsEnabled_Progress() false
+#endif
+
+#if CHIP_DETAIL_LOGGING
+#define _ChipLogIsEnabled_Detail() chip::Logging::IsCategoryEnabled(chip::Logging::kLogCategory_Detail)
+#else
+#define _ChipLogIsEnabled_Detail() false
+#endif
+
+#define ChipLogIsEnabled(CAT) _ChipLogIsEnabled_##CAT()
+
 #if CHIP_ERROR_LOGGING || CHIP_PROGRESS_LOGGING || CHIP_DETAIL_LOGGING
 #define _CHIP_USE_LOGGING 1
 #else
@@ -0,0 +1,131 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <support/DeadlineQueue.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using chip::DeadlineQueue;
+
+void TestInOrder(nlTestSuite * inSuite, void * inContext)
+{
+    DeadlineQueue<uint32_t> queue;
+    uint64_t deadline;
+    uint32_t value;
+
+    NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+    NL_TEST_ASSERT(inSuite, !queue.GetEarliestDeadline(deadline));
+    NL_TEST_ASSERT(inSuite, !queue.PopExpired(UINT64_MAX, value));
+
+    // Enough entries to grow the storage a few times.
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        NL_TEST_ASSERT(inSuite, queue.Push(1000 + i, i) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, queue.Count() == 100);
+    NL_TEST_ASSERT(inSuite, queue.GetEarliestDeadline(deadline) && deadline == 1000);
+
+    // Nothing has expired yet.
+    NL_TEST_ASSERT(inSuite, !queue.PopExpired(999, value));
+
+    uint32_t expected = 0;
+    while (queue.PopExpired(1049, value))
+    {
+        NL_TEST_ASSERT(inSuite, value == expected);
+        expected++;
+    }
+    NL_TEST_ASSERT(inSuite, expected == 50);
+    NL_TEST_ASSERT(inSuite, queue.Count() == 50);
+
+    // Wrap around the ring, then grow it while wrapped.
+    for (uint32_t i = 100; i < 200; i++)
+    {
+        NL_TEST_ASSERT(inSuite, queue.Push(1000 + i, i) == CHIP_NO_ERROR);
+    }
+    while (queue.PopExpired(UINT64_MAX, value))
+    {
+        NL_TEST_ASSERT(inSuite, value == expected);
+        expected++;
+    }
+    NL_TEST_ASSERT(inSuite, expected == 200);
+    NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+}
+
+void TestOutOfOrder(nlTestSuite * inSuite, void * inContext)
+{
+    DeadlineQueue<uint32_t> queue;
+    uint64_t deadline;
+    uint32_t value;
+
+    NL_TEST_ASSERT(inSuite, queue.Push(300, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, queue.Push(100, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, queue.Push(200, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, queue.Push(100, 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, queue.GetEarliestDeadline(deadline) && deadline == 100);
+
+    // Equal deadlines keep the push order.
+    NL_TEST_ASSERT(inSuite, queue.PopExpired(100, value) && value == 2);
+    NL_TEST_ASSERT(inSuite, queue.PopExpired(100, value) && value == 4);
+    NL_TEST_ASSERT(inSuite, !queue.PopExpired(199, value));
+    NL_TEST_ASSERT(inSuite, queue.PopExpired(300, value) && value == 3);
+    NL_TEST_ASSERT(inSuite, queue.PopExpired(300, value) && value == 1);
+    NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+
+    NL_TEST_ASSERT(inSuite, queue.Push(50, 5) == CHIP_NO_ERROR);
+    queue.Clear();
+    NL_TEST_ASSERT(inSuite, queue.IsEmpty());
+    NL_TEST_ASSERT(inSuite, !queue.PopExpired(UINT64_MAX, value));
+}
+
+int Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return FAILURE;
+    return SUCCESS;
+}
+
+int Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF_FN(TestInOrder),    //
+    NL_TEST_DEF_FN(TestOutOfOrder), //
+    NL_TEST_SENTINEL()              //
+};
+
+int TestDeadlineQueue(void)
+{
+    nlTestSuite theSuite = { "CHIP DeadlineQueue tests", &sTests[0], Setup, Teardown };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDeadlineQueue)
@@ -23,6 +23,8 @@
 
 #include <nlunit-test.h>
 
+#include <string.h>
+
 namespace {
 
 void TestSerializableIntegerSet(nlTestSuite * inSuite, void * inContext)
@@ -144,6 +146,122 @@ void TestSerializableIntegerSetSerialize(nlTestSuite * inSuite, void * inContext
     NL_TEST_ASSERT(inSuite, !set.Contains(7));
 }
 
+void TestSerializableIntegerHashSet(nlTestSuite * inSuite, void * inContext)
+{
+    chip::SerializableU64HashSet<64, 2> set;
+    NL_TEST_ASSERT(inSuite, !set.Contains(123));
+    NL_TEST_ASSERT(inSuite, !set.Contains(2));
+
+    NL_TEST_ASSERT(inSuite, set.Insert(123) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, set.Insert(123) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, set.Contains(123));
+    NL_TEST_ASSERT(inSuite, set.Count() == 1);
+
+    // Try inserting empty value
+    NL_TEST_ASSERT(inSuite, set.Insert(2) != CHIP_NO_ERROR);
+
+    set.Remove(123);
+    NL_TEST_ASSERT(inSuite, !set.Contains(123));
+    NL_TEST_ASSERT(inSuite, set.Count() == 0);
+
+    // Fill the set with values sharing their low bits, then remove every other one.
+    for (uint64_t i = 0; i < 64; i++)
+    {
+        NL_TEST_ASSERT(inSuite, set.Insert((i << 32) | 1) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, set.Insert(7) == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, set.Insert(1) == CHIP_NO_ERROR);
+
+    for (uint64_t i = 0; i < 64; i += 2)
+    {
+        set.Remove((i << 32) | 1);
+    }
+    NL_TEST_ASSERT(inSuite, set.Count() == 32);
+
+    for (uint64_t i = 0; i < 64; i++)
+    {
+        NL_TEST_ASSERT(inSuite, set.Contains((i << 32) | 1) == (i % 2 == 1));
+    }
+
+    set.Clear();
+    NL_TEST_ASSERT(inSuite, set.Count() == 0);
+    NL_TEST_ASSERT(inSuite, !set.Contains(1));
+}
+
+void TestSerializableIntegerHashSetSerialize(nlTestSuite * inSuite, void * inContext)
+{
+    chip::SerializableU64HashSet<16> set;
+
+    for (uint64_t i = 1; i <= 12; i++)
+    {
+        NL_TEST_ASSERT(inSuite, set.Insert(0x1000 + i * 3) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, set.Insert(UINT64_MAX) == CHIP_NO_ERROR);
+
+    char * buf    = nullptr;
+    uint16_t size = 0;
+
+    NL_TEST_ASSERT(inSuite, set.SerializeBase64(buf, size) == nullptr);
+    NL_TEST_ASSERT(inSuite, size == set.SerializedSize());
+
+    chip::Platform::ScopedMemoryString buf1("", size);
+    NL_TEST_ASSERT(inSuite, set.SerializeBase64(buf1.Get(), size) == buf1.Get());
+    NL_TEST_ASSERT(inSuite, buf1.Get()[0] == chip::SerializableU64HashSetBase::kCompactFormatPrefix);
+    NL_TEST_ASSERT(inSuite, strlen(buf1.Get()) == size);
+
+    // Sorted small deltas take a byte or two each, instead of eight.
+    NL_TEST_ASSERT(inSuite, size < CHIP_MAX_SERIALIZED_SIZE_U64(13) / 2);
+
+    chip::SerializableU64HashSet<16> set2;
+    NL_TEST_ASSERT(inSuite, set2.Insert(5) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, set2.DeserializeBase64(buf1.Get(), static_cast<uint16_t>(size + 1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, set2.Count() == 13);
+    NL_TEST_ASSERT(inSuite, !set2.Contains(5));
+    for (uint64_t i = 1; i <= 12; i++)
+    {
+        NL_TEST_ASSERT(inSuite, set2.Contains(0x1000 + i * 3));
+    }
+    NL_TEST_ASSERT(inSuite, set2.Contains(UINT64_MAX));
+
+    // An empty set round trips.
+    chip::SerializableU64HashSet<16> emptySet;
+    char emptyBuf[8];
+    size = sizeof(emptyBuf);
+    NL_TEST_ASSERT(inSuite, emptySet.SerializeBase64(emptyBuf, size) == emptyBuf);
+    NL_TEST_ASSERT(inSuite, size == 1);
+    NL_TEST_ASSERT(inSuite, set2.DeserializeBase64(emptyBuf, size) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, set2.Count() == 0);
+
+    // Truncated varints and sets larger than the capacity are rejected.
+    NL_TEST_ASSERT(inSuite, set2.DeserializeBase64("~gA==", 5) != CHIP_NO_ERROR);
+    chip::SerializableU64HashSet<4> smallSet;
+    NL_TEST_ASSERT(inSuite, smallSet.DeserializeBase64(buf1.Get(), static_cast<uint16_t>(strlen(buf1.Get()))) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, smallSet.Count() == 0);
+}
+
+void TestSerializableIntegerHashSetReadsArrayFormat(nlTestSuite * inSuite, void * inContext)
+{
+    chip::SerializableU64Set<8> set;
+
+    for (uint64_t i = 1; i <= 6; i++)
+    {
+        NL_TEST_ASSERT(inSuite, set.Insert(i * 0x0101010101ULL) == CHIP_NO_ERROR);
+    }
+    set.Remove(3 * 0x0101010101ULL);
+
+    uint16_t size = set.SerializedSize();
+    chip::Platform::ScopedMemoryString buf("", size);
+    NL_TEST_ASSERT(inSuite, set.SerializeBase64(buf.Get(), size) == buf.Get());
+
+    chip::SerializableU64HashSet<8> hashSet;
+    NL_TEST_ASSERT(inSuite, hashSet.DeserializeBase64(buf.Get(), static_cast<uint16_t>(size + 1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, hashSet.Count() == 5);
+    for (uint64_t i = 1; i <= 6; i++)
+    {
+        NL_TEST_ASSERT(inSuite, hashSet.Contains(i * 0x0101010101ULL) == (i != 3));
+    }
+}
+
 int Setup(void * inContext)
 {
     CHIP_ERROR error = chip::Platform::MemoryInit();
@@ -165,10 +283,13 @@ int Teardown(void * inContext)
  *   Test Suite. It lists all the test functions.
  */
 static const nlTest sTests[] = {
-    NL_TEST_DEF_FN(TestSerializableIntegerSet),          //
-    NL_TEST_DEF_FN(TestSerializableIntegerSetNonZero),   //
-    NL_TEST_DEF_FN(TestSerializableIntegerSetSerialize), //
-    NL_TEST_SENTINEL()                                   //
+    NL_TEST_DEF_FN(TestSerializableIntegerSet),                     //
+    NL_TEST_DEF_FN(TestSerializableIntegerSetNonZero),              //
+    NL_TEST_DEF_FN(TestSerializableIntegerSetSerialize),            //
+    NL_TEST_DEF_FN(TestSerializableIntegerHashSet),                 //
+    NL_TEST_DEF_FN(TestSerializableIntegerHashSetSerialize),        //
+    NL_TEST_DEF_FN(TestSerializableIntegerHashSetReadsArrayFormat), //
+    NL_TEST_SENTINEL()                                              //
 };
 
 int TestSerializableIntegerSet(void)
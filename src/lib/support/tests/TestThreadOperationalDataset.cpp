@@ -177,6 +177,81 @@ void TestUnsetPSKc(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, dataset.SetPSKc(pskc) == CHIP_NO_ERROR);
 }
 
+void TestView(nlTestSuite * inSuite, void * inContext)
+{
+    Thread::OperationalDataset & dataset = *static_cast<Thread::OperationalDataset *>(inContext);
+    Thread::OperationalDatasetView view;
+
+    NL_TEST_ASSERT(inSuite, view.Init(dataset.AsByteSpan()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, view.AsByteSpan().data() == dataset.AsByteSpan().data());
+    NL_TEST_ASSERT(inSuite, view.IsCommissioned());
+
+    {
+        uint8_t extendedPanId[Thread::kSizeExtendedPanId];
+        ByteSpan extendedPanIdSpan;
+
+        NL_TEST_ASSERT(inSuite, dataset.GetExtendedPanId(extendedPanId) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, view.GetExtendedPanId(extendedPanIdSpan) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, extendedPanIdSpan.size() == sizeof(extendedPanId));
+        NL_TEST_ASSERT(inSuite, memcmp(extendedPanIdSpan.data(), extendedPanId, sizeof(extendedPanId)) == 0);
+    }
+
+    {
+        CharSpan networkName;
+
+        NL_TEST_ASSERT(inSuite, dataset.View().GetNetworkName(networkName) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, networkName.size() == 16 && memcmp(networkName.data(), "0123456789abcdef", 16) == 0);
+    }
+
+    {
+        uint8_t data[] = { Thread::kTlvPanId, 1, 0x12 };
+        uint16_t panid;
+
+        NL_TEST_ASSERT(inSuite, view.Init(ByteSpan(data)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, view.GetPanId(panid) == CHIP_ERROR_INVALID_TLV_ELEMENT);
+        NL_TEST_ASSERT(inSuite, view.GetChannel(panid) == CHIP_ERROR_TLV_TAG_NOT_FOUND);
+        NL_TEST_ASSERT(inSuite, view.Init(ByteSpan(data, 2)) == CHIP_ERROR_INVALID_ARGUMENT);
+    }
+}
+
+void TestDiff(nlTestSuite * inSuite, void * inContext)
+{
+    Thread::OperationalDataset & active = *static_cast<Thread::OperationalDataset *>(inContext);
+    Thread::OperationalDataset pending{};
+    uint8_t pendingData[Thread::kSizeOperationalDataset];
+    size_t pendingLength = active.AsByteSpan().size();
+
+    static constexpr uint8_t kPendingTlvs[] = {
+        Thread::kTlvPendingTimestamp, 8, 0, 0, 0, 0, 0, 0, 0, 2, //
+        Thread::kTlvDelayTimer, 4, 0, 0, 0x75, 0x30,             //
+    };
+
+    memcpy(pendingData, active.AsByteSpan().data(), pendingLength);
+    NL_TEST_ASSERT(inSuite, pending.Init(ByteSpan(pendingData, pendingLength)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, active.Diff(pending) == 0);
+
+    memcpy(&pendingData[pendingLength], kPendingTlvs, sizeof(kPendingTlvs));
+    pendingLength += sizeof(kPendingTlvs);
+    NL_TEST_ASSERT(inSuite, pending.Init(ByteSpan(pendingData, pendingLength)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pending.SetChannel(20) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pending.SetActiveTimestamp(2) == CHIP_NO_ERROR);
+
+    const uint64_t expected = Thread::DiffBit(Thread::kTlvChannel) | Thread::DiffBit(Thread::kTlvActiveTimestamp) |
+        Thread::DiffBit(Thread::kTlvPendingTimestamp) | Thread::DiffBit(Thread::kTlvDelayTimer);
+    NL_TEST_ASSERT(inSuite, active.Diff(pending) == expected);
+    NL_TEST_ASSERT(inSuite, pending.Diff(active) == expected);
+
+    // Setting the same values back only leaves the pending-only TLVs.
+    uint16_t channel;
+    uint64_t activeTimestamp;
+    NL_TEST_ASSERT(inSuite, active.GetChannel(channel) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, active.GetActiveTimestamp(activeTimestamp) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pending.SetChannel(channel) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pending.SetActiveTimestamp(activeTimestamp) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, active.Diff(pending) == (expected & ~(Thread::DiffBit(Thread::kTlvChannel) |
+                                                                  Thread::DiffBit(Thread::kTlvActiveTimestamp))));
+}
+
 void TestClear(nlTestSuite * inSuite, void * inContext)
 {
     Thread::OperationalDataset & dataset = *static_cast<Thread::OperationalDataset *>(inContext);
@@ -276,6 +351,8 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestPSKc", TestPSKc),                       //
     NL_TEST_DEF("TestUnsetMasterKey", TestUnsetMasterKey),   //
     NL_TEST_DEF("TestUnsetPSKc", TestUnsetPSKc),             //
+    NL_TEST_DEF("TestView", TestView),                       //
+    NL_TEST_DEF("TestDiff", TestDiff),                       //
     NL_TEST_DEF("TestClear", TestClear),                     //
     NL_TEST_SENTINEL()                                       //
 };
@@ -58,6 +58,11 @@ public:
     static bool ValidateCheckChar(const char * str);
     static bool ValidateCheckChar(const char * str, size_t strLen);
 
+    // Verify the check characters at the end of count strings of strLen characters each, stored stride bytes apart.
+    // Stores the result for each string in results, if given, and returns the number of valid strings. When built
+    // with VERHOEFF10_COMBINED_TABLES, the time taken depends only on strLen and count, not on the content of the strings.
+    static size_t ValidateCheckChars(const char * strs, size_t strLen, size_t stride, size_t count, bool * results = nullptr);
+
     // Convert between a character and its corresponding value.
     static int CharToVal(char ch);
     static char ValToChar(int val);
@@ -28,7 +28,7 @@
 #include <stdint.h>
 #include <string.h>
 
-#ifndef VERHOEFF10_NO_MULTIPLY_TABLE
+#if !defined(VERHOEFF10_NO_MULTIPLY_TABLE) && !defined(VERHOEFF10_COMBINED_TABLES)
 
 uint8_t Verhoeff10::sMultiplyTable[] = {
     0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 1, 2, 3, 4, 0, 6, 7, 8, 9, 5, 2, 3, 4, 0, 1, 7, 8, 9, 5, 6, 3, 4, 0, 1,
@@ -40,6 +40,99 @@ uint8_t Verhoeff10::sMultiplyTable[] = {
 
 uint8_t Verhoeff10::sPermTable[] = { 1, 5, 7, 6, 2, 8, 3, 0, 9, 4 };
 
+// VERHOEFF10_COMBINED_TABLES replaces the 100 byte multiply table with about 4.8 KB of precomputed
+// tables that fold two digits per lookup. It is meant for hosts and bulk tools, where speed matters
+// more than size.
+#ifdef VERHOEFF10_COMBINED_TABLES
+
+namespace {
+
+// The permutation applied to a digit repeats every 8 positions, so the permutation and the dihedral
+// multiply for a digit at any position can be folded into a single lookup keyed by the position modulo 8.
+constexpr int kPermPeriod = 8;
+
+constexpr uint8_t kPermTable[Verhoeff10::Base] = { 1, 5, 7, 6, 2, 8, 3, 0, 9, 4 };
+
+constexpr int DihedralMultiply5(int x, int y)
+{
+    constexpr int n = Verhoeff10::PolygonSize;
+    if (x < n)
+        return (y < n) ? (x + y) % n : ((x + (y - n)) % n) + n;
+    return (y < n) ? ((n + (x - n) - y) % n) + n : (n + (x - n) - (y - n)) % n;
+}
+
+constexpr int Permute(int val, int iterCount)
+{
+    for (int i = 0; i < iterCount; i++)
+        val = kPermTable[val];
+    return val;
+}
+
+struct CombinedTables
+{
+    // Check value after multiplying check value c by digit d at position p: digit[p][c][d]
+    uint8_t digit[kPermPeriod][Verhoeff10::Base][Verhoeff10::Base];
+    // Check value after multiplying check value c by digit d0 at even position 2q and digit d1 at
+    // position 2q + 1: pair[q][c][d0 * 10 + d1]
+    uint8_t pair[kPermPeriod / 2][Verhoeff10::Base][Verhoeff10::Base * Verhoeff10::Base];
+};
+
+constexpr CombinedTables MakeCombinedTables()
+{
+    CombinedTables tables = {};
+    for (int p = 0; p < kPermPeriod; p++)
+        for (int c = 0; c < Verhoeff10::Base; c++)
+            for (int d = 0; d < Verhoeff10::Base; d++)
+                tables.digit[p][c][d] = static_cast<uint8_t>(DihedralMultiply5(c, Permute(d, p)));
+    for (int q = 0; q < kPermPeriod / 2; q++)
+        for (int c = 0; c < Verhoeff10::Base; c++)
+            for (int d0 = 0; d0 < Verhoeff10::Base; d0++)
+                for (int d1 = 0; d1 < Verhoeff10::Base; d1++)
+                    tables.pair[q][c][d0 * Verhoeff10::Base + d1] = static_cast<uint8_t>(
+                        DihedralMultiply5(DihedralMultiply5(c, Permute(d0, 2 * q)), Permute(d1, 2 * q + 1)));
+    return tables;
+}
+
+constexpr CombinedTables sTables = MakeCombinedTables();
+
+// Returns the value of a decimal digit, or 0 for any other character, in which case invalid is set.
+inline uint8_t DigitVal(char ch, uint8_t & invalid)
+{
+    uint8_t val = static_cast<uint8_t>(ch - '0');
+    uint8_t bad = static_cast<uint8_t>(val > 9);
+    invalid     = static_cast<uint8_t>(invalid | bad);
+    return static_cast<uint8_t>(val & (bad - 1));
+}
+
+// Folds the check value of str, whose right-most character is at position pos, without branching on
+// its content. Any non-digit character sets invalid.
+inline uint8_t Accumulate(const char * str, size_t strLen, size_t pos, uint8_t & invalid)
+{
+    uint8_t c = 0;
+
+    if ((pos & 1) != 0 && strLen > 0)
+    {
+        c = sTables.digit[pos % kPermPeriod][c][DigitVal(str[--strLen], invalid)];
+        pos++;
+    }
+
+    for (; strLen >= 2; strLen -= 2, pos += 2)
+    {
+        uint8_t d0 = DigitVal(str[strLen - 1], invalid);
+        uint8_t d1 = DigitVal(str[strLen - 2], invalid);
+        c          = sTables.pair[(pos % kPermPeriod) / 2][c][d0 * Verhoeff10::Base + d1];
+    }
+
+    if (strLen > 0)
+        c = sTables.digit[pos % kPermPeriod][c][DigitVal(str[0], invalid)];
+
+    return c;
+}
+
+} // namespace
+
+#endif // VERHOEFF10_COMBINED_TABLES
+
 char Verhoeff10::ComputeCheckChar(const char * str)
 {
     return ComputeCheckChar(str, strlen(str));
@@ -47,6 +140,13 @@ char Verhoeff10::ComputeCheckChar(const char * str)
 
 char Verhoeff10::ComputeCheckChar(const char * str, size_t strLen)
 {
+#ifdef VERHOEFF10_COMBINED_TABLES
+    // The check character will occupy position 0, so the last character of str is at position 1.
+    uint8_t invalid = 0;
+    int c           = Accumulate(str, strLen, 1, invalid);
+    if (invalid)
+        return 0; // invalid character
+#else
     int c = 0;
 
     for (size_t i = 1; i <= strLen; i++)
@@ -65,6 +165,7 @@ char Verhoeff10::ComputeCheckChar(const char * str, size_t strLen)
         c = sMultiplyTable[c * Base + p];
 #endif
     }
+#endif
 
     c = Verhoeff::DihedralInvert(c, PolygonSize);
 
@@ -90,7 +191,68 @@ bool Verhoeff10::ValidateCheckChar(const char * str, size_t strLen)
 {
     if (strLen == 0)
         return false;
+#ifdef VERHOEFF10_COMBINED_TABLES
+    // A string ending in its check character folds to a check value of 0.
+    uint8_t invalid = 0;
+    return (Accumulate(str, strLen, 0, invalid) | invalid) == 0;
+#else
     return ValidateCheckChar(str[strLen - 1], str, strLen - 1);
+#endif
+}
+
+size_t Verhoeff10::ValidateCheckChars(const char * strs, size_t strLen, size_t stride, size_t count, bool * results)
+{
+    size_t validCount = 0;
+    size_t i          = 0;
+
+#ifdef VERHOEFF10_COMBINED_TABLES
+    // Fold several strings at once; their lookups are independent, so they overlap in the pipeline
+    // rather than each waiting on the previous one.
+    constexpr size_t kLanes = 4;
+
+    for (; strLen > 0 && i + kLanes <= count; i += kLanes)
+    {
+        const char * str[kLanes];
+        uint8_t c[kLanes]       = {};
+        uint8_t invalid[kLanes] = {};
+        size_t len              = strLen;
+        size_t pos              = 0;
+
+        for (size_t lane = 0; lane < kLanes; lane++)
+            str[lane] = strs + (i + lane) * stride;
+
+        for (; len >= 2; len -= 2, pos += 2)
+        {
+            for (size_t lane = 0; lane < kLanes; lane++)
+            {
+                uint8_t d0 = DigitVal(str[lane][len - 1], invalid[lane]);
+                uint8_t d1 = DigitVal(str[lane][len - 2], invalid[lane]);
+                c[lane]    = sTables.pair[(pos % kPermPeriod) / 2][c[lane]][d0 * Base + d1];
+            }
+        }
+
+        for (size_t lane = 0; lane < kLanes; lane++)
+        {
+            if (len > 0)
+                c[lane] = sTables.digit[pos % kPermPeriod][c[lane]][DigitVal(str[lane][0], invalid[lane])];
+
+            bool valid = (c[lane] | invalid[lane]) == 0;
+            validCount += valid;
+            if (results != nullptr)
+                results[i + lane] = valid;
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        bool valid = ValidateCheckChar(strs + i * stride, strLen);
+        validCount += valid;
+        if (results != nullptr)
+            results[i] = valid;
+    }
+
+    return validCount;
 }
 
 int Verhoeff10::CharToVal(char ch)
@@ -184,7 +184,7 @@
  * critical regions during buffer allocation, deallocation and memory
  * allocation and deallocation.
  */
-#define SYS_LIGHTWEIGHT_PROT (0)
+#define SYS_LIGHTWEIGHT_PROT (1)
 
 /**
  * TCPIP_THREAD_STACKSIZE: The stack size used by the main tcpip thread.
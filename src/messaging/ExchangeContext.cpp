@@ -76,6 +76,26 @@ void ExchangeContext::SetResponseTimeout(Timeout timeout)
     mResponseTimeout = timeout;
 }
 
+CHIP_ERROR ExchangeContext::ExpectResponse()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrReturnError(!IsResponseExpected(), CHIP_ERROR_INCORRECT_STATE);
+
+    SetResponseExpected(true);
+
+    if (mResponseTimeout > 0)
+    {
+        err = StartResponseTimer();
+        if (err != CHIP_NO_ERROR)
+        {
+            SetResponseExpected(false);
+        }
+    }
+
+    return err;
+}
+
 CHIP_ERROR ExchangeContext::SendMessage(Protocols::Id protocolId, uint8_t msgType, PacketBufferHandle msgBuf,
                                         const SendFlags & sendFlags)
 {
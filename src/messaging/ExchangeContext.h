@@ -167,6 +167,15 @@ public:
 
     void SetResponseTimeout(Timeout timeout);
 
+    /**
+     *  Wait for a further message on this exchange, as if a message with the kExpectResponse flag had just been sent.
+     *  The response timer is armed if a response timeout has been set.
+     *
+     *  @retval  #CHIP_ERROR_INCORRECT_STATE                if a response is already expected on this exchange.
+     *  @retval  #CHIP_NO_ERROR                             on success.
+     */
+    CHIP_ERROR ExpectResponse();
+
 private:
     Timeout mResponseTimeout; // Maximum time to wait for response (in milliseconds); 0 disables response timeout.
     ExchangeDelegateBase * mDelegate = nullptr;
@@ -375,10 +375,13 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & header, const Trans
     auto peer = header.GetSourceNodeId();
     if (!peer.HasValue())
     {
-        char addrBuffer[Transport::PeerAddress::kMaxToStringSize];
-        source.ToString(addrBuffer, sizeof(addrBuffer));
-        ChipLogError(ExchangeManager, "Unencrypted message from %s is dropped since no source node id in packet header.",
-                     addrBuffer);
+        if (ChipLogIsEnabled(Error))
+        {
+            char addrBuffer[Transport::PeerAddress::kMaxToStringSize];
+            source.ToString(addrBuffer, sizeof(addrBuffer));
+            ChipLogError(ExchangeManager, "Unencrypted message from %s is dropped since no source node id in packet header.",
+                         addrBuffer);
+        }
         return;
     }
 }
@@ -32,12 +32,13 @@
 #include <support/BitFlags.h>
 #include <support/CHIPFaultInjection.h>
 #include <support/CodeUtils.h>
+#include <support/SafeInt.h>
 #include <support/logging/CHIPLogging.h>
 
 namespace chip {
 namespace Messaging {
 
-ReliableMessageMgr::RetransTableEntry::RetransTableEntry() : rc(nullptr), nextRetransTimeTick(0), sendCount(0) {}
+ReliableMessageMgr::RetransTableEntry::RetransTableEntry() : rc(nullptr), sendTime(0), nextRetransTimeTick(0), sendCount(0) {}
 
 ReliableMessageMgr::ReliableMessageMgr(std::array<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
     mContextPool(contextPool), mSystemLayer(nullptr), mSessionMgr(nullptr), mCurrentTimerExpiry(0),
@@ -287,6 +288,7 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
     VerifyOrDie(entry != nullptr && entry->rc != nullptr);
 
+    entry->sendTime            = System::Layer::GetClock_MonotonicHiRes();
     entry->nextRetransTimeTick = static_cast<uint16_t>(entry->rc->GetInitialRetransmitTimeoutTick() +
                                                        GetTickCounterFromTimeDelta(System::Timer::GetCurrentEpoch()));
 
@@ -324,6 +326,12 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     {
         if ((entry.rc == rc) && entry.retainedBuf.GetMsgId() == ackMsgId)
         {
+            // An ack for a retransmitted message may be for any of its copies, so only first transmissions are timed.
+            if (entry.sendCount == 0)
+            {
+                UpdateRoundTripTime(entry);
+            }
+
             // Clear the entry from the retransmision table.
             ClearRetransTable(entry);
 
@@ -337,6 +345,22 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     return false;
 }
 
+void ReliableMessageMgr::UpdateRoundTripTime(const RetransTableEntry & entry)
+{
+    VerifyOrReturn(mSessionMgr != nullptr);
+
+    const SecureSessionHandle session      = entry.rc->GetExchangeContext()->GetSecureSession();
+    Transport::PeerConnectionState * state = mSessionMgr->GetPeerConnectionState(session);
+    VerifyOrReturn(state != nullptr);
+
+    // The ack is the message being received, so the session's last receive time is when it reached the host.
+    const uint64_t ackTime = state->GetLastReceiveTime();
+    VerifyOrReturn(ackTime > entry.sendTime);
+
+    const uint64_t roundTripTime = ackTime - entry.sendTime;
+    state->AddRoundTripTimeSample(CanCastTo<uint32_t>(roundTripTime) ? static_cast<uint32_t>(roundTripTime) : UINT32_MAX);
+}
+
 CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
 {
     CHIP_ERROR err              = CHIP_NO_ERROR;
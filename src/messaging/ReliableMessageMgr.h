@@ -61,6 +61,7 @@ public:
 
         ReliableMessageContext * rc;             /**< The context for the stored CHIP message. */
         EncryptedPacketBufferHandle retainedBuf; /**< The packet buffer holding the CHIP message. */
+        uint64_t sendTime;                       /**< When the message was first sent, in GetClock_MonotonicHiRes() time. */
         uint16_t nextRetransTimeTick;            /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                       /**< A counter representing the number of times the message has been sent. */
     };
@@ -149,6 +150,9 @@ public:
      *  Iterate through active exchange contexts and retrans table entries. Clear the entry matching
      *  the specified ExchangeContext and the message ID from the retransmision table.
      *
+     *  If the message was never retransmitted, the time from sending it to the arrival of the ack
+     *  is added to the round trip time estimate of the exchange's session.
+     *
      *  @param[in]    rc        A pointer to the ExchangeContext object.
      *
      *  @param[in]    msgId     message ID which has been acked.
@@ -223,6 +227,8 @@ public:
     void TestSetIntervalShift(uint16_t value) { mTimerIntervalShift = value; }
 
 private:
+    void UpdateRoundTripTime(const RetransTableEntry & entry);
+
     std::array<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
     SecureSessionMgr * mSessionMgr;
@@ -167,6 +167,27 @@ void CheckExchangeMessages(nlTestSuite * inSuite, void * inContext)
     ec1->Close();
 }
 
+void CheckExpectResponseTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err;
+    MockAppDelegate mockAppDelegate;
+
+    ExchangeContext * ec = ctx.NewExchangeToLocal(&mockAppDelegate);
+    NL_TEST_ASSERT(inSuite, ec != nullptr);
+    ec->SetResponseTimeout(1000);
+
+    err = ec->ExpectResponse();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Only one response can be awaited at a time.
+    err = ec->ExpectResponse();
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INCORRECT_STATE);
+
+    ec->Close();
+}
+
 // Test Suite
 
 /**
@@ -178,6 +199,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test ExchangeMgr::NewContext",               CheckNewContextTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckUmhRegistrationTest", CheckUmhRegistrationTest),
     NL_TEST_DEF("Test ExchangeMgr::CheckExchangeMessages",    CheckExchangeMessages),
+    NL_TEST_DEF("Test ExchangeMgr::CheckExpectResponseTest",  CheckExpectResponseTest),
 
     NL_TEST_SENTINEL()
 };
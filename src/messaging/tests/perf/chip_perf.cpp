@@ -0,0 +1,533 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements chip-perf, a performance harness that runs
+ *      Echo and Interaction Model read workloads between an initiator and
+ *      a responder living in the same process, and reports throughput,
+ *      latency and memory high-water marks.
+ *
+ *      The harness uses the System::Layer, PacketBuffer and UDPEndPoint
+ *      of whichever network configuration it is built for, so running
+ *      the sockets and LwIP builds side by side compares the two.  Under
+ *      LwIP, traffic flows through the stack's loopback netif and no
+ *      TUN/TAP device is needed.
+ *
+ */
+
+#include <algorithm>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <vector>
+
+#include <CHIPVersion.h>
+
+#include <app/InteractionModelEngine.h>
+#include <core/CHIPCore.h>
+#include <messaging/ExchangeMgr.h>
+#include <protocols/echo/Echo.h>
+#include <protocols/secure_channel/PASESession.h>
+#include <support/CHIPArgParser.hpp>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
+#include <transport/AdminPairingTable.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/UDP.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/stats.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+
+#include <inet/tests/TestInetCommon.h>
+#include <inet/tests/TestInetCommonOptions.h>
+
+using namespace chip;
+using namespace chip::ArgParser;
+
+#define kToolName "chip-perf"
+
+namespace {
+
+constexpr ClusterId kPerfClusterId   = 6;
+constexpr EndpointId kPerfEndpointId = 1;
+constexpr FieldId kPerfFieldId       = 1;
+
+// The initiator and responder share a single SecureSessionMgr, so each side of the session gets its own admin and key.
+// ReadClient always addresses its peer with key 0, which makes that the responder's local key.
+constexpr Transport::AdminId kInitiatorAdminId = 0;
+constexpr Transport::AdminId kResponderAdminId = 1;
+constexpr uint16_t kInitiatorKeyId             = 1;
+constexpr uint16_t kResponderKeyId             = 0;
+
+constexpr uint32_t kCountDefault       = 1000;
+constexpr uint32_t kPayloadSizeDefault = 64;
+constexpr uint32_t kTimeoutMsDefault   = 5000;
+
+enum
+{
+    kToolOptCount       = 'c',
+    kToolOptPayloadSize = 's',
+    kToolOptTimeout     = 't',
+    kToolOptWorkload    = 'w',
+};
+
+enum
+{
+    kWorkloadEcho = 0x01,
+    kWorkloadRead = 0x02,
+    kWorkloadAll  = kWorkloadEcho | kWorkloadRead,
+};
+
+uint32_t sCount       = kCountDefault;
+uint32_t sPayloadSize = kPayloadSizeDefault;
+uint32_t sTimeoutMs   = kTimeoutMsDefault;
+uint8_t sWorkloads    = kWorkloadAll;
+
+/**
+ * The progress of one workload: requests are issued one at a time and the round trip time of each one is recorded.
+ */
+struct Workload
+{
+    const char * mName;
+    uint32_t mSent;
+    uint32_t mCompleted;
+    uint64_t mStartTimeUs;
+    uint64_t mSendTimeUs;
+    uint64_t mEndTimeUs;
+    bool mInFlight;
+    bool mFailed;
+    std::vector<uint32_t> mLatenciesUs;
+};
+
+Workload sEchoWorkload = { "echo" };
+Workload sReadWorkload = { "read" };
+
+TransportMgr<Transport::UDP> sTransportManager;
+SecureSessionMgr sSessionManager;
+Messaging::ExchangeManager sExchangeManager;
+Transport::AdminPairingTable sAdmins;
+SecurePairingUsingTestSecret sInitiatorPairing(kResponderKeyId, kInitiatorKeyId);
+SecurePairingUsingTestSecret sResponderPairing(kInitiatorKeyId, kResponderKeyId);
+Protocols::Echo::EchoClient sEchoClient;
+Protocols::Echo::EchoServer sEchoServer;
+app::ReadClient * sReadClient = nullptr;
+
+// Both network stacks are timed with the host's monotonic clock: the LwIP system layer only keeps time in milliseconds.
+uint64_t Now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * UINT64_C(1000000) + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+void CompleteRequest(Workload & aWorkload, bool aSucceeded)
+{
+    uint64_t now = Now();
+
+    VerifyOrReturn(aWorkload.mInFlight);
+    aWorkload.mInFlight = false;
+
+    if (!aSucceeded)
+    {
+        aWorkload.mFailed = true;
+        return;
+    }
+
+    aWorkload.mLatenciesUs.push_back(static_cast<uint32_t>(now - aWorkload.mSendTimeUs));
+    aWorkload.mCompleted++;
+    aWorkload.mEndTimeUs = now;
+}
+
+void HandleEchoResponseReceived(Messaging::ExchangeContext * ec, System::PacketBufferHandle payload)
+{
+    CompleteRequest(sEchoWorkload, payload->DataLength() == sPayloadSize);
+}
+
+class PerfInteractionModelDelegate : public app::InteractionModelDelegate
+{
+public:
+    CHIP_ERROR ReportProcessed(const app::ReadClient * apReadClient) override
+    {
+        CompleteRequest(sReadWorkload, true);
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR ReportError(const app::ReadClient * apReadClient, CHIP_ERROR aError) override
+    {
+        printf("%s: read failed: %s\n", kToolName, ErrorStr(aError));
+        CompleteRequest(sReadWorkload, false);
+        return CHIP_NO_ERROR;
+    }
+};
+
+PerfInteractionModelDelegate sInteractionModelDelegate;
+
+CHIP_ERROR SendEchoRequest()
+{
+    System::PacketBufferHandle payload = MessagePacketBuffer::New(sPayloadSize);
+    VerifyOrReturnError(!payload.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    memset(payload->Start(), 0xA5, sPayloadSize);
+    payload->SetDataLength(static_cast<uint16_t>(sPayloadSize));
+
+    return sEchoClient.SendEchoRequest(std::move(payload), Messaging::SendFlags(Messaging::SendMessageFlags::kNone));
+}
+
+CHIP_ERROR SendReadRequest()
+{
+    app::AttributePathParams attributePathParams(kTestDeviceNodeId, kPerfEndpointId, kPerfClusterId, kPerfFieldId, 0,
+                                                 app::AttributePathFlags::kFieldIdValid);
+
+    return sReadClient->SendReadRequest(kTestDeviceNodeId, kInitiatorAdminId, nullptr, 0, &attributePathParams, 1);
+}
+
+bool RunWorkload(Workload & aWorkload, CHIP_ERROR (*aSendRequest)())
+{
+    uint64_t lastProgressMs = gSystemLayer.GetClock_MonotonicMS();
+
+    aWorkload.mLatenciesUs.reserve(sCount);
+    aWorkload.mStartTimeUs = Now();
+
+    while (!aWorkload.mFailed && aWorkload.mCompleted < sCount)
+    {
+        struct timeval sleepTime;
+
+        if (!aWorkload.mInFlight)
+        {
+            aWorkload.mInFlight   = true;
+            aWorkload.mSendTimeUs = Now();
+
+            CHIP_ERROR err = aSendRequest();
+            if (err != CHIP_NO_ERROR)
+            {
+                printf("%s: %s request %" PRIu32 " failed: %s\n", kToolName, aWorkload.mName, aWorkload.mSent, ErrorStr(err));
+                aWorkload.mFailed = true;
+                break;
+            }
+
+            aWorkload.mSent++;
+            lastProgressMs = gSystemLayer.GetClock_MonotonicMS();
+        }
+
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+
+        ServiceNetwork(sleepTime);
+
+        if (aWorkload.mInFlight && gSystemLayer.GetClock_MonotonicMS() - lastProgressMs >= sTimeoutMs)
+        {
+            printf("%s: %s request %" PRIu32 " timed out\n", kToolName, aWorkload.mName, aWorkload.mSent);
+            aWorkload.mFailed = true;
+        }
+    }
+
+    return !aWorkload.mFailed;
+}
+
+void ReportWorkload(const Workload & aWorkload, uint32_t aRequestBytes)
+{
+    std::vector<uint32_t> latencies = aWorkload.mLatenciesUs;
+    uint64_t totalUs                = 0;
+    double elapsed;
+
+    VerifyOrReturn(!latencies.empty());
+
+    std::sort(latencies.begin(), latencies.end());
+    for (uint32_t latency : latencies)
+    {
+        totalUs += latency;
+    }
+
+    elapsed = static_cast<double>(aWorkload.mEndTimeUs - aWorkload.mStartTimeUs) / 1000000;
+
+    printf("%s: %" PRIu32 " requests in %.3f s, %.1f req/s", aWorkload.mName, aWorkload.mCompleted, elapsed,
+           aWorkload.mCompleted / elapsed);
+    if (aRequestBytes != 0)
+    {
+        printf(", %.1f KiB/s", static_cast<double>(aWorkload.mCompleted) * aRequestBytes / 1024 / elapsed);
+    }
+    printf("\n");
+
+    printf("%s: latency us min %" PRIu32 " avg %" PRIu64 " p50 %" PRIu32 " p99 %" PRIu32 " max %" PRIu32 "\n", aWorkload.mName,
+           latencies.front(), totalUs / latencies.size(), latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+           latencies.back());
+}
+
+void ReportMemory()
+{
+    struct rusage usage;
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    const System::Stats::Label * labels = System::Stats::GetStrings();
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
+    System::Stats::UpdateLwipPbufCounts();
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
+
+    for (int i = 0; i < System::Stats::kNumEntries; i++)
+    {
+        printf("high-water: %s %" PRI_CHIP_SYS_STATS_COUNT "\n", labels[i], System::Stats::GetHighWatermarks()[i]);
+    }
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS
+#if MEM_STATS
+    printf("high-water: LwIP_HeapBytes %u of %u\n", static_cast<unsigned>(lwip_stats.mem.max),
+           static_cast<unsigned>(lwip_stats.mem.avail));
+#endif // MEM_STATS
+#if MEMP_STATS
+    printf("high-water: LwIP_PbufPool %u of %u\n", static_cast<unsigned>(lwip_stats.memp[MEMP_PBUF_POOL]->max),
+           static_cast<unsigned>(lwip_stats.memp[MEMP_PBUF_POOL]->avail));
+#endif // MEMP_STATS
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        printf("high-water: Process_MaxRSSKiB %ld\n", usage.ru_maxrss);
+    }
+}
+
+CHIP_ERROR InitSessions()
+{
+    Optional<Transport::PeerAddress> peer;
+    Inet::IPAddress loopback;
+
+    VerifyOrReturnError(Inet::IPAddress::FromString("127.0.0.1", loopback), CHIP_ERROR_INVALID_ADDRESS);
+    peer.SetValue(Transport::PeerAddress::UDP(loopback, CHIP_PORT));
+
+    VerifyOrReturnError(sAdmins.AssignAdminId(kInitiatorAdminId, kTestControllerNodeId) != nullptr, CHIP_ERROR_NO_MEMORY);
+    VerifyOrReturnError(sAdmins.AssignAdminId(kResponderAdminId, kTestDeviceNodeId) != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(
+        sTransportManager.Init(Transport::UdpListenParameters(&gInet).SetAddressType(Inet::kIPAddressType_IPv4)));
+    ReturnErrorOnFailure(sSessionManager.Init(kTestControllerNodeId, &gSystemLayer, &sTransportManager, &sAdmins));
+    ReturnErrorOnFailure(sExchangeManager.Init(&sSessionManager));
+
+    ReturnErrorOnFailure(sSessionManager.NewPairing(peer, kTestDeviceNodeId, &sInitiatorPairing,
+                                                    SecureSessionMgr::PairingDirection::kInitiator, kInitiatorAdminId));
+    ReturnErrorOnFailure(sSessionManager.NewPairing(peer, kTestControllerNodeId, &sResponderPairing,
+                                                    SecureSessionMgr::PairingDirection::kResponder, kResponderAdminId));
+
+    ReturnErrorOnFailure(sEchoServer.Init(&sExchangeManager));
+    ReturnErrorOnFailure(sEchoClient.Init(&sExchangeManager, { kTestDeviceNodeId, kResponderKeyId, kInitiatorAdminId }));
+    sEchoClient.SetEchoResponseReceived(HandleEchoResponseReceived);
+
+    ReturnErrorOnFailure(app::InteractionModelEngine::GetInstance()->Init(&sExchangeManager, &sInteractionModelDelegate));
+    return app::InteractionModelEngine::GetInstance()->NewReadClient(&sReadClient);
+}
+
+void ShutdownSessions()
+{
+    if (sReadClient != nullptr)
+    {
+        sReadClient->Shutdown();
+        sReadClient = nullptr;
+    }
+    app::InteractionModelEngine::GetInstance()->Shutdown();
+    sEchoClient.Shutdown();
+    sEchoServer.Shutdown();
+    sExchangeManager.Shutdown();
+    sSessionManager.Shutdown();
+    // Release the endpoint while the system layer can still take the deferred release event.
+    sTransportManager.Close();
+}
+
+bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier, const char * aName, const char * aValue)
+{
+    bool retval = true;
+
+    switch (aIdentifier)
+    {
+    case kToolOptCount:
+        if (!ParseInt(aValue, sCount) || sCount == 0)
+        {
+            PrintArgError("%s: invalid value specified for request count: %s\n", aProgram, aValue);
+            retval = false;
+        }
+        break;
+
+    case kToolOptPayloadSize:
+        if (!ParseInt(aValue, sPayloadSize) || sPayloadSize == 0 || sPayloadSize > kMaxAppMessageLen)
+        {
+            PrintArgError("%s: invalid value specified for payload size: %s\n", aProgram, aValue);
+            retval = false;
+        }
+        break;
+
+    case kToolOptTimeout:
+        if (!ParseInt(aValue, sTimeoutMs))
+        {
+            PrintArgError("%s: invalid value specified for timeout: %s\n", aProgram, aValue);
+            retval = false;
+        }
+        break;
+
+    case kToolOptWorkload:
+        if (strcmp(aValue, "echo") == 0)
+        {
+            sWorkloads = kWorkloadEcho;
+        }
+        else if (strcmp(aValue, "read") == 0)
+        {
+            sWorkloads = kWorkloadRead;
+        }
+        else if (strcmp(aValue, "all") == 0)
+        {
+            sWorkloads = kWorkloadAll;
+        }
+        else
+        {
+            PrintArgError("%s: invalid value specified for workload: %s\n", aProgram, aValue);
+            retval = false;
+        }
+        break;
+
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", aProgram, aName);
+        retval = false;
+        break;
+    }
+
+    return retval;
+}
+
+// clang-format off
+OptionDef sToolOptionDefs[] =
+{
+    { "count",                     kArgumentRequired,  kToolOptCount                  },
+    { "payload-size",              kArgumentRequired,  kToolOptPayloadSize            },
+    { "timeout",                   kArgumentRequired,  kToolOptTimeout                },
+    { "workload",                  kArgumentRequired,  kToolOptWorkload               },
+    { }
+};
+
+const char * sToolOptionHelp =
+    "  -c, --count <num>\n"
+    "       Number of requests issued by each workload (default: 1000).\n"
+    "\n"
+    "  -s, --payload-size <size>\n"
+    "       Size in bytes of each echo request payload (default: 64).\n"
+    "\n"
+    "  -t, --timeout <ms>\n"
+    "       Fail a workload when a request is not answered within this time (default: 5000 ms).\n"
+    "\n"
+    "  -w, --workload <echo | read | all>\n"
+    "       Workload to run (default: all).\n"
+    "\n";
+
+OptionSet sToolOptions =
+{
+    HandleOption,
+    sToolOptionDefs,
+    "GENERAL OPTIONS",
+    sToolOptionHelp
+};
+
+HelpOptions sHelpOptions(
+    kToolName,
+    "Usage: " kToolName " [ <options> ]\n",
+    CHIP_VERSION_STRING "\n" CHIP_TOOL_COPYRIGHT
+);
+
+OptionSet * sToolOptionSets[] =
+{
+    &sToolOptions,
+    &gNetworkOptions,
+    &sHelpOptions,
+    nullptr
+};
+// clang-format on
+
+} // namespace
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR ReadSingleClusterData(AttributePathParams & aAttributePathParams, TLV::TLVWriter & aWriter)
+{
+    VerifyOrReturnError(aAttributePathParams.mClusterId == kPerfClusterId && aAttributePathParams.mEndpointId == kPerfEndpointId,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    return aWriter.Put(TLV::ContextTag(kPerfFieldId), sReadWorkload.mSent);
+}
+
+CHIP_ERROR WriteSingleClusterData(AttributePathParams & aAttributePathParams, TLV::TLVReader & aReader)
+{
+    // Attribute data received by the read workload is discarded.
+    return CHIP_NO_ERROR;
+}
+
+} // namespace app
+} // namespace chip
+
+int main(int argc, char * argv[])
+{
+    bool successful = true;
+    CHIP_ERROR err;
+
+    InitTestInetCommon();
+
+    if (!ParseArgsFromEnvVar(kToolName, TOOL_OPTIONS_ENV_VAR_NAME, sToolOptionSets, nullptr, true) ||
+        !ParseArgs(kToolName, argc, argv, sToolOptionSets))
+    {
+        return EXIT_FAILURE;
+    }
+
+    InitSystemLayer();
+
+    InitNetwork();
+
+    printf("%s: %s network, %" PRIu32 " requests per workload\n", kToolName,
+           CHIP_SYSTEM_CONFIG_USE_LWIP ? "lwip" : "sockets", sCount);
+
+    err = InitSessions();
+    if (err != CHIP_NO_ERROR)
+    {
+        printf("%s: initialization failed: %s\n", kToolName, ErrorStr(err));
+        successful = false;
+    }
+
+    if (successful && (sWorkloads & kWorkloadEcho))
+    {
+        successful = RunWorkload(sEchoWorkload, SendEchoRequest);
+        ReportWorkload(sEchoWorkload, sPayloadSize);
+    }
+
+    if (successful && (sWorkloads & kWorkloadRead))
+    {
+        successful = RunWorkload(sReadWorkload, SendReadRequest);
+        ReportWorkload(sReadWorkload, 0);
+    }
+
+    ReportMemory();
+
+    ShutdownSessions();
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return successful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,487 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Bulk generation and validation of onboarding codes, for provisioning
+ *      devices on a manufacturing line.
+ *
+ *      bulk-generate derives a discriminator and a setup PIN code for every
+ *      unit from a secret seed and the unit index with HKDF-SHA256, so that
+ *      the credentials of a unit tell nothing about the seed or the other
+ *      units, and writes one line per unit:
+ *
+ *          <index>,<discriminator>,<setup PIN code>,<QR code>,<manual code>
+ *
+ *      bulk-validate parses both codes on every line of such a file and
+ *      checks that they carry the listed discriminator and setup PIN code.
+ *
+ *      Both commands split the units across threads and use the
+ *      allocation-free encoders and parsers of the setup payload library.
+ */
+
+#include "bulk_payload_commands.h"
+
+#include <core/CHIPEncoding.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <setup_payload/ManualSetupPayloadGenerator.h>
+#include <setup_payload/ManualSetupPayloadParser.h>
+#include <setup_payload/QRCodeSetupPayloadGenerator.h>
+#include <setup_payload/QRCodeSetupPayloadParser.h>
+#include <setup_payload/SetupPayloadHelper.h>
+#include <support/BufferWriter.h>
+#include <support/CHIPArgParser.hpp>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <fstream>
+#include <inttypes.h>
+#include <iterator>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+
+namespace {
+
+// Number of units generated before the output is written out; bounds the memory used.
+constexpr uint64_t kBlockSize = 1 << 16;
+// Longest line: index, discriminator, setup PIN code, both codes and the separators.
+constexpr size_t kMaxLineLength       = 20 + 1 + 4 + 1 + 8 + 1 + kQRCodeWithoutOptionalDataBufferSize + kManualSetupCodeBufferSize;
+constexpr size_t kFieldCount          = 5;
+constexpr size_t kMaxReportedFailures = 10;
+constexpr size_t kMinSeedLength       = 16;
+constexpr size_t kMaxSeedLength       = 32;
+
+// HKDF info prefix, followed by the unit index and the derivation round
+constexpr char kCredentialsInfo[] = "CHIP bulk unit credentials";
+
+// The manual code only carries the most significant bits of the discriminator
+constexpr uint16_t kManualDiscriminatorMask = ((1 << kManualSetupDiscriminatorFieldLengthInBits) - 1)
+    << (kPayloadDiscriminatorFieldLengthInBits - kManualSetupDiscriminatorFieldLengthInBits);
+
+struct BulkOptions
+{
+    const char * payloadPath = nullptr;
+    const char * inputPath   = nullptr;
+    const char * outputPath  = nullptr;
+    uint64_t count           = 0;
+    uint64_t firstIndex      = 0;
+    uint8_t seed[kMaxSeedLength];
+    size_t seedLength    = 0;
+    unsigned threadCount = 0;
+};
+
+struct InputLine
+{
+    size_t offset;
+    size_t number;
+};
+
+struct ValidateResult
+{
+    uint64_t failed = 0;
+    std::vector<size_t> failedLines;
+};
+
+bool parseUnsigned(const char * str, uint64_t & value)
+{
+    char * end;
+    errno = 0;
+    value = strtoull(str, &end, 10);
+    return errno == 0 && end != str && *end == '\0';
+}
+
+bool parseOptions(int argc, char * const * argv, const char * optstring, BulkOptions & options)
+{
+    int ch;
+    uint64_t value;
+
+    optind = 1;
+    while ((ch = getopt(argc, argv, optstring)) != -1)
+    {
+        switch (ch)
+        {
+        case 'f':
+            options.payloadPath = optarg;
+            break;
+
+        case 'i':
+            options.inputPath = optarg;
+            break;
+
+        case 'o':
+            options.outputPath = optarg;
+            break;
+
+        case 'n':
+            if (!parseUnsigned(optarg, options.count))
+            {
+                return false;
+            }
+            break;
+
+        case 's':
+            if (!parseUnsigned(optarg, options.firstIndex))
+            {
+                return false;
+            }
+            break;
+
+        case 'k': {
+            uint32_t seedLength;
+            if (!ArgParser::ParseHexString(optarg, static_cast<uint32_t>(strlen(optarg)), options.seed, sizeof(options.seed),
+                                           seedLength) ||
+                seedLength < kMinSeedLength)
+            {
+                return false;
+            }
+            options.seedLength = seedLength;
+            break;
+        }
+
+        case 't':
+            if (!parseUnsigned(optarg, value) || value == 0 || value > 1024)
+            {
+                return false;
+            }
+            options.threadCount = static_cast<unsigned>(value);
+            break;
+
+        case '?':
+        default:
+            return false;
+        }
+    }
+
+    if (options.threadCount == 0)
+    {
+        options.threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    return true;
+}
+
+CHIP_ERROR deriveUnitCredentials(const BulkOptions & options, uint64_t index, uint16_t & discriminator, uint32_t & setUpPINCode)
+{
+    uint8_t info[sizeof(kCredentialsInfo) + sizeof(uint64_t) + sizeof(uint32_t)];
+    uint8_t okm[Crypto::kSHA256_Hash_Length];
+
+    // Each round yields 32 bytes: the discriminator, then candidate setup PIN codes until one is acceptable
+    for (uint32_t round = 0;; round++)
+    {
+        Encoding::BigEndian::BufferWriter writer(info, sizeof(info));
+        writer.Put(kCredentialsInfo).Put8(0).Put64(index).Put32(round);
+        VerifyOrReturnError(writer.Fit(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        ReturnErrorOnFailure(
+            Crypto::HKDF_SHA256(options.seed, options.seedLength, nullptr, 0, info, writer.Needed(), okm, sizeof(okm)));
+
+        size_t offset = 0;
+        if (round == 0)
+        {
+            discriminator = static_cast<uint16_t>(Encoding::BigEndian::Get16(okm) & kMaxDiscriminatorValue);
+            offset        = sizeof(uint16_t);
+        }
+
+        for (; offset + sizeof(uint32_t) <= sizeof(okm); offset += sizeof(uint32_t))
+        {
+            if (SetupPINCodeFromRandom(Encoding::BigEndian::Get32(&okm[offset]), setUpPINCode))
+            {
+                return CHIP_NO_ERROR;
+            }
+        }
+    }
+}
+
+// Runs work(worker, first, count) on threadCount threads, each over its share of [first, first + count)
+template <typename Work>
+void runOnThreads(unsigned threadCount, uint64_t first, uint64_t count, Work work)
+{
+    std::vector<std::thread> threads;
+    const uint64_t end   = first + count;
+    const uint64_t share = (count + threadCount - 1) / threadCount;
+
+    for (unsigned worker = 0; worker < threadCount; worker++)
+    {
+        uint64_t begin = std::min(first + worker * share, end);
+        threads.emplace_back(work, worker, begin, std::min(begin + share, end) - begin);
+    }
+
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+}
+
+CHIP_ERROR generateUnits(const SetupPayload & base, const BulkOptions & options, uint64_t first, uint64_t count,
+                         std::string & output)
+{
+    SetupPayload payload = base;
+    char qrCode[kQRCodeWithoutOptionalDataBufferSize];
+    char manualCode[kManualSetupCodeBufferSize];
+    char line[kMaxLineLength + 1];
+
+    output.clear();
+    output.reserve(static_cast<size_t>(count) * kMaxLineLength);
+
+    for (uint64_t index = first; index < first + count; index++)
+    {
+        ReturnErrorOnFailure(deriveUnitCredentials(options, index, payload.discriminator, payload.setUpPINCode));
+
+        ReturnErrorOnFailure(QRCodeSetupPayloadGenerator(payload).payloadBase38Representation(qrCode, sizeof(qrCode)));
+        ReturnErrorOnFailure(
+            ManualSetupPayloadGenerator(payload).payloadDecimalStringRepresentation(manualCode, sizeof(manualCode)));
+
+        int length = snprintf(line, sizeof(line), "%" PRIu64 ",%u,%" PRIu32 ",%s,%s\n", index, payload.discriminator,
+                              payload.setUpPINCode, qrCode, manualCode);
+        output.append(line, static_cast<size_t>(length));
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool sameProductInformation(const SetupPayload & a, const SetupPayload & b)
+{
+    return a.version == b.version && a.vendorID == b.vendorID && a.productID == b.productID &&
+        a.requiresCustomFlow == b.requiresCustomFlow && a.rendezvousInformation.Raw() == b.rendezvousInformation.Raw();
+}
+
+// Validates one line, which is modified in place
+bool validateLine(char * line, const SetupPayload * base)
+{
+    char * fields[kFieldCount];
+    char * cursor = line;
+    uint64_t discriminator;
+    uint64_t setUpPINCode;
+    SetupPayload qrPayload;
+    SetupPayload manualPayload;
+
+    size_t lineLength = strlen(line);
+    if (lineLength > 0 && line[lineLength - 1] == '\r')
+    {
+        line[lineLength - 1] = '\0';
+    }
+
+    for (size_t i = 0; i < kFieldCount; i++)
+    {
+        fields[i] = cursor;
+        cursor    = strchr(cursor, ',');
+        if (i + 1 == kFieldCount)
+        {
+            break;
+        }
+        if (cursor == nullptr)
+        {
+            return false;
+        }
+        *cursor++ = '\0';
+    }
+
+    if (cursor != nullptr || !parseUnsigned(fields[1], discriminator) || !parseUnsigned(fields[2], setUpPINCode))
+    {
+        return false;
+    }
+
+    if (QRCodeSetupPayloadParser::populatePayload(CharSpan(fields[3], strlen(fields[3])), qrPayload) != CHIP_NO_ERROR ||
+        !qrPayload.isValidQRCodePayload() || qrPayload.discriminator != discriminator || qrPayload.setUpPINCode != setUpPINCode)
+    {
+        return false;
+    }
+
+    if (ManualSetupPayloadParser::populatePayload(CharSpan(fields[4], strlen(fields[4])), manualPayload) != CHIP_NO_ERROR ||
+        manualPayload.discriminator != (discriminator & kManualDiscriminatorMask) || manualPayload.setUpPINCode != setUpPINCode ||
+        manualPayload.requiresCustomFlow != qrPayload.requiresCustomFlow)
+    {
+        return false;
+    }
+
+    if (qrPayload.requiresCustomFlow &&
+        (manualPayload.vendorID != qrPayload.vendorID || manualPayload.productID != qrPayload.productID))
+    {
+        return false;
+    }
+
+    return base == nullptr || sameProductInformation(*base, qrPayload);
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+extern int bulk_payload_operation_generate(int argc, char * const * argv)
+{
+    BulkOptions options;
+    SetupPayload base;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    if (!parseOptions(argc, argv, "f:n:o:s:k:t:", options) || options.payloadPath == nullptr || options.outputPath == nullptr ||
+        options.count == 0)
+    {
+        return 2;
+    }
+
+    if (loadPayloadFromFile(base, options.payloadPath) != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipTool, "Failed to load payload from %s", options.payloadPath);
+        return 2;
+    }
+
+    if (options.seedLength == 0)
+    {
+        // Without a seed of their own, the credentials can only be recovered from the output file.
+        options.seedLength = kMaxSeedLength;
+        if (Crypto::DRBG_get_bytes(options.seed, options.seedLength) != CHIP_NO_ERROR)
+        {
+            ChipLogError(chipTool, "Failed to generate a seed");
+            return 2;
+        }
+    }
+
+    FILE * output = fopen(options.outputPath, "w");
+    if (output == nullptr)
+    {
+        ChipLogError(chipTool, "Failed to open %s: %s", options.outputPath, strerror(errno));
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> outputs(options.threadCount);
+    std::vector<CHIP_ERROR> errors(options.threadCount);
+
+    for (uint64_t done = 0; done < options.count && err == CHIP_NO_ERROR;)
+    {
+        uint64_t blockCount = std::min(kBlockSize * options.threadCount, options.count - done);
+
+        runOnThreads(options.threadCount, options.firstIndex + done, blockCount,
+                     [&](unsigned worker, uint64_t first, uint64_t count) {
+                         errors[worker] = generateUnits(base, options, first, count, outputs[worker]);
+                     });
+
+        for (unsigned worker = 0; worker < options.threadCount && err == CHIP_NO_ERROR; worker++)
+        {
+            err = errors[worker];
+            if (err == CHIP_NO_ERROR && fwrite(outputs[worker].data(), 1, outputs[worker].size(), output) != outputs[worker].size())
+            {
+                err = CHIP_ERROR_WRITE_FAILED;
+            }
+        }
+        done += blockCount;
+    }
+
+    if (fclose(output) != 0 && err == CHIP_NO_ERROR)
+    {
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipTool, "Bulk generation failed: %" PRId32, err);
+        return 2;
+    }
+
+    double elapsed = secondsSince(start);
+    ChipLogDetail(chipTool, "Generated %" PRIu64 " payloads from index %" PRIu64 " in %.3f s (%.0f/s)", options.count,
+                  options.firstIndex, elapsed, static_cast<double>(options.count) / elapsed);
+    return 0;
+}
+
+extern int bulk_payload_operation_validate(int argc, char * const * argv)
+{
+    BulkOptions options;
+    SetupPayload base;
+
+    if (!parseOptions(argc, argv, "f:i:t:", options) || options.inputPath == nullptr)
+    {
+        return 2;
+    }
+
+    if (options.payloadPath != nullptr && loadPayloadFromFile(base, options.payloadPath) != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipTool, "Failed to load payload from %s", options.payloadPath);
+        return 2;
+    }
+
+    std::ifstream input(options.inputPath, std::ios::binary);
+    if (!input)
+    {
+        ChipLogError(chipTool, "Failed to open %s", options.inputPath);
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<char> contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::vector<InputLine> lines;
+
+    // Split the file into NUL-terminated lines, skipping blank ones but keeping their numbers for the report
+    contents.push_back('\n');
+    for (size_t offset = 0, number = 1; offset < contents.size(); number++)
+    {
+        char * newline = static_cast<char *>(memchr(&contents[offset], '\n', contents.size() - offset));
+        size_t end     = static_cast<size_t>(newline - contents.data());
+        *newline       = '\0';
+        if (end > offset)
+        {
+            lines.push_back({ offset, number });
+        }
+        offset = end + 1;
+    }
+
+    std::vector<ValidateResult> results(options.threadCount);
+    const SetupPayload * expected = options.payloadPath != nullptr ? &base : nullptr;
+
+    runOnThreads(options.threadCount, 0, lines.size(), [&](unsigned worker, uint64_t first, uint64_t count) {
+        ValidateResult & result = results[worker];
+        for (uint64_t line = first; line < first + count; line++)
+        {
+            if (!validateLine(&contents[lines[line].offset], expected))
+            {
+                result.failed++;
+                if (result.failedLines.size() < kMaxReportedFailures)
+                {
+                    result.failedLines.push_back(lines[line].number);
+                }
+            }
+        }
+    });
+
+    uint64_t failed = 0;
+    size_t reported = 0;
+    for (const ValidateResult & result : results)
+    {
+        failed += result.failed;
+        for (size_t line = 0; line < result.failedLines.size() && reported < kMaxReportedFailures; line++, reported++)
+        {
+            ChipLogError(chipTool, "Invalid payload on line %zu", result.failedLines[line]);
+        }
+    }
+
+    double elapsed = secondsSince(start);
+    ChipLogDetail(chipTool, "Validated %zu payloads, %" PRIu64 " invalid, in %.3f s (%.0f/s)", lines.size(), failed, elapsed,
+                  static_cast<double>(lines.size()) / elapsed);
+    return failed == 0 ? 0 : 2;
+}
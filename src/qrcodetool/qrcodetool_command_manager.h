@@ -18,6 +18,7 @@
 #ifndef QRCODETOOL_CMD_MANAGER_H
 #define QRCODETOOL_CMD_MANAGER_H
 
+#include "bulk_payload_commands.h"
 #include "setup_payload_commands.h"
 
 typedef int (*command_func)(int argc, char * const * argv);
@@ -37,6 +38,23 @@ qrcodetool_command_t commands[] = { { "generate-qr-code", setup_payload_operatio
                                       "[-f file-path]\n"
                                       "    -f File path of payload.\n",
                                       "Generate manual code from payload in text file." },
+
+                                    { "bulk-generate", bulk_payload_operation_generate,
+                                      "-f file-path -n count -o output-path [-s first-index] [-k seed] [-t threads]\n"
+                                      "    -f File path of the base payload.\n"
+                                      "    -n Number of payloads to generate.\n"
+                                      "    -o File path of the generated payloads.\n"
+                                      "    -s Index of the first payload, 0 by default.\n"
+                                      "    -k Secret hex seed (16 to 32 bytes) of the credentials, random by default.\n"
+                                      "    -t Number of threads, one per core by default.\n",
+                                      "Generate QR and manual codes with unique credentials for a batch of devices." },
+
+                                    { "bulk-validate", bulk_payload_operation_validate,
+                                      "-i input-path [-f file-path] [-t threads]\n"
+                                      "    -i File path of payloads generated by bulk-generate.\n"
+                                      "    -f File path of the base payload the codes must match.\n"
+                                      "    -t Number of threads, one per core by default.\n",
+                                      "Check the QR and manual codes of a batch of devices." },
                                     // Last one
                                     {} };
 
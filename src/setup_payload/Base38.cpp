@@ -31,6 +31,8 @@
 
 #include "Base38.h"
 
+#include <support/CodeUtils.h>
+
 #include <climits>
 
 namespace {
@@ -46,7 +48,7 @@ static inline CHIP_ERROR decodeChar(char c, uint8_t & value)
     static const int kBogus = 255;
     // map of base38 charater to numeric value
     // subtract 45 from the charater, then index into this array, if possible
-    const uint8_t decodes[] = {
+    static const uint8_t decodes[] = {
         36,     // '-', =45
         37,     // '.', =46
         kBogus, // '/', =47
@@ -111,10 +113,11 @@ static inline CHIP_ERROR decodeChar(char c, uint8_t & value)
 
 namespace chip {
 
-std::string base38Encode(const uint8_t * buf, size_t buf_len)
-{
-    std::string result;
+namespace {
 
+// Encodes buf into base38 characters at out, which must have room for base38EncodedLength(buf_len) characters
+void encodeChunks(const uint8_t * buf, size_t buf_len, char * out)
+{
     while (buf_len > 0)
     {
         uint32_t value = 0;
@@ -134,19 +137,18 @@ std::string base38Encode(const uint8_t * buf, size_t buf_len)
 
         for (uint8_t character = 0; character < base38CharactersNeeded; character++)
         {
-            result += kCodes[value % kRadix];
+            *out++ = kCodes[value % kRadix];
             value /= kRadix;
         }
     }
-    return result;
 }
 
-CHIP_ERROR base38Decode(std::string base38, std::vector<uint8_t> & result)
+// Decodes base38 characters into out, which must have room for base38DecodedLength(base38_len) bytes
+CHIP_ERROR decodeChunks(const char * base38, size_t base38_len, uint8_t * out, size_t & out_len)
 {
-    result.clear();
+    size_t base38CharactersNumber = base38_len;
+    out_len                       = 0;
 
-    int base38CharactersNumber  = static_cast<int>(base38.length());
-    int decodedBase38Characters = 0;
     while (base38CharactersNumber > 0)
     {
         uint8_t base38CharactersInChunk;
@@ -177,7 +179,7 @@ CHIP_ERROR base38Decode(std::string base38, std::vector<uint8_t> & result)
         for (int i = (base38CharactersInChunk - 1); i >= 0; i--)
         {
             uint8_t v;
-            CHIP_ERROR err = decodeChar(base38[static_cast<uint8_t>(decodedBase38Characters + i)], v);
+            CHIP_ERROR err = decodeChar(base38[i], v);
 
             if (err != CHIP_NO_ERROR)
             {
@@ -186,15 +188,57 @@ CHIP_ERROR base38Decode(std::string base38, std::vector<uint8_t> & result)
 
             value = value * kRadix + v;
         }
-        decodedBase38Characters += base38CharactersInChunk;
+        base38 += base38CharactersInChunk;
         base38CharactersNumber -= base38CharactersInChunk;
 
         for (int i = 0; i < bytesInDecodedChunk; i++)
         {
-            result.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            out[out_len++] = static_cast<uint8_t>(value >> (8 * i));
         }
     }
     return CHIP_NO_ERROR;
 }
 
+} // unnamed namespace
+
+CHIP_ERROR base38Encode(ByteSpan in_buf, char * out_buf, size_t out_buf_size)
+{
+    const size_t encodedLength = base38EncodedLength(in_buf.size());
+
+    VerifyOrReturnError(out_buf_size > encodedLength, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    encodeChunks(in_buf.data(), in_buf.size(), out_buf);
+    out_buf[encodedLength] = '\0';
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR base38Decode(CharSpan base38, uint8_t * out_buf, size_t out_buf_size, size_t & out_len)
+{
+    VerifyOrReturnError(out_buf_size >= base38DecodedLength(base38.size()), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    return decodeChunks(base38.data(), base38.size(), out_buf, out_len);
+}
+
+std::string base38Encode(const uint8_t * buf, size_t buf_len)
+{
+    std::string result(base38EncodedLength(buf_len), '\0');
+
+    if (!result.empty())
+    {
+        encodeChunks(buf, buf_len, &result[0]);
+    }
+    return result;
+}
+
+CHIP_ERROR base38Decode(const std::string & base38, std::vector<uint8_t> & result)
+{
+    size_t decodedLength = 0;
+
+    result.resize(base38DecodedLength(base38.length()));
+
+    CHIP_ERROR err = decodeChunks(base38.data(), base38.length(), result.data(), decodedLength);
+    result.resize(err == CHIP_NO_ERROR ? decodedLength : 0);
+    return err;
+}
+
 } // namespace chip
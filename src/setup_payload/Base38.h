@@ -23,14 +23,37 @@
 #pragma once
 
 #include <core/CHIPError.h>
+#include <support/Span.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string>
 #include <vector>
 
 namespace chip {
+
+// Number of base38 characters needed to encode num_bytes bytes
+constexpr size_t base38EncodedLength(size_t num_bytes)
+{
+    return (num_bytes / 3) * 5 + (num_bytes % 3) * 2;
+}
+
+// Upper bound of the number of bytes decoded from num_chars base38 characters
+constexpr size_t base38DecodedLength(size_t num_chars)
+{
+    return (num_chars / 5) * 3 + (num_chars % 5) / 2;
+}
+
+// Encodes in_buf into out_buf as a NUL-terminated string, without allocating memory.
+// out_buf_size must be at least base38EncodedLength(in_buf.size()) + 1.
+CHIP_ERROR base38Encode(ByteSpan in_buf, char * out_buf, size_t out_buf_size);
+
+// Decodes base38 into out_buf, without allocating memory, and sets out_len to the number of bytes decoded.
+// out_buf_size must be at least base38DecodedLength(base38.size()).
+CHIP_ERROR base38Decode(CharSpan base38, uint8_t * out_buf, size_t out_buf_size, size_t & out_len);
+
 // returns CHIP_NO_ERROR on successful decode
-CHIP_ERROR base38Decode(std::string base38, std::vector<uint8_t> & out);
+CHIP_ERROR base38Decode(const std::string & base38, std::vector<uint8_t> & out);
 std::string base38Encode(const uint8_t * buf, size_t buf_len);
 
 } // namespace chip
@@ -26,6 +26,7 @@
 #include <inttypes.h>
 #include <limits>
 
+#include <support/CodeUtils.h>
 #include <support/logging/CHIPLogging.h>
 #include <support/verhoeff/Verhoeff.h>
 
@@ -87,24 +88,27 @@ static uint32_t chunk3PayloadRepresentation(const SetupPayload & payload)
     return result;
 }
 
-// TODO: issue #3663 - Unbounded stack in src/setup_payload
-#if !defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstack-usage="
-#endif
-
-static std::string decimalStringWithPadding(uint32_t number, int minLength)
+// Writes number as exactly length decimal digits, zero padded, at outBuffer
+static void decimalStringWithPadding(char * outBuffer, uint32_t number, size_t length)
 {
-    char buf[minLength + 1];
-    snprintf(buf, sizeof(buf), "%0*" PRIu32, minLength, number);
-    return std::string(buf);
+    for (size_t i = length; i > 0; i--)
+    {
+        outBuffer[i - 1] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    }
 }
 
-#if !defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
-
 CHIP_ERROR ManualSetupPayloadGenerator::payloadDecimalStringRepresentation(std::string & outDecimalString)
+{
+    char decimalString[kManualSetupCodeBufferSize];
+
+    ReturnErrorOnFailure(payloadDecimalStringRepresentation(decimalString, sizeof(decimalString)));
+
+    outDecimalString = decimalString;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ManualSetupPayloadGenerator::payloadDecimalStringRepresentation(char * outBuffer, size_t outBufferSize)
 {
     if (!mSetupPayload.isValidManualCode())
     {
@@ -121,22 +125,31 @@ CHIP_ERROR ManualSetupPayloadGenerator::payloadDecimalStringRepresentation(std::
     static_assert(kManualSetupChunk2PINCodeLsbitsLength + kManualSetupChunk3PINCodeMsbitsLength == kSetupPINCodeFieldLengthInBits,
                   "PIN code won't fit");
 
+    size_t codeLength = mSetupPayload.requiresCustomFlow ? kManualSetupLongCodeCharLength : kManualSetupShortCodeCharLength;
+    VerifyOrReturnError(outBufferSize > codeLength + 1, CHIP_ERROR_BUFFER_TOO_SMALL);
+
     uint32_t chunk1 = chunk1PayloadRepresentation(mSetupPayload);
     uint32_t chunk2 = chunk2PayloadRepresentation(mSetupPayload);
     uint32_t chunk3 = chunk3PayloadRepresentation(mSetupPayload);
 
-    std::string decimalString = decimalStringWithPadding(chunk1, kManualSetupCodeChunk1CharLength);
-    decimalString += decimalStringWithPadding(chunk2, kManualSetupCodeChunk2CharLength);
-    decimalString += decimalStringWithPadding(chunk3, kManualSetupCodeChunk3CharLength);
+    char * out = outBuffer;
+    decimalStringWithPadding(out, chunk1, kManualSetupCodeChunk1CharLength);
+    out += kManualSetupCodeChunk1CharLength;
+    decimalStringWithPadding(out, chunk2, kManualSetupCodeChunk2CharLength);
+    out += kManualSetupCodeChunk2CharLength;
+    decimalStringWithPadding(out, chunk3, kManualSetupCodeChunk3CharLength);
+    out += kManualSetupCodeChunk3CharLength;
 
     if (mSetupPayload.requiresCustomFlow)
     {
-        decimalString += decimalStringWithPadding(mSetupPayload.vendorID, kManualSetupVendorIdCharLength);
-        decimalString += decimalStringWithPadding(mSetupPayload.productID, kManualSetupProductIdCharLength);
+        decimalStringWithPadding(out, mSetupPayload.vendorID, kManualSetupVendorIdCharLength);
+        out += kManualSetupVendorIdCharLength;
+        decimalStringWithPadding(out, mSetupPayload.productID, kManualSetupProductIdCharLength);
+        out += kManualSetupProductIdCharLength;
     }
-    decimalString += Verhoeff10::ComputeCheckChar(decimalString.c_str());
 
-    outDecimalString = decimalString;
+    outBuffer[codeLength]     = Verhoeff10::ComputeCheckChar(outBuffer, codeLength);
+    outBuffer[codeLength + 1] = '\0';
     return CHIP_NO_ERROR;
 }
 
@@ -45,6 +45,9 @@
 
 namespace chip {
 
+// Size of a buffer that holds any NUL-terminated manual setup code, check digit included
+constexpr size_t kManualSetupCodeBufferSize = kManualSetupLongCodeCharLength + 1 + 1;
+
 class ManualSetupPayloadGenerator
 {
 private:
@@ -55,6 +58,10 @@ public:
 
     // Populates decimal string representation of the payload into outDecimalString
     CHIP_ERROR payloadDecimalStringRepresentation(std::string & outDecimalString);
+
+    // Writes the NUL-terminated decimal string representation of the payload into outBuffer, without allocating memory.
+    // outBufferSize must be at least kManualSetupCodeBufferSize for codes that require a custom flow.
+    CHIP_ERROR payloadDecimalStringRepresentation(char * outBuffer, size_t outBufferSize);
 };
 
 } // namespace chip
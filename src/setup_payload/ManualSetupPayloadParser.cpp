@@ -27,23 +27,21 @@
 #include <support/logging/CHIPLogging.h>
 #include <support/verhoeff/Verhoeff.h>
 
-#include <math.h>
-#include <string>
-#include <vector>
+#include <ctype.h>
 
 namespace chip {
 
-static CHIP_ERROR checkDecimalStringValidity(std::string decimalString, std::string & decimalStringWithoutCheckDigit)
+static CHIP_ERROR checkDecimalStringValidity(CharSpan decimalString, CharSpan & decimalStringWithoutCheckDigit)
 {
-    if (decimalString.length() < 2)
+    if (decimalString.size() < 2)
     {
-        ChipLogError(SetupPayload, "Failed decoding base10. Input was empty. %zu", decimalString.length());
+        ChipLogError(SetupPayload, "Failed decoding base10. Input was empty. %zu", decimalString.size());
         return CHIP_ERROR_INVALID_STRING_LENGTH;
     }
-    std::string repWithoutCheckChar = decimalString.substr(0, decimalString.length() - 1);
-    char checkChar                  = decimalString.back();
+    CharSpan repWithoutCheckChar(decimalString.data(), decimalString.size() - 1);
+    char checkChar = decimalString.data()[decimalString.size() - 1];
 
-    if (!Verhoeff10::ValidateCheckChar(checkChar, repWithoutCheckChar.c_str()))
+    if (!Verhoeff10::ValidateCheckChar(checkChar, repWithoutCheckChar.data(), repWithoutCheckChar.size()))
     {
         return CHIP_ERROR_INTEGRITY_CHECK_FAILED;
     }
@@ -51,23 +49,24 @@ static CHIP_ERROR checkDecimalStringValidity(std::string decimalString, std::str
     return CHIP_NO_ERROR;
 }
 
-static CHIP_ERROR checkCodeLengthValidity(const std::string & decimalString, bool isLongCode)
+static CHIP_ERROR checkCodeLengthValidity(CharSpan decimalString, bool isLongCode)
 {
     size_t expectedCharLength = isLongCode ? kManualSetupLongCodeCharLength : kManualSetupShortCodeCharLength;
-    if (decimalString.length() != expectedCharLength)
+    if (decimalString.size() != expectedCharLength)
     {
-        ChipLogError(SetupPayload, "Failed decoding base10. Input length %zu was not expected length %zu", decimalString.length(),
+        ChipLogError(SetupPayload, "Failed decoding base10. Input length %zu was not expected length %zu", decimalString.size(),
                      expectedCharLength);
         return CHIP_ERROR_INVALID_STRING_LENGTH;
     }
     return CHIP_NO_ERROR;
 }
 
-static CHIP_ERROR toNumber(const std::string & decimalString, uint32_t & dest)
+static CHIP_ERROR toNumber(const char * decimalString, size_t length, uint32_t & dest)
 {
     uint32_t number = 0;
-    for (char c : decimalString)
+    for (size_t i = 0; i < length; i++)
     {
+        char c = decimalString[i];
         if (!isdigit(c))
         {
             ChipLogError(SetupPayload, "Failed decoding base10. Character was invalid %c", c);
@@ -81,27 +80,30 @@ static CHIP_ERROR toNumber(const std::string & decimalString, uint32_t & dest)
 }
 
 // Populate numberOfChars into dest from decimalString starting at startIndex (least significant digit = left-most digit)
-static CHIP_ERROR readDigitsFromDecimalString(const std::string & decimalString, size_t & index, uint32_t & dest,
-                                              size_t numberOfCharsToRead)
+static CHIP_ERROR readDigitsFromDecimalString(CharSpan decimalString, size_t & index, uint32_t & dest, size_t numberOfCharsToRead)
 {
-    if (decimalString.length() < numberOfCharsToRead || (numberOfCharsToRead + index > decimalString.length()))
+    if (decimalString.size() < numberOfCharsToRead || (numberOfCharsToRead + index > decimalString.size()))
     {
-        ChipLogError(SetupPayload, "Failed decoding base10. Input was too short. %zu", decimalString.length());
+        ChipLogError(SetupPayload, "Failed decoding base10. Input was too short. %zu", decimalString.size());
         return CHIP_ERROR_INVALID_STRING_LENGTH;
     }
 
-    std::string decimalSubstring = decimalString.substr(index, numberOfCharsToRead);
+    const char * decimalSubstring = decimalString.data() + index;
     index += numberOfCharsToRead;
-    return toNumber(decimalSubstring, dest);
+    return toNumber(decimalSubstring, numberOfCharsToRead, dest);
 }
 
 CHIP_ERROR ManualSetupPayloadParser::populatePayload(SetupPayload & outPayload)
+{
+    return populatePayload(CharSpan(mDecimalStringRepresentation.data(), mDecimalStringRepresentation.length()), outPayload);
+}
+
+CHIP_ERROR ManualSetupPayloadParser::populatePayload(CharSpan decimalRepresentation, SetupPayload & outPayload)
 {
     CHIP_ERROR result = CHIP_NO_ERROR;
-    SetupPayload payload;
-    std::string representationWithoutCheckDigit;
+    CharSpan representationWithoutCheckDigit;
 
-    result = checkDecimalStringValidity(mDecimalStringRepresentation, representationWithoutCheckDigit);
+    result = checkDecimalStringValidity(decimalRepresentation, representationWithoutCheckDigit);
     if (result != CHIP_NO_ERROR)
     {
         return result;
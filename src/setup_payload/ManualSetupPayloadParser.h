@@ -24,6 +24,8 @@
 #include "SetupPayload.h"
 
 #include <core/CHIPError.h>
+#include <support/Span.h>
+
 #include <string>
 #include <utility>
 
@@ -41,6 +43,9 @@ private:
 public:
     ManualSetupPayloadParser(std::string decimalRepresentation) : mDecimalStringRepresentation(std::move(decimalRepresentation)) {}
     CHIP_ERROR populatePayload(SetupPayload & outPayload);
+
+    // Parses decimalRepresentation into outPayload without copying it or allocating memory.
+    static CHIP_ERROR populatePayload(CharSpan decimalRepresentation, SetupPayload & outPayload);
 };
 
 } // namespace chip
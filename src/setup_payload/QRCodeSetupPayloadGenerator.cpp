@@ -33,9 +33,12 @@
 #include <protocols/Protocols.h>
 #include <support/CodeUtils.h>
 #include <support/RandUtils.h>
+#include <support/SafeInt.h>
+#include <support/ScopedBuffer.h>
 
 #include <stdlib.h>
 #include <string.h>
+#include <utility>
 
 namespace chip {
 
@@ -64,22 +67,6 @@ exit:
     return err;
 }
 
-static CHIP_ERROR populateTLVBits(uint8_t * bits, size_t & offset, const uint8_t * tlvBuf, size_t tlvBufSizeInBytes,
-                                  size_t totalPayloadDataSizeInBits)
-{
-    CHIP_ERROR err = CHIP_NO_ERROR;
-    for (size_t i = 0; i < tlvBufSizeInBytes; i++)
-    {
-        uint8_t value = tlvBuf[i];
-        err           = populateBits(bits, offset, value, 8, totalPayloadDataSizeInBits);
-        if (err != CHIP_NO_ERROR)
-        {
-            return err;
-        }
-    }
-    return err;
-}
-
 CHIP_ERROR writeTag(TLV::TLVWriter & writer, uint64_t tag, OptionalQRCodeInfo & info)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -131,10 +118,13 @@ CHIP_ERROR writeTag(TLV::TLVWriter & writer, uint64_t tag, OptionalQRCodeInfoExt
 CHIP_ERROR QRCodeSetupPayloadGenerator::generateTLVFromOptionalData(SetupPayload & outPayload, uint8_t * tlvDataStart,
                                                                     uint32_t maxLen, size_t & tlvDataLengthInBytes)
 {
-    CHIP_ERROR err                                                 = CHIP_NO_ERROR;
-    std::vector<OptionalQRCodeInfo> optionalData                   = outPayload.getAllOptionalVendorData();
-    std::vector<OptionalQRCodeInfoExtension> optionalExtensionData = outPayload.getAllOptionalExtensionData();
-    VerifyOrExit(!optionalData.empty() || !optionalExtensionData.empty(), err = CHIP_NO_ERROR);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    std::vector<OptionalQRCodeInfo> optionalData;
+    std::vector<OptionalQRCodeInfoExtension> optionalExtensionData;
+    VerifyOrExit(!outPayload.optionalVendorData.empty() || !outPayload.optionalExtensionData.empty(), err = CHIP_NO_ERROR);
+
+    optionalData          = outPayload.getAllOptionalVendorData();
+    optionalExtensionData = outPayload.getAllOptionalExtensionData();
 
     TLV::TLVWriter rootWriter;
     rootWriter.Init(tlvDataStart, maxLen);
@@ -168,44 +158,51 @@ exit:
     return err;
 }
 
-static CHIP_ERROR generateBitSet(SetupPayload & payload, uint8_t * bits, uint8_t * tlvDataStart, size_t tlvDataLengthInBytes)
+// Populates the fixed fields of payload into the first kTotalPayloadDataSizeInBytes of bits
+static CHIP_ERROR generateFixedBitSet(SetupPayload & payload, uint8_t * bits)
 {
-    CHIP_ERROR err                = CHIP_NO_ERROR;
-    size_t offset                 = 0;
-    size_t totalPayloadSizeInBits = kTotalPayloadDataSizeInBits + (tlvDataLengthInBytes * 8);
-    err = populateBits(bits, offset, payload.version, kVersionFieldLengthInBits, kTotalPayloadDataSizeInBits);
-    err = populateBits(bits, offset, payload.vendorID, kVendorIDFieldLengthInBits, kTotalPayloadDataSizeInBits);
-    err = populateBits(bits, offset, payload.productID, kProductIDFieldLengthInBits, kTotalPayloadDataSizeInBits);
-    err = populateBits(bits, offset, payload.requiresCustomFlow, kCustomFlowRequiredFieldLengthInBits, kTotalPayloadDataSizeInBits);
-    err = populateBits(bits, offset, payload.rendezvousInformation.Raw(), kRendezvousInfoFieldLengthInBits,
-                       kTotalPayloadDataSizeInBits);
-    err = populateBits(bits, offset, payload.discriminator, kPayloadDiscriminatorFieldLengthInBits, kTotalPayloadDataSizeInBits);
-    err = populateBits(bits, offset, payload.setUpPINCode, kSetupPINCodeFieldLengthInBits, kTotalPayloadDataSizeInBits);
-    err = populateBits(bits, offset, 0, kPaddingFieldLengthInBits, kTotalPayloadDataSizeInBits);
-    err = populateTLVBits(bits, offset, tlvDataStart, tlvDataLengthInBytes, totalPayloadSizeInBits);
-    return err;
+    size_t offset = 0;
+
+    memset(bits, 0, kTotalPayloadDataSizeInBytes);
+    ReturnErrorOnFailure(populateBits(bits, offset, payload.version, kVersionFieldLengthInBits, kTotalPayloadDataSizeInBits));
+    ReturnErrorOnFailure(populateBits(bits, offset, payload.vendorID, kVendorIDFieldLengthInBits, kTotalPayloadDataSizeInBits));
+    ReturnErrorOnFailure(populateBits(bits, offset, payload.productID, kProductIDFieldLengthInBits, kTotalPayloadDataSizeInBits));
+    ReturnErrorOnFailure(populateBits(bits, offset, payload.requiresCustomFlow, kCustomFlowRequiredFieldLengthInBits,
+                                      kTotalPayloadDataSizeInBits));
+    ReturnErrorOnFailure(populateBits(bits, offset, payload.rendezvousInformation.Raw(), kRendezvousInfoFieldLengthInBits,
+                                      kTotalPayloadDataSizeInBits));
+    ReturnErrorOnFailure(populateBits(bits, offset, payload.discriminator, kPayloadDiscriminatorFieldLengthInBits,
+                                      kTotalPayloadDataSizeInBits));
+    ReturnErrorOnFailure(
+        populateBits(bits, offset, payload.setUpPINCode, kSetupPINCodeFieldLengthInBits, kTotalPayloadDataSizeInBits));
+    return populateBits(bits, offset, 0, kPaddingFieldLengthInBits, kTotalPayloadDataSizeInBits);
 }
 
-// TODO: issue #3663 - Unbounded stack in payloadBase38RepresentationWithTLV()
-#if !defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wstack-usage="
-#endif
+CHIP_ERROR QRCodeSetupPayloadGenerator::generateBitSet(uint8_t * bits, size_t bitsSize, size_t & bitsLength)
+{
+    size_t tlvDataLengthInBytes = 0;
+
+    static_assert(kTotalPayloadDataSizeInBits % 8 == 0, "TLV data is not byte aligned");
+    VerifyOrReturnError(mPayload.isValidQRCodePayload(), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(bitsSize >= kTotalPayloadDataSizeInBytes, CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(CanCastTo<uint32_t>(bitsSize - kTotalPayloadDataSizeInBytes), CHIP_ERROR_INVALID_ARGUMENT);
 
-static CHIP_ERROR payloadBase38RepresentationWithTLV(SetupPayload & setupPayload, std::string & base38Representation,
-                                                     size_t bitsetSize, uint8_t * tlvDataStart, size_t tlvDataLengthInBytes)
+    ReturnErrorOnFailure(generateTLVFromOptionalData(mPayload, bits + kTotalPayloadDataSizeInBytes,
+                                                     static_cast<uint32_t>(bitsSize - kTotalPayloadDataSizeInBytes),
+                                                     tlvDataLengthInBytes));
+    ReturnErrorOnFailure(generateFixedBitSet(mPayload, bits));
+
+    bitsLength = kTotalPayloadDataSizeInBytes + tlvDataLengthInBytes;
+    return CHIP_NO_ERROR;
+}
+
+static CHIP_ERROR encodeBitSet(const uint8_t * bits, size_t bitsLength, char * outBuffer, size_t outBufferSize)
 {
-    uint8_t bits[bitsetSize];
-    memset(bits, 0, bitsetSize);
-    std::string encodedPayload;
-    CHIP_ERROR err = generateBitSet(setupPayload, bits, tlvDataStart, tlvDataLengthInBytes);
-    SuccessOrExit(err);
+    const size_t prefixLength = strlen(kQRCodePrefix);
 
-    encodedPayload = base38Encode(bits, ArraySize(bits));
-    encodedPayload.insert(0, kQRCodePrefix);
-    base38Representation = encodedPayload;
-exit:
-    return err;
+    VerifyOrReturnError(outBufferSize > prefixLength, CHIP_ERROR_BUFFER_TOO_SMALL);
+    memcpy(outBuffer, kQRCodePrefix, prefixLength);
+    return base38Encode(ByteSpan(bits, bitsLength), outBuffer + prefixLength, outBufferSize - prefixLength);
 }
 
 CHIP_ERROR QRCodeSetupPayloadGenerator::payloadBase38Representation(std::string & base38Representation)
@@ -218,23 +215,48 @@ CHIP_ERROR QRCodeSetupPayloadGenerator::payloadBase38Representation(std::string
 CHIP_ERROR QRCodeSetupPayloadGenerator::payloadBase38Representation(std::string & base38Representation, uint8_t * tlvDataStart,
                                                                     uint32_t tlvDataStartSize)
 {
-    CHIP_ERROR err              = CHIP_NO_ERROR;
-    size_t tlvDataLengthInBytes = 0;
+    char code[kQRCodeWithoutOptionalDataBufferSize];
 
-    VerifyOrExit(mPayload.isValidQRCodePayload(), err = CHIP_ERROR_INVALID_ARGUMENT);
-    err = generateTLVFromOptionalData(mPayload, tlvDataStart, tlvDataStartSize, tlvDataLengthInBytes);
-    SuccessOrExit(err);
+    if (mPayload.optionalVendorData.empty() && mPayload.optionalExtensionData.empty())
+    {
+        ReturnErrorOnFailure(payloadBase38Representation(code, sizeof(code)));
+        base38Representation = code;
+        return CHIP_NO_ERROR;
+    }
 
-    err = payloadBase38RepresentationWithTLV(mPayload, base38Representation, kTotalPayloadDataSizeInBytes + tlvDataLengthInBytes,
-                                             tlvDataStart, tlvDataLengthInBytes);
-    SuccessOrExit(err);
+    // tlvDataStart only has room for the optional data, so the packed payload is assembled in a separate buffer.
+    chip::Platform::ScopedMemoryBuffer<uint8_t> bits;
+    size_t bitsLength = 0;
 
-exit:
-    return err;
+    VerifyOrReturnError(tlvDataStart != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    bits.Alloc(kTotalPayloadDataSizeInBytes + tlvDataStartSize);
+    VerifyOrReturnError(bits, CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(generateBitSet(bits.Get(), kTotalPayloadDataSizeInBytes + tlvDataStartSize, bitsLength));
+    memcpy(tlvDataStart, bits.Get() + kTotalPayloadDataSizeInBytes, bitsLength - kTotalPayloadDataSizeInBytes);
+
+    std::string encodedPayload(strlen(kQRCodePrefix) + base38EncodedLength(bitsLength) + 1, '\0');
+    ReturnErrorOnFailure(encodeBitSet(bits.Get(), bitsLength, &encodedPayload[0], encodedPayload.length()));
+    encodedPayload.resize(encodedPayload.length() - 1);
+
+    base38Representation = std::move(encodedPayload);
+    return CHIP_NO_ERROR;
 }
 
-#if !defined(__clang__)
-#pragma GCC diagnostic pop // -Wstack-usage
-#endif
+CHIP_ERROR QRCodeSetupPayloadGenerator::payloadBase38Representation(char * outBuffer, size_t outBufferSize)
+{
+    uint8_t bits[kTotalPayloadDataSizeInBytes];
+
+    return payloadBase38Representation(outBuffer, outBufferSize, bits, sizeof(bits));
+}
+
+CHIP_ERROR QRCodeSetupPayloadGenerator::payloadBase38Representation(char * outBuffer, size_t outBufferSize, uint8_t * bitsBuffer,
+                                                                    size_t bitsBufferSize)
+{
+    size_t bitsLength = 0;
+
+    ReturnErrorOnFailure(generateBitSet(bitsBuffer, bitsBufferSize, bitsLength));
+    return encodeBitSet(bitsBuffer, bitsLength, outBuffer, outBufferSize);
+}
 
 } // namespace chip
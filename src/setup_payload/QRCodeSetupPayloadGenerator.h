@@ -27,6 +27,7 @@
  *        single byte is encoded to 2 characters of the Base-38 alphabet.
  */
 
+#include "Base38.h"
 #include "SetupPayload.h"
 
 #include <string>
@@ -35,6 +36,12 @@
 
 namespace chip {
 
+/**
+ * Size of a buffer that holds the NUL-terminated QR code of a payload without optional data.
+ */
+constexpr size_t kQRCodeWithoutOptionalDataBufferSize =
+    sizeof("CH:") - 1 + base38EncodedLength(kTotalPayloadDataSizeInBytes) + 1;
+
 class QRCodeSetupPayloadGenerator
 {
 private:
@@ -82,9 +89,51 @@ public:
      */
     CHIP_ERROR payloadBase38Representation(std::string & base38Representation, uint8_t * tlvDataStart, uint32_t tlvDataStartSize);
 
+    /**
+     * This function is called to encode a payload without optional data to
+     * a NUL-terminated base38 string, without allocating memory.
+     *
+     * @param[out] outBuffer
+     *                  The buffer to write the base38 string to.
+     * @param[in]  outBufferSize
+     *                  The size of outBuffer, at least
+     *                  kQRCodeWithoutOptionalDataBufferSize.
+     *
+     * @retval #CHIP_NO_ERROR if the method succeeded.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT if the payload is invalid.
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL if outBuffer is too small, or the
+     *               payload has optional data.
+     */
+    CHIP_ERROR payloadBase38Representation(char * outBuffer, size_t outBufferSize);
+
+    /**
+     * This function is called to encode a payload, with its optional data,
+     * to a NUL-terminated base38 string, without allocating memory.
+     *
+     * @param[out] outBuffer
+     *                  The buffer to write the base38 string to.
+     * @param[in]  outBufferSize
+     *                  The size of outBuffer.
+     * @param[in]  bitsBuffer
+     *                  A scratch buffer the packed binary payload is built
+     *                  in: chip::kTotalPayloadDataSizeInBytes followed by the
+     *                  TLV encoded optional data.
+     * @param[in]  bitsBufferSize
+     *                  The size of bitsBuffer.
+     *
+     * @retval #CHIP_NO_ERROR if the method succeeded.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT if the payload is invalid.
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL if either buffer is too small.
+     * @retval other Other CHIP or platform-specific error codes indicating
+     *               that an error occurred preventing the function from
+     *               producing the requested string.
+     */
+    CHIP_ERROR payloadBase38Representation(char * outBuffer, size_t outBufferSize, uint8_t * bitsBuffer, size_t bitsBufferSize);
+
 private:
     CHIP_ERROR generateTLVFromOptionalData(SetupPayload & outPayload, uint8_t * tlvDataStart, uint32_t maxLen,
                                            size_t & tlvDataLengthInBytes);
+    CHIP_ERROR generateBitSet(uint8_t * bits, size_t bitsSize, size_t & bitsLength);
 };
 
 } // namespace chip
@@ -24,10 +24,7 @@
 #include "QRCodeSetupPayloadParser.h"
 #include "Base38.h"
 
-#include <math.h>
-#include <memory>
 #include <string.h>
-#include <vector>
 
 #include <core/CHIPCore.h>
 #include <core/CHIPError.h>
@@ -42,13 +39,13 @@
 namespace chip {
 
 // Populate numberOfBits into dest from buf starting at startIndex
-static CHIP_ERROR readBits(std::vector<uint8_t> buf, size_t & index, uint64_t & dest, size_t numberOfBitsToRead)
+static CHIP_ERROR readBits(const uint8_t * buf, size_t bufLen, size_t & index, uint64_t & dest, size_t numberOfBitsToRead)
 {
     dest = 0;
-    if (index + numberOfBitsToRead > buf.size() * 8 || numberOfBitsToRead > sizeof(uint64_t) * 8)
+    if (index + numberOfBitsToRead > bufLen * 8 || numberOfBitsToRead > sizeof(uint64_t) * 8)
     {
-        ChipLogError(SetupPayload, "Error parsing QR code. startIndex %d numberOfBitsToLoad %zu buf_len %zu ", index,
-                     numberOfBitsToRead, buf.size());
+        ChipLogError(SetupPayload, "Error parsing QR code. startIndex %zu numberOfBitsToLoad %zu buf_len %zu ", index,
+                     numberOfBitsToRead, bufLen);
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
 
@@ -57,7 +54,7 @@ static CHIP_ERROR readBits(std::vector<uint8_t> buf, size_t & index, uint64_t &
     {
         if (buf[currentIndex / 8] & (1 << (currentIndex % 8)))
         {
-            dest |= (1 << bitsRead);
+            dest |= (static_cast<uint64_t>(1) << bitsRead);
         }
         currentIndex++;
     }
@@ -256,7 +253,8 @@ exit:
     return err;
 }
 
-CHIP_ERROR QRCodeSetupPayloadParser::parseTLVFields(SetupPayload & outPayload, uint8_t * tlvDataStart, size_t tlvDataLengthInBytes)
+CHIP_ERROR QRCodeSetupPayloadParser::parseTLVFields(SetupPayload & outPayload, const uint8_t * tlvDataStart,
+                                                    size_t tlvDataLengthInBytes)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     if (!CanCastTo<uint32_t>(tlvDataLengthInBytes))
@@ -288,117 +286,127 @@ exit:
     return err;
 }
 
-CHIP_ERROR QRCodeSetupPayloadParser::populateTLV(SetupPayload & outPayload, const std::vector<uint8_t> & buf, size_t & index)
+CHIP_ERROR QRCodeSetupPayloadParser::populateTLV(SetupPayload & outPayload, const uint8_t * buf, size_t bufLen, size_t & index)
 {
-    size_t bitsLeftToRead = (buf.size() * 8) - index;
-    size_t tlvBytesLength = (bitsLeftToRead + 7) / 8; // ceil(bitsLeftToRead/8)
-    chip::Platform::ScopedMemoryBuffer<uint8_t> tlvArray;
+    // The fixed fields, padding included, end on a byte boundary, so the TLV data can be parsed in place.
+    static_assert(kTotalPayloadDataSizeInBits % 8 == 0, "TLV data is not byte aligned");
+    VerifyOrReturnError(index % 8 == 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t tlvBytesLength = bufLen - index / 8;
 
     ReturnErrorCodeIf(tlvBytesLength == 0, CHIP_NO_ERROR);
 
-    tlvArray.Alloc(tlvBytesLength);
-    ReturnErrorCodeIf(!tlvArray, CHIP_ERROR_NO_MEMORY);
+    const uint8_t * tlvData = buf + index / 8;
+    index += tlvBytesLength * 8;
 
-    for (size_t i = 0; i < tlvBytesLength; i++)
-    {
-        uint64_t dest;
-        readBits(buf, index, dest, 8);
-        tlvArray[i] = static_cast<uint8_t>(dest);
-    }
-
-    return parseTLVFields(outPayload, tlvArray.Get(), tlvBytesLength);
+    return parseTLVFields(outPayload, tlvData, tlvBytesLength);
 }
 
-static std::string extractPayload(std::string inString)
+// Find the first segment between '%' delimiters that starts with kQRCodePrefix, and return it without the prefix
+static CharSpan extractPayload(CharSpan inString)
 {
-    std::string chipSegment;
-    char delimiter = '%';
-    std::vector<size_t> startIndices;
-    startIndices.push_back(0);
+    const size_t prefixLength = strlen(kQRCodePrefix);
+    const char * segment      = inString.data();
+    const char * end          = inString.data() + inString.size();
 
-    for (size_t i = 0; i < inString.length(); i++)
+    if (inString.size() == 0)
     {
-        if (inString[i] == delimiter)
-        {
-            startIndices.push_back(i + 1);
-        }
+        return CharSpan();
     }
 
-    // Find the first string between delimiters that starts with kQRCodePrefix
-    for (size_t i = 0; i < startIndices.size(); i++)
+    while (true)
     {
-        size_t startIndex   = startIndices[i];
-        size_t endIndex     = (i == startIndices.size() - 1 ? std::string::npos : startIndices[i + 1] - 1);
-        size_t length       = (endIndex != std::string::npos ? endIndex - startIndex : std::string::npos);
-        std::string segment = inString.substr(startIndex, length);
+        const char * segmentEnd = static_cast<const char *>(memchr(segment, '%', static_cast<size_t>(end - segment)));
+        if (segmentEnd == nullptr)
+        {
+            segmentEnd = end;
+        }
 
-        // Find a segment that starts with kQRCodePrefix
-        if (segment.find(kQRCodePrefix, 0) == 0 && segment.length() > strlen(kQRCodePrefix))
+        size_t segmentLength = static_cast<size_t>(segmentEnd - segment);
+        if (segmentLength > prefixLength && memcmp(segment, kQRCodePrefix, prefixLength) == 0)
         {
-            chipSegment = segment;
-            break;
+            return CharSpan(segment + prefixLength, segmentLength - prefixLength);
         }
-    }
 
-    if (chipSegment.length() > 0)
-    {
-        return chipSegment.substr(strlen(kQRCodePrefix)); // strip out prefix before returning
+        if (segmentEnd == end)
+        {
+            break;
+        }
+        segment = segmentEnd + 1;
     }
 
-    return chipSegment;
+    return CharSpan();
 }
 
 CHIP_ERROR QRCodeSetupPayloadParser::populatePayload(SetupPayload & outPayload)
 {
-    std::vector<uint8_t> buf;
+    return populatePayload(CharSpan(mBase38Representation.data(), mBase38Representation.length()), outPayload);
+}
+
+CHIP_ERROR QRCodeSetupPayloadParser::populatePayload(CharSpan base38Representation, SetupPayload & outPayload)
+{
+    // Payloads carrying little optional data are decoded on the stack; longer ones need a heap buffer.
+    uint8_t stackBuf[kQRCodeParserStackBufferSize];
+    chip::Platform::ScopedMemoryBuffer<uint8_t> heapBuf;
+    uint8_t * buf          = stackBuf;
+    size_t bufSize         = sizeof(stackBuf);
+    size_t bufLen          = 0;
     CHIP_ERROR err         = CHIP_NO_ERROR;
     size_t indexToReadFrom = 0;
     uint64_t dest;
 
-    std::string payload = extractPayload(mBase38Representation);
-    VerifyOrExit(payload.length() != 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+    CharSpan payload = extractPayload(base38Representation);
+    VerifyOrExit(payload.size() != 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (base38DecodedLength(payload.size()) > bufSize)
+    {
+        bufSize = base38DecodedLength(payload.size());
+        heapBuf.Alloc(bufSize);
+        VerifyOrExit(heapBuf, err = CHIP_ERROR_NO_MEMORY);
+        buf = heapBuf.Get();
+    }
 
-    err = base38Decode(payload, buf);
+    err = base38Decode(payload, buf, bufSize, bufLen);
     SuccessOrExit(err);
 
-    err = readBits(buf, indexToReadFrom, dest, kVersionFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kVersionFieldLengthInBits);
     SuccessOrExit(err);
     static_assert(kVersionFieldLengthInBits <= 8, "Won't fit in uint8_t");
     outPayload.version = static_cast<uint8_t>(dest);
 
-    err = readBits(buf, indexToReadFrom, dest, kVendorIDFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kVendorIDFieldLengthInBits);
     SuccessOrExit(err);
     static_assert(kVendorIDFieldLengthInBits <= 16, "Won't fit in uint16_t");
     outPayload.vendorID = static_cast<uint16_t>(dest);
 
-    err = readBits(buf, indexToReadFrom, dest, kProductIDFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kProductIDFieldLengthInBits);
     SuccessOrExit(err);
     static_assert(kProductIDFieldLengthInBits <= 16, "Won't fit in uint16_t");
     outPayload.productID = static_cast<uint16_t>(dest);
 
-    err = readBits(buf, indexToReadFrom, dest, kCustomFlowRequiredFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kCustomFlowRequiredFieldLengthInBits);
     SuccessOrExit(err);
     static_assert(kCustomFlowRequiredFieldLengthInBits <= 8, "Won't fit in uint8_t");
     outPayload.requiresCustomFlow = static_cast<uint8_t>(dest);
 
-    err = readBits(buf, indexToReadFrom, dest, kRendezvousInfoFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kRendezvousInfoFieldLengthInBits);
     SuccessOrExit(err);
     outPayload.rendezvousInformation = RendezvousInformationFlags(static_cast<RendezvousInformationFlag>(dest));
 
-    err = readBits(buf, indexToReadFrom, dest, kPayloadDiscriminatorFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kPayloadDiscriminatorFieldLengthInBits);
     SuccessOrExit(err);
     static_assert(kPayloadDiscriminatorFieldLengthInBits <= 16, "Won't fit in uint16_t");
     outPayload.discriminator = static_cast<uint16_t>(dest);
 
-    err = readBits(buf, indexToReadFrom, dest, kSetupPINCodeFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kSetupPINCodeFieldLengthInBits);
     SuccessOrExit(err);
     static_assert(kSetupPINCodeFieldLengthInBits <= 32, "Won't fit in uint32_t");
     outPayload.setUpPINCode = static_cast<uint32_t>(dest);
 
-    err = readBits(buf, indexToReadFrom, dest, kPaddingFieldLengthInBits);
+    err = readBits(buf, bufLen, indexToReadFrom, dest, kPaddingFieldLengthInBits);
     SuccessOrExit(err);
 
-    err = populateTLV(outPayload, buf, indexToReadFrom);
+    err = populateTLV(outPayload, buf, bufLen, indexToReadFrom);
     SuccessOrExit(err);
 
 exit:
@@ -25,12 +25,19 @@
 
 #include <core/CHIPError.h>
 #include <core/CHIPTLV.h>
+#include <support/Span.h>
 
 #include <string>
 #include <utility>
 
 namespace chip {
 
+/**
+ * Size of the buffer QRCodeSetupPayloadParser decodes payloads into on the stack. The fixed fields take
+ * kTotalPayloadDataSizeInBytes; payloads with more optional data than fits in the rest are decoded into a heap buffer.
+ */
+constexpr size_t kQRCodeParserStackBufferSize = 64;
+
 /**
  * @class QRCodeSetupPayloadParser
  * A class that can be used to convert a base38 encoded payload to a SetupPayload object
@@ -44,10 +51,17 @@ public:
     QRCodeSetupPayloadParser(std::string base38Representation) : mBase38Representation(std::move(base38Representation)) {}
     CHIP_ERROR populatePayload(SetupPayload & outPayload);
 
+    /**
+     * Parse a QR code, with or without other '%'-separated segments, into @p outPayload. Unlike the member
+     * populatePayload, this does not copy the code, and only allocates memory for optional data that does not fit in
+     * kQRCodeParserStackBufferSize bytes or that holds strings.
+     */
+    static CHIP_ERROR populatePayload(CharSpan base38Representation, SetupPayload & outPayload);
+
 private:
-    CHIP_ERROR retrieveOptionalInfos(SetupPayload & outPayload, TLV::TLVReader & reader);
-    CHIP_ERROR populateTLV(SetupPayload & outPayload, const std::vector<uint8_t> & buf, size_t & index);
-    CHIP_ERROR parseTLVFields(chip::SetupPayload & outPayload, uint8_t * tlvDataStart, size_t tlvDataLengthInBytes);
+    static CHIP_ERROR retrieveOptionalInfos(SetupPayload & outPayload, TLV::TLVReader & reader);
+    static CHIP_ERROR populateTLV(SetupPayload & outPayload, const uint8_t * buf, size_t bufLen, size_t & index);
+    static CHIP_ERROR parseTLVFields(chip::SetupPayload & outPayload, const uint8_t * tlvDataStart, size_t tlvDataLengthInBytes);
 };
 
 } // namespace chip
@@ -27,6 +27,7 @@
 #include <core/CHIPTLV.h>
 #include <core/CHIPTLVData.hpp>
 #include <core/CHIPTLVUtilities.hpp>
+#include <crypto/CHIPCryptoPAL.h>
 #include <support/CodeUtils.h>
 #include <support/RandUtils.h>
 #include <utility>
@@ -43,6 +44,55 @@ bool IsVendorTag(uint8_t tag)
     return tag < (1 << kRawVendorTagLengthInBits);
 }
 
+namespace {
+
+// 32-bit values above this limit are discarded, so that the remaining ones cover every setup PIN code equally often
+constexpr uint32_t kSetupPINCodeRandomLimit = UINT32_MAX - (UINT32_MAX % (kMaxSetupPINCode + 1)) - 1;
+
+} // namespace
+
+bool IsValidSetupPINCode(uint32_t setUpPINCode)
+{
+    // Codes that are trivial to guess are not allowed
+    switch (setUpPINCode)
+    {
+    case 0:
+    case 11111111:
+    case 22222222:
+    case 33333333:
+    case 44444444:
+    case 55555555:
+    case 66666666:
+    case 77777777:
+    case 88888888:
+    case 12345678:
+    case 87654321:
+        return false;
+    default:
+        return setUpPINCode <= kMaxSetupPINCode;
+    }
+}
+
+bool SetupPINCodeFromRandom(uint32_t value, uint32_t & setUpPINCode)
+{
+    VerifyOrReturnError(value <= kSetupPINCodeRandomLimit, false);
+
+    setUpPINCode = value % (kMaxSetupPINCode + 1);
+    return IsValidSetupPINCode(setUpPINCode);
+}
+
+CHIP_ERROR GenerateRandomSetupPINCode(uint32_t & setUpPINCode)
+{
+    uint32_t value;
+
+    do
+    {
+        ReturnErrorOnFailure(Crypto::DRBG_get_bytes(reinterpret_cast<uint8_t *>(&value), sizeof(value)));
+    } while (!SetupPINCodeFromRandom(value, setUpPINCode));
+
+    return CHIP_NO_ERROR;
+}
+
 // Check the Setup Payload for validity
 //
 // `vendor_id` and `product_id` are allowed all of uint16_t
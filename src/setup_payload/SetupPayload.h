@@ -69,6 +69,9 @@ const uint8_t kSerialNumberTag = 128;
 // The largest value of the 12-bit Payload discriminator
 const uint16_t kMaxDiscriminatorValue = 0xFFF;
 
+// The largest setup PIN code; 99999999 is reserved
+const uint32_t kMaxSetupPINCode = 99999998;
+
 // clang-format off
 const int kTotalPayloadDataSizeInBits =
     kVersionFieldLengthInBits +
@@ -138,6 +141,23 @@ struct OptionalQRCodeInfoExtension : OptionalQRCodeInfo
 bool IsCHIPTag(uint8_t tag);
 bool IsVendorTag(uint8_t tag);
 
+/**
+ * Check that @p setUpPINCode is in range and is not one of the codes that are trivial to guess.
+ */
+bool IsValidSetupPINCode(uint32_t setUpPINCode);
+
+/**
+ * Map a uniformly distributed 32-bit value to a valid setup PIN code, keeping all valid codes equally likely.
+ *
+ * @return false if @p value must be discarded and another one drawn.
+ */
+bool SetupPINCodeFromRandom(uint32_t value, uint32_t & setUpPINCode);
+
+/**
+ * Draw a valid setup PIN code from the DRBG, all valid codes being equally likely.
+ */
+CHIP_ERROR GenerateRandomSetupPINCode(uint32_t & setUpPINCode);
+
 class SetupPayload
 {
 
@@ -22,12 +22,13 @@
 
 #pragma once
 
-#include <core/CHIPError.h>
-#include <string>
+#include "SetupPayload.h"
 
+#include <core/CHIPError.h>
 #include <string>
 
 namespace chip {
+CHIP_ERROR loadPayloadFromFile(SetupPayload & setupPayload, const std::string & filePath);
 CHIP_ERROR generateQRCodeFromFilePath(std::string filePath, std::string & outCode);
 CHIP_ERROR generateManualCodeFromFilePath(std::string filePath, std::string & outCode);
 } // namespace chip
@@ -22,8 +22,10 @@
  *
  */
 
+#include <math.h>
 #include <nlunit-test.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <setup_payload/ManualSetupPayloadGenerator.cpp>
 #include <setup_payload/ManualSetupPayloadParser.cpp>
@@ -337,6 +339,38 @@ void TestLongCodeReadWrite(nlTestSuite * inSuite, void * context)
     NL_TEST_ASSERT(inSuite, inPayload == outPayload);
 }
 
+void TestCodeReadWriteToBuffer(nlTestSuite * inSuite, void * context)
+{
+    SetupPayload inPayload = GetDefaultPayload();
+    SetupPayload outPayload;
+    std::string expected;
+    char result[kManualSetupCodeBufferSize];
+
+    ManualSetupPayloadGenerator(inPayload).payloadDecimalStringRepresentation(expected);
+    NL_TEST_ASSERT(inSuite, ManualSetupPayloadGenerator(inPayload).payloadDecimalStringRepresentation(result, sizeof(result)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, expected == result);
+    NL_TEST_ASSERT(inSuite,
+                   ManualSetupPayloadParser::populatePayload(CharSpan(result, strlen(result)), outPayload) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, inPayload == outPayload);
+
+    inPayload.requiresCustomFlow = true;
+    inPayload.vendorID           = 65535;
+    inPayload.productID          = 1;
+
+    ManualSetupPayloadGenerator(inPayload).payloadDecimalStringRepresentation(expected);
+    NL_TEST_ASSERT(inSuite, ManualSetupPayloadGenerator(inPayload).payloadDecimalStringRepresentation(result, sizeof(result)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, expected == result);
+    NL_TEST_ASSERT(inSuite,
+                   ManualSetupPayloadParser::populatePayload(CharSpan(result, strlen(result)), outPayload) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, inPayload == outPayload);
+
+    NL_TEST_ASSERT(inSuite,
+                   ManualSetupPayloadGenerator(inPayload).payloadDecimalStringRepresentation(result, sizeof(result) - 1) ==
+                       CHIP_ERROR_BUFFER_TOO_SMALL);
+}
+
 void TestPayloadParser_InvalidEntry(nlTestSuite * inSuite, void * inContext)
 {
     SetupPayload payload;
@@ -388,96 +422,168 @@ void TestPayloadParser_InvalidEntry(nlTestSuite * inSuite, void * inContext)
                                 CHIP_ERROR_INTEGRITY_CHECK_FAILED, payload);
 }
 
+CharSpan ToSpan(const std::string & str)
+{
+    return CharSpan(str.data(), str.length());
+}
+
+CharSpan ToSpan(const char * str)
+{
+    return CharSpan(str, strlen(str));
+}
+
+CHIP_ERROR ToNumber(const char * decimalString, uint32_t & dest)
+{
+    return toNumber(decimalString, strlen(decimalString), dest);
+}
+
 void TestCheckDecimalStringValidity(nlTestSuite * inSuite, void * inContext)
 {
-    std::string outReprensation;
+    CharSpan outReprensation;
     char checkDigit;
     std::string representationWithoutCheckDigit;
     std::string decimalString;
 
     representationWithoutCheckDigit = "";
-    NL_TEST_ASSERT(
-        inSuite, checkDecimalStringValidity(representationWithoutCheckDigit, outReprensation) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite,
+                   checkDecimalStringValidity(ToSpan(representationWithoutCheckDigit), outReprensation) ==
+                       CHIP_ERROR_INVALID_STRING_LENGTH);
 
     representationWithoutCheckDigit = "1";
-    NL_TEST_ASSERT(
-        inSuite, checkDecimalStringValidity(representationWithoutCheckDigit, outReprensation) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite,
+                   checkDecimalStringValidity(ToSpan(representationWithoutCheckDigit), outReprensation) ==
+                       CHIP_ERROR_INVALID_STRING_LENGTH);
 
     representationWithoutCheckDigit = "10109";
     checkDigit                      = Verhoeff10::ComputeCheckChar(representationWithoutCheckDigit.c_str());
     decimalString                   = representationWithoutCheckDigit + checkDigit;
-    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(decimalString, outReprensation) == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, outReprensation == representationWithoutCheckDigit);
+    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(ToSpan(decimalString), outReprensation) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, std::string(outReprensation.data(), outReprensation.size()) == representationWithoutCheckDigit);
 
     representationWithoutCheckDigit = "0000";
     checkDigit                      = Verhoeff10::ComputeCheckChar(representationWithoutCheckDigit.c_str());
     decimalString                   = representationWithoutCheckDigit + checkDigit;
-    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(decimalString, outReprensation) == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, outReprensation == representationWithoutCheckDigit);
+    NL_TEST_ASSERT(inSuite, checkDecimalStringValidity(ToSpan(decimalString), outReprensation) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, std::string(outReprensation.data(), outReprensation.size()) == representationWithoutCheckDigit);
+}
+
+void TestCheckDigitBatchValidation(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kCodeCount = 23;
+    constexpr size_t kStride    = kManualSetupLongCodeCharLength + 2;
+    uint8_t permTable[]         = { 1, 5, 7, 6, 2, 8, 3, 0, 9, 4 };
+    char codes[kCodeCount][kStride];
+    bool results[kCodeCount];
+    uint32_t seed = 12345;
+
+    // Check digits computed with the combined tables match the reference algorithm, for every length and phase.
+    for (size_t len = 1; len <= kManualSetupLongCodeCharLength; len++)
+    {
+        for (size_t n = 0; n < kCodeCount; n++)
+        {
+            int expected = 0;
+            for (size_t i = 0; i < len; i++)
+            {
+                seed        = seed * 1103515245 + 12345;
+                codes[n][i] = static_cast<char>('0' + (seed >> 16) % 10);
+            }
+            for (size_t i = 1; i <= len; i++)
+            {
+                int permuted = Verhoeff::Permute(codes[n][len - i] - '0', permTable, Verhoeff10::Base, i);
+                expected     = Verhoeff::DihedralMultiply(expected, permuted, Verhoeff10::PolygonSize);
+            }
+            expected          = Verhoeff::DihedralInvert(expected, Verhoeff10::PolygonSize);
+            codes[n][len]     = Verhoeff10::ComputeCheckChar(codes[n], len);
+            codes[n][len + 1] = '\0';
+            NL_TEST_ASSERT(inSuite, codes[n][len] == Verhoeff10::ValToChar(expected));
+        }
+
+        // Corrupt a few codes: a single digit, the check digit, a non-digit character and a transposition.
+        codes[1][0]       = static_cast<char>('0' + (codes[1][0] - '0' + 1) % 10);
+        codes[6][len]     = static_cast<char>('0' + (codes[6][len] - '0' + 5) % 10);
+        codes[9][len / 2] = 'A';
+        bool transposed   = (codes[14][0] != codes[14][1]);
+        if (transposed)
+        {
+            std::swap(codes[14][0], codes[14][1]);
+        }
+
+        size_t validCount = Verhoeff10::ValidateCheckChars(&codes[0][0], len + 1, kStride, kCodeCount, results);
+        NL_TEST_ASSERT(inSuite, validCount == kCodeCount - (transposed ? 4 : 3));
+        for (size_t n = 0; n < kCodeCount; n++)
+        {
+            NL_TEST_ASSERT(inSuite, results[n] == Verhoeff10::ValidateCheckChar(codes[n]));
+            NL_TEST_ASSERT(inSuite, results[n] == (n != 1 && n != 6 && n != 9 && !(n == 14 && transposed)));
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, Verhoeff10::ValidateCheckChars(&codes[0][0], 0, kStride, kCodeCount, results) == 0);
+    NL_TEST_ASSERT(inSuite, !results[0] && !results[kCodeCount - 1]);
 }
 
 void TestCheckCodeLengthValidity(nlTestSuite * inSuite, void * inContext)
 {
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("01234567890123456789", true) == CHIP_NO_ERROR);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("0123456789", false) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(ToSpan("01234567890123456789"), true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(ToSpan("0123456789"), false) == CHIP_NO_ERROR);
 
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("01234567891", false) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("012345678", false) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("012345678901234567891", true) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity("0123456789012345678", true) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(ToSpan("01234567891"), false) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(ToSpan("012345678"), false) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(ToSpan("012345678901234567891"), true) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, checkCodeLengthValidity(ToSpan("0123456789012345678"), true) == CHIP_ERROR_INVALID_STRING_LENGTH);
 }
 
 void TestDecimalStringToNumber(nlTestSuite * inSuite, void * inContext)
 {
     uint32_t number;
-    NL_TEST_ASSERT(inSuite, toNumber("12345", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ToNumber("12345", number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 12345);
 
-    NL_TEST_ASSERT(inSuite, toNumber("01234567890", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ToNumber("01234567890", number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1234567890);
 
-    NL_TEST_ASSERT(inSuite, toNumber("00000001", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ToNumber("00000001", number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1);
 
-    NL_TEST_ASSERT(inSuite, toNumber("0", number) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ToNumber("0", number) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 0);
 
-    NL_TEST_ASSERT(inSuite, toNumber("012345.123456789", number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
-    NL_TEST_ASSERT(inSuite, toNumber("/", number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
+    NL_TEST_ASSERT(inSuite, ToNumber("012345.123456789", number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
+    NL_TEST_ASSERT(inSuite, ToNumber("/", number) == CHIP_ERROR_INVALID_INTEGER_VALUE);
 }
 
 void TestReadCharsFromDecimalString(nlTestSuite * inSuite, void * inContext)
 {
     uint32_t number;
     size_t index = 3;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12345", index, number, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("12345"), index, number, 2) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 45);
 
     index = 2;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("6256276377282", index, number, 7) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("6256276377282"), index, number, 7) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 5627637);
 
     index = 0;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("10", index, number, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("10"), index, number, 2) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 10);
 
     index = 0;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("01", index, number, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("01"), index, number, 2) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1);
 
     index = 1;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("11", index, number, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("11"), index, number, 1) == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, number == 1);
 
     index = 2;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("100001", index, number, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("100001"), index, number, 3) == CHIP_NO_ERROR);
 
     index = 1;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12345", index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("12", index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("12345"), index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString(ToSpan("12"), index, number, 5) == CHIP_ERROR_INVALID_STRING_LENGTH);
 
     index = 200;
-    NL_TEST_ASSERT(inSuite, readDigitsFromDecimalString("6256276377282", index, number, 1) == CHIP_ERROR_INVALID_STRING_LENGTH);
+    NL_TEST_ASSERT(inSuite,
+                   readDigitsFromDecimalString(ToSpan("6256276377282"), index, number, 1) == CHIP_ERROR_INVALID_STRING_LENGTH);
 }
 
 void TestShortCodeCharLengths(nlTestSuite * inSuite, void * inContext)
@@ -517,7 +623,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test Invalid Entry To QR Code Parser",                                 TestPayloadParser_InvalidEntry),
     NL_TEST_DEF("Test Short Read Write",                                                TestShortCodeReadWrite),
     NL_TEST_DEF("Test Long Read Write",                                                 TestLongCodeReadWrite),
+    NL_TEST_DEF("Test Read Write To Buffer",                                            TestCodeReadWriteToBuffer),
     NL_TEST_DEF("Check Decimal String Validity",                                        TestCheckDecimalStringValidity),
+    NL_TEST_DEF("Check Digit Batch Validation",                                         TestCheckDigitBatchValidation),
     NL_TEST_DEF("Check QR Code Length Validity",                                        TestCheckCodeLengthValidity),
     NL_TEST_DEF("Test Decimal String to Number",                                        TestDecimalStringToNumber),
     NL_TEST_DEF("Test Short Code Character Lengths",                                    TestShortCodeCharLengths),
@@ -85,6 +85,47 @@ void TestPayloadBase38Rep(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, result == expected);
 }
 
+void TestPayloadBase38RepToBuffer(nlTestSuite * inSuite, void * inContext)
+{
+    SetupPayload payload = GetDefaultPayload();
+    SetupPayload outPayload;
+
+    QRCodeSetupPayloadGenerator generator(payload);
+    char result[kQRCodeWithoutOptionalDataBufferSize];
+    NL_TEST_ASSERT(inSuite, generator.payloadBase38Representation(result, sizeof(result)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(result, "CH:R5L90UV200A3L900000") == 0);
+    NL_TEST_ASSERT(inSuite, generator.payloadBase38Representation(result, sizeof(result) - 1) == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    NL_TEST_ASSERT(inSuite,
+                   QRCodeSetupPayloadParser::populatePayload(CharSpan(result, strlen(result)), outPayload) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, payload == outPayload);
+}
+
+void TestPayloadBase38RepToBufferWithOptionalData(nlTestSuite * inSuite, void * inContext)
+{
+    SetupPayload payload = GetDefaultPayloadWithOptionalDefaults();
+    // Long enough that the parser decodes it into a heap buffer
+    payload.addOptionalVendorData(kOptionalDefaultStringTag + 10, string(kQRCodeParserStackBufferSize, 'x'));
+
+    QRCodeSetupPayloadGenerator generator(payload);
+    string expected;
+    uint8_t optionalInfo[kDefaultBufferSizeInBytes];
+    NL_TEST_ASSERT(inSuite, generator.payloadBase38Representation(expected, optionalInfo, sizeof(optionalInfo)) == CHIP_NO_ERROR);
+
+    char result[2 * kDefaultBufferSizeInBytes];
+    uint8_t bits[kDefaultBufferSizeInBytes];
+    NL_TEST_ASSERT(inSuite, generator.payloadBase38Representation(result, sizeof(result), bits, sizeof(bits)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, expected == result);
+
+    // Optional data does not fit without a scratch buffer
+    NL_TEST_ASSERT(inSuite, generator.payloadBase38Representation(result, sizeof(result)) != CHIP_NO_ERROR);
+
+    SetupPayload outPayload;
+    NL_TEST_ASSERT(inSuite, QRCodeSetupPayloadParser::populatePayload(CharSpan(expected.data(), expected.length()), outPayload) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, payload == outPayload);
+}
+
 void TestBase38(nlTestSuite * inSuite, void * inContext)
 {
     uint8_t input[] = { 10, 10, 10 };
@@ -191,6 +232,29 @@ void TestBase38(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, decoded.size() == 2 && decoded[0] + decoded[1] * 256 == (kRadix * kRadix) - 1);
 }
 
+void TestBase38Buffers(nlTestSuite * inSuite, void * inContext)
+{
+    const uint8_t input[] = { 'H', 'e', 'l', 'l', 'o', ' ', 'W', 'o', 'r', 'l', 'd', '!' };
+    char encoded[base38EncodedLength(sizeof(input)) + 1];
+    uint8_t decoded[base38DecodedLength(base38EncodedLength(sizeof(input)))];
+    size_t decodedLength = 0;
+
+    NL_TEST_ASSERT(inSuite, base38Encode(ByteSpan(input), encoded, sizeof(encoded)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(encoded, "KKHF3W2S013OPM3EJX11") == 0);
+    NL_TEST_ASSERT(inSuite, base38Encode(ByteSpan(input), encoded, sizeof(encoded) - 1) == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    NL_TEST_ASSERT(inSuite,
+                   base38Decode(CharSpan(encoded, strlen(encoded)), decoded, sizeof(decoded), decodedLength) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, decodedLength == sizeof(input) && memcmp(decoded, input, sizeof(input)) == 0);
+    NL_TEST_ASSERT(inSuite,
+                   base38Decode(CharSpan(encoded, strlen(encoded)), decoded, sizeof(decoded) - 1, decodedLength) ==
+                       CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // A chunk of 1 or 3 characters does not decode to whole bytes
+    NL_TEST_ASSERT(inSuite,
+                   base38Decode(CharSpan("A0A", 3), decoded, sizeof(decoded), decodedLength) == CHIP_ERROR_INVALID_STRING_LENGTH);
+}
+
 void TestBitsetLen(nlTestSuite * inSuite, void * inContext)
 {
     NL_TEST_ASSERT(inSuite, kTotalPayloadDataSizeInBits % 8 == 0);
@@ -296,25 +360,57 @@ void TestQRCodeToPayloadGeneration(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, result == true);
 }
 
+string ExtractPayload(const char * qrCode)
+{
+    CharSpan payload = extractPayload(CharSpan(qrCode, strlen(qrCode)));
+    return payload.size() == 0 ? string() : string(payload.data(), payload.size());
+}
+
 void TestExtractPayload(nlTestSuite * inSuite, void * inContext)
 {
-    NL_TEST_ASSERT(inSuite, extractPayload(string("CH:ABC")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("CH:")) == string(""));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("H:")) == string(""));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("ASCH:")) == string(""));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("Z%CH:ABC%")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("Z%CH:ABC")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("%Z%CH:ABC")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("%Z%CH:ABC%")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("%Z%CH:ABC%DDD")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("CH:ABC%DDD")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("CH:ABC%")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("%CH:")) == string(""));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("%CH:%")) == string(""));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("A%")) == string(""));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("CH:%")) == string(""));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("%CH:ABC")) == string("ABC"));
-    NL_TEST_ASSERT(inSuite, extractPayload(string("ABC")) == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("CH:ABC") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("CH:") == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("H:") == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("ASCH:") == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("Z%CH:ABC%") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("Z%CH:ABC") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("%Z%CH:ABC") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("%Z%CH:ABC%") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("%Z%CH:ABC%DDD") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("CH:ABC%DDD") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("CH:ABC%") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("%CH:") == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("%CH:%") == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("A%") == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("CH:%") == string(""));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("%CH:ABC") == string("ABC"));
+    NL_TEST_ASSERT(inSuite, ExtractPayload("ABC") == string(""));
+}
+
+void TestSetupPINCode(nlTestSuite * inSuite, void * inContext)
+{
+    uint32_t setUpPINCode;
+
+    NL_TEST_ASSERT(inSuite, IsValidSetupPINCode(1));
+    NL_TEST_ASSERT(inSuite, IsValidSetupPINCode(kMaxSetupPINCode));
+    NL_TEST_ASSERT(inSuite, !IsValidSetupPINCode(0));
+    NL_TEST_ASSERT(inSuite, !IsValidSetupPINCode(12345678));
+    NL_TEST_ASSERT(inSuite, !IsValidSetupPINCode(88888888));
+    NL_TEST_ASSERT(inSuite, !IsValidSetupPINCode(kMaxSetupPINCode + 1));
+
+    // Values map to codes modulo the code count, up to the last whole multiple of it.
+    NL_TEST_ASSERT(inSuite, SetupPINCodeFromRandom(kMaxSetupPINCode + 2, setUpPINCode) && setUpPINCode == 1);
+    NL_TEST_ASSERT(inSuite, !SetupPINCodeFromRandom(kMaxSetupPINCode + 1, setUpPINCode));
+    NL_TEST_ASSERT(inSuite, !SetupPINCodeFromRandom(UINT32_MAX, setUpPINCode));
+
+    const uint32_t lastWholeMultiple = UINT32_MAX - UINT32_MAX % (kMaxSetupPINCode + 1);
+    NL_TEST_ASSERT(inSuite, SetupPINCodeFromRandom(lastWholeMultiple - 1, setUpPINCode) && setUpPINCode == kMaxSetupPINCode);
+    NL_TEST_ASSERT(inSuite, !SetupPINCodeFromRandom(lastWholeMultiple, setUpPINCode));
+
+    for (int i = 0; i < 100; i++)
+    {
+        NL_TEST_ASSERT(inSuite, GenerateRandomSetupPINCode(setUpPINCode) == CHIP_NO_ERROR && IsValidSetupPINCode(setUpPINCode));
+    }
 }
 
 // Test Suite
@@ -327,9 +423,12 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("Test Rendezvous Flags",                                            TestRendezvousFlags),
     NL_TEST_DEF("Test Base 38",                                                     TestBase38),
+    NL_TEST_DEF("Test Base 38 Buffers",                                             TestBase38Buffers),
     NL_TEST_DEF("Test Bitset Length",                                               TestBitsetLen),
     NL_TEST_DEF("Test Payload Byte Array Representation",                           TestPayloadByteArrayRep),
     NL_TEST_DEF("Test Payload Base 38 Representation",                              TestPayloadBase38Rep),
+    NL_TEST_DEF("Test Payload Base 38 Representation To Buffer",                    TestPayloadBase38RepToBuffer),
+    NL_TEST_DEF("Test Payload Base 38 Representation To Buffer With Optional Data", TestPayloadBase38RepToBufferWithOptionalData),
     NL_TEST_DEF("Test Setup Payload Verify",                                        TestSetupPayloadVerify),
     NL_TEST_DEF("Test Payload Equality",                                            TestPayloadEquality),
     NL_TEST_DEF("Test Payload Inequality",                                          TestPayloadInEquality),
@@ -337,6 +436,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test Invalid QR Code Payload - Wrong Character Set",               TestInvalidQRCodePayload_WrongCharacterSet),
     NL_TEST_DEF("Test Invalid QR Code Payload - Wrong  Length",                     TestInvalidQRCodePayload_WrongLength),
     NL_TEST_DEF("Test Extract Payload",                                             TestExtractPayload),
+    NL_TEST_DEF("Test Setup PIN Code",                                              TestSetupPINCode),
 
     NL_TEST_SENTINEL()
 };
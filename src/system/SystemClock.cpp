@@ -198,7 +198,7 @@ Error SetClock_RealTime(uint64_t newCurTime)
 
 uint64_t GetClock_Monotonic(void)
 {
-    return GetClock_MonotonicMS();
+    return GetClock_MonotonicMS() * 1000;
 }
 
 uint64_t GetClock_MonotonicMS(void)
@@ -243,7 +243,7 @@ uint64_t GetClock_MonotonicMS(void)
 
 uint64_t GetClock_MonotonicHiRes(void)
 {
-    return GetClock_MonotonicMS();
+    return GetClock_MonotonicMS() * 1000;
 }
 
 Error GetClock_RealTime(uint64_t & curTime)
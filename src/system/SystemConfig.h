@@ -498,6 +498,17 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS
+ *
+ *  @brief
+ *      This is the maximum number of functions that may be registered with \c Layer::AddWakeHandler, i.e. of components that
+ *      hand work from other threads to the select loop. Only used when \c CHIP_SYSTEM_CONFIG_USE_SOCKETS is enabled.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS
+#define CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS 2
+#endif /* CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
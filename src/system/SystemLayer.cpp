@@ -40,6 +40,7 @@
 
 // Include system and language headers
 #include <stddef.h>
+#include <string.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 #include <errno.h>
@@ -131,6 +132,8 @@ Error Layer::Init(void * aContext)
     // Create an event to allow an arbitrary thread to wake the thread in the select loop.
     lReturn = this->mWakeEvent.Open();
     SuccessOrExit(lReturn);
+
+    memset(this->mWakeHandlers, 0, sizeof(this->mWakeHandlers));
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
     this->mLayerState = kLayerState_Initialized;
@@ -701,6 +704,14 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
 
     DispatchTimerCallbacks(kCurrentEpoch);
 
+    for (const WakeHandler & lWakeHandler : this->mWakeHandlers)
+    {
+        if (lWakeHandler.mHandler != nullptr)
+        {
+            lWakeHandler.mHandler(this, lWakeHandler.mAppState);
+        }
+    }
+
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -738,6 +749,57 @@ void Layer::WakeSelect()
     }
 }
 
+/**
+ * Register a function to be called from @p HandleSelectResult() on every pass of the select loop.
+ *
+ *  Threads other than the one running the select loop can hand work to it by queuing the work in a structure of their own,
+ *  then calling @p WakeSelect(); the registered function, running on the select loop thread, picks the work up.
+ *
+ *  @note
+ *      Must be called on the select loop thread.
+ *
+ *  @param[in]  aHandler    The function to call.
+ *  @param[in]  aAppState   An argument passed to the function.
+ *
+ *  @return CHIP_SYSTEM_NO_ERROR on success, CHIP_SYSTEM_ERROR_NO_MEMORY if \c CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS functions are
+ *      already registered, or CHIP_SYSTEM_ERROR_UNEXPECTED_STATE if the layer is not initialized.
+ */
+Error Layer::AddWakeHandler(WakeHandlerFunct aHandler, void * aAppState)
+{
+    if (this->State() != kLayerState_Initialized)
+        return CHIP_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    for (WakeHandler & lWakeHandler : this->mWakeHandlers)
+    {
+        if (lWakeHandler.mHandler == nullptr)
+        {
+            lWakeHandler.mHandler  = aHandler;
+            lWakeHandler.mAppState = aAppState;
+            return CHIP_SYSTEM_NO_ERROR;
+        }
+    }
+
+    return CHIP_SYSTEM_ERROR_NO_MEMORY;
+}
+
+/**
+ * Unregister a function registered with @p AddWakeHandler().
+ *
+ *  @note
+ *      Must be called on the select loop thread.
+ */
+void Layer::RemoveWakeHandler(WakeHandlerFunct aHandler, void * aAppState)
+{
+    for (WakeHandler & lWakeHandler : this->mWakeHandlers)
+    {
+        if (lWakeHandler.mHandler == aHandler && lWakeHandler.mAppState == aAppState)
+        {
+            lWakeHandler.mHandler  = nullptr;
+            lWakeHandler.mAppState = nullptr;
+        }
+    }
+}
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -1137,7 +1199,7 @@ DLL_EXPORT Error DispatchEvents(Layer & aLayer, void * aContext)
     err_t lLwIPError;
     sys_mbox_t lSysMbox;
     void * lVoidPointer;
-    const LwIPEvent * lEvent;
+    LwIPEvent * lEvent;
 
     // Sanity check the context / queue.
     VerifyOrExit(aContext != NULL, lReturn = CHIP_SYSTEM_ERROR_BAD_ARGS);
@@ -1148,7 +1210,7 @@ DLL_EXPORT Error DispatchEvents(Layer & aLayer, void * aContext)
         lLwIPError = sys_arch_mbox_tryfetch(&lSysMbox, &lVoidPointer);
         VerifyOrExit(lLwIPError == ERR_OK, lReturn = chip::System::MapErrorLwIP(lLwIPError));
 
-        lEvent = static_cast<const LwIPEvent *>(lVoidPointer);
+        lEvent = static_cast<LwIPEvent *>(lVoidPointer);
         VerifyOrExit(lEvent != NULL && lEvent->Target != NULL, lReturn = CHIP_SYSTEM_ERROR_UNEXPECTED_EVENT);
 
         lReturn = aLayer.HandleEvent(*lEvent->Target, lEvent->Type, lEvent->Argument);
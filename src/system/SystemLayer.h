@@ -151,6 +151,10 @@ public:
     void PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet, struct timeval & aSleepTime);
     void HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet);
     void WakeSelect();
+
+    typedef void (*WakeHandlerFunct)(Layer * aLayer, void * aAppState);
+    Error AddWakeHandler(WakeHandlerFunct aHandler, void * aAppState);
+    void RemoveWakeHandler(WakeHandlerFunct aHandler, void * aAppState);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -189,7 +193,14 @@ private:
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+    struct WakeHandler
+    {
+        WakeHandlerFunct mHandler;
+        void * mAppState;
+    };
+
     SystemWakeEvent mWakeEvent;
+    WakeHandler mWakeHandlers[CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS];
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
     pthread_t mHandleSelectThread;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -148,6 +148,7 @@ void PacketBufferHandle::InternalRightSize()
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
         return;
     }
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
     uint8_t * const newStart = reinterpret_cast<uint8_t *>(newBuffer) + PacketBuffer::kStructureSize;
     newBuffer->next          = nullptr;
@@ -36,6 +36,7 @@
 #include <system/SystemWakeEvent.h>
 
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
 #include <pthread.h>
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
@@ -136,6 +137,116 @@ void TestClose(nlTestSuite * inSuite, void * aContext)
     NL_TEST_ASSERT(inSuite, lContext.mWakeEvent.Open() == CHIP_SYSTEM_NO_ERROR);
     NL_TEST_ASSERT(inSuite, notifFD < 0);
 }
+
+// Run one pass of the select loop of a layer, which sleeps until the layer is woken or the timeout expires.
+void ServiceLayerOnce(Layer & aLayer, timeval aTimeout = {})
+{
+    fd_set lReadSet;
+    fd_set lWriteSet;
+    fd_set lErrorSet;
+    int lSetSize = 0;
+
+    FD_ZERO(&lReadSet);
+    FD_ZERO(&lWriteSet);
+    FD_ZERO(&lErrorSet);
+    aLayer.PrepareSelect(lSetSize, &lReadSet, &lWriteSet, &lErrorSet, aTimeout);
+    const int lSelectResult = select(lSetSize, &lReadSet, &lWriteSet, &lErrorSet, &aTimeout);
+    aLayer.HandleSelectResult(lSelectResult, &lReadSet, &lWriteSet, &lErrorSet);
+}
+
+void CountWake(Layer * aLayer, void * aAppState)
+{
+    ++*static_cast<int *>(aAppState);
+}
+
+void TestWakeHandlers(nlTestSuite * inSuite, void * aContext)
+{
+    Layer lLayer;
+    int lCalls[CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS + 1] = {};
+    int & lExtraCalls                                     = lCalls[CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS];
+
+    // Check that handlers are only accepted by an initialized layer
+    NL_TEST_ASSERT(inSuite, lLayer.AddWakeHandler(CountWake, &lCalls[0]) == CHIP_SYSTEM_ERROR_UNEXPECTED_STATE);
+    NL_TEST_ASSERT(inSuite, lLayer.Init(nullptr) == CHIP_SYSTEM_NO_ERROR);
+
+    for (int i = 0; i < CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS; i++)
+    {
+        NL_TEST_ASSERT(inSuite, lLayer.AddWakeHandler(CountWake, &lCalls[i]) == CHIP_SYSTEM_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, lLayer.AddWakeHandler(CountWake, &lExtraCalls) == CHIP_SYSTEM_ERROR_NO_MEMORY);
+
+    // Check that every handler runs on each pass of the select loop
+    ServiceLayerOnce(lLayer);
+    for (int i = 0; i < CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS; i++)
+    {
+        NL_TEST_ASSERT(inSuite, lCalls[i] == 1);
+    }
+    NL_TEST_ASSERT(inSuite, lExtraCalls == 0);
+
+    // ...that a removed handler no longer runs, and frees its slot
+    lLayer.RemoveWakeHandler(CountWake, &lCalls[0]);
+    NL_TEST_ASSERT(inSuite, lLayer.AddWakeHandler(CountWake, &lExtraCalls) == CHIP_SYSTEM_NO_ERROR);
+    ServiceLayerOnce(lLayer);
+    NL_TEST_ASSERT(inSuite, lCalls[0] == 1);
+    for (int i = 1; i < CHIP_SYSTEM_CONFIG_MAX_WAKE_HANDLERS; i++)
+    {
+        NL_TEST_ASSERT(inSuite, lCalls[i] == 2);
+    }
+    NL_TEST_ASSERT(inSuite, lExtraCalls == 1);
+
+    lLayer.Shutdown();
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+struct WakeFromThreadState
+{
+    Layer * mLayer;
+    std::atomic<bool> mQueued{ false };
+    bool mPickedUp = false;
+};
+
+void * QueueWorkAndWake(void * aState)
+{
+    WakeFromThreadState & lState = *static_cast<WakeFromThreadState *>(aState);
+    lState.mQueued               = true;
+    lState.mLayer->WakeSelect();
+    return nullptr;
+}
+
+void PickUpWork(Layer * aLayer, void * aAppState)
+{
+    WakeFromThreadState & lState = *static_cast<WakeFromThreadState *>(aAppState);
+    if (lState.mQueued)
+    {
+        lState.mPickedUp = true;
+    }
+}
+
+void TestWakeHandlerFromThread(nlTestSuite * inSuite, void * aContext)
+{
+    Layer lLayer;
+    WakeFromThreadState lState;
+    pthread_t tid = 0;
+
+    NL_TEST_ASSERT(inSuite, lLayer.Init(nullptr) == CHIP_SYSTEM_NO_ERROR);
+    lState.mLayer = &lLayer;
+    NL_TEST_ASSERT(inSuite, lLayer.AddWakeHandler(PickUpWork, &lState) == CHIP_SYSTEM_NO_ERROR);
+
+    // Check that work queued by another thread is picked up by the handler as soon as that thread wakes the loop
+    NL_TEST_ASSERT(inSuite, 0 == pthread_create(&tid, nullptr, QueueWorkAndWake, &lState));
+    for (int i = 0; i < 5 && !lState.mPickedUp; i++)
+    {
+        ServiceLayerOnce(lLayer, timeval{ 1, 0 });
+    }
+    NL_TEST_ASSERT(inSuite, 0 == pthread_join(tid, nullptr));
+    NL_TEST_ASSERT(inSuite, lState.mPickedUp);
+
+    lLayer.RemoveWakeHandler(PickUpWork, &lState);
+    lLayer.Shutdown();
+}
+#else  // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+void TestWakeHandlerFromThread(nlTestSuite *, void *) {}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 } // namespace
 
 // Test Suite
@@ -151,6 +262,8 @@ static const nlTest sTests[] =
     NL_TEST_DEF("WakeEvent::TestConfirm",           TestConfirm),
     NL_TEST_DEF("WakeEvent::TestBlockingSelect",    TestBlockingSelect),
     NL_TEST_DEF("WakeEvent::TestClose",             TestClose),
+    NL_TEST_DEF("WakeEvent::TestWakeHandlers",      TestWakeHandlers),
+    NL_TEST_DEF("WakeEvent::TestWakeHandlerFromThread", TestWakeHandlerFromThread),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -21,6 +21,7 @@
 
 #include <core/CHIPEncoding.h>
 #include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
 #include <support/SafeInt.h>
 #include <transport/AdminPairingTable.h>
 
@@ -81,17 +82,27 @@ CHIP_ERROR AdminPairingInfo::GenerateKey(AdminId id, char * key, size_t len)
 
 AdminPairingInfo * AdminPairingTable::AssignAdminId(AdminId adminId)
 {
-    for (size_t i = 0; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
-    {
-        if (!mStates[i].IsInitialized())
-        {
-            mStates[i].SetAdminId(adminId);
+    VerifyOrReturnError(mCount < CHIP_CONFIG_MAX_DEVICE_ADMINS, nullptr);
 
-            return &mStates[i];
-        }
+    const uint8_t position   = mSlots[mCount];
+    AdminPairingInfo * admin = &mStates[position];
+
+    admin->Reset();
+    admin->SetAdminId(adminId);
+
+    // An admin with an undefined id is not valid, and its position remains free.
+    VerifyOrReturnError(adminId != kUndefinedAdminId, admin);
+
+    // Same-id admins end up along the probe sequence in assignment order, so FindAdmin() returns the earliest one.
+    size_t slot = IndexHome(adminId);
+    while (mIndex[slot] != kEmptyIndexSlot)
+    {
+        slot = (slot + 1) & (kIndexSize - 1);
     }
+    mIndex[slot] = position;
+    mCount++;
 
-    return nullptr;
+    return admin;
 }
 
 AdminPairingInfo * AdminPairingTable::AssignAdminId(AdminId adminId, NodeId nodeId)
@@ -108,20 +119,39 @@ AdminPairingInfo * AdminPairingTable::AssignAdminId(AdminId adminId, NodeId node
 
 void AdminPairingTable::ReleaseAdminId(AdminId adminId)
 {
-    AdminPairingInfo * admin = FindAdmin(adminId);
-    if (admin != nullptr)
+    const uint8_t position = FindPosition(adminId);
+    if (position != kEmptyIndexSlot)
     {
-        admin->Reset();
+        Release(position);
     }
 }
 
 AdminPairingInfo * AdminPairingTable::FindAdmin(AdminId adminId)
 {
-    for (size_t i = 0; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
+    const uint8_t position = FindPosition(adminId);
+    VerifyOrReturnError(position != kEmptyIndexSlot, nullptr);
+
+    AdminPairingInfo * admin = &mStates[position];
+    if (admin->mFetchPending)
     {
-        if (mStates[i].IsInitialized() && mStates[i].GetAdminId() == adminId)
+        admin->mFetchPending = false;
+        if (mStorage == nullptr || admin->FetchFromKVS(*mStorage) != CHIP_NO_ERROR)
         {
-            return &mStates[i];
+            Release(position);
+            return nullptr;
+        }
+    }
+
+    return admin;
+}
+
+AdminPairingInfo * AdminPairingTable::FindAdminForNode(NodeId nodeId)
+{
+    for (uint8_t i = 0; i < mCount; i++)
+    {
+        if (mStates[mSlots[i]].GetNodeId() == nodeId)
+        {
+            return &mStates[mSlots[i]];
         }
     }
 
@@ -130,10 +160,124 @@ AdminPairingInfo * AdminPairingTable::FindAdmin(AdminId adminId)
 
 void AdminPairingTable::Reset()
 {
-    for (size_t i = 0; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
+    for (uint8_t i = 0; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
     {
         mStates[i].Reset();
+        mSlots[i] = i;
+    }
+    mCount = 0;
+
+    memset(mIndex, kEmptyIndexSlot, sizeof(mIndex));
+    mStorage = nullptr;
+}
+
+CHIP_ERROR AdminPairingTable::StoreIntoKVS(PersistentStorageDelegate & kvs, AdminId adminId)
+{
+    const uint8_t position = FindPosition(adminId);
+    VerifyOrReturnError(position != kEmptyIndexSlot, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The record of an admin that has not been fetched yet is already in the KVS.
+    if (!mStates[position].mFetchPending)
+    {
+        ReturnErrorOnFailure(mStates[position].StoreIntoKVS(kvs));
+    }
+
+    return StoreIndexIntoKVS(kvs);
+}
+
+CHIP_ERROR AdminPairingTable::StoreIndexIntoKVS(PersistentStorageDelegate & kvs)
+{
+    static_assert(kIndexEntrySize * CHIP_CONFIG_MAX_DEVICE_ADMINS <= UINT16_MAX, "Admin table index too large for the KVS");
+
+    uint8_t index[kIndexEntrySize * CHIP_CONFIG_MAX_DEVICE_ADMINS];
+    uint8_t * p = index;
+
+    for (uint8_t i = 0; i < mCount; i++)
+    {
+        Encoding::LittleEndian::Write16(p, mStates[mSlots[i]].GetAdminId());
+        Encoding::LittleEndian::Write64(p, mStates[mSlots[i]].GetNodeId());
     }
+
+    return kvs.SyncSetKeyValue(kAdminTableIndexKey, index, static_cast<uint16_t>(p - index));
+}
+
+CHIP_ERROR AdminPairingTable::LoadIndexFromKVS(PersistentStorageDelegate & kvs)
+{
+    uint8_t index[kIndexEntrySize * CHIP_CONFIG_MAX_DEVICE_ADMINS];
+    uint16_t size = sizeof(index);
+
+    ReturnErrorOnFailure(kvs.SyncGetKeyValue(kAdminTableIndexKey, index, size));
+    VerifyOrReturnError(size <= sizeof(index) && size % kIndexEntrySize == 0, CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    mStorage = &kvs;
+
+    const uint8_t * p = index;
+    while (p < index + size)
+    {
+        const AdminId adminId = Encoding::LittleEndian::Read16(p);
+        const NodeId nodeId   = Encoding::LittleEndian::Read64(p);
+
+        AdminPairingInfo * admin = AssignAdminId(adminId, nodeId);
+        VerifyOrReturnError(admin != nullptr, CHIP_ERROR_NO_MEMORY);
+        admin->mFetchPending = admin->IsInitialized();
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void AdminPairingTable::DeleteIndexFromKVS(PersistentStorageDelegate & kvs)
+{
+    kvs.AsyncDeleteKeyValue(kAdminTableIndexKey);
+}
+
+uint8_t AdminPairingTable::FindPosition(AdminId adminId) const
+{
+    VerifyOrReturnError(adminId != kUndefinedAdminId, kEmptyIndexSlot);
+
+    for (size_t slot = IndexHome(adminId); mIndex[slot] != kEmptyIndexSlot; slot = (slot + 1) & (kIndexSize - 1))
+    {
+        if (mStates[mIndex[slot]].GetAdminId() == adminId)
+        {
+            return mIndex[slot];
+        }
+    }
+
+    return kEmptyIndexSlot;
+}
+
+void AdminPairingTable::Release(uint8_t position)
+{
+    const size_t mask = kIndexSize - 1;
+    size_t hole       = IndexHome(mStates[position].GetAdminId());
+
+    // Remove the position from the index, shifting back the entries that follow it along the probe
+    // sequence unless that would move them before their home slot.
+    while (mIndex[hole] != position)
+    {
+        hole = (hole + 1) & mask;
+    }
+    for (size_t next = (hole + 1) & mask; mIndex[next] != kEmptyIndexSlot; next = (next + 1) & mask)
+    {
+        const size_t home = IndexHome(mStates[mIndex[next]].GetAdminId());
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            mIndex[hole] = mIndex[next];
+            hole         = next;
+        }
+    }
+    mIndex[hole] = kEmptyIndexSlot;
+
+    // Remove the position from the valid admins, keeping them in assignment order, and free it.
+    uint8_t i = 0;
+    while (mSlots[i] != position)
+    {
+        i++;
+    }
+    memmove(&mSlots[i], &mSlots[i + 1], static_cast<size_t>(mCount - i - 1));
+    mCount--;
+    mSlots[mCount] = position;
+
+    mStates[position].Reset();
 }
 
 } // namespace Transport
@@ -35,6 +35,7 @@ static constexpr AdminId kUndefinedAdminId = UINT16_MAX;
 // platform. Keeping them short.
 constexpr char kAdminTableKeyPrefix[] = "CHIPAdmin";
 constexpr char kAdminTableCountKey[]  = "CHIPAdminNextId";
+constexpr char kAdminTableIndexKey[]  = "CHIPAdminIdx";
 
 struct OperationalCredentials
 {
@@ -83,8 +84,9 @@ public:
      */
     void Reset()
     {
-        mNodeId = kUndefinedNodeId;
-        mAdmin  = kUndefinedAdminId;
+        mNodeId       = kUndefinedNodeId;
+        mAdmin        = kUndefinedAdminId;
+        mFetchPending = false;
     }
 
     CHIP_ERROR StoreIntoKVS(PersistentStorageDelegate & kvs);
@@ -94,9 +96,14 @@ public:
     static CHIP_ERROR DeleteFromKVS(PersistentStorageDelegate & kvs, AdminId id);
 
 private:
+    friend class AdminPairingTable;
+
     AdminId mAdmin = kUndefinedAdminId;
     NodeId mNodeId = kUndefinedNodeId;
 
+    // Set for admins restored from the KVS index whose full record has not been fetched yet.
+    bool mFetchPending = false;
+
     OperationalCredentials mOpCred;
     AccessControlList mACL;
 
@@ -112,7 +119,7 @@ private:
 };
 
 /**
- * Iterates over valid admins within a list
+ * Iterates over valid admins within a list, given as the list of their positions in the admin array
  */
 class ConstAdminIterator
 {
@@ -121,16 +128,12 @@ public:
     using pointer    = AdminPairingInfo *;
     using reference  = AdminPairingInfo &;
 
-    ConstAdminIterator(const AdminPairingInfo * start, size_t index, size_t maxSize) :
-        mStart(start), mIndex(index), mMaxSize(maxSize)
+    ConstAdminIterator(const AdminPairingInfo * start, const uint8_t * slots, size_t index, size_t count) :
+        mStart(start), mSlots(slots), mIndex(index), mCount(count)
     {
-        if (mIndex >= maxSize)
+        if (mIndex >= count)
         {
-            mIndex = maxSize;
-        }
-        else if (!mStart[mIndex].IsInitialized())
-        {
-            Advance();
+            mIndex = count;
         }
     }
     ConstAdminIterator(const ConstAdminIterator &) = default;
@@ -144,8 +147,8 @@ public:
         return other;
     }
 
-    const AdminPairingInfo & operator*() const { return mStart[mIndex]; }
-    const AdminPairingInfo * operator->() const { return mStart + mIndex; }
+    const AdminPairingInfo & operator*() const { return mStart[mSlots[mIndex]]; }
+    const AdminPairingInfo * operator->() const { return mStart + mSlots[mIndex]; }
 
     bool operator==(const ConstAdminIterator & other)
     {
@@ -154,54 +157,125 @@ public:
             return other.IsAtEnd();
         }
 
-        return (mStart == other.mStart) && (mIndex == other.mIndex) && (mMaxSize == other.mMaxSize);
+        return (mStart == other.mStart) && (mIndex == other.mIndex) && (mCount == other.mCount);
     }
     bool operator!=(const ConstAdminIterator & other) { return !(*this == other); }
 
-    bool IsAtEnd() const { return (mIndex == mMaxSize); }
+    bool IsAtEnd() const { return (mIndex == mCount); }
 
 private:
     const AdminPairingInfo * mStart;
+    const uint8_t * mSlots;
     size_t mIndex;
-    size_t mMaxSize;
+    size_t mCount;
 
     ConstAdminIterator & Advance()
     {
-        do
+        if (mIndex < mCount)
         {
-            if (mIndex < mMaxSize)
-            {
-                mIndex++;
-            }
-        } while (!IsAtEnd() && !mStart[mIndex].IsInitialized());
+            mIndex++;
+        }
 
         return *this;
     }
 };
 
+// Size of the admin id hash index of AdminPairingTable: a power of two at least twice the table size,
+// so that probe sequences stay short and always end on an empty slot.
+constexpr size_t AdminIndexSize(size_t size = 2)
+{
+    return (size >= 2 * CHIP_CONFIG_MAX_DEVICE_ADMINS) ? size : AdminIndexSize(size * 2);
+}
+
+/**
+ * Table of the admins that have provisioned the device.
+ *
+ * Admins are indexed by admin id, so that FindAdmin(), which runs for every secure message, does not
+ * scan the whole table. The table can also be persisted as a compact index record, holding the id and
+ * node id of every admin, next to the per-admin records: restoring it reads only the index, and the
+ * record of an admin is fetched the first time FindAdmin() returns it, typically when a session
+ * for that admin is used.
+ */
 class DLL_EXPORT AdminPairingTable
 {
 public:
+    AdminPairingTable() { Reset(); }
+
     AdminPairingInfo * AssignAdminId(AdminId adminId);
 
     AdminPairingInfo * AssignAdminId(AdminId adminId, NodeId nodeId);
 
     void ReleaseAdminId(AdminId adminId);
 
+    /**
+     * Find the admin with the given id, fetching its record from the KVS if it was restored by
+     * LoadIndexFromKVS() and has not been fetched yet. An admin whose record cannot be fetched is released.
+     */
     AdminPairingInfo * FindAdmin(AdminId adminId);
 
+    /**
+     * Find the first admin that assigned the given node id to the device. Does not fetch the admin record.
+     */
+    AdminPairingInfo * FindAdminForNode(NodeId nodeId);
+
     void Reset();
 
-    ConstAdminIterator cbegin() const { return ConstAdminIterator(mStates, 0, CHIP_CONFIG_MAX_DEVICE_ADMINS); }
-    ConstAdminIterator cend() const
-    {
-        return ConstAdminIterator(mStates, CHIP_CONFIG_MAX_DEVICE_ADMINS, CHIP_CONFIG_MAX_DEVICE_ADMINS);
-    }
+    /**
+     * Store the record of the given admin and the table index into the KVS.
+     */
+    CHIP_ERROR StoreIntoKVS(PersistentStorageDelegate & kvs, AdminId adminId);
+
+    /**
+     * Store the table index into the KVS.
+     */
+    CHIP_ERROR StoreIndexIntoKVS(PersistentStorageDelegate & kvs);
+
+    /**
+     * Restore the admins listed in the KVS index, without fetching their records. The records are fetched
+     * from @p kvs on first use, which requires @p kvs to outlive the table or the next Reset().
+     *
+     * @return CHIP_ERROR_KEY_NOT_FOUND if no index was stored, e.g. by an earlier version of the table.
+     */
+    CHIP_ERROR LoadIndexFromKVS(PersistentStorageDelegate & kvs);
+
+    /**
+     * Delete the table index from the KVS. Admin records are deleted with AdminPairingInfo::DeleteFromKVS().
+     */
+    static void DeleteIndexFromKVS(PersistentStorageDelegate & kvs);
+
+    size_t GetCount() const { return mCount; }
+
+    ConstAdminIterator cbegin() const { return ConstAdminIterator(mStates, mSlots, 0, mCount); }
+    ConstAdminIterator cend() const { return ConstAdminIterator(mStates, mSlots, mCount, mCount); }
     ConstAdminIterator begin() const { return cbegin(); }
     ConstAdminIterator end() const { return cend(); }
 
 private:
+    static_assert(CHIP_CONFIG_MAX_DEVICE_ADMINS < UINT8_MAX, "Admin positions must fit in uint8_t");
+
+    static constexpr uint8_t kEmptyIndexSlot = UINT8_MAX;
+    static constexpr size_t kIndexSize       = AdminIndexSize();
+
+    // Serialized size of an admin in the KVS index: little-endian admin id and node id.
+    static constexpr size_t kIndexEntrySize = sizeof(AdminId) + sizeof(NodeId);
+
     AdminPairingInfo mStates[CHIP_CONFIG_MAX_DEVICE_ADMINS];
+
+    // Positions in mStates of the valid admins, in assignment order, followed by the free positions.
+    uint8_t mSlots[CHIP_CONFIG_MAX_DEVICE_ADMINS];
+    uint8_t mCount;
+
+    // Open-addressed hash index of positions in mStates, keyed by admin id, with linear probing.
+    uint8_t mIndex[kIndexSize];
+
+    PersistentStorageDelegate * mStorage = nullptr;
+
+    static size_t IndexHome(AdminId adminId) { return adminId & (kIndexSize - 1); }
+
+    // Position in mStates of the earliest assigned admin with the given id, or kEmptyIndexSlot.
+    uint8_t FindPosition(AdminId adminId) const;
+
+    void Release(uint8_t position);
 };
 
 } // namespace Transport
@@ -41,7 +41,13 @@ static constexpr uint32_t kUndefinedMessageIndex = UINT32_MAX;
  *   - SendMessageIndex is an ever increasing index for sending messages
  *   - LastActivityTimeMs is a monotonic timestamp of when this connection was
  *     last used. Inactive connections can expire.
+ *   - LastReceiveTime is when the last authenticated message from the peer
+ *     reached the host, in System::Layer::GetClock_MonotonicHiRes() time.
+ *   - SmoothedRoundTripTime and RoundTripTimeVariation estimate the round trip
+ *     time to the peer as in RFC 6298, from acknowledged messages.
  *   - SecureSession contains the encryption context of a connection
+ *   - SessionGeneration tells apart the keys of successive sessions that
+ *     reuse the same key ids; 0 until the keys are set up.
  *
  * TODO: to add any message ACK information
  */
@@ -82,6 +88,38 @@ public:
     uint64_t GetLastActivityTimeMs() const { return mLastActivityTimeMs; }
     void SetLastActivityTimeMs(uint64_t value) { mLastActivityTimeMs = value; }
 
+    uint32_t GetSessionGeneration() const { return mSessionGeneration; }
+    void SetSessionGeneration(uint32_t generation) { mSessionGeneration = generation; }
+
+    uint64_t GetLastReceiveTime() const { return mLastReceiveTime; }
+    void SetLastReceiveTime(uint64_t value) { mLastReceiveTime = value; }
+
+    /** Smoothed round trip time to the peer in microseconds, or 0 before the first sample. */
+    uint32_t GetSmoothedRoundTripTime() const { return mSmoothedRoundTripTime; }
+
+    /** Mean deviation of the round trip time to the peer in microseconds. */
+    uint32_t GetRoundTripTimeVariation() const { return mRoundTripTimeVariation; }
+
+    /**
+     *  Add a round trip time sample, in microseconds, to the estimate. Only
+     *  samples from messages that were not retransmitted should be added.
+     */
+    void AddRoundTripTimeSample(uint32_t sample)
+    {
+        if (mSmoothedRoundTripTime == 0)
+        {
+            mSmoothedRoundTripTime  = sample;
+            mRoundTripTimeVariation = sample / 2;
+            return;
+        }
+
+        // RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, then SRTT = 7/8 SRTT + 1/8 R.
+        const uint32_t deviation =
+            (sample > mSmoothedRoundTripTime) ? sample - mSmoothedRoundTripTime : mSmoothedRoundTripTime - sample;
+        mRoundTripTimeVariation = mRoundTripTimeVariation - mRoundTripTimeVariation / 4 + deviation / 4;
+        mSmoothedRoundTripTime  = mSmoothedRoundTripTime - mSmoothedRoundTripTime / 8 + sample / 8;
+    }
+
     SecureSession & GetSenderSecureSession() { return mSenderSecureSession; }
     SecureSession & GetReceiverSecureSession() { return mReceiverSecureSession; }
 
@@ -106,10 +144,14 @@ public:
      */
     void Reset()
     {
-        mPeerAddress        = PeerAddress::Uninitialized();
-        mPeerNodeId         = kUndefinedNodeId;
-        mSendMessageIndex   = 0;
-        mLastActivityTimeMs = 0;
+        mPeerAddress            = PeerAddress::Uninitialized();
+        mPeerNodeId             = kUndefinedNodeId;
+        mSendMessageIndex       = 0;
+        mLastActivityTimeMs     = 0;
+        mLastReceiveTime        = 0;
+        mSmoothedRoundTripTime  = 0;
+        mRoundTripTimeVariation = 0;
+        mSessionGeneration      = 0;
         mSenderSecureSession.Reset();
         mReceiverSecureSession.Reset();
         mMsgCounterSynStatus = MsgCounterSyncStatus::NotSync;
@@ -136,13 +178,17 @@ private:
     } mMsgCounterSynStatus;
 
     PeerAddress mPeerAddress;
-    NodeId mPeerNodeId           = kUndefinedNodeId;
-    uint32_t mSendMessageIndex   = 0;
-    uint32_t mPeerMessageIndex   = kUndefinedMessageIndex;
-    uint16_t mPeerKeyID          = UINT16_MAX;
-    uint16_t mLocalKeyID         = UINT16_MAX;
-    uint64_t mLastActivityTimeMs = 0;
-    Transport::Base * mTransport = nullptr;
+    NodeId mPeerNodeId               = kUndefinedNodeId;
+    uint32_t mSendMessageIndex       = 0;
+    uint32_t mPeerMessageIndex       = kUndefinedMessageIndex;
+    uint16_t mPeerKeyID              = UINT16_MAX;
+    uint16_t mLocalKeyID             = UINT16_MAX;
+    uint64_t mLastActivityTimeMs     = 0;
+    uint64_t mLastReceiveTime        = 0;
+    uint32_t mSmoothedRoundTripTime  = 0;
+    uint32_t mRoundTripTimeVariation = 0;
+    uint32_t mSessionGeneration      = 0;
+    Transport::Base * mTransport     = nullptr;
     SecureSession mSenderSecureSession;
     SecureSession mReceiverSecureSession;
     Transport::AdminId mAdmin = kUndefinedAdminId;
@@ -63,6 +63,37 @@ uint32_t EncryptedPacketBufferHandle::GetMsgId() const
     return 0;
 }
 
+/**
+ * Scoped locks on mPeerConnectionsLock; no-ops unless receive threads may decrypt concurrently.
+ */
+class SecureSessionMgr::PeerConnectionsWriteLock
+{
+public:
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    explicit PeerConnectionsWriteLock(SecureSessionMgr & mgr) : mLock(mgr.mPeerConnectionsLock) { pthread_rwlock_wrlock(&mLock); }
+    ~PeerConnectionsWriteLock() { pthread_rwlock_unlock(&mLock); }
+
+private:
+    pthread_rwlock_t & mLock;
+#else  // !CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    explicit PeerConnectionsWriteLock(SecureSessionMgr & mgr) {}
+#endif // !CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+};
+
+class SecureSessionMgr::PeerConnectionsReadLock
+{
+public:
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    explicit PeerConnectionsReadLock(SecureSessionMgr & mgr) : mLock(mgr.mPeerConnectionsLock) { pthread_rwlock_rdlock(&mLock); }
+    ~PeerConnectionsReadLock() { pthread_rwlock_unlock(&mLock); }
+
+private:
+    pthread_rwlock_t & mLock;
+#else  // !CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    explicit PeerConnectionsReadLock(SecureSessionMgr & mgr) {}
+#endif // !CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+};
+
 SecureSessionMgr::SecureSessionMgr() : mState(State::kNotReady) {}
 
 SecureSessionMgr::~SecureSessionMgr()
@@ -76,7 +107,10 @@ CHIP_ERROR SecureSessionMgr::Init(NodeId localNodeId, System::Layer * systemLaye
     VerifyOrReturnError(mState == State::kNotReady, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(transportMgr != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    mState        = State::kInitialized;
+    {
+        PeerConnectionsWriteLock lock(*this);
+        mState = State::kInitialized;
+    }
     mLocalNodeId  = localNodeId;
     mSystemLayer  = systemLayer;
     mTransportMgr = transportMgr;
@@ -96,7 +130,10 @@ void SecureSessionMgr::Shutdown()
 {
     CancelExpiryTimer();
 
-    mState        = State::kNotReady;
+    {
+        PeerConnectionsWriteLock lock(*this);
+        mState = State::kNotReady;
+    }
     mLocalNodeId  = kUndefinedNodeId;
     mSystemLayer  = nullptr;
     mTransportMgr = nullptr;
@@ -166,8 +203,11 @@ CHIP_ERROR SecureSessionMgr::SendMessage(SecureSessionHandle session, PayloadHea
     state = GetPeerConnectionState(session);
     VerifyOrExit(state != nullptr, err = CHIP_ERROR_NOT_CONNECTED);
 
-    // This marks any connection where we send data to as 'active'
-    mPeerConnections.MarkConnectionActive(state);
+    {
+        PeerConnectionsWriteLock lock(*this);
+        // This marks any connection where we send data to as 'active'
+        mPeerConnections.MarkConnectionActive(state);
+    }
     admin = mAdmins->FindAdmin(state->GetAdminId());
     VerifyOrExit(admin != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     localNodeId = admin->GetNodeId();
@@ -180,9 +220,11 @@ CHIP_ERROR SecureSessionMgr::SendMessage(SecureSessionHandle session, PayloadHea
 
     if (encryptionState == EncryptionState::kPayloadIsUnencrypted)
     {
+        // Encoding takes the next message index of the connection.
+        PeerConnectionsWriteLock lock(*this);
         err = SecureMessageCodec::Encode(localNodeId, state, payloadHeader, packetHeader, msgBuf);
-        SuccessOrExit(err);
     }
+    SuccessOrExit(err);
 
     // The start of buffer points to the beginning of the encrypted header, and the length of buffer
     // contains both the encrypted header and encrypted data.
@@ -244,22 +286,49 @@ CHIP_ERROR SecureSessionMgr::NewPairing(const Optional<Transport::PeerAddress> &
                                         Transport::Base * transport)
 {
     uint16_t peerKeyId          = pairing->GetPeerKeyId();
-    uint16_t localKeyId         = pairing->GetLocalKeyId();
     PeerConnectionState * state = mPeerConnections.FindPeerConnectionState(Optional<NodeId>::Value(peerNodeId), peerKeyId, nullptr);
 
     // Find any existing connection with the same node and key ID
     if (state && (state->GetAdminId() == Transport::kUndefinedAdminId || state->GetAdminId() == admin))
     {
-        mPeerConnections.MarkConnectionExpired(
-            state, [this](const Transport::PeerConnectionState & state1) { HandleConnectionExpired(state1); });
+        HandleConnectionExpired(*state);
+
+        PeerConnectionsWriteLock lock(*this);
+        mPeerConnections.MarkConnectionExpired(state, [](const Transport::PeerConnectionState &) {});
     }
 
     ChipLogDetail(Inet, "New pairing for device 0x%08" PRIx32 "%08" PRIx32 ", key %d!!", static_cast<uint32_t>(peerNodeId >> 32),
                   static_cast<uint32_t>(peerNodeId), peerKeyId);
-    state = nullptr;
+    ReturnErrorOnFailure(SetUpPairingState(peerAddr, peerNodeId, pairing, direction, admin, transport, &state));
+
+    if (mCB != nullptr)
+    {
+        mCB->OnNewConnection({ state->GetPeerNodeId(), state->GetPeerKeyID(), admin }, this);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SecureSessionMgr::SetUpPairingState(const Optional<Transport::PeerAddress> & peerAddr, NodeId peerNodeId,
+                                               PairingSession * pairing, PairingDirection direction, Transport::AdminId admin,
+                                               Transport::Base * transport, PeerConnectionState ** outState)
+{
+    uint16_t peerKeyId          = pairing->GetPeerKeyId();
+    uint16_t localKeyId         = pairing->GetLocalKeyId();
+    PeerConnectionState * state = nullptr;
+
+    // Receive threads must not see the connection before its keys are in place.
+    PeerConnectionsWriteLock lock(*this);
+
     ReturnErrorOnFailure(
         mPeerConnections.CreateNewPeerConnectionState(Optional<NodeId>::Value(peerNodeId), peerKeyId, localKeyId, &state));
+    *outState = state;
 
+    state->SetSessionGeneration(mNextSessionGeneration++);
+    if (mNextSessionGeneration == 0)
+    {
+        mNextSessionGeneration = 1;
+    }
     state->SetAdminId(admin);
     state->SetTransport(transport);
 
@@ -305,11 +374,6 @@ CHIP_ERROR SecureSessionMgr::NewPairing(const Optional<Transport::PeerAddress> &
         default:
             return CHIP_ERROR_INVALID_ARGUMENT;
         };
-
-        if (mCB != nullptr)
-        {
-            mCB->OnNewConnection({ state->GetPeerNodeId(), state->GetPeerKeyID(), admin }, this);
-        }
     }
 
     return CHIP_NO_ERROR;
@@ -336,15 +400,22 @@ void SecureSessionMgr::HandleGroupMessageReceived(const PacketHeader & packetHea
     PeerConnectionState * state = mPeerConnections.FindPeerConnectionState(packetHeader.GetEncryptionKeyID(), nullptr);
     VerifyOrReturn(state != nullptr, ChipLogError(Inet, "Failed to find the peer connection state"));
 
+    // The message was queued for message counter synchronization, so the time it reached the host is no longer known.
     OnMessageReceived(packetHeader, state->GetPeerAddress(), std::move(msgBuf));
 }
 
 void SecureSessionMgr::OnMessageReceived(const PacketHeader & packetHeader, const PeerAddress & peerAddress,
                                          System::PacketBufferHandle msg)
+{
+    OnMessageReceivedAt(packetHeader, peerAddress, std::move(msg), 0);
+}
+
+void SecureSessionMgr::OnMessageReceivedAt(const PacketHeader & packetHeader, const PeerAddress & peerAddress,
+                                           System::PacketBufferHandle msg, uint64_t receiveTime)
 {
     if (packetHeader.GetFlags().Has(Header::FlagValues::kSecure))
     {
-        SecureMessageDispatch(packetHeader, peerAddress, std::move(msg));
+        SecureMessageDispatch(packetHeader, peerAddress, std::move(msg), receiveTime);
     }
     else
     {
@@ -352,6 +423,45 @@ void SecureSessionMgr::OnMessageReceived(const PacketHeader & packetHeader, cons
     }
 }
 
+CHIP_ERROR SecureSessionMgr::DecodeMessageOnReceiveThread(const PacketHeader & packetHeader, PayloadHeader & payloadHeader,
+                                                          System::PacketBufferHandle & msg, uint32_t & sessionGeneration)
+{
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    VerifyOrReturnError(packetHeader.GetFlags().Has(Header::FlagValues::kSecure), CHIP_ERROR_NOT_IMPLEMENTED);
+    // Group messages may have to be queued, still encrypted, for message counter synchronization.
+    VerifyOrReturnError(!ChipKeyId::IsAppGroupKey(packetHeader.GetEncryptionKeyID()), CHIP_ERROR_NOT_IMPLEMENTED);
+
+    PeerConnectionsReadLock lock(*this);
+    VerifyOrReturnError(mState == State::kInitialized, CHIP_ERROR_NOT_IMPLEMENTED);
+
+    // Unknown sessions are reported on the CHIP thread.
+    PeerConnectionState * state = mPeerConnections.FindPeerConnectionState(packetHeader.GetEncryptionKeyID(), nullptr);
+    VerifyOrReturnError(state != nullptr, CHIP_ERROR_NOT_IMPLEMENTED);
+
+    sessionGeneration = state->GetSessionGeneration();
+    return SecureMessageCodec::Decode(state, payloadHeader, packetHeader, msg);
+#else  // !CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+#endif // !CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+}
+
+void SecureSessionMgr::OnDecodedMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                                const PeerAddress & peerAddress, System::PacketBufferHandle msg,
+                                                uint64_t receiveTime, uint32_t sessionGeneration)
+{
+    PeerConnectionState * state = mPeerConnections.FindPeerConnectionState(packetHeader.GetEncryptionKeyID(), nullptr);
+
+    // The message was authenticated with the keys of the session it was decrypted for, which may have been replaced since.
+    if (state != nullptr && state->GetSessionGeneration() != sessionGeneration)
+    {
+        ChipLogError(Inet, "Secure transport received message for replaced session (%d), discarding",
+                     packetHeader.GetEncryptionKeyID());
+        return;
+    }
+
+    SecureMessageDispatch(packetHeader, peerAddress, std::move(msg), receiveTime, &payloadHeader);
+}
+
 void SecureSessionMgr::MessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
                                        System::PacketBufferHandle msg)
 {
@@ -364,7 +474,8 @@ void SecureSessionMgr::MessageDispatch(const PacketHeader & packetHeader, const
 }
 
 void SecureSessionMgr::SecureMessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
-                                             System::PacketBufferHandle msg)
+                                             System::PacketBufferHandle msg, uint64_t receiveTime,
+                                             const PayloadHeader * decodedPayloadHeader)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
@@ -392,9 +503,13 @@ void SecureSessionMgr::SecureMessageDispatch(const PacketHeader & packetHeader,
             admin->GetNodeId() == packetHeader.GetDestinationNodeId().Value(),
             ChipLogError(Inet, "Secure transport received message, but destination node ID doesn't match our node ID, discarding"));
     }
-    mPeerConnections.MarkConnectionActive(state);
 
-    if (!packetHeader.IsSecureSessionControlMsg() && !state->IsPeerMsgCounterSynced() &&
+    {
+        PeerConnectionsWriteLock lock(*this);
+        mPeerConnections.MarkConnectionActive(state);
+    }
+
+    if (decodedPayloadHeader == nullptr && !packetHeader.IsSecureSessionControlMsg() && !state->IsPeerMsgCounterSynced() &&
         ChipKeyId::IsAppGroupKey(packetHeader.GetEncryptionKeyID()))
     {
         // Queue the message as needed for sync with destination node.
@@ -415,38 +530,53 @@ void SecureSessionMgr::SecureMessageDispatch(const PacketHeader & packetHeader,
         return;
     }
 
-    // Decode the message
-    VerifyOrExit(CHIP_NO_ERROR == SecureMessageCodec::Decode(state, payloadHeader, packetHeader, msg),
-                 ChipLogError(Inet, "Secure transport received message, but failed to decode it, discarding"));
-
-    if (packetHeader.GetSourceNodeId().HasValue())
+    // Decode the message, unless a transport receive thread already has.
+    if (decodedPayloadHeader != nullptr)
     {
-        if (state->GetPeerNodeId() == kUndefinedNodeId)
-        {
-            state->SetPeerNodeId(packetHeader.GetSourceNodeId().Value());
-        }
+        payloadHeader = *decodedPayloadHeader;
     }
-
-    if (packetHeader.GetDestinationNodeId().HasValue())
+    else
     {
-        admin->SetNodeId(packetHeader.GetDestinationNodeId().Value());
+        VerifyOrExit(CHIP_NO_ERROR == SecureMessageCodec::Decode(state, payloadHeader, packetHeader, msg),
+                     ChipLogError(Inet, "Secure transport received message, but failed to decode it, discarding"));
     }
 
-    // TODO: once mDNS address resolution is available reconsider if this is required
-    // This updates the peer address once a packet is received from a new address
-    // and serves as a way to auto-detect peer changing IPs.
-    if (state->GetPeerAddress() != peerAddress)
     {
-        state->SetPeerAddress(peerAddress);
-    }
+        // Receive threads look connections up by fields changed here.
+        PeerConnectionsWriteLock lock(*this);
 
-    if (!state->IsPeerMsgCounterSynced())
-    {
-        // For all control messages, the first authenticated message counter from an unsynchronized peer is trusted
-        // and used to seed subsequent message counter based replay protection.
-        if (packetHeader.IsSecureSessionControlMsg())
+        // Only authenticated messages may feed the peer's round trip time estimate.
+        state->SetLastReceiveTime(receiveTime != 0 ? receiveTime : System::Layer::GetClock_MonotonicHiRes());
+
+        if (packetHeader.GetSourceNodeId().HasValue())
+        {
+            if (state->GetPeerNodeId() == kUndefinedNodeId)
+            {
+                state->SetPeerNodeId(packetHeader.GetSourceNodeId().Value());
+            }
+        }
+
+        if (packetHeader.GetDestinationNodeId().HasValue())
+        {
+            admin->SetNodeId(packetHeader.GetDestinationNodeId().Value());
+        }
+
+        // TODO: once mDNS address resolution is available reconsider if this is required
+        // This updates the peer address once a packet is received from a new address
+        // and serves as a way to auto-detect peer changing IPs.
+        if (state->GetPeerAddress() != peerAddress)
         {
-            state->SetPeerMessageIndex(packetHeader.GetMessageId());
+            state->SetPeerAddress(peerAddress);
+        }
+
+        if (!state->IsPeerMsgCounterSynced())
+        {
+            // For all control messages, the first authenticated message counter from an unsynchronized peer is trusted
+            // and used to seed subsequent message counter based replay protection.
+            if (packetHeader.IsSecureSessionControlMsg())
+            {
+                state->SetPeerMessageIndex(packetHeader.GetMessageId());
+            }
         }
     }
 
@@ -465,10 +595,13 @@ exit:
 
 void SecureSessionMgr::HandleConnectionExpired(const Transport::PeerConnectionState & state)
 {
-    char addr[Transport::PeerAddress::kMaxToStringSize];
-    state.GetPeerAddress().ToString(addr);
+    if (ChipLogIsEnabled(Detail))
+    {
+        char addr[Transport::PeerAddress::kMaxToStringSize];
+        state.GetPeerAddress().ToString(addr);
 
-    ChipLogDetail(Inet, "Connection from '%s' expired", addr);
+        ChipLogDetail(Inet, "Connection from '%s' expired", addr);
+    }
 
     if (mCB != nullptr)
     {
@@ -496,4 +629,14 @@ PeerConnectionState * SecureSessionMgr::GetPeerConnectionState(SecureSessionHand
     return mPeerConnections.FindPeerConnectionState(Optional<NodeId>::Value(session.mPeerNodeId), session.mPeerKeyId, nullptr);
 }
 
+CHIP_ERROR SecureSessionMgr::UpdatePeerAddress(SecureSessionHandle session, const PeerAddress & address)
+{
+    PeerConnectionState * state = GetPeerConnectionState(session);
+    VerifyOrReturnError(state != nullptr, CHIP_ERROR_NOT_CONNECTED);
+
+    PeerConnectionsWriteLock lock(*this);
+    state->SetPeerAddress(address);
+    return CHIP_NO_ERROR;
+}
+
 } // namespace chip
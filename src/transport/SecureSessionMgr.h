@@ -28,6 +28,10 @@
 #include <utility>
 
 #include <core/CHIPCore.h>
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+#include <pthread.h>
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
 #include <inet/IPAddress.h>
 #include <inet/IPEndPointBasis.h>
 #include <support/CodeUtils.h>
@@ -236,6 +240,16 @@ public:
 
     Transport::PeerConnectionState * GetPeerConnectionState(SecureSessionHandle session);
 
+    /**
+     * @brief
+     *   Update the address of the peer of a session.
+     *
+     * @details
+     *   Use this rather than changing the address through GetPeerConnectionState(), which transport receive threads may be
+     *   reading.
+     */
+    CHIP_ERROR UpdatePeerAddress(SecureSessionHandle session, const Transport::PeerAddress & address);
+
     /**
      * @brief
      *   Set the callback object.
@@ -324,6 +338,40 @@ protected:
     void OnMessageReceived(const PacketHeader & header, const Transport::PeerAddress & source,
                            System::PacketBufferHandle msgBuf) override;
 
+    /**
+     * @brief
+     *   Handle received secure message, recording when it reached the host. Implements TransportMgrDelegate
+     *
+     * @param header      the received message header
+     * @param source      the source address of the package
+     * @param msgBuf      the buffer of (encrypted) payload
+     * @param receiveTime when the message reached the host, or 0 if unknown
+     */
+    void OnMessageReceivedAt(const PacketHeader & header, const Transport::PeerAddress & source, System::PacketBufferHandle msgBuf,
+                             uint64_t receiveTime) override;
+
+    /**
+     * @brief
+     *   Decrypt a received secure message on a transport receive thread. Implements TransportMgrDelegate
+     *
+     * @details
+     *   Only unicast session messages are decrypted here; group messages, which may have to wait for
+     *   message counter synchronization, and messages for unknown sessions are left to OnMessageReceived.
+     */
+    CHIP_ERROR DecodeMessageOnReceiveThread(const PacketHeader & header, PayloadHeader & payloadHeader,
+                                            System::PacketBufferHandle & msgBuf, uint32_t & sessionGeneration) override;
+
+    /**
+     * @brief
+     *   Handle a secure message decrypted by DecodeMessageOnReceiveThread. Implements TransportMgrDelegate
+     *
+     * @details
+     *   The message is dropped if its session was replaced, with the same key id, since it was decrypted.
+     */
+    void OnDecodedMessageReceived(const PacketHeader & header, const PayloadHeader & payloadHeader,
+                                  const Transport::PeerAddress & source, System::PacketBufferHandle msgBuf, uint64_t receiveTime,
+                                  uint32_t sessionGeneration) override;
+
 private:
     /**
      *    The State of a secure transport object.
@@ -349,10 +397,26 @@ private:
     TransportMgrBase * mTransportMgr       = nullptr;
     Transport::AdminPairingTable * mAdmins = nullptr;
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    // Held for reading by transport receive threads while they look up a connection and decrypt, and for writing by the
+    // CHIP thread whenever it changes a connection or mState. The CHIP thread, the only writer, reads without it.
+    pthread_rwlock_t mPeerConnectionsLock = PTHREAD_RWLOCK_INITIALIZER;
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
+    // Generation of the next session set up; never 0, which marks connections without keys.
+    uint32_t mNextSessionGeneration = 1;
+
+    class PeerConnectionsWriteLock;
+    class PeerConnectionsReadLock;
+
     CHIP_ERROR SendMessage(SecureSessionHandle session, PayloadHeader & payloadHeader, PacketHeader & packetHeader,
                            System::PacketBufferHandle msgBuf, EncryptedPacketBufferHandle * bufferRetainSlot,
                            EncryptionState encryptionState);
 
+    CHIP_ERROR SetUpPairingState(const Optional<Transport::PeerAddress> & peerAddr, NodeId peerNodeId, PairingSession * pairing,
+                                 PairingDirection direction, Transport::AdminId admin, Transport::Base * transport,
+                                 Transport::PeerConnectionState ** outState);
+
     /** Schedules a new oneshot timer for checking connection expiry. */
     void ScheduleExpiryTimer();
 
@@ -370,7 +434,8 @@ private:
     static void ExpiryTimerCallback(System::Layer * layer, void * param, System::Error error);
 
     void SecureMessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
-                               System::PacketBufferHandle msg);
+                               System::PacketBufferHandle msg, uint64_t receiveTime,
+                               const PayloadHeader * decodedPayloadHeader = nullptr);
     void MessageDispatch(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
                          System::PacketBufferHandle msg);
 };
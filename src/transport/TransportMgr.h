@@ -53,6 +53,50 @@ public:
      */
     virtual void OnMessageReceived(const PacketHeader & header, const Transport::PeerAddress & source,
                                    System::PacketBufferHandle msgBuf) = 0;
+
+    /**
+     * @brief
+     *   Handle received secure message, along with the time it reached the host. Delegates that track receive times
+     *   override this; by default the time is dropped.
+     *
+     * @param header      the received message header
+     * @param source      the source address of the package
+     * @param msgBuf      the buffer of (encrypted) payload
+     * @param receiveTime when the message reached the host, in System::Layer::GetClock_MonotonicHiRes() time, or 0 if
+     *                    unknown
+     */
+    virtual void OnMessageReceivedAt(const PacketHeader & header, const Transport::PeerAddress & source,
+                                     System::PacketBufferHandle msgBuf, uint64_t receiveTime)
+    {
+        OnMessageReceived(header, source, std::move(msgBuf));
+    }
+
+    /**
+     * @brief
+     *   Decrypt a received secure message on a transport receive thread. Must be thread safe.
+     *   See Transport::RawTransportDelegate::DecodeMessageOnReceiveThread.
+     */
+    virtual CHIP_ERROR DecodeMessageOnReceiveThread(const PacketHeader & header, PayloadHeader & payloadHeader,
+                                                    System::PacketBufferHandle & msgBuf, uint32_t & sessionGeneration)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * @brief
+     *   Handle a secure message already decrypted by DecodeMessageOnReceiveThread.
+     *
+     * @param header        the received message header
+     * @param payloadHeader the decrypted payload header
+     * @param source        the source address of the package
+     * @param msgBuf        the buffer of decrypted payload
+     * @param receiveTime   when the message reached the host, or 0 if unknown
+     * @param sessionGeneration the session generation given by DecodeMessageOnReceiveThread
+     */
+    virtual void OnDecodedMessageReceived(const PacketHeader & header, const PayloadHeader & payloadHeader,
+                                          const Transport::PeerAddress & source, System::PacketBufferHandle msgBuf,
+                                          uint64_t receiveTime, uint32_t sessionGeneration)
+    {}
 };
 
 template <typename... TransportTypes>
@@ -74,8 +118,9 @@ public:
 
     void Close()
     {
-        TransportMgrBase::Close();
+        // Close the transports first, so that no receive thread is using the delegate when it is cleared.
         mTransport.Close();
+        TransportMgrBase::Close();
     };
 
 private:
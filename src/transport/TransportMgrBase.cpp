@@ -47,18 +47,20 @@ CHIP_ERROR TransportMgrBase::Init(Transport::Base * transport)
 
 void TransportMgrBase::Close()
 {
-    mSecureSessionMgr = nullptr;
-    mTransport        = nullptr;
+    mSecureSessionMgr.store(nullptr, std::memory_order_release);
+    mTransport = nullptr;
 }
 
 void TransportMgrBase::HandleMessageReceived(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
-                                             System::PacketBufferHandle msg)
+                                             System::PacketBufferHandle msg, uint64_t receiveTime)
 {
-    if (mSecureSessionMgr != nullptr)
+    TransportMgrDelegate * secureSessionMgr = mSecureSessionMgr.load(std::memory_order_acquire);
+
+    if (secureSessionMgr != nullptr)
     {
-        mSecureSessionMgr->OnMessageReceived(packetHeader, peerAddress, std::move(msg));
+        secureSessionMgr->OnMessageReceivedAt(packetHeader, peerAddress, std::move(msg), receiveTime);
     }
-    else
+    else if (ChipLogIsEnabled(Error))
     {
         char addrBuffer[Transport::PeerAddress::kMaxToStringSize];
         peerAddress.ToString(addrBuffer);
@@ -67,4 +69,30 @@ void TransportMgrBase::HandleMessageReceived(const PacketHeader & packetHeader,
     }
 }
 
+CHIP_ERROR TransportMgrBase::DecodeMessageOnReceiveThread(const PacketHeader & packetHeader, PayloadHeader & payloadHeader,
+                                                          System::PacketBufferHandle & msg, uint32_t & sessionGeneration)
+{
+    TransportMgrDelegate * secureSessionMgr = mSecureSessionMgr.load(std::memory_order_acquire);
+
+    if (secureSessionMgr == nullptr)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    return secureSessionMgr->DecodeMessageOnReceiveThread(packetHeader, payloadHeader, msg, sessionGeneration);
+}
+
+void TransportMgrBase::HandleDecodedMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                                    const Transport::PeerAddress & peerAddress, System::PacketBufferHandle msg,
+                                                    uint64_t receiveTime, uint32_t sessionGeneration)
+{
+    TransportMgrDelegate * secureSessionMgr = mSecureSessionMgr.load(std::memory_order_acquire);
+
+    if (secureSessionMgr != nullptr)
+    {
+        secureSessionMgr->OnDecodedMessageReceived(packetHeader, payloadHeader, peerAddress, std::move(msg), receiveTime,
+                                                   sessionGeneration);
+    }
+}
+
 } // namespace chip
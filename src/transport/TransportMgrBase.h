@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <support/CodeUtils.h>
 #include <system/SystemPacketBuffer.h>
 #include <transport/raw/Base.h>
@@ -42,14 +44,25 @@ public:
 
     void Disconnect(const Transport::PeerAddress & address);
 
-    void SetSecureSessionMgr(TransportMgrDelegate * secureSessionMgr) { mSecureSessionMgr = secureSessionMgr; }
+    void SetSecureSessionMgr(TransportMgrDelegate * secureSessionMgr)
+    {
+        mSecureSessionMgr.store(secureSessionMgr, std::memory_order_release);
+    }
 
     void HandleMessageReceived(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
-                               System::PacketBufferHandle msg) override;
+                               System::PacketBufferHandle msg, uint64_t receiveTime) override;
+
+    CHIP_ERROR DecodeMessageOnReceiveThread(const PacketHeader & packetHeader, PayloadHeader & payloadHeader,
+                                            System::PacketBufferHandle & msg, uint32_t & sessionGeneration) override;
+
+    void HandleDecodedMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                      const Transport::PeerAddress & peerAddress, System::PacketBufferHandle msg,
+                                      uint64_t receiveTime, uint32_t sessionGeneration) override;
 
 private:
-    TransportMgrDelegate * mSecureSessionMgr = nullptr;
-    Transport::Base * mTransport             = nullptr;
+    // Read by transport receive threads (see DecodeMessageOnReceiveThread), which may run before it is set.
+    std::atomic<TransportMgrDelegate *> mSecureSessionMgr{ nullptr };
+    Transport::Base * mTransport = nullptr;
 };
 
 } // namespace chip
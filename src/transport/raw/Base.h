@@ -37,8 +37,40 @@ class RawTransportDelegate
 {
 public:
     virtual ~RawTransportDelegate() {}
+
+    /**
+     * Handle a received message.
+     *
+     * @param receiveTime  when the message reached the host, in System::Layer::GetClock_MonotonicHiRes() time, or 0 if the
+     *                     transport does not know.
+     */
     virtual void HandleMessageReceived(const PacketHeader & packetHeader, const Transport::PeerAddress & peerAddress,
-                                       System::PacketBufferHandle msg) = 0;
+                                       System::PacketBufferHandle msg, uint64_t receiveTime) = 0;
+
+    /**
+     * Decrypt a secure message on a transport receive thread, for transports that service the network from threads
+     * other than the CHIP thread (see UdpListenParameters::SetReceiveShards). Must be thread safe.
+     *
+     * @param[out] sessionGeneration  identifies the session key the message was decrypted with. The transport hands it back,
+     *                                unchanged, to HandleDecodedMessageReceived().
+     *
+     * @retval #CHIP_NO_ERROR               the message was decrypted; deliver it with HandleDecodedMessageReceived().
+     * @retval #CHIP_ERROR_NOT_IMPLEMENTED  the message must be delivered undecoded with HandleMessageReceived().
+     * @retval other                        the message failed authentication and must be dropped.
+     */
+    virtual CHIP_ERROR DecodeMessageOnReceiveThread(const PacketHeader & packetHeader, PayloadHeader & payloadHeader,
+                                                    System::PacketBufferHandle & msg, uint32_t & sessionGeneration)
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Handle, on the CHIP thread, a message decrypted by DecodeMessageOnReceiveThread().
+     */
+    virtual void HandleDecodedMessageReceived(const PacketHeader & packetHeader, const PayloadHeader & payloadHeader,
+                                              const Transport::PeerAddress & peerAddress, System::PacketBufferHandle msg,
+                                              uint64_t receiveTime, uint32_t sessionGeneration)
+    {}
 };
 
 /**
@@ -87,10 +119,14 @@ protected:
     /**
      * Method used by subclasses to notify that a packet has been received after
      * any associated headers have been decoded.
+     *
+     * Transports that know when the message reached the host pass that time as
+     * @p receiveTime; see RawTransportDelegate::HandleMessageReceived().
      */
-    void HandleMessageReceived(const PacketHeader & header, const PeerAddress & source, System::PacketBufferHandle && buffer)
+    void HandleMessageReceived(const PacketHeader & header, const PeerAddress & source, System::PacketBufferHandle && buffer,
+                               uint64_t receiveTime = 0)
     {
-        mDelegate->HandleMessageReceived(header, source, std::move(buffer));
+        mDelegate->HandleMessageReceived(header, source, std::move(buffer), receiveTime);
     }
 
     RawTransportDelegate * mDelegate;
@@ -87,6 +87,20 @@ constexpr uint16_t kEncryptionTypeMask = 0xF0;
 /// Shift to convert to/from a masked encryption type 16bit value to a 4bit encryption type.
 constexpr int kEncryptionTypeShift = 4;
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
+/// A UDP socket filter sees the datagram from the UDP header, which precedes the packet header.
+constexpr uint32_t kUDPHeaderSizeBytes = 8;
+
+/// Offset of the high byte of the 16bit header prefix, which holds the version and the node id flags.
+constexpr uint32_t kHeaderPrefixHighByteOffset = kUDPHeaderSizeBytes + 1;
+
+static_assert(static_cast<uint16_t>(Header::FlagValues::kDestinationNodeIdPresent) == 0x0100 &&
+                  static_cast<uint16_t>(Header::FlagValues::kSourceNodeIdPresent) == 0x0200 && kNodeIdSizeBytes == 8,
+              "The UDP socket filter assumes this header layout");
+
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
 } // namespace
 
 uint16_t PacketHeader::EncodeSizeBytes() const
@@ -200,6 +214,40 @@ exit:
     return err;
 }
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+const struct sock_filter * PacketHeader::GetUDPSocketFilter(uint16_t & length)
+{
+    static const struct sock_filter kUDPSocketFilter[] = {
+        // Drop datagrams shorter than the fixed header.
+        /* 0 */ BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0),
+        /* 1 */ BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, kUDPHeaderSizeBytes + kFixedUnencryptedHeaderSizeBytes, 0, 16),
+        // Drop other header versions.
+        /* 2 */ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, kHeaderPrefixHighByteOffset),
+        /* 3 */ BPF_STMT(BPF_ALU | BPF_AND | BPF_K, kVersionMask >> 8),
+        /* 4 */ BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, (PacketHeader::kHeaderVersion << kVersionShift) >> 8, 0, 13),
+        // X = 8 * destination node id flag + 8 * source node id flag + fixed header size.
+        /* 5 */ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, kHeaderPrefixHighByteOffset),
+        /* 6 */ BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0x01),
+        /* 7 */ BPF_STMT(BPF_ALU | BPF_LSH | BPF_K, 3),
+        /* 8 */ BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        /* 9 */ BPF_STMT(BPF_LD | BPF_B | BPF_ABS, kHeaderPrefixHighByteOffset),
+        /* 10 */ BPF_STMT(BPF_ALU | BPF_AND | BPF_K, 0x02),
+        /* 11 */ BPF_STMT(BPF_ALU | BPF_LSH | BPF_K, 2),
+        /* 12 */ BPF_STMT(BPF_ALU | BPF_ADD | BPF_X, 0),
+        /* 13 */ BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, kUDPHeaderSizeBytes + kFixedUnencryptedHeaderSizeBytes),
+        /* 14 */ BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        // Accept if the datagram holds the whole header.
+        /* 15 */ BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0),
+        /* 16 */ BPF_JUMP(BPF_JMP | BPF_JGE | BPF_X, 0, 0, 1),
+        /* 17 */ BPF_STMT(BPF_RET | BPF_K, UINT32_MAX),
+        /* 18 */ BPF_STMT(BPF_RET | BPF_K, 0),
+    };
+
+    length = static_cast<uint16_t>(sizeof(kUDPSocketFilter) / sizeof(kUDPSocketFilter[0]));
+    return kUDPSocketFilter;
+}
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
 CHIP_ERROR PacketHeader::DecodeAndConsume(const System::PacketBufferHandle & buf)
 {
     uint16_t headerSize = 0;
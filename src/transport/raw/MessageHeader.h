@@ -31,10 +31,15 @@
 #include <core/CHIPError.h>
 #include <core/Optional.h>
 #include <core/PeerId.h>
+#include <inet/InetConfig.h>
 #include <protocols/Protocols.h>
 #include <support/BitFlags.h>
 #include <system/SystemPacketBuffer.h>
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+#include <linux/filter.h>
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
 namespace chip {
 
 static constexpr size_t kMaxTagLen = 16;
@@ -248,6 +253,18 @@ public:
      */
     CHIP_ERROR DecodeAndConsume(const System::PacketBufferHandle & buf);
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    /**
+     * A classic BPF program for UDP sockets that drops datagrams which cannot
+     * hold a packet header: those of another header version, and those
+     * shorter than the header their flags announce. See
+     * Inet::IPEndPointBasis::SetSocketFilter().
+     *
+     * @param[out] length  the number of instructions in the program.
+     */
+    static const struct sock_filter * GetUDPSocketFilter(uint16_t & length);
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
     /**
      * Encodes a header into the given buffer.
      *
@@ -25,6 +25,8 @@
 
 #include <stdio.h>
 
+#include <functional>
+
 #include <core/CHIPConfig.h>
 #include <inet/IPAddress.h>
 #include <inet/InetInterface.h>
@@ -64,7 +66,7 @@ public:
     PeerAddress() : mIPAddress(Inet::IPAddress::Any), mTransportType(Type::kUndefined), mInterface(INET_NULL_INTERFACEID) {}
     PeerAddress(const Inet::IPAddress & addr, Type type) : mIPAddress(addr), mTransportType(type), mInterface(INET_NULL_INTERFACEID)
     {}
-    PeerAddress(Type type) : mTransportType(type) {}
+    PeerAddress(Type type) : mIPAddress(Inet::IPAddress::Any), mTransportType(type) {}
 
     PeerAddress(PeerAddress &&)      = default;
     PeerAddress(const PeerAddress &) = default;
@@ -103,12 +105,28 @@ public:
 
     bool operator==(const PeerAddress & other) const
     {
-        return (mTransportType == other.mTransportType) && (mIPAddress == other.mIPAddress) && (mPort == other.mPort) &&
-            (mInterface == other.mInterface);
+        // The narrow fields differ most often between peers on the same transport; compare them before the address.
+        return (mPort == other.mPort) && (mTransportType == other.mTransportType) && (mInterface == other.mInterface) &&
+            (mIPAddress == other.mIPAddress);
     }
 
     bool operator!=(const PeerAddress & other) const { return !(*this == other); }
 
+    /**
+     * Hash of the fields compared by operator==, so that a PeerAddress may key a hash table (see std::hash<PeerAddress>).
+     */
+    size_t Hash() const
+    {
+        const uint64_t fields = (static_cast<uint64_t>(std::hash<Inet::InterfaceId>()(mInterface)) << 24) ^
+            (static_cast<uint64_t>(mPort) << 8) ^ static_cast<uint8_t>(mTransportType);
+        uint64_t h = static_cast<uint64_t>(mIPAddress.Hash());
+
+        h ^= fields * UINT64_C(0x9E3779B97F4A7C15);
+        h ^= h >> 32;
+
+        return static_cast<size_t>(h);
+    }
+
     /// Maximum size of an Inet address ToString format, that can hold both IPV6 and IPV4 addresses.
 #ifdef INET6_ADDRSTRLEN
     static constexpr size_t kInetMaxAddrLen = INET6_ADDRSTRLEN;
@@ -180,3 +198,13 @@ private:
 
 } // namespace Transport
 } // namespace chip
+
+namespace std {
+
+template <>
+struct hash<chip::Transport::PeerAddress>
+{
+    size_t operator()(const chip::Transport::PeerAddress & addr) const { return addr.Hash(); }
+};
+
+} // namespace std
@@ -55,8 +55,40 @@ CHIP_ERROR UDP::Init(UdpListenParameters & params)
     err = mUDPEndPoint->Listen(OnUdpReceive, nullptr /*onReceiveError*/, this);
     SuccessOrExit(err);
 
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    {
+        uint16_t filterLength;
+        const struct sock_filter * filter = PacketHeader::GetUDPSocketFilter(filterLength);
+
+        // The filter only saves wakeups for datagrams OnUdpReceive would discard, so failing to attach it is not fatal.
+        if (mUDPEndPoint->SetSocketFilter(filter, filterLength) != INET_NO_ERROR)
+        {
+            ChipLogError(Inet, "Failed to attach the UDP transport socket filter");
+        }
+    }
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    // Without kernel timestamps, receive times only miss the time spent in the socket's queue.
+    if (mUDPEndPoint->EnableReceiveTimestamps() != INET_NO_ERROR)
+    {
+        ChipLogProgress(Inet, "UDP transport receive timestamps are not available");
+    }
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
     mUDPEndpointType = params.GetAddressType();
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    if (params.GetReceiveShards() > 0)
+    {
+        // The shards join the endpoint's SO_REUSEPORT group, which keeps receiving its share of the traffic.
+        VerifyOrExit(params.GetInterfaceId() == INET_NULL_INTERFACEID, err = CHIP_ERROR_NOT_IMPLEMENTED);
+        err = mReceiveShards.Init(*this, *params.GetInetLayer()->SystemLayer(), params.GetAddressType(),
+                                  mUDPEndPoint->GetBoundPort(), params.GetReceiveShards());
+        SuccessOrExit(err);
+    }
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
     mState = State::kInitialized;
 
 exit:
@@ -75,6 +107,10 @@ exit:
 
 void UDP::Close()
 {
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    mReceiveShards.Shutdown();
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
     if (mUDPEndPoint)
     {
         // Udp endpoint is only non null if udp endpoint is initialized and listening
@@ -113,7 +149,7 @@ void UDP::OnUdpReceive(Inet::IPEndPointBasis * endPoint, System::PacketBufferHan
     err = header.DecodeAndConsume(buffer);
     SuccessOrExit(err);
 
-    udp->HandleMessageReceived(header, peerAddress, std::move(buffer));
+    udp->HandleMessageReceived(header, peerAddress, std::move(buffer), pktInfo->ReceiveTime);
 
 exit:
     if (err != CHIP_NO_ERROR)
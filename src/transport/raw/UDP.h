@@ -32,6 +32,7 @@
 #include <inet/IPEndPointBasis.h>
 #include <inet/InetInterface.h>
 #include <transport/raw/Base.h>
+#include <transport/raw/UDPReceiveShards.h>
 
 namespace chip {
 namespace Transport {
@@ -70,16 +71,38 @@ public:
         return *this;
     }
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    uint8_t GetReceiveShards() const { return mReceiveShards; }
+
+    /**
+     * Receive on @p count additional SO_REUSEPORT sockets, each with its own thread that decrypts secure messages before
+     * handing them to the CHIP thread. Zero, the default, receives on the CHIP thread only.
+     */
+    UdpListenParameters & SetReceiveShards(uint8_t count)
+    {
+        mReceiveShards = count;
+
+        return *this;
+    }
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
 private:
     Inet::InetLayer * mLayer         = nullptr;                   ///< Associated inet layer
     Inet::IPAddressType mAddressType = Inet::kIPAddressType_IPv6; ///< type of listening socket
     uint16_t mListenPort             = CHIP_PORT;                 ///< UDP listen port
     Inet::InterfaceId mInterfaceId   = INET_NULL_INTERFACEID;     ///< Interface to listen on
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    uint8_t mReceiveShards = 0; ///< Number of receive shards
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
 };
 
 /** Implements a transport using UDP. */
 class DLL_EXPORT UDP : public Base
 {
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    friend class UDPReceiveShards;
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
     /**
      *  The State of the UDP connection
      *
@@ -127,6 +150,9 @@ private:
     Inet::UDPEndPoint * mUDPEndPoint     = nullptr;                                     ///< UDP socket used by the transport
     Inet::IPAddressType mUDPEndpointType = Inet::IPAddressType::kIPAddressType_Unknown; ///< Socket listening type
     State mState                         = State::kNotReady;                            ///< State of the UDP transport
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    UDPReceiveShards mReceiveShards; ///< Additional receive sockets and threads
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
 };
 
 } // namespace Transport
@@ -0,0 +1,424 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the receive shards of the UDP transport.
+ */
+#include <transport/raw/UDPReceiveShards.h>
+
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+#include <transport/raw/UDP.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace chip {
+namespace Transport {
+
+static_assert(CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE > 0, "UDP receive shard queues must not be empty");
+
+CHIP_ERROR UDPReceiveShards::Init(UDP & owner, System::Layer & systemLayer, Inet::IPAddressType addressType, uint16_t port,
+                                  uint8_t shardCount)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrReturnError(mShardCount == 0 && mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(shardCount > 0 && shardCount <= CHIP_CONFIG_UDP_MAX_RECEIVE_SHARDS, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mOwner = &owner;
+    mDropped.store(0, std::memory_order_relaxed);
+    mWakePending.store(false, std::memory_order_relaxed);
+    mDecoder.store(nullptr, std::memory_order_relaxed);
+
+    // Closing the write end of this pipe wakes every shard thread at once.
+    VerifyOrExit(pipe2(mStopPipe, O_CLOEXEC) == 0, err = System::MapErrorPOSIX(errno));
+
+    err = systemLayer.AddWakeHandler(HandleWake, this);
+    SuccessOrExit(err);
+    mSystemLayer = &systemLayer;
+
+    for (uint8_t i = 0; i < shardCount; i++)
+    {
+        Shard & shard       = mShards[i];
+        shard.Owner         = this;
+        shard.Socket        = -1;
+        shard.ThreadStarted = false;
+        shard.Head.store(0, std::memory_order_relaxed);
+        shard.Tail.store(0, std::memory_order_relaxed);
+        mShardCount++;
+
+        err = OpenSocket(shard, addressType, port);
+        SuccessOrExit(err);
+
+        int res = pthread_create(&shard.Thread, nullptr, ShardMain, &shard);
+        VerifyOrExit(res == 0, err = System::MapErrorPOSIX(res));
+        shard.ThreadStarted = true;
+    }
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to start UDP receive shards: %s", ErrorStr(err));
+        Shutdown();
+    }
+    return err;
+}
+
+void UDPReceiveShards::Shutdown()
+{
+    if (mStopPipe[1] >= 0)
+    {
+        close(mStopPipe[1]);
+        mStopPipe[1] = -1;
+    }
+
+    for (uint8_t i = 0; i < mShardCount; i++)
+    {
+        Shard & shard = mShards[i];
+
+        if (shard.ThreadStarted)
+        {
+            pthread_join(shard.Thread, nullptr);
+            shard.ThreadStarted = false;
+        }
+
+        if (shard.Socket >= 0)
+        {
+            close(shard.Socket);
+            shard.Socket = -1;
+        }
+
+        for (Message & message : shard.Queue)
+        {
+            message.Buffer = nullptr;
+        }
+        shard.Head.store(0, std::memory_order_relaxed);
+        shard.Tail.store(0, std::memory_order_relaxed);
+    }
+
+    if (mStopPipe[0] >= 0)
+    {
+        close(mStopPipe[0]);
+        mStopPipe[0] = -1;
+    }
+
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->RemoveWakeHandler(HandleWake, this);
+        mSystemLayer = nullptr;
+    }
+
+    mShardCount = 0;
+    mOwner      = nullptr;
+    mDecoder.store(nullptr, std::memory_order_relaxed);
+}
+
+CHIP_ERROR UDPReceiveShards::OpenSocket(Shard & shard, Inet::IPAddressType addressType, uint16_t port)
+{
+    const int one = 1;
+    union
+    {
+        sockaddr any;
+        sockaddr_in6 in6;
+#if INET_CONFIG_ENABLE_IPV4
+        sockaddr_in in;
+#endif // INET_CONFIG_ENABLE_IPV4
+    } sa;
+    socklen_t saLen;
+    int family;
+
+    memset(&sa, 0, sizeof(sa));
+
+    switch (addressType)
+    {
+    case Inet::kIPAddressType_IPv6:
+        family             = AF_INET6;
+        sa.in6.sin6_family = AF_INET6;
+        sa.in6.sin6_addr   = in6addr_any;
+        sa.in6.sin6_port   = htons(port);
+        saLen              = sizeof(sa.in6);
+        break;
+
+#if INET_CONFIG_ENABLE_IPV4
+    case Inet::kIPAddressType_IPv4:
+        family                = AF_INET;
+        sa.in.sin_family      = AF_INET;
+        sa.in.sin_addr.s_addr = htonl(INADDR_ANY);
+        sa.in.sin_port        = htons(port);
+        saLen                 = sizeof(sa.in);
+        break;
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    default:
+        return INET_ERROR_WRONG_ADDRESS_TYPE;
+    }
+
+    shard.Socket = socket(family, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+    VerifyOrReturnError(shard.Socket >= 0, System::MapErrorPOSIX(errno));
+
+    // Unlike the endpoint, a shard is useless without SO_REUSEPORT, so a failure to set it is fatal here.
+    VerifyOrReturnError(setsockopt(shard.Socket, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0, System::MapErrorPOSIX(errno));
+    VerifyOrReturnError(setsockopt(shard.Socket, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) == 0, System::MapErrorPOSIX(errno));
+
+    // Match the endpoint, which binds IPv6 sockets as IPv6 only.
+    if (family == AF_INET6)
+    {
+        VerifyOrReturnError(setsockopt(shard.Socket, IPPROTO_IPV6, IPV6_V6ONLY, &one, sizeof(one)) == 0,
+                            System::MapErrorPOSIX(errno));
+    }
+
+#if INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+    // Same filter as the transport's endpoint; see UDP::Init().
+    {
+        uint16_t filterLength;
+        struct sock_fprog program;
+
+        program.filter = const_cast<struct sock_filter *>(PacketHeader::GetUDPSocketFilter(filterLength));
+        program.len    = filterLength;
+        if (setsockopt(shard.Socket, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) != 0)
+        {
+            ChipLogError(Inet, "Failed to attach the UDP receive shard socket filter: %d", errno);
+        }
+    }
+#endif // INET_CONFIG_ENABLE_BPF_SOCKET_FILTERS
+
+#ifdef SO_TIMESTAMPNS
+    // Same receive timestamps as the transport's endpoint; see IPEndPointBasis::EnableReceiveTimestamps().
+    if (setsockopt(shard.Socket, SOL_SOCKET, SO_TIMESTAMPNS, &one, sizeof(one)) != 0)
+    {
+        ChipLogProgress(Inet, "UDP receive shard timestamps are not available: %d", errno);
+    }
+#endif // defined(SO_TIMESTAMPNS)
+
+    VerifyOrReturnError(bind(shard.Socket, &sa.any, saLen) == 0, System::MapErrorPOSIX(errno));
+
+    return CHIP_NO_ERROR;
+}
+
+void * UDPReceiveShards::ShardMain(void * arg)
+{
+    Shard * shard = static_cast<Shard *>(arg);
+
+    shard->Owner->ReceiveLoop(*shard);
+
+    return nullptr;
+}
+
+void UDPReceiveShards::ReceiveLoop(Shard & shard)
+{
+    pollfd fds[2];
+
+    fds[0].fd     = shard.Socket;
+    fds[0].events = POLLIN;
+    fds[1].fd     = mStopPipe[0];
+    fds[1].events = POLLIN;
+
+    while (true)
+    {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            ChipLogError(Inet, "UDP receive shard poll failed: %d", errno);
+            break;
+        }
+
+        // The stop pipe only becomes readable (at EOF) when Shutdown() closes its write end.
+        if (fds[1].revents != 0)
+            break;
+
+        if (fds[0].revents == 0)
+            continue;
+
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (buffer.IsNull())
+        {
+            // Discard the datagram rather than spin on a readable socket.
+            static_cast<void>(recv(shard.Socket, nullptr, 0, MSG_DONTWAIT));
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        sockaddr_storage srcAddr;
+        iovec msgIOV;
+        uint64_t controlData[8];
+        msghdr msgHeader;
+
+        memset(&srcAddr, 0, sizeof(srcAddr));
+        memset(&msgHeader, 0, sizeof(msgHeader));
+
+        msgIOV.iov_base          = buffer->Start();
+        msgIOV.iov_len           = buffer->AvailableDataLength();
+        msgHeader.msg_name       = &srcAddr;
+        msgHeader.msg_namelen    = sizeof(srcAddr);
+        msgHeader.msg_iov        = &msgIOV;
+        msgHeader.msg_iovlen     = 1;
+        msgHeader.msg_control    = controlData;
+        msgHeader.msg_controllen = sizeof(controlData);
+
+        ssize_t rcvLen = recvmsg(shard.Socket, &msgHeader, MSG_DONTWAIT);
+        if (rcvLen < 0)
+            continue;
+
+        uint16_t srcPort;
+        if (srcAddr.ss_family == AF_INET6)
+        {
+            srcPort = ntohs(reinterpret_cast<const sockaddr_in6 &>(srcAddr).sin6_port);
+        }
+#if INET_CONFIG_ENABLE_IPV4
+        else if (srcAddr.ss_family == AF_INET)
+        {
+            srcPort = ntohs(reinterpret_cast<const sockaddr_in &>(srcAddr).sin_port);
+        }
+#endif // INET_CONFIG_ENABLE_IPV4
+        else
+        {
+            continue;
+        }
+
+        buffer->SetDataLength(static_cast<uint16_t>(rcvLen));
+
+        const PeerAddress source =
+            PeerAddress::UDP(Inet::IPAddress::FromSockAddr(reinterpret_cast<const sockaddr &>(srcAddr)), srcPort);
+        ProcessDatagram(shard, std::move(buffer), source, Inet::IPEndPointBasis::GetReceiveTime(msgHeader));
+    }
+}
+
+void UDPReceiveShards::ProcessDatagram(Shard & shard, System::PacketBufferHandle && buffer, const PeerAddress & source,
+                                       uint64_t receiveTime)
+{
+    PacketHeader header;
+    PayloadHeader payloadHeader;
+    uint32_t sessionGeneration = 0;
+    bool decoded               = false;
+
+    CHIP_ERROR err = header.DecodeAndConsume(buffer);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to receive UDP message: %s", ErrorStr(err));
+        return;
+    }
+
+    RawTransportDelegate * decoder = mDecoder.load(std::memory_order_acquire);
+    if (decoder != nullptr && header.GetFlags().Has(Header::FlagValues::kSecure))
+    {
+        err = decoder->DecodeMessageOnReceiveThread(header, payloadHeader, buffer, sessionGeneration);
+        if (err == CHIP_NO_ERROR)
+        {
+            decoded = true;
+        }
+        else if (err != CHIP_ERROR_NOT_IMPLEMENTED)
+        {
+            ChipLogError(Inet, "Failed to decode UDP message on receive shard: %s", ErrorStr(err));
+            return;
+        }
+    }
+
+    const uint32_t tail = shard.Tail.load(std::memory_order_relaxed);
+    if (tail - shard.Head.load(std::memory_order_acquire) >= CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE)
+    {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Message & message         = shard.Queue[tail % CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE];
+    message.Header            = header;
+    message.Payload           = payloadHeader;
+    message.Source            = source;
+    message.Buffer            = std::move(buffer);
+    message.ReceiveTime       = receiveTime;
+    message.SessionGeneration = sessionGeneration;
+    message.Decoded           = decoded;
+    shard.Tail.store(tail + 1, std::memory_order_release);
+
+    // One wakeup covers everything queued until the CHIP thread drains.
+    if (!mWakePending.exchange(true, std::memory_order_acq_rel))
+    {
+        mSystemLayer->WakeSelect();
+    }
+}
+
+void UDPReceiveShards::HandleWake(System::Layer * layer, void * appState)
+{
+    UDPReceiveShards * shards = static_cast<UDPReceiveShards *>(appState);
+
+    // The delegate may be set or replaced after Init(); republish it on every pass of the event loop.
+    shards->mDecoder.store(shards->mOwner->mDelegate, std::memory_order_release);
+
+    if (shards->mWakePending.exchange(false, std::memory_order_acq_rel))
+    {
+        shards->Drain();
+    }
+}
+
+void UDPReceiveShards::Drain()
+{
+    RawTransportDelegate * delegate = mOwner->mDelegate;
+
+    for (uint8_t i = 0; i < mShardCount; i++)
+    {
+        Shard & shard = mShards[i];
+        uint32_t head = shard.Head.load(std::memory_order_relaxed);
+        // Only deliver what was queued before this pass; later messages come with their own wakeup.
+        const uint32_t tail = shard.Tail.load(std::memory_order_acquire);
+
+        while (head != tail)
+        {
+            Message & slot                    = shard.Queue[head % CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE];
+            const PacketHeader header         = slot.Header;
+            const PayloadHeader payloadHeader = slot.Payload;
+            const PeerAddress source          = slot.Source;
+            const uint64_t receiveTime        = slot.ReceiveTime;
+            const uint32_t sessionGeneration  = slot.SessionGeneration;
+            const bool decoded                = slot.Decoded;
+            System::PacketBufferHandle buffer = std::move(slot.Buffer);
+
+            // Hand the slot back before delivery, which may take a while.
+            shard.Head.store(++head, std::memory_order_release);
+
+            if (decoded)
+            {
+                delegate->HandleDecodedMessageReceived(header, payloadHeader, source, std::move(buffer), receiveTime,
+                                                       sessionGeneration);
+            }
+            else
+            {
+                mOwner->HandleMessageReceived(header, source, std::move(buffer), receiveTime);
+            }
+        }
+    }
+}
+
+} // namespace Transport
+} // namespace chip
+
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
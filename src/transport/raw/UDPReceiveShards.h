@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the receive shards of the UDP transport: additional
+ *      SO_REUSEPORT sockets on the transport's port, each serviced by its own
+ *      thread that decrypts messages before handing them to the CHIP thread.
+ */
+
+#pragma once
+
+#include <core/CHIPConfig.h>
+
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
+#include <atomic>
+#include <pthread.h>
+
+#include <core/CHIPError.h>
+#include <inet/IPAddress.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/MessageHeader.h>
+#include <transport/raw/PeerAddress.h>
+
+namespace chip {
+namespace Transport {
+
+class RawTransportDelegate;
+class UDP;
+
+/**
+ *  @class UDPReceiveShards
+ *
+ *  @brief
+ *    Receives datagrams for a UDP transport on several threads.
+ *
+ *    The kernel spreads incoming datagrams across all sockets bound to the
+ *    port with SO_REUSEPORT, by hash of the source address, so messages from
+ *    one peer stay in order. Each shard thread decodes the packet header and
+ *    asks the transport delegate to decrypt the message
+ *    (RawTransportDelegate::DecodeMessageOnReceiveThread), then places it on
+ *    a single-producer, single-consumer queue. The CHIP thread drains the
+ *    queues from a System::Layer wake handler and delivers the messages as if
+ *    they had been received by the transport's own endpoint.
+ */
+class UDPReceiveShards
+{
+public:
+    UDPReceiveShards() = default;
+    ~UDPReceiveShards() { Shutdown(); }
+
+    UDPReceiveShards(const UDPReceiveShards &) = delete;
+    UDPReceiveShards & operator=(const UDPReceiveShards &) = delete;
+
+    /**
+     * Open @p shardCount sockets bound to @p port and start their threads. Must be called on the CHIP thread, after the
+     * transport's own endpoint was bound to the same port.
+     */
+    CHIP_ERROR Init(UDP & owner, System::Layer & systemLayer, Inet::IPAddressType addressType, uint16_t port,
+                    uint8_t shardCount);
+
+    /**
+     * Stop the threads, close the sockets and drop any messages not yet delivered. Must be called on the CHIP thread.
+     */
+    void Shutdown();
+
+    uint8_t ShardCount() const { return mShardCount; }
+
+    /** Number of datagrams dropped because a shard queue was full or no buffer was available. */
+    uint32_t DroppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Message
+    {
+        PacketHeader Header;
+        PayloadHeader Payload;
+        PeerAddress Source;
+        System::PacketBufferHandle Buffer;
+        uint64_t ReceiveTime;
+        uint32_t SessionGeneration;
+        bool Decoded;
+    };
+
+    struct Shard
+    {
+        UDPReceiveShards * Owner;
+        pthread_t Thread;
+        int Socket;
+        bool ThreadStarted;
+
+        // Written by the shard thread only; read by the CHIP thread.
+        std::atomic<uint32_t> Tail;
+        // Written by the CHIP thread only; read by the shard thread.
+        std::atomic<uint32_t> Head;
+        Message Queue[CHIP_CONFIG_UDP_RECEIVE_SHARD_QUEUE_SIZE];
+    };
+
+    CHIP_ERROR OpenSocket(Shard & shard, Inet::IPAddressType addressType, uint16_t port);
+    void ReceiveLoop(Shard & shard);
+    void ProcessDatagram(Shard & shard, System::PacketBufferHandle && buffer, const PeerAddress & source, uint64_t receiveTime);
+    void Drain();
+
+    static void * ShardMain(void * arg);
+    static void HandleWake(System::Layer * layer, void * appState);
+
+    UDP * mOwner                  = nullptr;
+    System::Layer * mSystemLayer  = nullptr;
+    uint8_t mShardCount           = 0;
+    int mStopPipe[2]              = { -1, -1 };
+    std::atomic<bool> mWakePending{ false };
+    std::atomic<uint32_t> mDropped{ 0 };
+    // The transport's delegate, published by the CHIP thread for use by the shard threads.
+    std::atomic<RawTransportDelegate *> mDecoder{ nullptr };
+    Shard mShards[CHIP_CONFIG_UDP_MAX_RECEIVE_SHARDS];
+};
+
+} // namespace Transport
+} // namespace chip
+
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
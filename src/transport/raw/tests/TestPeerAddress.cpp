@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the PeerAddress class within the
+ *      transport layer
+ *
+ */
+#include <inet/IPAddress.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <transport/raw/PeerAddress.h>
+
+#include <nlunit-test.h>
+
+#include <functional>
+
+namespace {
+
+using namespace chip;
+using chip::Inet::IPAddress;
+using chip::Transport::PeerAddress;
+
+void TestHashEqualAddresses(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("fe80::1", addr));
+
+    PeerAddress first  = PeerAddress::UDP(addr, 5540);
+    PeerAddress second = PeerAddress::UDP(addr, 5540);
+
+    NL_TEST_ASSERT(inSuite, first == second);
+    NL_TEST_ASSERT(inSuite, first.Hash() == second.Hash());
+    NL_TEST_ASSERT(inSuite, std::hash<PeerAddress>()(first) == first.Hash());
+
+    NL_TEST_ASSERT(inSuite, PeerAddress::BLE().Hash() == PeerAddress::BLE().Hash());
+}
+
+void TestHashDistinctAddresses(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress otherAddr;
+
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("fe80::1", addr));
+    NL_TEST_ASSERT(inSuite, IPAddress::FromString("fe80::2", otherAddr));
+
+    // Each differs from the first in exactly one of the fields compared by operator==.
+    const PeerAddress peers[] = {
+        PeerAddress::UDP(addr, 5540),
+        PeerAddress::UDP(otherAddr, 5540),
+        PeerAddress::UDP(addr, 5541),
+        PeerAddress::TCP(addr, 5540),
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP
+        PeerAddress::UDP(addr, 5540, static_cast<Inet::InterfaceId>(1)),
+#endif
+    };
+
+    for (size_t i = 0; i < ArraySize(peers); i++)
+    {
+        for (size_t j = i + 1; j < ArraySize(peers); j++)
+        {
+            NL_TEST_ASSERT(inSuite, peers[i] != peers[j]);
+            NL_TEST_ASSERT(inSuite, peers[i].Hash() != peers[j].Hash());
+        }
+    }
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("HashEqualAddresses", TestHashEqualAddresses),
+    NL_TEST_DEF("HashDistinctAddresses", TestHashDistinctAddresses),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestPeerAddress(void)
+{
+    nlTestSuite theSuite = { "Transport-PeerAddress", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPeerAddress)
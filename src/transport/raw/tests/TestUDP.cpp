@@ -34,6 +34,14 @@
 
 #include <errno.h>
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+#include <atomic>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
 using namespace chip;
 using namespace chip::Inet;
 
@@ -76,6 +84,110 @@ private:
     nlTestSuite * mSuite;
 };
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+constexpr uint32_t kSessionGeneration = 7;
+
+/**
+ * Pretends to decrypt secure messages on the receive shards, and counts where each message was handled.
+ */
+class MockDecodingTransportMgrDelegate : public TransportMgrDelegate
+{
+public:
+    MockDecodingTransportMgrDelegate(nlTestSuite * inSuite) : mSuite(inSuite), mTestThread(pthread_self()) {}
+
+    CHIP_ERROR DecodeMessageOnReceiveThread(const PacketHeader & header, PayloadHeader & payloadHeader,
+                                            System::PacketBufferHandle & msgBuf, uint32_t & sessionGeneration) override
+    {
+        if (pthread_equal(pthread_self(), mTestThread))
+        {
+            mDecodedOnTestThread++;
+        }
+
+        mDecodeStarted++;
+        while (mHoldDecode)
+        {
+            usleep(1000);
+        }
+        sessionGeneration = kSessionGeneration;
+        mDecodeFinished++;
+
+        return CHIP_NO_ERROR;
+    }
+
+    void OnDecodedMessageReceived(const PacketHeader & header, const PayloadHeader & payloadHeader,
+                                  const Transport::PeerAddress & source, System::PacketBufferHandle msgBuf, uint64_t receiveTime,
+                                  uint32_t sessionGeneration) override
+    {
+        NL_TEST_ASSERT(mSuite, pthread_equal(pthread_self(), mTestThread));
+        NL_TEST_ASSERT(mSuite, sessionGeneration == kSessionGeneration);
+        NL_TEST_ASSERT(mSuite, header.GetMessageId() == kMessageId);
+        NL_TEST_ASSERT(mSuite, msgBuf->DataLength() == sizeof(PAYLOAD));
+        NL_TEST_ASSERT(mSuite, memcmp(msgBuf->Start(), PAYLOAD, sizeof(PAYLOAD)) == 0);
+
+        mDecodedCount++;
+    }
+
+    void OnMessageReceived(const PacketHeader & header, const Transport::PeerAddress & source,
+                           System::PacketBufferHandle msgBuf) override
+    {
+        mUndecodedCount++;
+    }
+
+    std::atomic<bool> mHoldDecode{ false };
+    std::atomic<int> mDecodeStarted{ 0 };
+    std::atomic<int> mDecodeFinished{ 0 };
+    std::atomic<int> mDecodedOnTestThread{ 0 };
+    int mDecodedCount   = 0;
+    int mUndecodedCount = 0;
+
+private:
+    nlTestSuite * mSuite;
+    pthread_t mTestThread;
+};
+
+/**
+ * Send a secure message to the loopback port from a new socket, so that the kernel picks a new source port and with it,
+ * possibly, a different receive shard.
+ */
+bool SendFromNewSocket(uint16_t port)
+{
+    PacketHeader header;
+    uint8_t datagram[64];
+    uint16_t headerSize = 0;
+    sockaddr_in dest;
+
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+    header.GetFlags().Set(Header::FlagValues::kSecure);
+    if (header.Encode(datagram, sizeof(datagram) - sizeof(PAYLOAD), &headerSize) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+    memcpy(&datagram[headerSize], PAYLOAD, sizeof(PAYLOAD));
+
+    memset(&dest, 0, sizeof(dest));
+    dest.sin_family      = AF_INET;
+    dest.sin_port        = htons(port);
+    dest.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    const int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0)
+    {
+        return false;
+    }
+    const ssize_t sent = sendto(sock, datagram, headerSize + sizeof(PAYLOAD), 0, reinterpret_cast<sockaddr *>(&dest), sizeof(dest));
+    close(sock);
+
+    return sent == static_cast<ssize_t>(headerSize + sizeof(PAYLOAD));
+}
+
+void * ReleaseDecodeLater(void * aDelegate)
+{
+    usleep(100 * 1000);
+    static_cast<MockDecodingTransportMgrDelegate *>(aDelegate)->mHoldDecode = false;
+    return nullptr;
+}
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
 } // namespace
 
 /////////////////////////// Init test
@@ -162,6 +274,84 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS && INET_CONFIG_ENABLE_IPV4
+/////////////////////////// Receive shards test
+
+void CheckReceiveShardsTest4(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kMessageCount = 32;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    Transport::UDP udp;
+
+    CHIP_ERROR err =
+        udp.Init(Transport::UdpListenParameters(&ctx.GetInetLayer()).SetAddressType(kIPAddressType_IPv4).SetReceiveShards(2));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockDecodingTransportMgrDelegate delegate(inSuite);
+    TransportMgrBase transportMgrBase;
+    transportMgrBase.SetSecureSessionMgr(&delegate);
+    transportMgrBase.Init(&udp);
+
+    // Let the event loop publish the delegate to the shards.
+    ctx.DriveIO();
+
+    for (int i = 0; i < kMessageCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, SendFromNewSocket(CHIP_PORT));
+    }
+
+    ctx.DriveIOUntil(1000 /* ms */, [&delegate]() { return delegate.mDecodedCount + delegate.mUndecodedCount == kMessageCount; });
+
+    // The endpoint keeps its share of the traffic; the rest is decrypted by the shards and delivered on the CHIP thread.
+    NL_TEST_ASSERT(inSuite, delegate.mDecodedCount + delegate.mUndecodedCount == kMessageCount);
+    NL_TEST_ASSERT(inSuite, delegate.mDecodedCount > 0);
+    NL_TEST_ASSERT(inSuite, delegate.mDecodedOnTestThread == 0);
+    NL_TEST_ASSERT(inSuite, delegate.mDecodeFinished == delegate.mDecodedCount);
+
+    udp.Close();
+}
+
+void CheckReceiveShardsShutdownTest4(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    pthread_t releaser;
+
+    Transport::UDP udp;
+
+    CHIP_ERROR err =
+        udp.Init(Transport::UdpListenParameters(&ctx.GetInetLayer()).SetAddressType(kIPAddressType_IPv4).SetReceiveShards(2));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockDecodingTransportMgrDelegate delegate(inSuite);
+    TransportMgrBase transportMgrBase;
+    transportMgrBase.SetSecureSessionMgr(&delegate);
+    transportMgrBase.Init(&udp);
+
+    ctx.DriveIO();
+
+    // Keep a shard busy decoding while the transport is closed.
+    delegate.mHoldDecode = true;
+    for (int i = 0; i < 64 && delegate.mDecodeStarted == 0; i++)
+    {
+        NL_TEST_ASSERT(inSuite, SendFromNewSocket(CHIP_PORT));
+        usleep(1000);
+    }
+    NL_TEST_ASSERT(inSuite, delegate.mDecodeStarted > 0);
+
+    NL_TEST_ASSERT(inSuite, 0 == pthread_create(&releaser, nullptr, ReleaseDecodeLater, &delegate));
+    udp.Close();
+
+    // Close waits for the decode in progress, and drops its message rather than deliver it after the transport is closed.
+    NL_TEST_ASSERT(inSuite, delegate.mDecodeFinished == delegate.mDecodeStarted);
+    ctx.DriveIO();
+    NL_TEST_ASSERT(inSuite, delegate.mDecodedCount == 0);
+
+    NL_TEST_ASSERT(inSuite, 0 == pthread_join(releaser, nullptr));
+}
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS && INET_CONFIG_ENABLE_IPV4
+
 // Test Suite
 
 /**
@@ -174,6 +364,10 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Simple Init Test IPV4",   CheckSimpleInitTest4),
     NL_TEST_DEF("Message Self Test IPV4",  CheckMessageTest4),
 #endif
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS && INET_CONFIG_ENABLE_IPV4
+    NL_TEST_DEF("Receive Shards Test IPV4", CheckReceiveShardsTest4),
+    NL_TEST_DEF("Receive Shards Shutdown Test IPV4", CheckReceiveShardsShutdownTest4),
+#endif
 
     NL_TEST_DEF("Simple Init Test IPV6",   CheckSimpleInitTest6),
     NL_TEST_DEF("Message Self Test IPV6",  CheckMessageTest6),
@@ -0,0 +1,262 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the AdminPairingTable class
+ *      within the transport layer
+ *
+ */
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <transport/AdminPairingTable.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+/**
+ * Minimal in-memory KVS that counts the reads it serves.
+ */
+class TestStorage : public PersistentStorageDelegate
+{
+public:
+    void SetStorageDelegate(PersistentStorageResultDelegate * delegate) override {}
+
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        mReadCount++;
+
+        Entry * entry = Find(key);
+        VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(entry->mSize <= size, CHIP_ERROR_NO_MEMORY);
+
+        memcpy(buffer, entry->mValue, entry->mSize);
+        size = entry->mSize;
+        return CHIP_NO_ERROR;
+    }
+
+    void AsyncSetKeyValue(const char * key, const char * value) override {}
+
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        Entry * entry = Find(key);
+        if (entry == nullptr)
+        {
+            VerifyOrReturnError(mEntryCount < kMaxEntries, CHIP_ERROR_NO_MEMORY);
+            entry = &mEntries[mEntryCount++];
+            strncpy(entry->mKey, key, sizeof(entry->mKey) - 1);
+        }
+        VerifyOrReturnError(size <= sizeof(entry->mValue), CHIP_ERROR_NO_MEMORY);
+
+        memcpy(entry->mValue, value, size);
+        entry->mSize = size;
+        return CHIP_NO_ERROR;
+    }
+
+    void AsyncDeleteKeyValue(const char * key) override
+    {
+        Entry * entry = Find(key);
+        if (entry != nullptr)
+        {
+            *entry = mEntries[--mEntryCount];
+        }
+    }
+
+    size_t mReadCount = 0;
+
+private:
+    static constexpr size_t kMaxEntries = CHIP_CONFIG_MAX_DEVICE_ADMINS + 2;
+
+    struct Entry
+    {
+        char mKey[32];
+        uint8_t mValue[256];
+        uint16_t mSize;
+    };
+
+    Entry * Find(const char * key)
+    {
+        for (size_t i = 0; i < mEntryCount; i++)
+        {
+            if (strcmp(mEntries[i].mKey, key) == 0)
+            {
+                return &mEntries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    Entry mEntries[kMaxEntries] = {};
+    size_t mEntryCount          = 0;
+};
+
+size_t CountAdmins(const AdminPairingTable & table)
+{
+    size_t count = 0;
+    for (const AdminPairingInfo & admin : table)
+    {
+        if (admin.IsInitialized())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void TestAssignFindRelease(nlTestSuite * inSuite, void * inContext)
+{
+    AdminPairingTable table;
+
+    // Fill the table with admin ids that collide in the index.
+    for (AdminId i = 0; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
+    {
+        const AdminId adminId = static_cast<AdminId>(i * 64);
+        NL_TEST_ASSERT(inSuite, table.AssignAdminId(adminId, 1000 + i) != nullptr);
+    }
+    NL_TEST_ASSERT(inSuite, table.AssignAdminId(7) == nullptr);
+    NL_TEST_ASSERT(inSuite, table.GetCount() == CHIP_CONFIG_MAX_DEVICE_ADMINS);
+    NL_TEST_ASSERT(inSuite, CountAdmins(table) == CHIP_CONFIG_MAX_DEVICE_ADMINS);
+
+    for (AdminId i = 0; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
+    {
+        AdminPairingInfo * admin = table.FindAdmin(static_cast<AdminId>(i * 64));
+        NL_TEST_ASSERT(inSuite, admin != nullptr && admin->GetNodeId() == 1000u + i);
+    }
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(1) == nullptr);
+    NL_TEST_ASSERT(inSuite, table.FindAdminForNode(1003) == table.FindAdmin(3 * 64));
+    NL_TEST_ASSERT(inSuite, table.FindAdminForNode(999) == nullptr);
+
+    // Releasing admins in the middle of a probe sequence keeps the others reachable.
+    table.ReleaseAdminId(0);
+    table.ReleaseAdminId(5 * 64);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(0) == nullptr);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(5 * 64) == nullptr);
+    for (AdminId i = 1; i < CHIP_CONFIG_MAX_DEVICE_ADMINS; i++)
+    {
+        if (i != 5)
+        {
+            NL_TEST_ASSERT(inSuite, table.FindAdmin(static_cast<AdminId>(i * 64)) != nullptr);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, CountAdmins(table) == CHIP_CONFIG_MAX_DEVICE_ADMINS - 2);
+
+    // Iteration keeps assignment order.
+    AdminId previous = 0;
+    for (const AdminPairingInfo & admin : table)
+    {
+        NL_TEST_ASSERT(inSuite, admin.GetAdminId() > previous);
+        previous = admin.GetAdminId();
+    }
+
+    // Freed positions are reused.
+    NL_TEST_ASSERT(inSuite, table.AssignAdminId(5) != nullptr);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(5) != nullptr);
+
+    // Admins sharing an id are found in assignment order.
+    AdminPairingInfo * first = table.AssignAdminId(9, 1);
+    NL_TEST_ASSERT(inSuite, table.AssignAdminId(9, 2) == nullptr);
+    table.ReleaseAdminId(5);
+    AdminPairingInfo * second = table.AssignAdminId(9, 2);
+    NL_TEST_ASSERT(inSuite, first != nullptr && second != nullptr);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(9) == first);
+    table.ReleaseAdminId(9);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(9) == second);
+
+    table.Reset();
+    NL_TEST_ASSERT(inSuite, table.GetCount() == 0);
+    NL_TEST_ASSERT(inSuite, table.begin() == table.end());
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(64) == nullptr);
+}
+
+void TestLazyLoadFromKVS(nlTestSuite * inSuite, void * inContext)
+{
+    TestStorage storage;
+    AdminPairingTable table;
+    AdminPairingTable restored;
+
+    NL_TEST_ASSERT(inSuite, restored.LoadIndexFromKVS(storage) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    for (AdminId i = 0; i < 4; i++)
+    {
+        NL_TEST_ASSERT(inSuite, table.AssignAdminId(i, 0x100 + i) != nullptr);
+        NL_TEST_ASSERT(inSuite, table.StoreIntoKVS(storage, i) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, table.StoreIntoKVS(storage, 4) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Restoring reads the index only.
+    storage.mReadCount = 0;
+    NL_TEST_ASSERT(inSuite, restored.LoadIndexFromKVS(storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.mReadCount == 1);
+    NL_TEST_ASSERT(inSuite, restored.GetCount() == 4);
+    NL_TEST_ASSERT(inSuite, restored.FindAdminForNode(0x102) != nullptr);
+    NL_TEST_ASSERT(inSuite, storage.mReadCount == 1);
+
+    // The admin record is fetched on first use only.
+    AdminPairingInfo * admin = restored.FindAdmin(2);
+    NL_TEST_ASSERT(inSuite, admin != nullptr && admin->GetNodeId() == 0x102);
+    NL_TEST_ASSERT(inSuite, storage.mReadCount == 2);
+    NL_TEST_ASSERT(inSuite, restored.FindAdmin(2) == admin);
+    NL_TEST_ASSERT(inSuite, storage.mReadCount == 2);
+
+    // An admin whose record is gone is dropped when first used.
+    AdminPairingInfo::DeleteFromKVS(storage, 3);
+    NL_TEST_ASSERT(inSuite, restored.FindAdmin(3) == nullptr);
+    NL_TEST_ASSERT(inSuite, restored.GetCount() == 3);
+
+    // Releasing an admin and storing another one updates the index.
+    restored.ReleaseAdminId(3);
+    NL_TEST_ASSERT(inSuite, restored.AssignAdminId(10, 0x110) != nullptr);
+    NL_TEST_ASSERT(inSuite, restored.StoreIntoKVS(storage, 10) == CHIP_NO_ERROR);
+
+    table.Reset();
+    NL_TEST_ASSERT(inSuite, table.LoadIndexFromKVS(storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, table.GetCount() == 4);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(3) == nullptr);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(0) != nullptr && table.FindAdmin(0)->GetNodeId() == 0x100);
+    NL_TEST_ASSERT(inSuite, table.FindAdmin(10) != nullptr && table.FindAdmin(10)->GetNodeId() == 0x110);
+
+    AdminPairingTable::DeleteIndexFromKVS(storage);
+    table.Reset();
+    NL_TEST_ASSERT(inSuite, table.LoadIndexFromKVS(storage) == CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("AssignFindRelease", TestAssignFindRelease),
+    NL_TEST_DEF("LazyLoadFromKVS", TestLazyLoadFromKVS),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestAdminPairingTableFn(void)
+{
+    nlTestSuite theSuite = { "Transport-AdminPairingTable", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAdminPairingTableFn)
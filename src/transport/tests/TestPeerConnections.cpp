@@ -284,6 +284,37 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3Addr, nullptr));
 }
 
+void TestRoundTripTime(nlTestSuite * inSuite, void * inContext)
+{
+    PeerConnectionState state(kPeer1Addr);
+
+    NL_TEST_ASSERT(inSuite, state.GetSmoothedRoundTripTime() == 0);
+
+    // The first sample seeds the estimate.
+    state.AddRoundTripTimeSample(8000);
+    NL_TEST_ASSERT(inSuite, state.GetSmoothedRoundTripTime() == 8000);
+    NL_TEST_ASSERT(inSuite, state.GetRoundTripTimeVariation() == 4000);
+
+    // Later samples move it by an eighth of the difference, and the variation by a quarter.
+    state.AddRoundTripTimeSample(16000);
+    NL_TEST_ASSERT(inSuite, state.GetSmoothedRoundTripTime() == 9000);
+    NL_TEST_ASSERT(inSuite, state.GetRoundTripTimeVariation() == 5000);
+
+    // A steady round trip time converges.
+    for (int i = 0; i < 200; i++)
+    {
+        state.AddRoundTripTimeSample(2000);
+    }
+    NL_TEST_ASSERT(inSuite, state.GetSmoothedRoundTripTime() >= 2000 && state.GetSmoothedRoundTripTime() < 2010);
+    NL_TEST_ASSERT(inSuite, state.GetRoundTripTimeVariation() < 10);
+
+    state.SetLastReceiveTime(1234);
+    state.Reset();
+    NL_TEST_ASSERT(inSuite, state.GetSmoothedRoundTripTime() == 0);
+    NL_TEST_ASSERT(inSuite, state.GetRoundTripTimeVariation() == 0);
+    NL_TEST_ASSERT(inSuite, state.GetLastReceiveTime() == 0);
+}
+
 } // namespace
 
 // clang-format off
@@ -294,6 +325,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("FindByNodeId", TestFindByNodeId),
     NL_TEST_DEF("FindByKeyId", TestFindByKeyId),
     NL_TEST_DEF("ExpireConnections", TestExpireConnections),
+    NL_TEST_DEF("RoundTripTime", TestRoundTripTime),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -91,6 +91,36 @@ public:
     bool CanSendToPeer(const PeerAddress & address) override { return true; }
 };
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+/// Decrypts sent messages the way a receive shard does, and holds them until the test delivers them
+class DecodingTransport : public Transport::Base
+{
+public:
+    CHIP_ERROR SendMessage(const PacketHeader & header, const PeerAddress & address, System::PacketBufferHandle msgBuf) override
+    {
+        mHeader  = header;
+        mAddress = address;
+        ReturnErrorOnFailure(mDelegate->DecodeMessageOnReceiveThread(mHeader, mPayloadHeader, msgBuf, mSessionGeneration));
+        mMessage = std::move(msgBuf);
+        return CHIP_NO_ERROR;
+    }
+
+    void DeliverMessage()
+    {
+        mDelegate->HandleDecodedMessageReceived(mHeader, mPayloadHeader, mAddress, std::move(mMessage), 0, mSessionGeneration);
+    }
+
+    bool CanSendToPeer(const PeerAddress & address) override { return true; }
+
+private:
+    PacketHeader mHeader;
+    PayloadHeader mPayloadHeader;
+    PeerAddress mAddress;
+    System::PacketBufferHandle mMessage;
+    uint32_t mSessionGeneration = 0;
+};
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
 class TestSessMgrCallback : public SecureSessionMgrDelegate
 {
 public:
@@ -463,6 +493,87 @@ void SendBadEncryptedPacketTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 2);
 }
 
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+void DecodedMessageReplacedSessionTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    callback.LargeMessageSent = false;
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    DecodingTransport transport;
+    TransportMgrBase transportMgr;
+    SecureSessionMgr secureSessionMgr;
+
+    err = transportMgr.Init(&transport);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    Transport::AdminPairingTable admins;
+    err = secureSessionMgr.Init(kSourceNodeId, ctx.GetInetLayer().SystemLayer(), &transportMgr, &admins);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.mSuite = inSuite;
+
+    secureSessionMgr.SetDelegate(&callback);
+
+    Optional<Transport::PeerAddress> peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+
+    Transport::AdminPairingInfo * admin = admins.AssignAdminId(0, kSourceNodeId);
+    NL_TEST_ASSERT(inSuite, admin != nullptr);
+
+    admin = admins.AssignAdminId(1, kDestinationNodeId);
+    NL_TEST_ASSERT(inSuite, admin != nullptr);
+
+    SecurePairingUsingTestSecret pairing1(1, 2);
+    err = secureSessionMgr.NewPairing(peer, kSourceNodeId, &pairing1, SecureSessionMgr::PairingDirection::kInitiator, 1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    SecurePairingUsingTestSecret pairing2(2, 1);
+    err = secureSessionMgr.NewPairing(peer, kDestinationNodeId, &pairing2, SecureSessionMgr::PairingDirection::kResponder, 0);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    SecureSessionHandle localToRemoteSession = callback.mLocalToRemoteSession;
+
+    callback.ReceiveHandlerCallCount = 0;
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(0);
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+
+    // A message decrypted on a receive thread is delivered to its session
+    err = secureSessionMgr.SendMessage(localToRemoteSession, payloadHeader,
+                                       chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    transport.DeliverMessage();
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
+
+    // A message decrypted with the keys of a session that is replaced, with the same key ids, before the message reaches the
+    // CHIP thread is dropped
+    err = secureSessionMgr.SendMessage(localToRemoteSession, payloadHeader,
+                                       chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    SecurePairingUsingTestSecret pairing3(1, 2);
+    err = secureSessionMgr.NewPairing(peer, kSourceNodeId, &pairing3, SecureSessionMgr::PairingDirection::kInitiator, 1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    transport.DeliverMessage();
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
+
+    // Messages decrypted with the keys of the new session are delivered
+    err = secureSessionMgr.SendMessage(localToRemoteSession, payloadHeader,
+                                       chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    transport.DeliverMessage();
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 2);
+}
+#endif // CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+
 // Test Suite
 
 /**
@@ -475,6 +586,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("Message Self Test",              CheckMessageTest),
     NL_TEST_DEF("Send Encrypted Packet Test",     SendEncryptedPacketTest),
     NL_TEST_DEF("Send Bad Encrypted Packet Test", SendBadEncryptedPacketTest),
+#if CHIP_CONFIG_ENABLE_UDP_RECEIVE_SHARDS
+    NL_TEST_DEF("Decoded Message Replaced Session Test", DecodedMessageReplacedSessionTest),
+#endif
 
     NL_TEST_SENTINEL()
 };